@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef DOUBLE_BINARY_TREE_H_
+#define DOUBLE_BINARY_TREE_H_
+
+#include "utils/ucc_datastruct.h"
+
+#define UCC_DBT_PEER_NULL ((ucc_rank_t)-1)
+
+/* Double binary tree (Sanders, Speck, Traff 2009,
+   https://doi.org/10.1016/j.parco.2009.09.001): two binary trees over the
+   same ranks, the second one is the first one mirrored (even size) or
+   shifted by one rank (odd size). Leaves of the first tree are the odd
+   ranks and leaves of the second one are the even ranks, so every rank is
+   interior in at most one tree (except rank 0 for odd size) and, when each
+   tree carries half of the data, both links of every rank are busy. */
+typedef struct ucc_dbt_single_tree {
+    ucc_rank_t parent;      /*< UCC_DBT_PEER_NULL for the root of the tree */
+    ucc_rank_t children[2];
+    int        n_children;
+} ucc_dbt_single_tree_t;
+
+/**
+ *  In-order binary tree over ranks [0, size) rooted at rank 0: rank with
+ *  the lowest set bit "bit" has children rank -/+ bit / 2 (the right one
+ *  is moved down while it is out of range), rank 0 has the single child
+ *  which is the largest power of 2 below size.
+ *  @param [in]  rank  Rank in the tree
+ *  @param [in]  size  Size of the tree
+ *  @param [out] t     Parent and children of the rank
+ */
+static inline void ucc_dbt_build_btree(ucc_rank_t rank, ucc_rank_t size,
+                                       ucc_dbt_single_tree_t *t)
+{
+    ucc_rank_t bit, lowbit;
+
+    t->parent     = UCC_DBT_PEER_NULL;
+    t->n_children = 0;
+    if (size == 1) {
+        return;
+    }
+    for (bit = 1; bit < size; bit <<= 1) {
+        if (bit & rank) {
+            break;
+        }
+    }
+    if (rank == 0) {
+        t->children[t->n_children++] = bit >> 1;
+        return;
+    }
+    t->parent = (rank ^ bit) | (bit << 1);
+    if (t->parent >= size) {
+        t->parent = rank ^ bit;
+    }
+    lowbit = bit >> 1;
+    if (lowbit == 0) {
+        return;
+    }
+    t->children[t->n_children++] = rank - lowbit;
+    while (lowbit > 0 && rank + lowbit >= size) {
+        lowbit >>= 1;
+    }
+    if (lowbit > 0) {
+        t->children[t->n_children++] = rank + lowbit;
+    }
+}
+
+static inline ucc_rank_t ucc_dbt_map_rank(ucc_rank_t rank, ucc_rank_t size,
+                                          int inverse)
+{
+    if (rank == UCC_DBT_PEER_NULL) {
+        return rank;
+    }
+    if (size % 2 == 0) {
+        return size - 1 - rank;
+    }
+    return inverse ? (rank + 1) % size : (rank - 1 + size) % size;
+}
+
+/**
+ *  Builds both trees of the double binary tree for the rank.
+ *  @param [in]  rank  Rank in the trees
+ *  @param [in]  size  Number of ranks
+ *  @param [out] t1    First tree, rooted at rank 0
+ *  @param [out] t2    Second tree, rooted at ucc_dbt_root(size, 1)
+ */
+static inline void ucc_dbt_build_trees(ucc_rank_t rank, ucc_rank_t size,
+                                       ucc_dbt_single_tree_t *t1,
+                                       ucc_dbt_single_tree_t *t2)
+{
+    int i;
+
+    ucc_dbt_build_btree(rank, size, t1);
+    ucc_dbt_build_btree(ucc_dbt_map_rank(rank, size, 0), size, t2);
+    t2->parent = ucc_dbt_map_rank(t2->parent, size, 1);
+    for (i = 0; i < t2->n_children; i++) {
+        t2->children[i] = ucc_dbt_map_rank(t2->children[i], size, 1);
+    }
+}
+
+/* Root of the tree "tree" (0 or 1) of the double binary tree */
+static inline ucc_rank_t ucc_dbt_root(ucc_rank_t size, int tree)
+{
+    return tree ? ucc_dbt_map_rank(0, size, 1) : 0;
+}
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef KNOMIAL_MODEL_H_
+#define KNOMIAL_MODEL_H_
+
+#include "utils/ucc_datastruct.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_compiler_def.h"
+#include "recursive_knomial.h"
+
+/* LogGP-like cost model of the knomial algorithms, used to select the radix
+   per message size and team size. At each step of a knomial algorithm with
+   radix r a rank exchanges data with up to r - 1 peers:
+       T_step = L + n_peers * (2 * o + m * G)
+   L - latency, o - per message CPU overhead (send + recv), G - time per
+   byte (includes the reduction cost for reductions). */
+
+#define UCC_KN_MODEL_MAX_RADIX 16
+
+typedef struct ucc_kn_model {
+    double L;
+    double o;
+    double G;
+} ucc_kn_model_t;
+
+typedef enum ucc_kn_model_pattern {
+    /* full message at every step, extra ranks are served by proxies:
+       allreduce knomial, barrier */
+    UCC_KN_MODEL_RECURSIVE,
+    /* full message at every step: bcast and reduce knomial trees */
+    UCC_KN_MODEL_TREE,
+    /* message is split between r peers at every step: scatter knomial */
+    UCC_KN_MODEL_SCATTER,
+    /* scatter (reduce_scatter) followed by allgather: SRA allreduce, SAG
+       bcast */
+    UCC_KN_MODEL_SRA
+} ucc_kn_model_pattern_t;
+
+static inline double ucc_kn_model_step(const ucc_kn_model_t *model,
+                                       ucc_rank_t n_peers, double msgsize)
+{
+    return n_peers ? model->L + n_peers * (2 * model->o + msgsize * model->G)
+                   : 0;
+}
+
+static inline double ucc_kn_model_cost(const ucc_kn_model_t  *model,
+                                       ucc_kn_model_pattern_t pattern,
+                                       ucc_rank_t size, size_t msgsize,
+                                       ucc_kn_radix_t radix)
+{
+    double     t   = 0;
+    double     seg = (double)msgsize;
+    int        pow_radix_sup, full_pow_size;
+    ucc_rank_t n_full, n_extra, n_peers;
+    int        i;
+
+    CALC_POW_RADIX_SUP(size, radix, pow_radix_sup, full_pow_size);
+    n_full  = size / full_pow_size;
+    n_extra = size - n_full * full_pow_size;
+    for (i = 0; i < pow_radix_sup; i++) {
+        /* last step of not full tree has fewer peers */
+        n_peers = (i == pow_radix_sup - 1 && full_pow_size != size) ?
+                  n_full - 1 : radix - 1;
+        if (pattern == UCC_KN_MODEL_SCATTER || pattern == UCC_KN_MODEL_SRA) {
+            seg /= (n_peers + 1);
+        }
+        t += ucc_kn_model_step(model, n_peers, seg);
+    }
+    if (pattern == UCC_KN_MODEL_SRA) {
+        /* allgather mirrors the reduce_scatter */
+        t *= 2;
+    }
+    if (n_extra &&
+        (pattern == UCC_KN_MODEL_RECURSIVE || pattern == UCC_KN_MODEL_SRA)) {
+        /* data exchange between extra ranks and proxies */
+        t += 2 * ucc_kn_model_step(model, 1, (double)msgsize);
+    }
+    return t;
+}
+
+/* Returns the radix from [2, min(max_radix, size)] with the min cost */
+static inline ucc_kn_radix_t
+ucc_kn_model_get_radix(const ucc_kn_model_t *model,
+                       ucc_kn_model_pattern_t pattern, ucc_rank_t size,
+                       size_t msgsize, ucc_kn_radix_t max_radix)
+{
+    ucc_kn_radix_t best = 2;
+    double         best_t, t;
+    ucc_kn_radix_t r;
+
+    if (size <= 2) {
+        /* radix of knomial algorithms is at least 2 */
+        return 2;
+    }
+    max_radix = ucc_min(ucc_min(max_radix, UCC_KN_MODEL_MAX_RADIX), size);
+    best_t    = ucc_kn_model_cost(model, pattern, size, msgsize, best);
+    for (r = 3; r <= max_radix; r++) {
+        t = ucc_kn_model_cost(model, pattern, size, msgsize, r);
+        if (t < best_t) {
+            best_t = t;
+            best   = r;
+        }
+    }
+    return best;
+}
+
+#endif
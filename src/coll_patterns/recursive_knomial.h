@@ -149,6 +149,41 @@ static inline ucc_rank_t ucc_knomial_pattern_get_loop_peer(ucc_knomial_pattern_t
         (peer < p->n_extra) ? peer*2 : peer + p->n_extra;
 }
 
+/* Rank ordered block layout: loop rank l serves the blocks of ranks
+   [2l, 2l + 2) if it is a proxy and l + n_extra otherwise, so a group of
+   consecutive loop ranks serves a contiguous range of blocks */
+static inline ucc_rank_t
+ucc_knomial_pattern_loop_first_block(ucc_knomial_pattern_t *p,
+                                     ucc_rank_t             loop_rank)
+{
+    return (loop_rank < p->n_extra) ? loop_rank * 2 : loop_rank + p->n_extra;
+}
+
+/* Range of blocks served by the group of radix_pow loop ranks of rank */
+static inline void ucc_knomial_pattern_loop_range(ucc_knomial_pattern_t *p,
+                                                  ucc_rank_t             size,
+                                                  ucc_rank_t             rank,
+                                                  ucc_rank_t            *start,
+                                                  ucc_rank_t *n_blocks)
+{
+    ucc_rank_t n_loop = size - p->n_extra;
+    ucc_rank_t lrank  = ucc_knomial_pattern_loop_rank(p, rank);
+    ucc_rank_t first  = lrank - lrank % p->radix_pow;
+    ucc_rank_t last   = ucc_min(first + p->radix_pow, n_loop);
+
+    *start    = ucc_knomial_pattern_loop_first_block(p, first);
+    *n_blocks = ucc_knomial_pattern_loop_first_block(p, last) - *start;
+}
+
+/* Digit of the loop rank at the current iteration. Loop ranks with zero
+   digit are the parents of the knomial tree formed by the iteration, the
+   peer of a rank with digit d != 0 at loop_step (radix - d) is its parent. */
+static inline ucc_kn_radix_t
+ucc_knomial_pattern_loop_digit(ucc_knomial_pattern_t *p, ucc_rank_t rank)
+{
+    return (ucc_knomial_pattern_loop_rank(p, rank) / p->radix_pow) % p->radix;
+}
+
 static inline void ucc_knomial_pattern_next_iteration(ucc_knomial_pattern_t *p)
 {
     p->iteration++;
@@ -6,6 +6,9 @@
 #include "ucc_coll_score.h"
 #include "utils/ucc_string.h"
 #include "utils/ucc_coll_utils.h"
+#include "core/ucc_team.h"
+#include "core/ucc_global_opts.h"
+#include <ctype.h>
 
 ucc_status_t ucc_coll_score_alloc(ucc_coll_score_t **score)
 {
@@ -20,6 +23,7 @@ ucc_status_t ucc_coll_score_alloc(ucc_coll_score_t **score)
     for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
         for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
             ucc_list_head_init(&s->scores[i][j]);
+            ucc_list_head_init(&s->cands[i][j]);
         }
     }
     *score = s;
@@ -36,7 +40,7 @@ static inline ucc_status_t
 coll_score_add_range(ucc_coll_score_t *score, ucc_coll_type_t coll_type,
                      ucc_memory_type_t mem_type, size_t start, size_t end,
                      ucc_score_t msg_score, ucc_base_coll_init_fn_t init,
-                     ucc_base_team_t *team)
+                     ucc_base_team_t *team, unsigned radix)
 {
     ucc_msg_range_t *r;
     ucc_msg_range_t *range;
@@ -58,6 +62,7 @@ coll_score_add_range(ucc_coll_score_t *score, ucc_coll_type_t coll_type,
     r->super.score = msg_score;
     r->super.init  = init;
     r->super.team  = team;
+    r->super.radix = radix;
     list           = &score->scores[ucc_ilog2(coll_type)][mem_type];
     insert_pos     = list;
     ucc_list_for_each(range, list, super.list_elem) {
@@ -92,7 +97,49 @@ ucc_status_t ucc_coll_score_add_range(ucc_coll_score_t *score,
         return UCC_OK;
     }
     return coll_score_add_range(score, coll_type, mem_type, start, end,
-                                msg_score, init, team);
+                                msg_score, init, team, 0);
+}
+
+ucc_status_t ucc_coll_score_add_cand(ucc_coll_score_t *score,
+                                     ucc_coll_type_t   coll_type,
+                                     ucc_memory_type_t mem_type, int alg_id,
+                                     unsigned radix,
+                                     ucc_base_coll_init_fn_t init,
+                                     ucc_base_team_t *team)
+{
+    ucc_coll_cand_t *c;
+
+    c = ucc_malloc(sizeof(*c), "ucc_coll_cand");
+    if (!c) {
+        ucc_error("failed to allocate %zd bytes for ucc_coll_cand", sizeof(*c));
+        return UCC_ERR_NO_MEMORY;
+    }
+    c->super.score = UCC_SCORE_INVALID;
+    c->super.init  = init;
+    c->super.team  = team;
+    c->super.radix = radix;
+    c->alg_id      = alg_id;
+    ucc_list_add_tail(&score->cands[ucc_ilog2(coll_type)][mem_type],
+                      &c->super.list_elem);
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_cand_list_dup(const ucc_list_link_t *src,
+                                      ucc_list_link_t       *dst)
+{
+    ucc_coll_cand_t *c, *dup;
+
+    ucc_list_for_each(c, src, super.list_elem) {
+        dup = ucc_malloc(sizeof(*dup), "ucc_coll_cand");
+        if (!dup) {
+            ucc_error("failed to allocate %zd bytes for ucc_coll_cand",
+                      sizeof(*dup));
+            return UCC_ERR_NO_MEMORY;
+        }
+        memcpy(dup, c, sizeof(*dup));
+        ucc_list_add_tail(dst, &dup->super.list_elem);
+    }
+    return UCC_OK;
 }
 
 void ucc_coll_score_free(ucc_coll_score_t *score)
@@ -105,6 +152,8 @@ void ucc_coll_score_free(ucc_coll_score_t *score)
         for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
             ucc_list_destruct(&score->scores[i][j], ucc_msg_range_t,
                               ucc_msg_range_free, super.list_elem);
+            ucc_list_destruct(&score->cands[i][j], ucc_coll_cand_t, ucc_free,
+                              super.list_elem);
         }
     }
     ucc_free(score);
@@ -113,6 +162,7 @@ void ucc_coll_score_free(ucc_coll_score_t *score)
 static ucc_status_t ucc_fallback_alloc(ucc_score_t              score,
                                        ucc_base_coll_init_fn_t  init,
                                        ucc_base_team_t         *team,
+                                       unsigned                 radix,
                                        ucc_coll_entry_t       **_fb)
 {
     ucc_coll_entry_t *fb;
@@ -127,6 +177,7 @@ static ucc_status_t ucc_fallback_alloc(ucc_score_t              score,
     fb->score = score;
     fb->init  = init;
     fb->team  = team;
+    fb->radix = radix;
     *_fb      = fb;
     return UCC_OK;
 }
@@ -140,7 +191,7 @@ static inline void ucc_fallback_insert(ucc_list_link_t  *list,
     insert_pos = list;
     ucc_list_for_each(f, list, list_elem) {
         if (fb->score == f->score && fb->init == f->init &&
-            fb->team == f->team) {
+            fb->team == f->team && fb->radix == f->radix) {
             ucc_free(fb);
             /* same fallback: skip */
             return;
@@ -157,7 +208,8 @@ static inline void ucc_fallback_insert(ucc_list_link_t  *list,
 #define FB_ALLOC_INSERT(_fb_in, _fb_out, _dest, _status, _label) do {   \
         _status =                                                       \
             ucc_fallback_alloc((_fb_in)->score, (_fb_in)->init,         \
-                               (_fb_in)->team, &(_fb_out));             \
+                               (_fb_in)->team, (_fb_in)->radix,         \
+                               &(_fb_out));                             \
         if (ucc_unlikely(UCC_OK != _status)) {                          \
             goto _label;                                                \
         }                                                               \
@@ -217,12 +269,13 @@ static ucc_status_t ucc_msg_range_add_fallback(const ucc_msg_range_t *in,
     ucc_status_t      status;
 
     if (in->super.init == out->super.init &&
-        in->super.team == out->super.team) {
+        in->super.team == out->super.team &&
+        in->super.radix == out->super.radix) {
         return UCC_OK;
     }
 
     status = ucc_fallback_alloc(in->super.score, in->super.init, in->super.team,
-                                &fb);
+                                in->super.radix, &fb);
     if (ucc_unlikely(UCC_OK != status)) {
         return status;
     }
@@ -276,7 +329,7 @@ static inline int ucc_msg_range_fb_compare(ucc_msg_range_t *r1,
     fb2 = ucc_list_head(l2, ucc_coll_entry_t, list_elem);
     ucc_list_for_each(fb1, l1, list_elem) {
         if (fb1->score != fb2->score || fb1->init != fb2->init ||
-            fb1->team != fb2->team) {
+            fb1->team != fb2->team || fb1->radix != fb2->radix) {
             return 0;
         }
         fb2 = ucc_list_next(&fb2->list_elem, ucc_coll_entry_t, list_elem);
@@ -374,6 +427,7 @@ static ucc_status_t ucc_coll_score_merge_one(ucc_list_link_t *list1,
                 range->end == next->start &&
                 range->super.init == next->super.init &&
                 range->super.team == next->super.team &&
+                range->super.radix == next->super.radix &&
                 1 == ucc_msg_range_fb_compare(range, next)) {
                 next->start = range->start;
                 ucc_list_del(&range->super.list_elem);
@@ -409,6 +463,14 @@ ucc_status_t ucc_coll_score_merge(ucc_coll_score_t * score1,
             status = ucc_coll_score_merge_one(&score1->scores[i][j],
                                               &score2->scores[i][j],
                                               &out->scores[i][j]);
+            if (UCC_OK == status) {
+                status = ucc_cand_list_dup(&score1->cands[i][j],
+                                           &out->cands[i][j]);
+            }
+            if (UCC_OK == status) {
+                status = ucc_cand_list_dup(&score2->cands[i][j],
+                                           &out->cands[i][j]);
+            }
             if (UCC_OK != status) {
                 ucc_coll_score_free(out);
                 goto out;
@@ -521,6 +583,18 @@ static ucc_status_t str_to_alg_id(const char *str, const char **alg_id)
     return UCC_OK;
 }
 
+static ucc_status_t str_to_radix(const char *str, unsigned *radix)
+{
+    const char *prefix = "radix=";
+
+    if (0 != strncasecmp(str, prefix, strlen(prefix)) ||
+        UCC_OK != ucc_str_is_number(str + strlen(prefix))) {
+        return UCC_ERR_NOT_FOUND;
+    }
+    *radix = (unsigned)atoi(str + strlen(prefix));
+    return (*radix >= 2) ? UCC_OK : UCC_ERR_NOT_FOUND;
+}
+
 static ucc_status_t str_to_msgranges(const char *str, size_t **ranges,
                                      unsigned *n_ranges)
 {
@@ -654,160 +728,278 @@ err:
     goto out;
 }
 
-static ucc_status_t ucc_coll_score_parse_str(const char *str,
-                                             ucc_coll_score_t *score,
-                                             ucc_rank_t team_size, //NOLINT
-                                             ucc_base_coll_init_fn_t init,
-                                             ucc_base_team_t *team,
-                                             ucc_alg_id_to_init_fn_t alg_fn)
+/* Team shape qualifier: "<prefix>[r_start_1-r_end_1,...]" */
+static ucc_status_t str_to_shape(const char *str, const char *prefix,
+                                 ucc_rank_t **ranges, unsigned *n_ranges)
 {
-    ucc_status_t            status   = UCC_OK;
-    ucc_coll_type_t        *ct       = NULL;
-    ucc_memory_type_t      *mt       = NULL;
-    size_t                 *msg      = NULL;
-    ucc_rank_t             *tsizes   = NULL;
-    ucc_base_coll_init_fn_t alg_init = NULL;
-    const char*             alg_id   = NULL;
-    ucc_score_t             score_v  = UCC_SCORE_INVALID;
-    int                     ts_skip  = 0;
-    char                  **tokens;
-    unsigned i, n_tokens, ct_n, mt_n, c, m, n_ranges, r, n_tsizes;
-
-    mt_n = ct_n = n_ranges = n_tsizes = 0;
-    tokens = ucc_str_split(str, ":");
+    ucc_status_t status;
+
+    if (0 != strncasecmp(str, prefix, strlen(prefix))) {
+        return UCC_ERR_NOT_FOUND;
+    }
+    status = str_to_tsizes(str + strlen(prefix), ranges, n_ranges);
+    return (UCC_ERR_NOT_FOUND == status) ? UCC_ERR_INVALID_PARAM : status;
+}
+
+static inline int ucc_rank_in_ranges(ucc_rank_t v, const ucc_rank_t *ranges,
+                                     unsigned n_ranges)
+{
+    unsigned i;
+
+    for (i = 0; i < n_ranges; i++) {
+        if (v >= ranges[2 * i] && v <= ranges[2 * i + 1]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Single "#" separated token of the score string */
+typedef struct ucc_coll_score_rule {
+    ucc_list_link_t    list_elem;
+    char              *str;
+    ucc_coll_type_t   *ct;
+    ucc_memory_type_t *mt;
+    size_t            *msg;
+    ucc_rank_t        *tsizes;
+    ucc_rank_t        *nnodes;
+    ucc_rank_t        *ppn;
+    char              *alg_id;
+    unsigned           ct_n;
+    unsigned           mt_n;
+    unsigned           n_ranges;
+    unsigned           n_tsizes;
+    unsigned           n_nnodes;
+    unsigned           n_ppn;
+    unsigned           radix;
+    ucc_score_t        score;
+} ucc_coll_score_rule_t;
+
+/* Rules of a single score string, applied with one score update */
+typedef struct ucc_coll_score_rules_group {
+    ucc_list_link_t list_elem;
+    ucc_list_link_t rules;
+} ucc_coll_score_rules_group_t;
+
+struct ucc_coll_score_rules {
+    ucc_list_link_t groups;
+};
+
+static void ucc_coll_score_rule_free(ucc_coll_score_rule_t *rule)
+{
+    ucc_free(rule->str);
+    ucc_free(rule->ct);
+    ucc_free(rule->mt);
+    ucc_free(rule->msg);
+    ucc_free(rule->tsizes);
+    ucc_free(rule->nnodes);
+    ucc_free(rule->ppn);
+    ucc_free(rule->alg_id);
+    ucc_free(rule);
+}
+
+static ucc_status_t ucc_coll_score_rule_parse(const char             *str,
+                                              ucc_coll_score_rule_t **rule_p)
+{
+    ucc_status_t           status = UCC_OK;
+    const char            *alg_id = NULL;
+    ucc_coll_score_rule_t *rule;
+    char                 **tokens;
+    unsigned               i, n_tokens;
+
+    rule = ucc_calloc(1, sizeof(*rule), "ucc_coll_score_rule");
+    if (!rule) {
+        ucc_error("failed to allocate %zd bytes for ucc_coll_score_rule",
+                  sizeof(*rule));
+        return UCC_ERR_NO_MEMORY;
+    }
+    rule->score = UCC_SCORE_INVALID;
+    tokens      = ucc_str_split(str, ":");
     if (!tokens) {
         status = UCC_ERR_INVALID_PARAM;
         goto out;
     }
     n_tokens = ucc_str_split_count(tokens);
     for (i = 0; i < n_tokens; i++) {
-        if (!ct && UCC_OK == str_to_coll_type(tokens[i], &ct_n, &ct)) {
+        if (!rule->ct &&
+            UCC_OK == str_to_coll_type(tokens[i], &rule->ct_n, &rule->ct)) {
+            continue;
+        }
+        if (!rule->mt &&
+            UCC_OK == str_to_mem_type(tokens[i], &rule->mt_n, &rule->mt)) {
+            continue;
+        }
+        if ((UCC_SCORE_INVALID == rule->score) &&
+            UCC_OK == str_to_score(tokens[i], &rule->score)) {
             continue;
         }
-        if (!mt && UCC_OK == str_to_mem_type(tokens[i], &mt_n, &mt)) {
+        if (!rule->msg && UCC_OK == str_to_msgranges(tokens[i], &rule->msg,
+                                                     &rule->n_ranges)) {
             continue;
         }
-        if ((UCC_SCORE_INVALID == score_v) &&
-            UCC_OK == str_to_score(tokens[i], &score_v)) {
+        if (!rule->tsizes && UCC_OK == str_to_tsizes(tokens[i], &rule->tsizes,
+                                                     &rule->n_tsizes)) {
             continue;
         }
-        if (!msg && UCC_OK == str_to_msgranges(tokens[i], &msg, &n_ranges)) {
+        if (!rule->nnodes &&
+            UCC_OK == str_to_shape(tokens[i], "nnodes=", &rule->nnodes,
+                                   &rule->n_nnodes)) {
             continue;
         }
-        if (!tsizes && UCC_OK == str_to_tsizes(tokens[i], &tsizes, &n_tsizes)) {
+        if (!rule->ppn && UCC_OK == str_to_shape(tokens[i], "ppn=", &rule->ppn,
+                                                 &rule->n_ppn)) {
             continue;
         }
         if (!alg_id && UCC_OK == str_to_alg_id(tokens[i], &alg_id)) {
             continue;
         }
+        if (!rule->radix && UCC_OK == str_to_radix(tokens[i], &rule->radix)) {
+            continue;
+        }
         /* if we get there then we could not match token to any field */
         status = UCC_ERR_INVALID_PARAM;
-
-        //TODO add parsing of msg ranges and team size ranges
         goto out;
     }
-    if (tsizes) {
-        /* Team size qualifier was provided: check if we should apply this
-           str setting to the  current team */
-        ts_skip = 1;
-        for (i = 0; i < n_tsizes; i++) {
-            if (team_size >= tsizes[2 * i] && team_size <= tsizes[2 * i + 1]) {
-                ts_skip = 0;
-                break;
-            }
-        }
+    rule->str = strdup(str);
+    if (alg_id) {
+        rule->alg_id = strdup(alg_id);
     }
-    if (!ts_skip && (UCC_SCORE_INVALID != score_v || NULL != alg_id)) {
-        /* Score provided but not coll_types/mem_types.
-           This means: apply score to ALL coll_types/mem_types */
-        if (!ct)
-            ct_n = UCC_COLL_TYPE_NUM;
-        if (!mt)
-            mt_n = UCC_MEMORY_TYPE_LAST;
-        if (!msg)
-            n_ranges = 1;
-        for (c = 0; c < ct_n; c++) {
-            for (m = 0; m < mt_n; m++) {
-                ucc_coll_type_t   coll_type = ct ? ct[c] :
-                                                   (ucc_coll_type_t)UCC_BIT(c);
-                ucc_memory_type_t mem_type  = mt ? mt[m] :
-                                                   (ucc_memory_type_t)m;
-                if (alg_id) {
-                    if (!alg_fn) {
-                        status = UCC_ERR_NOT_SUPPORTED;
-                        ucc_error("modifying algorithm id is not supported by "
-                                  "component %s",
-                                  team->context->lib->log_component.name);
-                        goto out;
-                    }
-                    ucc_assert(NULL != team);
-                    const char *alg_id_str = NULL;
-                    int         alg_id_n   = 0;
-                    if (UCC_OK == ucc_str_is_number(alg_id)) {
-                        alg_id_n = atoi(alg_id);
-                    } else {
-                        alg_id_str = alg_id;
-                    }
-                    status = alg_fn(alg_id_n, alg_id_str, coll_type, mem_type,
-                                    &alg_init);
-                    if (UCC_ERR_INVALID_PARAM == status) {
-                        ucc_error("incorrect algorithm id provided: %s, %s, "
-                                  "component %s",
-                                  alg_id, str,
-                                  team->context->lib->log_component.name);
-                        goto out;
-                    } else if (UCC_ERR_NOT_SUPPORTED == status) {
-                        ucc_error("modifying algorithm id is not supported for "
-                                  "%s, alg %s, component %s",
-                                  ucc_coll_type_str(coll_type), alg_id,
-                                  team->context->lib->log_component.name);
-                        goto out;
-                    } else if (status < 0) {
-                        ucc_error("failed to map alg id to init: %s, %s, "
-                                  "status %s, component %s",
-                                  alg_id, str, ucc_status_string(status),
-                                  team->context->lib->log_component.name);
-                        goto out;
-                    }
+    if (!rule->str || (alg_id && !rule->alg_id)) {
+        ucc_error("failed to allocate ucc_coll_score_rule strings");
+        status = UCC_ERR_NO_MEMORY;
+    }
+out:
+    ucc_str_split_free(tokens);
+    if (UCC_OK != status) {
+        ucc_coll_score_rule_free(rule);
+        return status;
+    }
+    *rule_p = rule;
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_coll_score_rule_apply(const ucc_coll_score_rule_t      *rule,
+                          ucc_coll_score_t                 *score,
+                          const ucc_coll_score_team_info_t *info,
+                          ucc_base_coll_init_fn_t init, ucc_base_team_t *team,
+                          ucc_alg_id_to_init_fn_t alg_fn)
+{
+    ucc_status_t            status   = UCC_OK;
+    ucc_base_coll_init_fn_t alg_init = NULL;
+    unsigned                ct_n     = rule->ct_n;
+    unsigned                mt_n     = rule->mt_n;
+    unsigned                n_ranges = rule->n_ranges;
+    unsigned                c, m, r;
+
+    /* Team shape qualifiers were provided: check if we should apply this
+       str setting to the current team. Unknown shape never matches. */
+    if ((rule->tsizes &&
+         !ucc_rank_in_ranges(info->size, rule->tsizes, rule->n_tsizes)) ||
+        (rule->nnodes && (!info->nnodes || !ucc_rank_in_ranges(
+                                               info->nnodes, rule->nnodes,
+                                               rule->n_nnodes))) ||
+        (rule->ppn &&
+         (!info->ppn ||
+          !ucc_rank_in_ranges(info->ppn, rule->ppn, rule->n_ppn)))) {
+        return UCC_OK;
+    }
+    if (UCC_SCORE_INVALID == rule->score && NULL == rule->alg_id &&
+        !rule->radix) {
+        return UCC_OK;
+    }
+    /* Score provided but not coll_types/mem_types.
+       This means: apply score to ALL coll_types/mem_types */
+    if (!rule->ct)
+        ct_n = UCC_COLL_TYPE_NUM;
+    if (!rule->mt)
+        mt_n = UCC_MEMORY_TYPE_LAST;
+    if (!rule->msg)
+        n_ranges = 1;
+    for (c = 0; c < ct_n; c++) {
+        for (m = 0; m < mt_n; m++) {
+            ucc_coll_type_t   coll_type = rule->ct ? rule->ct[c] :
+                                                     (ucc_coll_type_t)UCC_BIT(c);
+            ucc_memory_type_t mem_type  = rule->mt ? rule->mt[m] :
+                                                     (ucc_memory_type_t)m;
+            if (rule->alg_id) {
+                if (!alg_fn) {
+                    ucc_error("modifying algorithm id is not supported by "
+                              "component %s",
+                              team->context->lib->log_component.name);
+                    return UCC_ERR_NOT_SUPPORTED;
                 }
-                for (r = 0; r < n_ranges; r++) {
-                    size_t m_start = 0;
-                    size_t m_end   = UCC_MSG_MAX;
-                    if (msg) {
-                        m_start = msg[r * 2];
-                        m_end   = msg[r * 2 + 1];
-                    }
-                    status = coll_score_add_range(
-                        score, coll_type, mem_type, m_start, m_end, score_v,
-                        alg_init ? alg_init : init, team);
+                ucc_assert(NULL != team);
+                const char *alg_id_str = NULL;
+                int         alg_id_n   = 0;
+                if (UCC_OK == ucc_str_is_number(rule->alg_id)) {
+                    alg_id_n = atoi(rule->alg_id);
+                } else {
+                    alg_id_str = rule->alg_id;
                 }
+                status = alg_fn(alg_id_n, alg_id_str, coll_type, mem_type,
+                                &alg_init);
+                if (UCC_ERR_INVALID_PARAM == status) {
+                    ucc_error("incorrect algorithm id provided: %s, %s, "
+                              "component %s",
+                              rule->alg_id, rule->str,
+                              team->context->lib->log_component.name);
+                    return status;
+                } else if (UCC_ERR_NOT_SUPPORTED == status) {
+                    ucc_error("modifying algorithm id is not supported for "
+                              "%s, alg %s, component %s",
+                              ucc_coll_type_str(coll_type), rule->alg_id,
+                              team->context->lib->log_component.name);
+                    return status;
+                } else if (status < 0) {
+                    ucc_error("failed to map alg id to init: %s, %s, "
+                              "status %s, component %s",
+                              rule->alg_id, rule->str,
+                              ucc_status_string(status),
+                              team->context->lib->log_component.name);
+                    return status;
+                }
+            }
+            for (r = 0; r < n_ranges; r++) {
+                size_t m_start = 0;
+                size_t m_end   = UCC_MSG_MAX;
+                if (rule->msg) {
+                    m_start = rule->msg[r * 2];
+                    m_end   = rule->msg[r * 2 + 1];
+                }
+                status = coll_score_add_range(
+                    score, coll_type, mem_type, m_start, m_end, rule->score,
+                    alg_init ? alg_init : init, team, rule->radix);
             }
         }
     }
-out:
-    ucc_free(ct);
-    ucc_free(mt);
-    ucc_free(msg);
-    ucc_free(tsizes);
-    ucc_str_split_free(tokens);
     return status;
 }
 
-ucc_status_t ucc_coll_score_alloc_from_str(const char *            str,
-                                           ucc_coll_score_t **     score_p,
-                                           ucc_rank_t              team_size,
-                                           ucc_base_coll_init_fn_t init,
-                                           ucc_base_team_t *       team,
-                                           ucc_alg_id_to_init_fn_t alg_fn)
+static void ucc_coll_score_rules_group_free(ucc_coll_score_rules_group_t *g)
 {
-    ucc_coll_score_t *score;
-    ucc_status_t      status;
-    char            **tokens;
-    unsigned          n_tokens, i;
-    status = ucc_coll_score_alloc(&score);
-    if (UCC_OK != status) {
-        return status;
+    ucc_list_destruct(&g->rules, ucc_coll_score_rule_t,
+                      ucc_coll_score_rule_free, list_elem);
+    ucc_free(g);
+}
+
+static ucc_status_t
+ucc_coll_score_rules_group_parse(const char                     *str,
+                                 ucc_coll_score_rules_group_t **group_p)
+{
+    ucc_status_t                  status = UCC_OK;
+    ucc_coll_score_rules_group_t *group;
+    ucc_coll_score_rule_t        *rule;
+    char                        **tokens;
+    unsigned                      n_tokens, i;
+
+    group = ucc_malloc(sizeof(*group), "ucc_coll_score_rules_group");
+    if (!group) {
+        ucc_error("failed to allocate %zd bytes for ucc_coll_score_rules_group",
+                  sizeof(*group));
+        return UCC_ERR_NO_MEMORY;
     }
+    ucc_list_head_init(&group->rules);
     tokens = ucc_str_split(str, "#");
     if (!tokens) {
         status = UCC_ERR_INVALID_PARAM;
@@ -815,24 +1007,248 @@ ucc_status_t ucc_coll_score_alloc_from_str(const char *            str,
     }
     n_tokens = ucc_str_split_count(tokens);
     for (i = 0; i < n_tokens; i++) {
-        status = ucc_coll_score_parse_str(tokens[i], score, team_size, init,
-                                          team, alg_fn);
+        status = ucc_coll_score_rule_parse(tokens[i], &rule);
         if (UCC_OK != status) {
-            goto error_msg;
+            ucc_error("failed to parse UCC_*_TUNE parameter: %s", tokens[i]);
+            goto error;
         }
+        ucc_list_add_tail(&group->rules, &rule->list_elem);
     }
     ucc_str_split_free(tokens);
-    *score_p = score;
+    *group_p = group;
     return UCC_OK;
-error_msg:
-    ucc_error("failed to parse UCC_*_TUNE parameter: %s", tokens[i]);
 error:
-    *score_p = NULL;
-    ucc_coll_score_free(score);
     ucc_str_split_free(tokens);
+    ucc_coll_score_rules_group_free(group);
     return status;
 }
 
+static ucc_status_t
+ucc_coll_score_rules_group_apply(const ucc_coll_score_rules_group_t *group,
+                                 ucc_coll_score_t                   *score,
+                                 const ucc_coll_score_team_info_t   *info,
+                                 ucc_base_coll_init_fn_t             init,
+                                 ucc_base_team_t                    *team,
+                                 ucc_alg_id_to_init_fn_t             alg_fn)
+{
+    ucc_coll_score_rule_t *rule;
+    ucc_status_t           status;
+
+    ucc_list_for_each(rule, &group->rules, list_elem) {
+        status = ucc_coll_score_rule_apply(rule, score, info, init, team,
+                                           alg_fn);
+        if (UCC_OK != status) {
+            ucc_error("failed to apply UCC_*_TUNE parameter: %s", rule->str);
+            return status;
+        }
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_coll_score_alloc_from_str(const char *            str,
+                                           ucc_coll_score_t **     score_p,
+                                           ucc_rank_t              team_size,
+                                           ucc_base_coll_init_fn_t init,
+                                           ucc_base_team_t *       team,
+                                           ucc_alg_id_to_init_fn_t alg_fn)
+{
+    ucc_coll_score_team_info_t    info = {.size = team_size};
+    ucc_coll_score_rules_group_t *group;
+    ucc_coll_score_t             *score;
+    ucc_status_t                  status;
+
+    *score_p = NULL;
+    status   = ucc_coll_score_rules_group_parse(str, &group);
+    if (UCC_OK != status) {
+        return status;
+    }
+    status = ucc_coll_score_alloc(&score);
+    if (UCC_OK != status) {
+        goto out;
+    }
+    status = ucc_coll_score_rules_group_apply(group, score, &info, init, team,
+                                              alg_fn);
+    if (UCC_OK != status) {
+        ucc_coll_score_free(score);
+        goto out;
+    }
+    *score_p = score;
+out:
+    ucc_coll_score_rules_group_free(group);
+    return status;
+}
+
+ucc_status_t ucc_coll_score_rules_alloc(ucc_coll_score_rules_t **rules_p)
+{
+    ucc_coll_score_rules_t *rules;
+
+    rules = ucc_malloc(sizeof(*rules), "ucc_coll_score_rules");
+    if (!rules) {
+        ucc_error("failed to allocate %zd bytes for ucc_coll_score_rules",
+                  sizeof(*rules));
+        return UCC_ERR_NO_MEMORY;
+    }
+    ucc_list_head_init(&rules->groups);
+    *rules_p = rules;
+    return UCC_OK;
+}
+
+void ucc_coll_score_rules_free(ucc_coll_score_rules_t *rules)
+{
+    if (!rules) {
+        return;
+    }
+    ucc_list_destruct(&rules->groups, ucc_coll_score_rules_group_t,
+                      ucc_coll_score_rules_group_free, list_elem);
+    ucc_free(rules);
+}
+
+int ucc_coll_score_rules_is_empty(const ucc_coll_score_rules_t *rules)
+{
+    return !rules || ucc_list_is_empty(&rules->groups);
+}
+
+static int ucc_coll_score_rule_topo_required(const ucc_coll_score_rule_t *rule,
+                                             ucc_alg_topo_required_fn_t topo_fn)
+{
+    const char     *alg_id_str = NULL;
+    int             alg_id_n   = 0;
+    unsigned        ct_n, c;
+    ucc_coll_type_t coll_type;
+
+    if (rule->nnodes || rule->ppn) {
+        return 1;
+    }
+    if (!rule->alg_id || !topo_fn) {
+        return 0;
+    }
+    if (UCC_OK == ucc_str_is_number(rule->alg_id)) {
+        alg_id_n = atoi(rule->alg_id);
+    } else {
+        alg_id_str = rule->alg_id;
+    }
+    ct_n = rule->ct ? rule->ct_n : UCC_COLL_TYPE_NUM;
+    for (c = 0; c < ct_n; c++) {
+        coll_type = rule->ct ? rule->ct[c] : (ucc_coll_type_t)UCC_BIT(c);
+        if (topo_fn(alg_id_n, alg_id_str, coll_type)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int ucc_coll_score_rules_topo_required(const ucc_coll_score_rules_t *rules,
+                                       ucc_alg_topo_required_fn_t    topo_fn)
+{
+    ucc_coll_score_rules_group_t *group;
+    ucc_coll_score_rule_t        *rule;
+
+    if (!rules) {
+        return 0;
+    }
+    ucc_list_for_each(group, &rules->groups, list_elem) {
+        ucc_list_for_each(rule, &group->rules, list_elem) {
+            if (ucc_coll_score_rule_topo_required(rule, topo_fn)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+ucc_status_t ucc_coll_score_rules_add_str(ucc_coll_score_rules_t *rules,
+                                          const char             *str)
+{
+    ucc_coll_score_rules_group_t *group;
+    ucc_status_t                  status;
+
+    status = ucc_coll_score_rules_group_parse(str, &group);
+    if (UCC_OK != status) {
+        return status;
+    }
+    ucc_list_add_tail(&rules->groups, &group->list_elem);
+    return UCC_OK;
+}
+
+ucc_status_t ucc_coll_score_rules_add_file(ucc_coll_score_rules_t *rules,
+                                           const char *filename,
+                                           const char *key)
+{
+    ucc_status_t status  = UCC_OK;
+    ucc_status_t st;
+    char        *line    = NULL;
+    size_t       len     = 0;
+    size_t       key_len = strlen(key);
+    int          lineno  = 0;
+    FILE        *f;
+    ssize_t      n;
+
+    f = fopen(filename, "r");
+    if (!f) {
+        ucc_error("failed to open tuning file %s", filename);
+        return UCC_ERR_NOT_FOUND;
+    }
+    while ((n = getline(&line, &len, f)) != -1) {
+        lineno++;
+        while (n > 0 && isspace(line[n - 1])) {
+            line[--n] = '\0';
+        }
+        /* "<key>=<score string>" lines, other components lines and
+           comments are skipped */
+        if (0 != strncmp(line, key, key_len) || line[key_len] != '=') {
+            continue;
+        }
+        st = ucc_coll_score_rules_add_str(rules, line + key_len + 1);
+        if (UCC_OK != st) {
+            /* invalid line is skipped, the rest of the file is loaded */
+            ucc_error("invalid %s setting in tuning file %s:%d", key,
+                      filename, lineno);
+            if (UCC_OK == status || UCC_ERR_NO_MEMORY == st) {
+                status = st;
+            }
+            if (UCC_ERR_NO_MEMORY == st) {
+                break;
+            }
+        }
+    }
+    free(line);
+    fclose(f);
+    return status;
+}
+
+ucc_status_t
+ucc_coll_score_update_from_rules(const ucc_coll_score_rules_t     *rules,
+                                 ucc_coll_score_t                 *score,
+                                 const ucc_coll_score_team_info_t *info,
+                                 ucc_base_coll_init_fn_t init,
+                                 ucc_base_team_t *team, ucc_score_t def_score,
+                                 ucc_alg_id_to_init_fn_t alg_fn)
+{
+    ucc_coll_score_rules_group_t *group;
+    ucc_coll_score_t             *update;
+    ucc_status_t                  status;
+
+    if (!rules) {
+        return UCC_OK;
+    }
+    ucc_list_for_each(group, &rules->groups, list_elem) {
+        status = ucc_coll_score_alloc(&update);
+        if (UCC_OK != status) {
+            return status;
+        }
+        status = ucc_coll_score_rules_group_apply(group, update, info, init,
+                                                  team, alg_fn);
+        if (UCC_OK == status) {
+            status = ucc_coll_score_update(score, update, def_score);
+        }
+        ucc_coll_score_free(update);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    return UCC_OK;
+}
+
 static ucc_status_t ucc_coll_score_update_one(ucc_list_link_t *dest,
                                               ucc_list_link_t *src,
                                               ucc_score_t      default_score)
@@ -892,6 +1308,9 @@ static ucc_status_t ucc_coll_score_update_one(ucc_list_link_t *dest,
                     rd->super.init = rs->super.init;
                     rd->super.team = rs->super.team;
                 }
+                if (rs->super.init || rs->super.radix) {
+                    rd->super.radix = rs->super.radix;
+                }
                 rs->start = rd->end;
                 d         = d->next;
             } else if (rs->end < rd->end) {
@@ -908,6 +1327,9 @@ static ucc_status_t ucc_coll_score_update_one(ucc_list_link_t *dest,
                     new->super.init = rs->super.init;
                     new->super.team = rs->super.team;
                 }
+                if (rs->super.init || rs->super.radix) {
+                    new->super.radix = rs->super.radix;
+                }
                 ucc_list_insert_before(d, &new->super.list_elem);
                 rd->start = rs->end;
                 s         = s->next;
@@ -923,6 +1345,9 @@ static ucc_status_t ucc_coll_score_update_one(ucc_list_link_t *dest,
                     rd->super.init = rs->super.init;
                     rd->super.team = rs->super.team;
                 }
+                if (rs->super.init || rs->super.radix) {
+                    rd->super.radix = rs->super.radix;
+                }
                 s = s->next;
                 d = d->next;
             }
@@ -956,6 +1381,7 @@ static ucc_status_t ucc_coll_score_update_one(ucc_list_link_t *dest,
                 range->end == next->start &&
                 range->super.init == next->super.init &&
                 range->super.team == next->super.team &&
+                range->super.radix == next->super.radix &&
                 1 == ucc_msg_range_fb_compare(range, next)) {
                 next->start = range->start;
                 ucc_list_del(&range->super.list_elem);
@@ -1006,6 +1432,73 @@ ucc_status_t ucc_coll_score_update_from_str(const char *            str,
     return status;
 }
 
+void ucc_coll_score_team_info_init(ucc_base_team_t            *team,
+                                   ucc_coll_score_team_info_t *info)
+{
+    ucc_team_t *core_team = team->params.team;
+
+    info->size   = team->params.size;
+    info->nnodes = 0;
+    info->ppn    = 0;
+    if (!core_team || !core_team->topo) {
+        /* topo is not available for non global contexts */
+        return;
+    }
+    if (UCC_OK != ucc_topo_get_shape(core_team->topo, team->params.map,
+                                     info->size, &info->nnodes, &info->ppn)) {
+        info->nnodes = 0;
+        info->ppn    = 0;
+    }
+}
+
+ucc_status_t ucc_coll_score_lib_rules_init(ucc_base_lib_t *lib,
+                                           const char     *score_str)
+{
+    const char  *file = ucc_global_config.tune_file;
+    char         key[64];
+    ucc_status_t status;
+    int          i;
+
+    lib->score_rules = NULL;
+    if (strlen(file) == 0 && strlen(score_str) == 0) {
+        return UCC_OK;
+    }
+    status = ucc_coll_score_rules_alloc(&lib->score_rules);
+    if (UCC_OK != status) {
+        return status;
+    }
+    if (strlen(file) > 0) {
+        /* same key as in the output of ucc_coll_tuner_str */
+        ucc_snprintf_safe(key, sizeof(key), "UCC_%s_TUNE",
+                          lib->log_component.name);
+        for (i = 0; key[i]; i++) {
+            key[i] = (key[i] == ' ' || key[i] == '-') ? '_' : toupper(key[i]);
+        }
+        status = ucc_coll_score_rules_add_file(lib->score_rules, file, key);
+        if (UCC_ERR_NO_MEMORY == status) {
+            goto error;
+        }
+    }
+    if (strlen(score_str) > 0) {
+        status = ucc_coll_score_rules_add_str(lib->score_rules, score_str);
+        if (UCC_ERR_NO_MEMORY == status) {
+            goto error;
+        }
+    }
+    /* If INVALID_PARAM - User provided incorrect input - the invalid
+       settings are skipped (error is reported by the parser), try to
+       proceed */
+    if (ucc_coll_score_rules_is_empty(lib->score_rules)) {
+        ucc_coll_score_rules_free(lib->score_rules);
+        lib->score_rules = NULL;
+    }
+    return UCC_OK;
+error:
+    ucc_coll_score_rules_free(lib->score_rules);
+    lib->score_rules = NULL;
+    return status;
+}
+
 ucc_status_t ucc_coll_score_build_default(ucc_base_team_t        *team,
                                           ucc_score_t             default_score,
                                           ucc_base_coll_init_fn_t default_init,
@@ -1062,6 +1555,11 @@ ucc_status_t ucc_coll_score_dup(const ucc_coll_score_t *in,
             if (UCC_OK != status) {
                 return status;
             }
+            status = ucc_cand_list_dup(&in->cands[i][j], &score->cands[i][j]);
+            if (UCC_OK != status) {
+                ucc_coll_score_free(score);
+                return status;
+            }
         }
     }
     *out = score;
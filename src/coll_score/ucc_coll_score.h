@@ -24,6 +24,7 @@ typedef struct ucc_coll_entry {
     ucc_score_t              score;
     ucc_base_coll_init_fn_t  init;
     ucc_base_team_t         *team;
+    unsigned                 radix; /*< 0 - component default radix */
 } ucc_coll_entry_t;
 
 typedef struct ucc_msg_range {
@@ -33,8 +34,16 @@ typedef struct ucc_msg_range {
     size_t                  end;
 } ucc_msg_range_t;
 
+/* Algorithm candidate of the online tuner (see ucc_coll_score_tune.h),
+   score of the entry is not used */
+typedef struct ucc_coll_cand {
+    ucc_coll_entry_t        super;
+    int                     alg_id;
+} ucc_coll_cand_t;
+
 typedef struct ucc_coll_score {
     ucc_list_link_t scores[UCC_COLL_TYPE_NUM][UCC_MEMORY_TYPE_LAST];
+    ucc_list_link_t cands[UCC_COLL_TYPE_NUM][UCC_MEMORY_TYPE_LAST];
 } ucc_coll_score_t;
 
 typedef struct ucc_score_map ucc_score_map_t;
@@ -51,6 +60,15 @@ ucc_status_t  ucc_coll_score_add_range(ucc_coll_score_t *score,
                                        ucc_base_coll_init_fn_t init,
                                        ucc_base_team_t *team);
 
+/* Adds the algorithm candidate that can be selected by the online tuner
+   for the coll_type/mem_type. Candidates are kept by merge and dup. */
+ucc_status_t  ucc_coll_score_add_cand(ucc_coll_score_t *score,
+                                      ucc_coll_type_t   coll_type,
+                                      ucc_memory_type_t mem_type, int alg_id,
+                                      unsigned radix,
+                                      ucc_base_coll_init_fn_t init,
+                                      ucc_base_team_t *team);
+
 /* Releases the score data structure and all the score ranges stored
    there */
 void          ucc_coll_score_free(ucc_coll_score_t *score);
@@ -123,6 +141,64 @@ ucc_status_t ucc_coll_score_update(ucc_coll_score_t *score,
                                    ucc_coll_score_t *update,
                                    ucc_score_t       default_score);
 
+/* Team shape used to filter the score ranges with team_size, nnodes and
+   ppn qualifiers. 0 - unknown, ranges with the qualifier are skipped. */
+typedef struct ucc_coll_score_team_info {
+    ucc_rank_t size;
+    ucc_rank_t nnodes; /*< number of nodes spanned by the team */
+    ucc_rank_t ppn;    /*< max number of team processes per node */
+} ucc_coll_score_team_info_t;
+
+/* Fills team info of the component team, nnodes and ppn are only known
+   if the core team has topo */
+void ucc_coll_score_team_info_init(ucc_base_team_t            *team,
+                                   ucc_coll_score_team_info_t *info);
+
+/* Score rules: SCORE strings parsed once and applied to every team of the
+   component with ucc_coll_score_update_from_rules. Each added string is
+   applied as a separate update in the order of addition, so later
+   strings take precedence. */
+ucc_status_t ucc_coll_score_rules_alloc(ucc_coll_score_rules_t **rules);
+
+void         ucc_coll_score_rules_free(ucc_coll_score_rules_t *rules);
+
+int          ucc_coll_score_rules_is_empty(const ucc_coll_score_rules_t *rules);
+
+ucc_status_t ucc_coll_score_rules_add_str(ucc_coll_score_rules_t *rules,
+                                          const char             *str);
+
+/* Adds the SCORE strings of "key=str" lines of the tuning file, other
+   lines are ignored */
+ucc_status_t ucc_coll_score_rules_add_file(ucc_coll_score_rules_t *rules,
+                                           const char *filename,
+                                           const char *key);
+
+/* Same as ucc_coll_score_update_from_str for every string of rules,
+   ranges are filtered with team info */
+ucc_status_t
+ucc_coll_score_update_from_rules(const ucc_coll_score_rules_t     *rules,
+                                 ucc_coll_score_t                 *score,
+                                 const ucc_coll_score_team_info_t *info,
+                                 ucc_base_coll_init_fn_t init,
+                                 ucc_base_team_t *team, ucc_score_t def_score,
+                                 ucc_alg_id_to_init_fn_t alg_fn);
+
+/* Returns 1 if the algorithm of coll_type given by alg_id (or alg_id_str
+   if not NULL) needs the node layout of the team */
+typedef int (*ucc_alg_topo_required_fn_t)(int             alg_id,
+                                          const char     *alg_id_str,
+                                          ucc_coll_type_t coll_type);
+
+/* Returns 1 if the rules depend on the node layout of the team: a rule has
+   nnodes or ppn qualifiers or selects an algorithm for which topo_fn
+   returns 1. Rules without coll types are checked for every coll type. */
+int ucc_coll_score_rules_topo_required(const ucc_coll_score_rules_t *rules,
+                                       ucc_alg_topo_required_fn_t    topo_fn);
+
+/* Initializes lib->score_rules from UCC_TUNE_FILE and lib SCORE string */
+ucc_status_t ucc_coll_score_lib_rules_init(ucc_base_lib_t *lib,
+                                           const char     *score_str);
+
 /* Initializes the default score datastruct with a set of coll_types specified
    as a bitmap, mem_types passed as array, default score value and default init fn.
    The collective will have msg range 0-inf. */
@@ -133,12 +209,28 @@ ucc_status_t ucc_coll_score_build_default(ucc_base_team_t        *team,
                                           ucc_memory_type_t      *mem_types,
                                           int mt_n, ucc_coll_score_t **score_p);
 
-/* Builds optimized representation of a score for the faster lookup */
+/* Builds optimized representation of a score for the faster lookup:
+   msg ranges of each coll_type/mem_type are compiled into a sorted array
+   searched with binary search, fallbacks are resolved into a flat array.
+   The map takes ownership of the score, which must not be modified
+   afterwards. */
 ucc_status_t ucc_coll_score_build_map(ucc_coll_score_t *score,
                                       ucc_score_map_t **map);
 
 void         ucc_coll_score_free_map(ucc_score_map_t *map);
 
+/* Returns the list of ucc_coll_cand_t of the score the map is built from */
+ucc_list_link_t *ucc_coll_score_map_cands(ucc_score_map_t  *map,
+                                          ucc_coll_type_t   coll_type,
+                                          ucc_memory_type_t mem_type);
+
+/* Initializes task using the given score entry: the radix of the entry is
+   passed to the component with UCC_BASE_CARGS_RADIX */
+ucc_status_t ucc_coll_entry_init(ucc_base_coll_args_t *bargs,
+                                 ucc_base_coll_init_fn_t init,
+                                 ucc_base_team_t *team, unsigned radix,
+                                 ucc_coll_task_t **task);
+
 /* Initializes task based on args selection and score map.
    Checks fallbacks if necessary. */
 ucc_status_t ucc_coll_init(ucc_score_map_t      *map,
@@ -5,42 +5,174 @@
  */
 #include "ucc_coll_score.h"
 #include "utils/ucc_coll_utils.h"
+#include "utils/ucc_math.h"
 #include "schedule/ucc_schedule.h"
 
+/* Compiled representation of the score: for each coll_type/mem_type pair
+   the msg ranges are stored as flat array sorted by "start" with no
+   overlaps, so that lookup is a binary search. Init fn and team of the
+   range together with its fallbacks are stored as contiguous array of
+   entries, first entry is the primary selection. */
+typedef struct ucc_score_map_entry {
+    ucc_base_coll_init_fn_t init;
+    ucc_base_team_t        *team;
+    unsigned                radix;
+} ucc_score_map_entry_t;
+
+typedef struct ucc_score_map_range {
+    size_t                 start;
+    size_t                 end;
+    ucc_score_map_entry_t *entries;
+    int                    n_entries;
+} ucc_score_map_range_t;
+
+typedef struct ucc_score_map_list {
+    ucc_score_map_range_t *ranges;
+    int                    n_ranges;
+} ucc_score_map_list_t;
+
 typedef struct ucc_score_map {
-    ucc_coll_score_t *score;
+    ucc_coll_score_t      *score;
+    ucc_score_map_range_t *ranges;
+    ucc_score_map_entry_t *entries;
+    ucc_score_map_list_t   lists[UCC_COLL_TYPE_NUM][UCC_MEMORY_TYPE_LAST];
 } ucc_score_map_t;
 
 ucc_status_t ucc_coll_score_build_map(ucc_coll_score_t *score,
                                       ucc_score_map_t **map_p)
 {
-    ucc_score_map_t *map;
-    map = ucc_malloc(sizeof(*map), "ucc_score_map");
+    size_t                 n_ranges  = 0;
+    size_t                 n_entries = 0;
+    ucc_score_map_t       *map;
+    ucc_score_map_list_t  *ml;
+    ucc_score_map_range_t *mr;
+    ucc_score_map_entry_t *me;
+    ucc_msg_range_t       *r;
+    ucc_coll_entry_t      *fb;
+    size_t                 start, max_end;
+    int                    i, j;
+
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
+            ucc_list_for_each(r, &score->scores[i][j], super.list_elem) {
+                n_ranges++;
+                n_entries += 1 + ucc_list_length(&r->fallback);
+            }
+        }
+    }
+
+    map = ucc_calloc(1, sizeof(*map), "ucc_score_map");
     if (!map) {
         ucc_error("failed to allocate %zd bytes for score map", sizeof(*map));
         return UCC_ERR_NO_MEMORY;
     }
+    if (n_ranges) {
+        map->ranges = ucc_malloc(n_ranges * sizeof(*map->ranges),
+                                 "score_map_ranges");
+        if (!map->ranges) {
+            ucc_error("failed to allocate %zd bytes for score map ranges",
+                      n_ranges * sizeof(*map->ranges));
+            goto err;
+        }
+        map->entries = ucc_malloc(n_entries * sizeof(*map->entries),
+                                  "score_map_entries");
+        if (!map->entries) {
+            ucc_error("failed to allocate %zd bytes for score map entries",
+                      n_entries * sizeof(*map->entries));
+            goto err;
+        }
+    }
+
+    mr = map->ranges;
+    me = map->entries;
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
+            ml           = &map->lists[i][j];
+            ml->ranges   = mr;
+            ml->n_ranges = 0;
+            max_end      = 0;
+            /* score list is sorted by range start and ranges do not
+               overlap (guaranteed by add_range). Clip the start anyway
+               so that the array is always disjoint and the binary search
+               result is identical to the list walk. */
+            ucc_list_for_each(r, &score->scores[i][j], super.list_elem) {
+                start = ucc_max(r->start, max_end);
+                if (start >= r->end) {
+                    continue;
+                }
+                max_end       = ucc_max(max_end, r->end);
+                mr->start     = start;
+                mr->end       = r->end;
+                mr->entries   = me;
+                mr->n_entries = 1;
+                me->init      = r->super.init;
+                me->team      = r->super.team;
+                me->radix     = r->super.radix;
+                me++;
+                ucc_list_for_each(fb, &r->fallback, list_elem) {
+                    me->init  = fb->init;
+                    me->team  = fb->team;
+                    me->radix = fb->radix;
+                    me++;
+                    mr->n_entries++;
+                }
+                mr++;
+                ml->n_ranges++;
+            }
+        }
+    }
     map->score = score;
     *map_p     = map;
     return UCC_OK;
+err:
+    ucc_free(map->ranges);
+    ucc_free(map);
+    return UCC_ERR_NO_MEMORY;
 }
 
 void ucc_coll_score_free_map(ucc_score_map_t *map)
 {
     ucc_coll_score_free(map->score);
+    ucc_free(map->entries);
+    ucc_free(map->ranges);
     ucc_free(map);
 }
 
-static
-ucc_status_t ucc_coll_score_map_lookup(ucc_score_map_t      *map,
-                                       ucc_base_coll_args_t *bargs,
-                                       ucc_msg_range_t     **range)
+ucc_list_link_t *ucc_coll_score_map_cands(ucc_score_map_t  *map,
+                                          ucc_coll_type_t   coll_type,
+                                          ucc_memory_type_t mem_type)
+{
+    return &map->score->cands[ucc_ilog2(coll_type)][mem_type];
+}
+
+ucc_status_t ucc_coll_entry_init(ucc_base_coll_args_t *bargs,
+                                 ucc_base_coll_init_fn_t init,
+                                 ucc_base_team_t *team, unsigned radix,
+                                 ucc_coll_task_t **task)
+{
+    ucc_status_t status;
+
+    if (!radix) {
+        return init(bargs, team, task);
+    }
+    bargs->mask  |= UCC_BASE_CARGS_RADIX;
+    bargs->radix  = radix;
+    status        = init(bargs, team, task);
+    bargs->mask  &= ~UCC_BASE_CARGS_RADIX;
+    return status;
+}
+
+static inline
+ucc_status_t ucc_coll_score_map_lookup(ucc_score_map_t        *map,
+                                       ucc_base_coll_args_t   *bargs,
+                                       ucc_score_map_range_t **range)
 {
-    ucc_memory_type_t mt      = ucc_coll_args_mem_type(bargs);
-    unsigned          ct      = ucc_ilog2(bargs->args.coll_type);
-    size_t            msgsize = ucc_coll_args_msgsize(bargs);
-    ucc_list_link_t  *list;
-    ucc_msg_range_t  *r;
+    ucc_memory_type_t      mt      = ucc_coll_args_mem_type(bargs);
+    unsigned               ct      = ucc_ilog2(bargs->args.coll_type);
+    size_t                 msgsize = ucc_coll_args_msgsize(bargs);
+    ucc_score_map_list_t  *list;
+    ucc_score_map_range_t *r;
+    int                    lo, hi, mid;
 
     if (mt == UCC_MEMORY_TYPE_ASSYMETRIC) {
         /* TODO */
@@ -56,46 +188,53 @@ ucc_status_t ucc_coll_score_map_lookup(ucc_score_map_t      *map,
            range [0:inf]) */
         msgsize = 0;
     }
-    list = &map->score->scores[ct][mt];
-    ucc_list_for_each(r, list, super.list_elem) {
-        if (msgsize >= r->start && msgsize < r->end) {
-            *range = r;
-            return UCC_OK;
+    list = &map->lists[ct][mt];
+    lo   = 0;
+    hi   = list->n_ranges - 1;
+    /* find the last range with start <= msgsize */
+    while (lo <= hi) {
+        mid = lo + (hi - lo) / 2;
+        if (list->ranges[mid].start <= msgsize) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
         }
     }
-    return UCC_ERR_NOT_SUPPORTED;
+    if (hi < 0) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    r = &list->ranges[hi];
+    if (msgsize >= r->end) {
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    *range = r;
+    return UCC_OK;
 }
 
 ucc_status_t ucc_coll_init(ucc_score_map_t      *map,
                            ucc_base_coll_args_t *bargs,
                            ucc_coll_task_t     **task)
 {
-    ucc_msg_range_t  *r;
-    ucc_coll_entry_t *fb;
-    ucc_base_team_t  *team;
-    ucc_status_t      status;
+    ucc_score_map_range_t *r;
+    ucc_score_map_entry_t *e;
+    ucc_status_t           status;
+    int                    i;
 
     status = ucc_coll_score_map_lookup(map, bargs, &r);
     if (UCC_OK != status) {
         return status;
     }
 
-    team   = r->super.team;
-    status = r->super.init(bargs, team, task);
-    if (UCC_OK == status) {
-        return UCC_OK;
-    }
-
-    fb = ucc_list_head(&r->fallback, ucc_coll_entry_t, list_elem);
-    while (&fb->list_elem != &r->fallback &&
-           (status == UCC_ERR_NOT_SUPPORTED ||
-            status == UCC_ERR_NOT_IMPLEMENTED)) {
+    e      = &r->entries[0];
+    status = ucc_coll_entry_init(bargs, e->init, e->team, e->radix, task);
+    for (i = 1; i < r->n_entries &&
+                (status == UCC_ERR_NOT_SUPPORTED ||
+                 status == UCC_ERR_NOT_IMPLEMENTED); i++) {
         ucc_debug("coll is not supported for %s, fallback %s",
-                  team->context->lib->log_component.name,
-                  fb->team->context->lib->log_component.name);
-        team   = fb->team;
-        status = fb->init(bargs, team, task);
-        fb     = ucc_list_next(&fb->list_elem, ucc_coll_entry_t, list_elem);
+                  e->team->context->lib->log_component.name,
+                  r->entries[i].team->context->lib->log_component.name);
+        e      = &r->entries[i];
+        status = ucc_coll_entry_init(bargs, e->init, e->team, e->radix, task);
     }
 
     return status;
@@ -0,0 +1,378 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "ucc_coll_score_tune.h"
+#include "utils/ucc_coll_utils.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_malloc.h"
+#include "components/mc/base/ucc_mc_base.h"
+#include <float.h>
+#include <ctype.h>
+
+static inline int ucc_coll_tune_bucket_id(size_t msgsize)
+{
+    return msgsize ? (int)ucc_ilog2(msgsize) + 1 : 0;
+}
+
+static inline size_t ucc_coll_tune_bucket_start(int id)
+{
+    return id ? ((size_t)1 << (id - 1)) : 0;
+}
+
+static inline size_t ucc_coll_tune_bucket_end(int id)
+{
+    return (id == UCC_COLL_TUNE_N_BUCKETS - 1) ? UCC_MSG_MAX
+                                               : ((size_t)1 << id);
+}
+
+static ucc_coll_tune_bucket_t *
+ucc_coll_tuner_lookup(ucc_coll_tuner_t *tuner, ucc_base_coll_args_t *bargs,
+                      ucc_coll_tune_list_t **list)
+{
+    ucc_memory_type_t     mt      = ucc_coll_args_mem_type(bargs);
+    size_t                msgsize = ucc_coll_args_msgsize(bargs);
+    ucc_coll_tune_list_t *l;
+
+    /* same rules as score map lookup */
+    if (mt == UCC_MEMORY_TYPE_ASSYMETRIC) {
+        return NULL;
+    } else if (mt == UCC_MEMORY_TYPE_NOT_APPLY) {
+        mt = UCC_MEMORY_TYPE_HOST;
+    }
+    if (msgsize == UCC_MSG_SIZE_INVALID || msgsize == UCC_MSG_SIZE_ASSYMETRIC) {
+        msgsize = 0;
+    }
+    l = &tuner->lists[ucc_ilog2(bargs->args.coll_type)][mt];
+    if (!l->buckets) {
+        return NULL;
+    }
+    *list = l;
+    return &l->buckets[ucc_coll_tune_bucket_id(msgsize)];
+}
+
+void ucc_coll_tuner_destroy(ucc_coll_tuner_t *tuner)
+{
+    ucc_coll_tune_list_t *l;
+    int                   i, j;
+
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
+            l = &tuner->lists[i][j];
+            if (l->buckets) {
+                ucc_free(l->buckets[0].stats);
+            }
+            ucc_free(l->buckets);
+            ucc_free(l->cands);
+        }
+    }
+    ucc_free(tuner);
+}
+
+ucc_status_t ucc_coll_tuner_create(ucc_score_map_t *map, uint32_t n_iters,
+                                   ucc_coll_tune_agree_fn_t agree,
+                                   void *agree_arg, ucc_coll_tuner_t **tuner_p)
+{
+    int                   n_tuned = 0;
+    ucc_coll_tuner_t     *tuner;
+    ucc_coll_tune_list_t *l;
+    ucc_coll_tune_stat_t *stats;
+    ucc_list_link_t      *cands;
+    ucc_coll_cand_t      *c;
+    int                   i, j, b, n;
+
+    tuner = ucc_calloc(1, sizeof(*tuner), "coll_tuner");
+    if (!tuner) {
+        ucc_error("failed to allocate %zd bytes for coll tuner",
+                  sizeof(*tuner));
+        return UCC_ERR_NO_MEMORY;
+    }
+    tuner->map       = map;
+    tuner->n_iters   = ucc_max(n_iters, 1);
+    tuner->agree     = agree;
+    tuner->agree_arg = agree_arg;
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
+            cands = ucc_coll_score_map_cands(map, (ucc_coll_type_t)UCC_BIT(i),
+                                             (ucc_memory_type_t)j);
+            n     = ucc_list_length(cands);
+            if (n < 2) {
+                /* nothing to select from */
+                continue;
+            }
+            l          = &tuner->lists[i][j];
+            l->cands   = ucc_malloc(n * sizeof(*l->cands), "tune_cands");
+            l->buckets = ucc_calloc(UCC_COLL_TUNE_N_BUCKETS,
+                                    sizeof(*l->buckets), "tune_buckets");
+            stats      = ucc_calloc(UCC_COLL_TUNE_N_BUCKETS * n,
+                                    sizeof(*stats), "tune_stats");
+            if (!l->cands || !l->buckets || !stats) {
+                ucc_error("failed to allocate coll tuner tables");
+                ucc_free(stats);
+                ucc_coll_tuner_destroy(tuner);
+                return UCC_ERR_NO_MEMORY;
+            }
+            l->n_cands = 0;
+            ucc_list_for_each(c, cands, super.list_elem) {
+                l->cands[l->n_cands++] = c;
+            }
+            for (b = 0; b < UCC_COLL_TUNE_N_BUCKETS; b++) {
+                l->buckets[b].best  = -1;
+                l->buckets[b].stats = stats + b * n;
+            }
+            n_tuned++;
+        }
+    }
+    if (!n_tuned) {
+        ucc_coll_tuner_destroy(tuner);
+        return UCC_ERR_NOT_FOUND;
+    }
+    *tuner_p = tuner;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_coll_tuner_freeze(ucc_coll_tuner_t       *tuner,
+                                          ucc_coll_tune_list_t   *list,
+                                          ucc_coll_tune_bucket_t *bucket,
+                                          ucc_base_coll_args_t   *bargs)
+{
+    int              id = (int)(bucket - list->buckets);
+    double          *lat;
+    ucc_coll_cand_t *c;
+    ucc_status_t     status;
+    int              i, best;
+
+    lat = ucc_malloc(list->n_cands * sizeof(*lat), "tune_lat");
+    if (!lat) {
+        ucc_error("failed to allocate %zd bytes for tuner latencies",
+                  list->n_cands * sizeof(*lat));
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (i = 0; i < list->n_cands; i++) {
+        lat[i] = bucket->stats[i].n_samples
+                     ? bucket->stats[i].time / bucket->stats[i].n_samples
+                     : DBL_MAX;
+    }
+    status = tuner->agree(tuner->agree_arg, lat, list->n_cands);
+    if (UCC_OK != status) {
+        ucc_error("coll tuner failed to agree on %s selection: %s",
+                  ucc_coll_type_str(bargs->args.coll_type),
+                  ucc_status_string(status));
+        goto out;
+    }
+    best = 0;
+    for (i = 0; i < list->n_cands; i++) {
+        c = list->cands[i];
+        ucc_debug("coll tuner: %s msgsize [%zd, %zd), %s alg %d radix %u: "
+                  "%g us", ucc_coll_type_str(bargs->args.coll_type),
+                  ucc_coll_tune_bucket_start(id), ucc_coll_tune_bucket_end(id),
+                  c->super.team->context->lib->log_component.name, c->alg_id,
+                  c->super.radix, lat[i] * 1e6);
+        if (lat[i] < lat[best]) {
+            best = i;
+        }
+    }
+    bucket->best = best;
+    c            = list->cands[best];
+    ucc_info("coll tuner: %s msgsize [%zd, %zd) selected %s alg %d radix %u",
+             ucc_coll_type_str(bargs->args.coll_type),
+             ucc_coll_tune_bucket_start(id), ucc_coll_tune_bucket_end(id),
+             c->super.team->context->lib->log_component.name, c->alg_id,
+             c->super.radix);
+out:
+    ucc_free(lat);
+    return status;
+}
+
+ucc_status_t ucc_coll_tuner_coll_init(ucc_coll_tuner_t *tuner,
+                                      ucc_base_coll_args_t *bargs,
+                                      ucc_coll_task_t **task, int *cand)
+{
+    ucc_coll_tune_list_t   *list;
+    ucc_coll_tune_bucket_t *bucket;
+    ucc_coll_cand_t        *c;
+    ucc_status_t            status;
+
+    *cand  = -1;
+    bucket = ucc_coll_tuner_lookup(tuner, bargs, &list);
+    if (!bucket) {
+        return ucc_coll_init(tuner->map, bargs, task);
+    }
+    if (bucket->best < 0 &&
+        bucket->n_inits == list->n_cands * tuner->n_iters) {
+        status = ucc_coll_tuner_freeze(tuner, list, bucket, bargs);
+        if (UCC_OK != status) {
+            return status;
+        }
+    }
+    if (bucket->best >= 0) {
+        c = list->cands[bucket->best];
+    } else {
+        *cand = bucket->n_inits++ / tuner->n_iters;
+        c     = list->cands[*cand];
+    }
+    status = ucc_coll_entry_init(bargs, c->super.init, c->super.team,
+                                 c->super.radix, task);
+    if (status == UCC_ERR_NOT_SUPPORTED || status == UCC_ERR_NOT_IMPLEMENTED) {
+        /* candidate does not support the args (e.g. datatype): not sampled,
+           default selection is used */
+        *cand  = -1;
+        status = ucc_coll_init(tuner->map, bargs, task);
+    }
+    return status;
+}
+
+void ucc_coll_tuner_sample(ucc_coll_tuner_t *tuner,
+                           ucc_base_coll_args_t *bargs, int cand,
+                           double time)
+{
+    ucc_coll_tune_list_t   *list;
+    ucc_coll_tune_bucket_t *bucket;
+
+    bucket = ucc_coll_tuner_lookup(tuner, bargs, &list);
+    if (!bucket || bucket->best >= 0) {
+        /* completed after the selection is frozen */
+        return;
+    }
+    ucc_assert(cand >= 0 && cand < list->n_cands);
+    bucket->stats[cand].time += time;
+    bucket->stats[cand].n_samples++;
+}
+
+/* lower case name with '_' separators as accepted by the TUNE parser */
+static void ucc_coll_tune_name(const char *in, char *out, size_t len)
+{
+    size_t i;
+
+    for (i = 0; in[i] && i < len - 1; i++) {
+        out[i] = (in[i] == ' ' || in[i] == '-') ? '_' : tolower(in[i]);
+    }
+    out[i] = '\0';
+}
+
+#define TUNE_STR_ADD(_fmt, ...)                                                \
+    do {                                                                       \
+        int _n = snprintf(buf + ucc_min(off, len), len - ucc_min(off, len),    \
+                          _fmt, ##__VA_ARGS__);                                \
+        off += (_n > 0) ? _n : 0;                                              \
+    } while (0)
+
+static size_t ucc_coll_tuner_team_str(ucc_coll_tuner_t *tuner,
+                                      ucc_base_team_t *team, char *buf,
+                                      size_t len)
+{
+    size_t                  off      = 0;
+    int                     n_tokens = 0;
+    ucc_coll_tune_list_t   *l;
+    ucc_coll_cand_t        *c;
+    char                    ct_str[32], mt_str[32];
+    int                     i, j, b, e;
+
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
+            l = &tuner->lists[i][j];
+            if (!l->buckets) {
+                continue;
+            }
+            ucc_coll_tune_name(ucc_coll_type_str((ucc_coll_type_t)UCC_BIT(i)),
+                               ct_str, sizeof(ct_str));
+            ucc_coll_tune_name(ucc_memory_type_names[j], mt_str,
+                               sizeof(mt_str));
+            for (b = 0; b < UCC_COLL_TUNE_N_BUCKETS; b = e) {
+                e = b + 1;
+                if (l->buckets[b].best < 0) {
+                    continue;
+                }
+                c = l->cands[l->buckets[b].best];
+                if (c->super.team != team) {
+                    continue;
+                }
+                /* consecutive buckets with the same selection */
+                while (e < UCC_COLL_TUNE_N_BUCKETS &&
+                       l->buckets[e].best == l->buckets[b].best) {
+                    e++;
+                }
+                TUNE_STR_ADD("%s%s:%s:%zd-", n_tokens++ ? "#" : "", ct_str,
+                             mt_str, ucc_coll_tune_bucket_start(b));
+                if (e == UCC_COLL_TUNE_N_BUCKETS) {
+                    TUNE_STR_ADD("inf");
+                } else {
+                    TUNE_STR_ADD("%zd", ucc_coll_tune_bucket_end(e - 1));
+                }
+                TUNE_STR_ADD(":[%u]:@%d", (unsigned)team->params.size,
+                             c->alg_id);
+                if (c->super.radix) {
+                    TUNE_STR_ADD(":radix=%u", c->super.radix);
+                }
+            }
+        }
+    }
+    return n_tokens ? off : 0;
+}
+
+int ucc_coll_tuner_str(ucc_coll_tuner_t *tuner, char *buf, size_t len)
+{
+    size_t                off     = 0;
+    int                   n_teams = 0;
+    ucc_base_team_t     **teams   = NULL;
+    ucc_base_team_t     **tmp;
+    ucc_coll_tune_list_t *l;
+    ucc_base_team_t      *team;
+    char                  name[64];
+    size_t                start, n;
+    int                   i, j, k, t;
+
+    if (len) {
+        buf[0] = '\0';
+    }
+    /* one line per component team */
+    for (i = 0; i < UCC_COLL_TYPE_NUM; i++) {
+        for (j = 0; j < UCC_MEMORY_TYPE_LAST; j++) {
+            l = &tuner->lists[i][j];
+            if (!l->n_cands) {
+                continue;
+            }
+            tmp = ucc_realloc(teams, (n_teams + l->n_cands) * sizeof(*teams),
+                              "tune_teams");
+            if (!tmp) {
+                ucc_error("failed to allocate coll tuner teams");
+                ucc_free(teams);
+                return 0;
+            }
+            teams = tmp;
+            for (k = 0; k < l->n_cands; k++) {
+                team = l->cands[k]->super.team;
+                for (t = 0; t < n_teams && teams[t] != team; t++) {
+                    ;
+                }
+                if (t == n_teams) {
+                    teams[n_teams++] = team;
+                }
+            }
+        }
+    }
+    for (t = 0; t < n_teams; t++) {
+        ucc_coll_tune_name(teams[t]->context->lib->log_component.name, name,
+                           sizeof(name));
+        for (k = 0; name[k]; k++) {
+            name[k] = toupper(name[k]);
+        }
+        start = off;
+        TUNE_STR_ADD("UCC_%s_TUNE=", name);
+        n = ucc_coll_tuner_team_str(tuner, teams[t], buf + ucc_min(off, len),
+                                    len - ucc_min(off, len));
+        if (!n) {
+            /* nothing is frozen for the team yet */
+            off = start;
+            if (off < len) {
+                buf[off] = '\0';
+            }
+            continue;
+        }
+        off += n;
+        TUNE_STR_ADD("\n");
+    }
+    ucc_free(teams);
+    return (int)off;
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_COLL_SCORE_TUNE_H_
+#define UCC_COLL_SCORE_TUNE_H_
+#include "ucc_coll_score.h"
+
+/* Online tuner of the algorithm selection.
+   Components register algorithm candidates (alg id x radix) in their score
+   with ucc_coll_score_add_cand. For every coll_type/mem_type with at least
+   2 candidates the messages are split into power of 2 size buckets. The
+   first n_iters * n_cands collectives of a bucket are the warm-up window:
+   they rotate through the candidates, n_iters collectives each, and their
+   latency (post to completion) is sampled. The first collective of the
+   bucket initialized after the window runs the agreement callback: it
+   replaces the local average latency of each candidate with the max over
+   the team, so that all the ranks select the same candidate. Candidates
+   without completed samples get DBL_MAX. The candidate with min latency is
+   frozen and used for all the following collectives of the bucket.
+   All the decisions only depend on the order of collective init calls.
+   The learned selection can be exported as UCC_<COMPONENT>_TUNE string. */
+
+#define UCC_COLL_TUNE_N_BUCKETS 65 /*< msgsize 0 and [2^(i-1), 2^i) */
+
+typedef struct ucc_coll_tune_config {
+    int      enable;
+    uint32_t n_iters; /*< samples per candidate */
+    char    *file;    /*< learned selection is appended to the file */
+} ucc_coll_tune_config_t;
+
+/* Replaces lat[i] of n candidates with the value agreed by the team */
+typedef ucc_status_t (*ucc_coll_tune_agree_fn_t)(void *arg, double *lat,
+                                                 int n);
+
+typedef struct ucc_coll_tune_stat {
+    double   time;
+    uint32_t n_samples;
+} ucc_coll_tune_stat_t;
+
+typedef struct ucc_coll_tune_bucket {
+    uint32_t              n_inits;
+    int                   best;  /*< frozen candidate, -1 while tuning */
+    ucc_coll_tune_stat_t *stats; /*< per candidate */
+} ucc_coll_tune_bucket_t;
+
+typedef struct ucc_coll_tune_list {
+    ucc_coll_cand_t       **cands;
+    int                     n_cands;
+    ucc_coll_tune_bucket_t *buckets; /*< NULL if not tuned */
+} ucc_coll_tune_list_t;
+
+typedef struct ucc_coll_tuner {
+    ucc_score_map_t         *map;
+    uint32_t                 n_iters;
+    ucc_coll_tune_agree_fn_t agree;
+    void                    *agree_arg;
+    ucc_coll_tune_list_t     lists[UCC_COLL_TYPE_NUM][UCC_MEMORY_TYPE_LAST];
+} ucc_coll_tuner_t;
+
+/* Creates the tuner for the candidates stored in the score map. Returns
+   UCC_ERR_NOT_FOUND if there is nothing to tune. */
+ucc_status_t ucc_coll_tuner_create(ucc_score_map_t *map, uint32_t n_iters,
+                                   ucc_coll_tune_agree_fn_t agree,
+                                   void *agree_arg, ucc_coll_tuner_t **tuner);
+
+void ucc_coll_tuner_destroy(ucc_coll_tuner_t *tuner);
+
+/* Initializes the collective with the candidate selected by the tuner or
+   with the score map if the collective is not tuned. "cand" is set to the
+   index of the candidate to be sampled or -1. */
+ucc_status_t ucc_coll_tuner_coll_init(ucc_coll_tuner_t *tuner,
+                                      ucc_base_coll_args_t *bargs,
+                                      ucc_coll_task_t **task, int *cand);
+
+/* Adds latency sample of the collective initialized with candidate "cand" */
+void ucc_coll_tuner_sample(ucc_coll_tuner_t *tuner,
+                           ucc_base_coll_args_t *bargs, int cand,
+                           double time);
+
+/* Prints the frozen selections as UCC_<COMPONENT>_TUNE=<str> lines, one
+   line per component. Returns the length of the output, the output is
+   truncated if it exceeds len. */
+int ucc_coll_tuner_str(ucc_coll_tuner_t *tuner, char *buf, size_t len);
+
+#endif
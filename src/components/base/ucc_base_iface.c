@@ -12,9 +12,9 @@ ucc_config_field_t ucc_base_config_table[] = {
 
     {"TUNE", "", "Collective tuning modifier for a CL/TL component\n"
      "format: token1#token2#...#tokenn - '#' separated list of tokens where\n"
-     "    token=coll_type:msg_range:mem_type:team_size:score:alg - ':' separated\n"
-     "    list of qualifiers. Each qualifier is optional. The only requirement\n"
-     "    is that either \"score\" or \"alg\" is provided.\n"
+     "    token=coll_type:msg_range:mem_type:team_size:nnodes:ppn:score:alg -\n"
+     "    ':' separated list of qualifiers. Each qualifier is optional. The\n"
+     "    only requirement is that either \"score\" or \"alg\" is provided.\n"
      "qualifiers:\n"
      "    coll_type=coll_type_1,coll_type_2,...,coll_type_n - ',' separated\n"
      "              list of coll_types\n"
@@ -25,11 +25,19 @@ ucc_config_field_t ucc_base_config_table[] = {
      "    mem_type=m1,m2,..,mn - ',' separated list of memory types\n"
      "    team_size=[t_start_1-t_end_1,t_start_2-t_end_2,...,t_start_n-t_end_n] -\n"
      "              ',' separated list of team size ranges enclosed with [].\n"
+     "    nnodes=[n_start_1-n_end_1,...] - ',' separated list of ranges of the\n"
+     "           number of nodes spanned by the team, enclosed with [].\n"
+     "    ppn=[p_start_1-p_end_1,...] - ',' separated list of ranges of the max\n"
+     "        number of team processes per node, enclosed with [].\n"
+     "        The token with nnodes or ppn qualifier is skipped if the team\n"
+     "        topology is not known.\n"
      "    score=value - int value from 0 to \"inf\"\n"
      "          0 - disables the CL/TL in the given range for a given coll\n"
      "          inf - forces the CL/TL in the given range for a given coll\n"
      "    alg=@<value|str> - character @ followed by either int number or string\n"
-     "        representing the collective algorithm.",
+     "        representing the collective algorithm.\n"
+     "    radix=radix=<value> - radix of the algorithm, only used by radix\n"
+     "          based algorithms, component default radix is used otherwise.",
      ucc_offsetof(ucc_base_config_t, score_str), UCC_CONFIG_TYPE_STRING},
 
     {NULL}};
@@ -20,6 +20,7 @@
 typedef struct ucc_team ucc_team_t;
 typedef struct ucc_context ucc_context_t;
 typedef struct ucc_coll_score ucc_coll_score_t;
+typedef struct ucc_coll_score_rules ucc_coll_score_rules_t;
 typedef struct ucc_coll_task ucc_coll_task_t;
 
 
@@ -27,6 +28,9 @@ typedef struct ucc_coll_task ucc_coll_task_t;
 typedef struct ucc_base_lib {
     ucc_log_component_config_t log_component;
     char                      *score_str;
+    /* score_str and tuning file settings parsed at lib init,
+       NULL if there are none */
+    ucc_coll_score_rules_t    *score_rules;
 } ucc_base_lib_t;
 
 typedef struct ucc_base_config {
@@ -120,10 +124,17 @@ typedef struct ucc_base_team_iface {
     ucc_status_t (*get_scores)(ucc_base_team_t *team, ucc_coll_score_t **score);
 } ucc_base_team_iface_t;
 
+enum {
+    /* radix of the algorithm is selected by the score map entry (tuning
+       string or online tuner) instead of the component config */
+    UCC_BASE_CARGS_RADIX = UCC_BIT(0)
+};
+
 typedef struct ucc_base_coll_args {
     uint64_t        mask;
     ucc_coll_args_t args;
     ucc_team_t     *team;
+    uint32_t        radix;
 } ucc_base_coll_args_t;
 
 typedef ucc_status_t (*ucc_base_coll_init_fn_t)(ucc_base_coll_args_t *coll_args,
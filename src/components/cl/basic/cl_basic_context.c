@@ -6,6 +6,7 @@
 
 #include "cl_basic.h"
 #include "utils/ucc_malloc.h"
+#include "coll_score/ucc_coll_score.h"
 
 UCC_CLASS_INIT_FUNC(ucc_cl_basic_context_t,
                     const ucc_base_context_params_t *params,
@@ -77,10 +78,11 @@ ucc_cl_basic_get_context_attr(const ucc_base_context_t *context,
         attr->attr.ctx_addr_len = 0;
     }
 
-    /* CL BASIC reports topo_required if any of the TL available
-       TL contexts needs it */
-    attr->topo_required = 0;
-    for (i = 0; i < ctx->n_tl_ctxs; i++) {
+    /* CL BASIC reports topo_required if its own tuning has nnodes/ppn
+       qualifiers or any of the TL available TL contexts needs it */
+    attr->topo_required = ucc_coll_score_rules_topo_required(
+        ctx->super.super.lib->score_rules, NULL);
+    for (i = 0; i < ctx->n_tl_ctxs && !attr->topo_required; i++) {
         memset(&tl_attr, 0, sizeof(tl_attr));
         status = UCC_TL_CTX_IFACE(ctx->tl_ctxs[i])
                      ->context.get_attr(&ctx->tl_ctxs[i]->super, &tl_attr);
@@ -166,15 +166,17 @@ ucc_status_t ucc_cl_basic_team_get_scores(ucc_base_team_t   *cl_team,
 {
     ucc_cl_basic_team_t *team = ucc_derived_of(cl_team, ucc_cl_basic_team_t);
     ucc_base_lib_t      *lib  = UCC_CL_TEAM_LIB(team);
+    ucc_coll_score_team_info_t info;
     ucc_status_t         status;
 
     status = ucc_coll_score_dup(team->score, score);
     if (UCC_OK != status) {
         return status;
     }
-    if (strlen(lib->score_str) > 0) {
-        status = ucc_coll_score_update_from_str(
-            lib->score_str, *score, UCC_CL_TEAM_SIZE(team), NULL, cl_team,
+    if (lib->score_rules) {
+        ucc_coll_score_team_info_init(cl_team, &info);
+        status = ucc_coll_score_update_from_rules(
+            lib->score_rules, *score, &info, NULL, cl_team,
             UCC_CL_BASIC_DEFAULT_SCORE, NULL);
 
         /* If INVALID_PARAM - User provided incorrect input - try to proceed */
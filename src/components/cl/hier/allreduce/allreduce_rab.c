@@ -7,24 +7,26 @@
 #include "allreduce.h"
 #include "../cl_hier_coll.h"
 
-#define MAX_AR_RAB_TASKS 3
+/* Reduce on every level below the top one, allreduce on the top level and
+   bcast on the levels below the top one in reverse order */
+#define MAX_AR_RAB_TASKS (2 * UCC_HIER_SBGP_LAST)
 
 static ucc_status_t ucc_cl_hier_allreduce_rab_start(ucc_coll_task_t *task)
 {
-    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+    ucc_dag_t *schedule = ucc_derived_of(task, ucc_dag_t);
 
     UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_allreduce_rab_start", 0);
-    return ucc_schedule_start(schedule);
+    return ucc_dag_start(schedule);
 }
 
 static ucc_status_t ucc_cl_hier_allreduce_rab_finalize(ucc_coll_task_t *task)
 {
-    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
-    ucc_status_t    status;
+    ucc_dag_t    *schedule = ucc_derived_of(task, ucc_dag_t);
+    ucc_status_t  status;
 
     UCC_CL_HIER_PROFILE_REQUEST_EVENT(task, "cl_hier_allreduce_rab_finalize",
                                       0);
-    status = ucc_schedule_finalize(task);
+    status = ucc_dag_finalize(task);
     ucc_cl_hier_put_schedule(schedule);
     return status;
 }
@@ -36,12 +38,14 @@ UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_allreduce_rab_init,
 {
     ucc_cl_hier_team_t  *cl_team = ucc_derived_of(team, ucc_cl_hier_team_t);
     ucc_coll_task_t     *tasks[MAX_AR_RAB_TASKS] = {NULL};
-    ucc_schedule_t      *schedule;
+    int                  top     = cl_team->n_levels - 1;
+    ucc_dag_t           *schedule;
+    ucc_hier_sbgp_t     *hs;
     ucc_status_t         status;
     ucc_base_coll_args_t args;
-    int                  n_tasks, i;
+    int                  n_tasks, i, l;
 
-    schedule = &ucc_cl_hier_get_schedule(cl_team)->super.super;
+    schedule = &ucc_cl_hier_get_schedule(cl_team)->super;
     if (ucc_unlikely(!schedule)) {
         return UCC_ERR_NO_MEMORY;
     }
@@ -49,65 +53,62 @@ UCC_CL_HIER_PROFILE_FUNC(ucc_status_t, ucc_cl_hier_allreduce_rab_init,
     memcpy(&args, coll_args, sizeof(args));
     args.args.root = 0; /* TODO: we can select the rank closest to HCA */
     n_tasks        = 0;
-    status         = ucc_schedule_init(schedule, &args, team);
+    status         = ucc_dag_init(schedule, &args, team);
     if (ucc_unlikely(UCC_OK != status)) {
         goto out;
     }
 
-    if (SBGP_ENABLED(cl_team, NODE)) {
-        ucc_assert(n_tasks == 0);
-        /* can have only NODE sbgp, both above have been skipped */
-        if (cl_team->top_sbgp == UCC_HIER_SBGP_NODE) {
+    for (l = 0; l <= top; l++) {
+        hs = &cl_team->sbgps[cl_team->levels[l]];
+        if (hs->state != UCC_HIER_SBGP_ENABLED) {
+            /* process is not part of this level */
+            continue;
+        }
+        if (l == top) {
             args.args.coll_type = UCC_COLL_TYPE_ALLREDUCE;
         } else {
             args.args.coll_type = UCC_COLL_TYPE_REDUCE;
             if (UCC_IS_INPLACE(args.args) &&
-                (SBGP_RANK(cl_team, NODE) != args.args.root)) {
+                (hs->sbgp->group_rank != args.args.root)) {
                 args.args.src.info = args.args.dst.info;
             }
         }
-        status =
-            ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]);
+        status = ucc_coll_init(hs->score_map, &args, &tasks[n_tasks]);
         if (ucc_unlikely(UCC_OK != status)) {
             goto out;
         }
         n_tasks++;
-        args.args.mask |= UCC_COLL_ARGS_FIELD_FLAGS;
+        args.args.mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
         args.args.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
     }
 
-    if (SBGP_ENABLED(cl_team, NODE_LEADERS)) {
-        ucc_assert(cl_team->top_sbgp == UCC_HIER_SBGP_NODE_LEADERS);
-        args.args.coll_type = UCC_COLL_TYPE_ALLREDUCE;
-        status = ucc_coll_init(SCORE_MAP(cl_team, NODE_LEADERS), &args,
-                               &tasks[n_tasks]);
-        if (ucc_unlikely(UCC_OK != status)) {
-            goto out;
+    for (l = top - 1; l >= 0; l--) {
+        hs = &cl_team->sbgps[cl_team->levels[l]];
+        if (hs->state != UCC_HIER_SBGP_ENABLED) {
+            continue;
         }
-        n_tasks++;
-    }
-
-
-    if (SBGP_ENABLED(cl_team, NODE) &&
-        cl_team->top_sbgp != UCC_HIER_SBGP_NODE) {
         /* For bcast src should point to origin dst of allreduce */
-        args.args.src.info = args.args.dst.info;
+        args.args.src.info  = args.args.dst.info;
         args.args.coll_type = UCC_COLL_TYPE_BCAST;
-        status =
-            ucc_coll_init(SCORE_MAP(cl_team, NODE), &args, &tasks[n_tasks]);
+        status = ucc_coll_init(hs->score_map, &args, &tasks[n_tasks]);
         if (ucc_unlikely(UCC_OK != status)) {
             goto out;
         }
         n_tasks++;
     }
 
-    ucc_event_manager_subscribe(&schedule->super.em, UCC_EVENT_SCHEDULE_STARTED,
-                                tasks[0], ucc_task_start_handler);
-    ucc_schedule_add_task(schedule, tasks[0]);
-    for (i = 1; i < n_tasks; i++) {
-        ucc_event_manager_subscribe(&tasks[i - 1]->em, UCC_EVENT_COMPLETED,
-                                    tasks[i], ucc_task_start_handler);
-        ucc_schedule_add_task(schedule, tasks[i]);
+    for (i = 0; i < n_tasks; i++) {
+        status = ucc_dag_add_node(schedule, tasks[i], NULL);
+        if (ucc_unlikely(UCC_OK != status)) {
+            goto out;
+        }
+        if (i > 0) {
+            status = ucc_dag_add_edge(schedule, i - 1, i,
+                                      UCC_DAG_DEP_COMPLETED);
+            if (ucc_unlikely(UCC_OK != status)) {
+                goto out;
+            }
+        }
     }
 
     schedule->super.post     = ucc_cl_hier_allreduce_rab_start;
@@ -119,6 +120,7 @@ out:
     for (i = 0; i < n_tasks; i++) {
         tasks[i]->finalize(tasks[i]);
     }
+    ucc_dag_cleanup(schedule);
     ucc_cl_hier_put_schedule(schedule);
     return status;
 }
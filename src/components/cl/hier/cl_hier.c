@@ -38,6 +38,28 @@ static ucc_config_field_t ucc_cl_hier_lib_config_table[] = {
      ucc_offsetof(ucc_cl_hier_lib_config_t, sbgp_tls[UCC_HIER_SBGP_NET]),
      UCC_CONFIG_TYPE_STRING_ARRAY},
 
+    {"SOCKET_SBGP_TLS", "ucp",
+     "TLS to be used for SOCKET subgroup.\n"
+     "SOCKET subgroup contains processes of a team located on the same socket",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, sbgp_tls[UCC_HIER_SBGP_SOCKET]),
+     UCC_CONFIG_TYPE_STRING_ARRAY},
+
+    {"SOCKET_LEADERS_SBGP_TLS", "ucp",
+     "TLS to be used for SOCKET_LEADERS subgroup.\n"
+     "SOCKET_LEADERS subgroup contains processes of a node with local socket "
+     "rank equal 0",
+     ucc_offsetof(ucc_cl_hier_lib_config_t,
+                  sbgp_tls[UCC_HIER_SBGP_SOCKET_LEADERS]),
+     UCC_CONFIG_TYPE_STRING_ARRAY},
+
+    {"SOCKET_LEVEL", "n",
+     "Split the node level of hierarchical algorithms into SOCKET and "
+     "SOCKET_LEADERS levels.\n"
+     "Only applies if processes are bound to sockets, otherwise NODE "
+     "subgroup is used",
+     ucc_offsetof(ucc_cl_hier_lib_config_t, socket_level),
+     UCC_CONFIG_TYPE_BOOL},
+
     {NULL}};
 
 static ucs_config_field_t ucc_cl_hier_context_config_table[] = {
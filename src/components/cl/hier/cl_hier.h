@@ -37,6 +37,8 @@ typedef enum {
     UCC_HIER_SBGP_NODE,
     UCC_HIER_SBGP_NODE_LEADERS,
     UCC_HIER_SBGP_NET,
+    UCC_HIER_SBGP_SOCKET,
+    UCC_HIER_SBGP_SOCKET_LEADERS,
     UCC_HIER_SBGP_LAST,
 } ucc_hier_sbgp_type_t;
 //DO we need it? Potential use case: different hier sbgps over same sbgp
@@ -46,6 +48,7 @@ typedef struct ucc_cl_hier_lib_config {
     /* List of TLs corresponding to the sbgp team,
        which are selected based on the TL scores */
     ucc_config_names_array_t sbgp_tls[UCC_HIER_SBGP_LAST];
+    int                      socket_level;
 } ucc_cl_hier_lib_config_t;
 
 typedef struct ucc_cl_hier_context_config {
@@ -99,6 +102,9 @@ typedef struct ucc_cl_hier_team {
     ucc_coll_score_t        *score;
     ucc_hier_sbgp_t          sbgps[UCC_HIER_SBGP_LAST];
     ucc_hier_sbgp_type_t     top_sbgp;
+    /* hierarchy levels from the lowest one up to top_sbgp */
+    ucc_hier_sbgp_type_t     levels[UCC_HIER_SBGP_LAST];
+    int                      n_levels;
 } ucc_cl_hier_team_t;
 UCC_CLASS_DECLARE(ucc_cl_hier_team_t, ucc_base_context_t *,
                   const ucc_base_team_params_t *);
@@ -7,10 +7,10 @@
 #define UCC_CL_HIER_COLL_H_
 
 #include "cl_hier.h"
-#include "schedule/ucc_schedule_pipelined.h"
+#include "schedule/ucc_dag.h"
 
 typedef struct ucc_cl_hier_schedule_t {
-    ucc_schedule_pipelined_t super;
+    ucc_dag_t super;
 } ucc_cl_hier_schedule_t;
 
 static inline ucc_cl_hier_schedule_t *
@@ -23,7 +23,7 @@ ucc_cl_hier_get_schedule(ucc_cl_hier_team_t *team)
     return schedule;
 }
 
-static inline void ucc_cl_hier_put_schedule(ucc_schedule_t *schedule)
+static inline void ucc_cl_hier_put_schedule(ucc_dag_t *schedule)
 {
     UCC_CL_HIER_PROFILE_REQUEST_FREE(schedule);
     ucc_mpool_put(schedule);
@@ -14,15 +14,35 @@
     _team->sbgps[UCC_HIER_SBGP_##_sbgp].sbgp_type = UCC_SBGP_##_sbgp;          \
     _team->sbgps[UCC_HIER_SBGP_##_sbgp].state     = UCC_HIER_SBGP_##_enable;
 
+/* Hierarchy levels in bottom-up order, only enabled sbgps are used */
+static const ucc_hier_sbgp_type_t ucc_cl_hier_levels[] = {
+    UCC_HIER_SBGP_SOCKET, UCC_HIER_SBGP_SOCKET_LEADERS, UCC_HIER_SBGP_NODE,
+    UCC_HIER_SBGP_NODE_LEADERS};
+#define UCC_CL_HIER_N_LEVELS                                                   \
+    (sizeof(ucc_cl_hier_levels) / sizeof(ucc_cl_hier_levels[0]))
+
 /* The function below must enable/disable those hier sbgps that will be
    used to construct hierarchical schedules.
-   Currently just enable two sbgps as example and for testing purposes.
-   Next step is to enable sbgps based on the requested hierarchical algs. */
-static void ucc_cl_hier_enable_sbgps(ucc_cl_hier_team_t *team)
+   Node level is either a single NODE sbgp or, if socket level is requested
+   and processes are bound to sockets, SOCKET and SOCKET_LEADERS sbgps.
+   The decision only depends on the data that is identical on all the
+   processes of the team. */
+static void ucc_cl_hier_enable_sbgps(ucc_cl_hier_team_t *team,
+                                     ucc_topo_t         *topo)
 {
+    ucc_cl_hier_lib_t *lib = UCC_CL_HIER_TEAM_LIB(team);
+
     SBGP_SET(team, NET, DISABLED);
-    SBGP_SET(team, NODE, ENABLED);
     SBGP_SET(team, NODE_LEADERS, ENABLED);
+    if (lib->cfg.socket_level && topo->topo->sock_bound) {
+        SBGP_SET(team, NODE, DISABLED);
+        SBGP_SET(team, SOCKET, ENABLED);
+        SBGP_SET(team, SOCKET_LEADERS, ENABLED);
+    } else {
+        SBGP_SET(team, NODE, ENABLED);
+        SBGP_SET(team, SOCKET, DISABLED);
+        SBGP_SET(team, SOCKET_LEADERS, DISABLED);
+    }
 }
 
 UCC_CLASS_INIT_FUNC(ucc_cl_hier_team_t, ucc_base_context_t *cl_context,
@@ -51,7 +71,7 @@ UCC_CLASS_INIT_FUNC(ucc_cl_hier_team_t, ucc_base_context_t *cl_context,
 
     UCC_CLASS_CALL_SUPER_INIT(ucc_cl_team_t, &ctx->super, params);
 
-    ucc_cl_hier_enable_sbgps(self);
+    ucc_cl_hier_enable_sbgps(self, params->team->topo);
     n_sbgp_teams = 0;
     for (i = 0; i < UCC_HIER_SBGP_LAST; i++) {
         hs        = &self->sbgps[i];
@@ -283,12 +303,17 @@ ucc_status_t ucc_cl_hier_team_create_test(ucc_base_team_t *cl_team)
     ucc_team_multiple_req_free(team->team_create_req);
     team->team_create_req = NULL;
 
-    if (SBGP_EXISTS(team, NODE_LEADERS)) {
-        team->top_sbgp = UCC_HIER_SBGP_NODE_LEADERS;
-    } else {
-        ucc_assert(SBGP_EXISTS(team, NODE));
-        team->top_sbgp = UCC_HIER_SBGP_NODE;
+    /* levels that don't exist (e.g. single process socket) are skipped,
+       the last existing level is the top one */
+    team->n_levels = 0;
+    for (i = 0; i < (int)UCC_CL_HIER_N_LEVELS; i++) {
+        hs = &team->sbgps[ucc_cl_hier_levels[i]];
+        if (hs->sbgp && hs->sbgp->status != UCC_SBGP_NOT_EXISTS) {
+            team->levels[team->n_levels++] = ucc_cl_hier_levels[i];
+        }
     }
+    ucc_assert(team->n_levels > 0);
+    team->top_sbgp = team->levels[team->n_levels - 1];
 
     return status;
 }
@@ -300,6 +325,7 @@ ucc_status_t ucc_cl_hier_team_get_scores(ucc_base_team_t   *cl_team,
     ucc_base_lib_t     *lib   = UCC_CL_TEAM_LIB(team);
     ucc_memory_type_t   mt[2] = {UCC_MEMORY_TYPE_HOST, UCC_MEMORY_TYPE_CUDA};
     ucc_coll_score_t   *score;
+    ucc_coll_score_team_info_t info;
     ucc_status_t        status;
     int                 i;
 
@@ -319,10 +345,10 @@ ucc_status_t ucc_cl_hier_team_get_scores(ucc_base_team_t   *cl_team,
         }
     }
 
-    if (strlen(lib->score_str) > 0) {
-        status = ucc_coll_score_update_from_str(
-            lib->score_str, score, UCC_CL_TEAM_SIZE(team),
-            ucc_cl_hier_coll_init,
+    if (lib->score_rules) {
+        ucc_coll_score_team_info_init(cl_team, &info);
+        status = ucc_coll_score_update_from_rules(
+            lib->score_rules, score, &info, ucc_cl_hier_coll_init,
             cl_team, UCC_CL_HIER_DEFAULT_SCORE, NULL);
 
         /* If INVALID_PARAM - User provided incorrect input - try to proceed */
@@ -8,6 +8,7 @@
 #include "utils/ucc_log.h"
 #include "utils/ucc_malloc.h"
 #include "core/ucc_global_opts.h"
+#include "coll_score/ucc_coll_score.h"
 
 static char * ucc_cl_tls_doc_str = "List of TLs used by a given CL component.\n"
     "Allowed values: either \"all\" or comma-separated list of: ";
@@ -48,16 +49,25 @@ UCC_CLASS_INIT_FUNC(ucc_cl_lib_t, ucc_cl_iface_t *cl_iface,
                      cl_iface->cl_lib_config.name,
                      sizeof(self->super.log_component.name));
     self->super.score_str = strdup(cl_config->super.score_str);
+    status = ucc_coll_score_lib_rules_init(&self->super,
+                                           self->super.score_str);
+    if (UCC_OK != status) {
+        ucc_free(self->super.score_str);
+        return status;
+    }
     status = ucc_config_names_array_dup(&self->tls, &cl_config->tls);
     if (UCC_OK != status) {
         ucc_error("failed to dup TLS config_names_array for CL %s",
                   cl_iface->cl_lib_config.name);
+        ucc_coll_score_rules_free(self->super.score_rules);
+        ucc_free(self->super.score_str);
     }
     return status;
 }
 
 UCC_CLASS_CLEANUP_FUNC(ucc_cl_lib_t)
 {
+    ucc_coll_score_rules_free(self->super.score_rules);
     ucc_free(self->super.score_str);
     ucc_config_names_array_free(&self->tls);
 }
@@ -122,6 +122,10 @@ typedef struct ucc_mc_ops {
  } ucc_mc_ops_t;
 
 typedef struct ucc_ee_ops {
+    /* optional: ee private context created from user ee_context on ee
+       create, passed to task/event post instead of user ee_context */
+    ucc_status_t (*ee_context_create)(void *user_context, void **ee_context);
+    ucc_status_t (*ee_context_destroy)(void *ee_context);
     ucc_status_t (*ee_task_post)(void *ee_context, void **ee_req);
     ucc_status_t (*ee_task_query)(void *ee_req);
     ucc_status_t (*ee_task_end)(void *ee_req);
@@ -7,7 +7,9 @@
 #include "mc_cpu.h"
 #include "reduce/mc_cpu_reduce.h"
 #include "utils/ucc_malloc.h"
+#include "utils/ucc_atomic.h"
 #include <sys/types.h>
+#include <limits.h>
 
 static ucc_config_field_t ucc_mc_cpu_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_mc_cpu_config_t, super),
@@ -26,6 +28,8 @@ static ucc_config_field_t ucc_mc_cpu_config_table[] = {
 
 static ucc_status_t ucc_mc_cpu_init(const ucc_mc_params_t *mc_params)
 {
+    ucc_status_t status;
+
     ucc_strncpy_safe(ucc_mc_cpu.super.config->log_component.name,
                      ucc_mc_cpu.super.super.name,
                      sizeof(ucc_mc_cpu.super.config->log_component.name));
@@ -33,7 +37,30 @@ static ucc_status_t ucc_mc_cpu_init(const ucc_mc_params_t *mc_params)
     // lock assures single mpool initiation when multiple threads concurrently execute
     // different collective operations thus concurrently entering init function.
     ucc_spinlock_init(&ucc_mc_cpu.mpool_init_spinlock, 0);
+
+    /* ee tasks and events are used by progress and compute threads */
+    status = ucc_mpool_init(&ucc_mc_cpu.ee_tasks, 0, sizeof(ucc_ee_cpu_task_t),
+                            0, UCC_CACHE_LINE_SIZE, 16, UINT_MAX, NULL,
+                            UCC_THREAD_MULTIPLE, "CPU EE tasks");
+    if (status != UCC_OK) {
+        mc_error(&ucc_mc_cpu.super, "failed to create ee tasks pool");
+        goto err_tasks;
+    }
+    status = ucc_mpool_init(&ucc_mc_cpu.ee_events, 0,
+                            sizeof(ucc_ee_cpu_event_t), 0, UCC_CACHE_LINE_SIZE,
+                            16, UINT_MAX, NULL, UCC_THREAD_MULTIPLE,
+                            "CPU EE events");
+    if (status != UCC_OK) {
+        mc_error(&ucc_mc_cpu.super, "failed to create ee events pool");
+        goto err_events;
+    }
     return UCC_OK;
+
+err_events:
+    ucc_mpool_cleanup(&ucc_mc_cpu.ee_tasks, 1);
+err_tasks:
+    ucc_spinlock_destroy(&ucc_mc_cpu.mpool_init_spinlock);
+    return status;
 }
 
 static ucc_status_t ucc_mc_cpu_get_attr(ucc_mc_attr_t *mc_attr)
@@ -261,47 +288,122 @@ static ucc_status_t ucc_mc_cpu_mem_query(const void *ptr, //NOLINT
     return UCC_ERR_NOT_SUPPORTED;
 }
 
-ucc_status_t ucc_ee_cpu_task_post(void *ee_context, //NOLINT
-                                  void **ee_req)
+/* Every cpu thread ee owns its stream, it is released on ee destroy */
+ucc_status_t ucc_ee_cpu_context_create(void *user_context, void **ee_context)
 {
-    *ee_req = NULL;
+    ucc_ee_cpu_stream_t *stream;
+
+    stream = ucc_malloc(sizeof(*stream), "ee cpu stream");
+    if (ucc_unlikely(!stream)) {
+        mc_error(&ucc_mc_cpu.super, "failed to allocate %zd bytes for ee "
+                 "stream", sizeof(*stream));
+        return UCC_ERR_NO_MEMORY;
+    }
+    stream->user_context = user_context;
+    stream->n_posted     = 0;
+    stream->n_ended      = 0;
+    *ee_context          = stream;
     return UCC_OK;
 }
 
-ucc_status_t ucc_ee_cpu_task_query(void *ee_req) //NOLINT
+ucc_status_t ucc_ee_cpu_context_destroy(void *ee_context)
 {
+    ucc_ee_cpu_stream_t *stream = ee_context;
+
+    if (stream->n_ended != stream->n_posted) {
+        mc_warn(&ucc_mc_cpu.super, "ee stream %p is destroyed with %lu tasks "
+                "not ended", stream, stream->n_posted - stream->n_ended);
+    }
+    ucc_free(stream);
     return UCC_OK;
 }
 
-ucc_status_t ucc_ee_cpu_task_end(void *ee_req) //NOLINT
+ucc_status_t ucc_ee_cpu_task_post(void *ee_context, void **ee_req)
 {
+    ucc_ee_cpu_stream_t *stream = ee_context;
+    ucc_ee_cpu_task_t   *task;
+
+    task = ucc_mpool_get(&ucc_mc_cpu.ee_tasks);
+    if (ucc_unlikely(!task)) {
+        mc_error(&ucc_mc_cpu.super, "failed to get ee task from mpool");
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->stream  = stream;
+    task->seq_num = ucc_atomic_fadd64(&stream->n_posted, 1);
+    *ee_req       = task;
+    mc_info(&ucc_mc_cpu.super, "CPU stream task posted, stream %p, req %p, "
+            "seq_num %lu", stream, task, task->seq_num);
     return UCC_OK;
 }
 
-ucc_status_t ucc_ee_cpu_create_event(void **event)
+ucc_status_t ucc_ee_cpu_task_query(void *ee_req)
 {
-    *event = NULL;
+    ucc_ee_cpu_task_t *task = ee_req;
+
+    /* tasks of the stream are started in order */
+    return (task->stream->n_ended == task->seq_num) ? UCC_OK : UCC_INPROGRESS;
+}
+
+ucc_status_t ucc_ee_cpu_task_end(void *ee_req)
+{
+    ucc_ee_cpu_task_t   *task   = ee_req;
+    ucc_ee_cpu_stream_t *stream = task->stream;
+
+    ucc_assert(stream->n_ended == task->seq_num);
+    mc_info(&ucc_mc_cpu.super, "CPU stream task done, stream %p, req %p, "
+            "seq_num %lu", stream, task, task->seq_num);
+    ucc_mpool_put(task);
+    /* releases the next task and events posted after this task */
+    ucc_memory_cpu_store_fence();
+    ucc_atomic_add64(&stream->n_ended, 1);
     return UCC_OK;
 }
 
-ucc_status_t ucc_ee_cpu_destroy_event(void *event) //NOLINT
+ucc_status_t ucc_ee_cpu_create_event(void **event)
 {
+    ucc_ee_cpu_event_t *cpu_event;
+
+    cpu_event = ucc_mpool_get(&ucc_mc_cpu.ee_events);
+    if (ucc_unlikely(!cpu_event)) {
+        mc_error(&ucc_mc_cpu.super, "failed to get ee event from mpool");
+        return UCC_ERR_NO_MEMORY;
+    }
+    cpu_event->stream = NULL;
+    *event            = cpu_event;
     return UCC_OK;
 }
 
-ucc_status_t ucc_ee_cpu_event_post(void *ee_context, //NOLINT
-                                   void *event) //NOLINT
+ucc_status_t ucc_ee_cpu_destroy_event(void *event)
 {
+    ucc_mpool_put(event);
     return UCC_OK;
 }
 
-ucc_status_t ucc_ee_cpu_event_test(void *event) //NOLINT
+ucc_status_t ucc_ee_cpu_event_post(void *ee_context, void *event)
 {
+    ucc_ee_cpu_event_t  *cpu_event = event;
+    ucc_ee_cpu_stream_t *stream    = ee_context;
+
+    cpu_event->seq_num = stream->n_posted;
+    cpu_event->stream  = stream;
     return UCC_OK;
 }
 
+ucc_status_t ucc_ee_cpu_event_test(void *event)
+{
+    ucc_ee_cpu_event_t *cpu_event = event;
+
+    if (!cpu_event->stream ||
+        cpu_event->stream->n_ended >= cpu_event->seq_num) {
+        return UCC_OK;
+    }
+    return UCC_INPROGRESS;
+}
+
 static ucc_status_t ucc_mc_cpu_finalize()
 {
+    ucc_mpool_cleanup(&ucc_mc_cpu.ee_events, 1);
+    ucc_mpool_cleanup(&ucc_mc_cpu.ee_tasks, 1);
     if (ucc_mc_cpu.mpool_init_flag) {
         ucc_mpool_cleanup(&ucc_mc_cpu.mpool, 1);
         ucc_mc_cpu.mpool_init_flag     = 0;
@@ -334,13 +436,15 @@ ucc_mc_cpu_t ucc_mc_cpu = {
             .table  = ucc_mc_cpu_config_table,
             .size   = sizeof(ucc_mc_cpu_config_t),
         },
-    .super.ee_ops.ee_task_post     = ucc_ee_cpu_task_post,
-    .super.ee_ops.ee_task_query    = ucc_ee_cpu_task_query,
-    .super.ee_ops.ee_task_end      = ucc_ee_cpu_task_end,
-    .super.ee_ops.ee_create_event  = ucc_ee_cpu_create_event,
-    .super.ee_ops.ee_destroy_event = ucc_ee_cpu_destroy_event,
-    .super.ee_ops.ee_event_post    = ucc_ee_cpu_event_post,
-    .super.ee_ops.ee_event_test    = ucc_ee_cpu_event_test,
+    .super.ee_ops.ee_context_create  = ucc_ee_cpu_context_create,
+    .super.ee_ops.ee_context_destroy = ucc_ee_cpu_context_destroy,
+    .super.ee_ops.ee_task_post       = ucc_ee_cpu_task_post,
+    .super.ee_ops.ee_task_query      = ucc_ee_cpu_task_query,
+    .super.ee_ops.ee_task_end        = ucc_ee_cpu_task_end,
+    .super.ee_ops.ee_create_event    = ucc_ee_cpu_create_event,
+    .super.ee_ops.ee_destroy_event   = ucc_ee_cpu_destroy_event,
+    .super.ee_ops.ee_event_post      = ucc_ee_cpu_event_post,
+    .super.ee_ops.ee_event_test      = ucc_ee_cpu_event_test,
     .mpool_init_flag               = 0,
 };
 
@@ -16,12 +16,35 @@ typedef struct ucc_mc_cpu_config {
     int             mpool_max_elems;
 } ucc_mc_cpu_config_t;
 
+/* CPU execution engine stream: ordered queue of ee tasks posted on the same
+   ee, created with the ee and used as its ee_context. Task with sequence
+   number N is started when all the tasks posted before it are ended, event
+   posted on the stream is completed when all the tasks posted before the
+   event are ended. */
+typedef struct ucc_ee_cpu_stream {
+    void             *user_context;
+    volatile uint64_t n_posted;
+    volatile uint64_t n_ended;
+} ucc_ee_cpu_stream_t;
+
+typedef struct ucc_ee_cpu_task {
+    ucc_ee_cpu_stream_t *stream;
+    uint64_t             seq_num;
+} ucc_ee_cpu_task_t;
+
+typedef struct ucc_ee_cpu_event {
+    ucc_ee_cpu_stream_t *stream; /*< NULL if event was not posted */
+    uint64_t             seq_num;
+} ucc_ee_cpu_event_t;
+
 typedef struct ucc_mc_cpu {
     ucc_mc_base_t     super;
     ucc_mpool_t       mpool;
     int               mpool_init_flag;
     ucc_spinlock_t    mpool_init_spinlock;
     ucc_thread_mode_t thread_mode;
+    ucc_mpool_t       ee_tasks;
+    ucc_mpool_t       ee_events;
 } ucc_mc_cpu_t;
 
 extern ucc_mc_cpu_t ucc_mc_cpu;
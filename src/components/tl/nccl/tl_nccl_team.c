@@ -186,6 +186,7 @@ ucc_status_t ucc_tl_nccl_team_get_scores(ucc_base_team_t   *tl_team,
     ucc_tl_nccl_lib_t * lib  = UCC_TL_NCCL_TEAM_LIB(team);
     ucc_memory_type_t   mt   = UCC_MEMORY_TYPE_CUDA;
     ucc_coll_score_t   *score;
+    ucc_coll_score_team_info_t info;
     ucc_status_t        status;
     int                 i;
 
@@ -221,11 +222,12 @@ ucc_status_t ucc_tl_nccl_team_get_scores(ucc_base_team_t   *tl_team,
         return status;
     }
 
-    if (strlen(lib->super.super.score_str) > 0) {
-        status = ucc_coll_score_update_from_str(
-            lib->super.super.score_str, score, UCC_TL_TEAM_SIZE(team),
-            ucc_tl_nccl_coll_init, &team->super.super,
-            UCC_TL_NCCL_DEFAULT_SCORE, ucc_tl_nccl_alg_id_to_init);
+    if (lib->super.super.score_rules) {
+        ucc_coll_score_team_info_init(&team->super.super, &info);
+        status = ucc_coll_score_update_from_rules(
+            lib->super.super.score_rules, score, &info, ucc_tl_nccl_coll_init,
+            &team->super.super, UCC_TL_NCCL_DEFAULT_SCORE,
+            ucc_tl_nccl_alg_id_to_init);
         /* If INVALID_PARAM - User provided incorrect input - try to proceed */
         if ((status < 0) && (status != UCC_ERR_INVALID_PARAM) &&
             (status != UCC_ERR_NOT_SUPPORTED)) {
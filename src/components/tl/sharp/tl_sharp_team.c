@@ -133,6 +133,7 @@ ucc_status_t ucc_tl_sharp_team_get_scores(ucc_base_team_t   *tl_team,
     ucc_tl_sharp_team_t *team = ucc_derived_of(tl_team, ucc_tl_sharp_team_t);
     ucc_tl_sharp_lib_t  *lib  = UCC_TL_SHARP_TEAM_LIB(team);
     ucc_coll_score_t    *score;
+    ucc_coll_score_team_info_t info;
     ucc_status_t         status;
 
     /* There can be a different logic for different coll_type/mem_type.
@@ -146,11 +147,11 @@ ucc_status_t ucc_tl_sharp_team_get_scores(ucc_base_team_t   *tl_team,
         return status;
     }
 
-    if (strlen(lib->super.super.score_str) > 0) {
-        status = ucc_coll_score_update_from_str(
-            lib->super.super.score_str, score, UCC_TL_TEAM_SIZE(team),
-            ucc_tl_sharp_coll_init, &team->super.super,
-            UCC_TL_SHARP_DEFAULT_SCORE, NULL);
+    if (lib->super.super.score_rules) {
+        ucc_coll_score_team_info_init(&team->super.super, &info);
+        status = ucc_coll_score_update_from_rules(
+            lib->super.super.score_rules, score, &info, ucc_tl_sharp_coll_init,
+            &team->super.super, UCC_TL_SHARP_DEFAULT_SCORE, NULL);
         /* If INVALID_PARAM - User provided incorrect input - try to proceed */
         if ((status < 0) && (status != UCC_ERR_INVALID_PARAM) &&
             (status != UCC_ERR_NOT_SUPPORTED)) {
@@ -6,6 +6,7 @@
 
 #include "ucc_tl.h"
 #include "utils/ucc_log.h"
+#include "coll_score/ucc_coll_score.h"
 
 ucc_config_field_t ucc_tl_lib_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_tl_lib_config_t, super),
@@ -21,6 +22,7 @@ ucc_config_field_t ucc_tl_context_config_table[] = {
 UCC_CLASS_INIT_FUNC(ucc_tl_lib_t, ucc_tl_iface_t *tl_iface,
                     const ucc_tl_lib_config_t *tl_config)
 {
+    ucc_status_t status;
     UCC_CLASS_CALL_BASE_INIT();
     self->iface         = tl_iface;
     self->super.log_component = tl_config->super.log_component;
@@ -31,11 +33,17 @@ UCC_CLASS_INIT_FUNC(ucc_tl_lib_t, ucc_tl_iface_t *tl_iface,
                      tl_iface->tl_lib_config.name,
                      sizeof(self->super.log_component.name));
     self->super.score_str = strdup(tl_config->super.score_str);
-    return UCC_OK;
+    status = ucc_coll_score_lib_rules_init(&self->super,
+                                           self->super.score_str);
+    if (UCC_OK != status) {
+        ucc_free(self->super.score_str);
+    }
+    return status;
 }
 
 UCC_CLASS_CLEANUP_FUNC(ucc_tl_lib_t)
 {
+    ucc_coll_score_rules_free(self->super.score_rules);
     ucc_free(self->super.score_str);
 }
 
@@ -7,17 +7,48 @@
 #include "tl_ucp.h"
 #include "allgather.h"
 
-ucc_status_t ucc_tl_ucp_allgather_ring_start(ucc_coll_task_t *task);
-ucc_status_t ucc_tl_ucp_allgather_ring_progress(ucc_coll_task_t *task);
+ucc_base_coll_alg_info_t
+    ucc_tl_ucp_allgather_algs[UCC_TL_UCP_ALLGATHER_ALG_LAST + 1] = {
+        [UCC_TL_UCP_ALLGATHER_ALG_KNOMIAL] =
+            {.id   = UCC_TL_UCP_ALLGATHER_ALG_KNOMIAL,
+             .name = "knomial",
+             .desc = "recursive k-ing with arbitrary radix"},
+        [UCC_TL_UCP_ALLGATHER_ALG_RING] =
+            {.id   = UCC_TL_UCP_ALLGATHER_ALG_RING,
+             .name = "ring",
+             .desc = "O(N) ring implementation (bw oriented alg)"},
+        [UCC_TL_UCP_ALLGATHER_ALG_BRUCK] =
+            {.id   = UCC_TL_UCP_ALLGATHER_ALG_BRUCK,
+             .name = "bruck",
+             .desc = "O(log N) Bruck with final local rotation (latency "
+                     "oriented alg)"},
+        [UCC_TL_UCP_ALLGATHER_ALG_LAST] = {
+            .id = 0, .name = NULL, .desc = NULL}};
 
 ucc_status_t ucc_tl_ucp_allgather_init(ucc_tl_ucp_task_t *task)
 {
-    if ((!UCC_DT_IS_PREDEFINED((TASK_ARGS(task)).src.info.datatype) ||
-        !UCC_DT_IS_PREDEFINED((TASK_ARGS(task)).dst.info.datatype))) {
-        tl_error(UCC_TASK_LIB(task), "user defined datatype is not supported");
-        return UCC_ERR_NOT_SUPPORTED;
-    }
+    ucc_status_t status = UCC_OK;
+
+    ALLGATHER_TASK_CHECK(TASK_ARGS(task), TASK_TEAM(task));
     task->super.post     = ucc_tl_ucp_allgather_ring_start;
     task->super.progress = ucc_tl_ucp_allgather_ring_progress;
+out:
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_ring_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t *     team,
+                                            ucc_coll_task_t **    task_h)
+{
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_allgather_init(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    *task_h = &task->super;
     return UCC_OK;
 }
@@ -8,17 +8,65 @@
 #include "../tl_ucp.h"
 #include "../tl_ucp_coll.h"
 
+enum {
+    UCC_TL_UCP_ALLGATHER_ALG_KNOMIAL,
+    UCC_TL_UCP_ALLGATHER_ALG_RING,
+    UCC_TL_UCP_ALLGATHER_ALG_BRUCK,
+    UCC_TL_UCP_ALLGATHER_ALG_LAST
+};
+
+extern ucc_base_coll_alg_info_t
+    ucc_tl_ucp_allgather_algs[UCC_TL_UCP_ALLGATHER_ALG_LAST + 1];
+
+#define UCC_TL_UCP_ALLGATHER_DEFAULT_ALG_SELECT_STR                            \
+    "allgather:0-4k:@bruck#allgather:4k-inf:@ring"
+
+#define ALLGATHER_TASK_CHECK(_args, _team)                                     \
+    do {                                                                       \
+        if (!UCC_DT_IS_PREDEFINED((_args).src.info.datatype) ||                \
+            !UCC_DT_IS_PREDEFINED((_args).dst.info.datatype)) {                \
+            tl_error(UCC_TL_TEAM_LIB(_team),                                   \
+                     "user defined datatype is not supported");                \
+            status = UCC_ERR_NOT_SUPPORTED;                                    \
+            goto out;                                                          \
+        }                                                                      \
+    } while (0)
+
 ucc_status_t ucc_tl_ucp_allgather_init(ucc_tl_ucp_task_t *task);
 ucc_status_t ucc_tl_ucp_allgather_ring_progress(ucc_coll_task_t *task);
 ucc_status_t ucc_tl_ucp_allgather_ring_start(ucc_coll_task_t *task);
 
-/* Uses allgather_kn_radix from config */
+ucc_status_t ucc_tl_ucp_allgather_ring_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t *     team,
+                                            ucc_coll_task_t **    task_h);
+
+/* Recursive k-ing allgather of the rank ordered blocks,
+   uses allgather_kn_radix from config */
 ucc_status_t ucc_tl_ucp_allgather_knomial_init(ucc_base_coll_args_t *coll_args,
                                                ucc_base_team_t *     team,
                                                ucc_coll_task_t **    task_h);
 
-/* Internal interface with custom radix */
+/* Internal interface with custom radix, data layout of SRA knomial
+   reduce-scatter/scatter */
 ucc_status_t ucc_tl_ucp_allgather_knomial_init_r(
     ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
     ucc_coll_task_t **task_h, ucc_kn_radix_t radix);
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t *     team,
+                                             ucc_coll_task_t **    task_h);
+ucc_status_t ucc_tl_ucp_allgather_bruck_start(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_allgather_bruck_progress(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_allgather_bruck_finalize(ucc_coll_task_t *task);
+
+static inline int ucc_tl_ucp_allgather_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_TL_UCP_ALLGATHER_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_tl_ucp_allgather_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
 #endif
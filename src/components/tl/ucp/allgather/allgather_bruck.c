@@ -0,0 +1,163 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "allgather.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "core/ucc_mc.h"
+
+/* Bruck allgather: at step with distance dist rank sends first
+   min(dist, size - dist) blocks of scratch to rank - dist and receives the
+   same number of blocks from rank + dist right after its own ones. After
+   ceil(log2(size)) steps block i of scratch is the block of rank + i, it
+   is rotated into dst locally. */
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task      = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team      = TASK_TEAM(task);
+    ucc_rank_t         rank      = task->subset.myrank;
+    ucc_rank_t         size      = (ucc_rank_t)task->subset.map.ep_num;
+    void              *rbuf      = TASK_ARGS(task).dst.info.buffer;
+    ucc_memory_type_t  rmem      = TASK_ARGS(task).dst.info.mem_type;
+    size_t             count     = TASK_ARGS(task).dst.info.count;
+    ucc_datatype_t     dt        = TASK_ARGS(task).dst.info.datatype;
+    size_t             data_size = (count / size) * ucc_dt_size(dt);
+    void              *scratch   = task->allgather_bruck.scratch;
+    ucc_rank_t         dist, n_blocks, sendto, recvfrom;
+    ucc_status_t       status;
+
+    while ((dist = task->allgather_bruck.dist) < size) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        n_blocks = ucc_min(dist, size - dist);
+        sendto   = ucc_ep_map_eval(task->subset.map, (rank - dist + size) % size);
+        recvfrom = ucc_ep_map_eval(task->subset.map, (rank + dist) % size);
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(scratch, n_blocks * data_size, rmem,
+                                         sendto, team, task),
+                      task, out);
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(PTR_OFFSET(scratch, dist * data_size),
+                                         n_blocks * data_size, rmem, recvfrom,
+                                         team, task),
+                      task, out);
+        task->allgather_bruck.dist = dist * 2;
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    /* local rotation: scratch[i] -> dst[(rank + i) % size] */
+    status = ucc_mc_memcpy(PTR_OFFSET(rbuf, rank * data_size), scratch,
+                           (size - rank) * data_size, rmem, rmem);
+    if (ucc_unlikely(UCC_OK != status)) {
+        task->super.super.status = status;
+        goto out;
+    }
+    if (rank > 0) {
+        status = ucc_mc_memcpy(rbuf,
+                               PTR_OFFSET(scratch, (size - rank) * data_size),
+                               rank * data_size, rmem, rmem);
+        if (ucc_unlikely(UCC_OK != status)) {
+            task->super.super.status = status;
+            goto out;
+        }
+    }
+    task->super.super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgather_bruck_done", 0);
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task      = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team      = TASK_TEAM(task);
+    ucc_coll_args_t   *args      = &TASK_ARGS(task);
+    ucc_rank_t         size      = (ucc_rank_t)task->subset.map.ep_num;
+    size_t             data_size = (args->dst.info.count / size) *
+                                   ucc_dt_size(args->dst.info.datatype);
+    void              *sbuf;
+    ucc_memory_type_t  smem;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgather_bruck_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    task->allgather_bruck.dist = 1;
+
+    if (UCC_IS_INPLACE(*args)) {
+        sbuf = PTR_OFFSET(args->dst.info.buffer,
+                          task->subset.myrank * data_size);
+        smem = args->dst.info.mem_type;
+    } else {
+        sbuf = args->src.info.buffer;
+        smem = args->src.info.mem_type;
+    }
+    status = ucc_mc_memcpy(task->allgather_bruck.scratch, sbuf, data_size,
+                           args->dst.info.mem_type, smem);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+
+    status = ucc_tl_ucp_allgather_bruck_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st;
+
+    global_st = ucc_mc_free(task->allgather_bruck.scratch_mc_header);
+    if (ucc_unlikely(global_st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+ucc_status_t ucc_tl_ucp_allgather_bruck_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t *     team,
+                                             ucc_coll_task_t **    task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_coll_args_t   *args    = &coll_args->args;
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status  = UCC_OK;
+
+    ALLGATHER_TASK_CHECK(*args, tl_team);
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_mc_alloc(&task->allgather_bruck.scratch_mc_header,
+                          ucc_max(args->dst.info.count *
+                                      ucc_dt_size(args->dst.info.datatype),
+                                  1),
+                          args->dst.info.mem_type);
+    if (ucc_unlikely(UCC_OK != status)) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    task->allgather_bruck.scratch =
+        task->allgather_bruck.scratch_mc_header->addr;
+    task->super.post     = ucc_tl_ucp_allgather_bruck_start;
+    task->super.progress = ucc_tl_ucp_allgather_bruck_progress;
+    task->super.finalize = ucc_tl_ucp_allgather_bruck_finalize;
+    *task_h              = &task->super;
+out:
+    return status;
+}
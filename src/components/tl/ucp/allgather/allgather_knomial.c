@@ -6,7 +6,7 @@
 
 #include "config.h"
 #include "tl_ucp.h"
-#include "tl_ucp_coll.h"
+#include "allgather.h"
 #include "tl_ucp_sendrecv.h"
 #include "core/ucc_progress_queue.h"
 #include "core/ucc_mc.h"
@@ -205,14 +205,171 @@ ucc_status_t ucc_tl_ucp_allgather_knomial_init_r(
     return UCC_OK;
 }
 
+/* Recursive k-ing allgather of the rank ordered blocks: a group of
+   consecutive loop ranks holds a contiguous range of blocks (see
+   ucc_knomial_pattern_loop_range) and every step is a single send/recv per
+   peer. */
+static ucc_status_t
+ucc_tl_ucp_allgather_knomial_rec_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t     *task      = ucc_derived_of(coll_task,
+                                                      ucc_tl_ucp_task_t);
+    ucc_coll_args_t       *args      = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t     *team      = TASK_TEAM(task);
+    ucc_knomial_pattern_t *p         = &task->allgather_kn.p;
+    ucc_kn_radix_t         radix     = p->radix;
+    uint8_t                node_type = p->node_type;
+    void                  *rbuf      = args->dst.info.buffer;
+    ucc_memory_type_t      mem_type  = args->dst.info.mem_type;
+    ucc_rank_t             size      = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t             rank      = task->subset.myrank;
+    size_t                 data_size = (args->dst.info.count / size) *
+                                       ucc_dt_size(args->dst.info.datatype);
+    ucc_rank_t             peer, start, n_blocks;
+    ucc_kn_radix_t         loop_step;
+
+    UCC_KN_GOTO_PHASE(task->allgather_kn.phase);
+    if (KN_NODE_EXTRA == node_type) {
+        peer = ucc_ep_map_eval(task->subset.map,
+                               ucc_knomial_pattern_get_proxy(p, rank));
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(PTR_OFFSET(rbuf, rank * data_size),
+                                         data_size, mem_type, peer, team,
+                                         task),
+                      task, out);
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(rbuf, size * data_size, mem_type,
+                                         peer, team, task),
+                      task, out);
+    }
+    if (KN_NODE_PROXY == node_type) {
+        peer = ucc_ep_map_eval(task->subset.map,
+                               ucc_knomial_pattern_get_extra(p, rank));
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_recv_nb(PTR_OFFSET(rbuf, (rank + 1) * data_size),
+                               data_size, mem_type, peer, team, task),
+            task, out);
+    }
+UCC_KN_PHASE_EXTRA:
+    if (KN_NODE_PROXY == node_type || KN_NODE_EXTRA == node_type) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(UCC_KN_PHASE_EXTRA);
+            return task->super.super.status;
+        }
+        if (KN_NODE_EXTRA == node_type) {
+            goto completion;
+        }
+    }
+    while (!ucc_knomial_pattern_loop_done(p)) {
+        ucc_knomial_pattern_loop_range(p, size, rank, &start, &n_blocks);
+        for (loop_step = 1; loop_step < radix; loop_step++) {
+            peer = ucc_knomial_pattern_get_loop_peer(p, rank, size, loop_step);
+            if (peer == UCC_KN_PEER_NULL)
+                continue;
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_send_nb(PTR_OFFSET(rbuf, start * data_size),
+                                   n_blocks * data_size, mem_type,
+                                   ucc_ep_map_eval(task->subset.map, peer),
+                                   team, task),
+                task, out);
+        }
+        for (loop_step = 1; loop_step < radix; loop_step++) {
+            peer = ucc_knomial_pattern_get_loop_peer(p, rank, size, loop_step);
+            if (peer == UCC_KN_PEER_NULL)
+                continue;
+            ucc_knomial_pattern_loop_range(p, size, peer, &start, &n_blocks);
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_recv_nb(PTR_OFFSET(rbuf, start * data_size),
+                                   n_blocks * data_size, mem_type,
+                                   ucc_ep_map_eval(task->subset.map, peer),
+                                   team, task),
+                task, out);
+        }
+    UCC_KN_PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(UCC_KN_PHASE_LOOP);
+            return task->super.super.status;
+        }
+        ucc_knomial_pattern_next_iteration(p);
+    }
+    if (KN_NODE_PROXY == node_type) {
+        peer = ucc_ep_map_eval(task->subset.map,
+                               ucc_knomial_pattern_get_extra(p, rank));
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(rbuf, size * data_size, mem_type,
+                                         peer, team, task),
+                      task, out);
+    } else {
+        goto completion;
+    }
+UCC_KN_PHASE_PROXY:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(UCC_KN_PHASE_PROXY);
+        return task->super.super.status;
+    }
+completion:
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgather_kn_done", 0);
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allgather_knomial_rec_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_rank_t         size = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         rank = task->subset.myrank;
+    size_t             data_size = (args->dst.info.count / size) *
+                                   ucc_dt_size(args->dst.info.datatype);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allgather_kn_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    task->allgather_kn.phase = UCC_KN_PHASE_INIT;
+    ucc_knomial_pattern_init(size, rank, task->allgather_kn.p.radix,
+                             &task->allgather_kn.p);
+    if (!UCC_IS_INPLACE(*args)) {
+        status = ucc_mc_memcpy(PTR_OFFSET(args->dst.info.buffer,
+                                          rank * data_size),
+                               args->src.info.buffer, data_size,
+                               args->dst.info.mem_type,
+                               args->src.info.mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+    status = ucc_tl_ucp_allgather_knomial_rec_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
+
 ucc_status_t ucc_tl_ucp_allgather_knomial_init(ucc_base_coll_args_t *coll_args,
                                                ucc_base_team_t      *team,
                                                ucc_coll_task_t     **task_h)
 {
     ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
     ucc_rank_t         size    = UCC_TL_TEAM_SIZE(tl_team);
+    ucc_tl_ucp_task_t *task;
     ucc_kn_radix_t     radix;
+    ucc_status_t       status  = UCC_OK;
 
-    radix = ucc_min(UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.allgather_kn_radix, size);
-    return ucc_tl_ucp_allgather_knomial_init_r(coll_args, team, task_h, radix);
+    ALLGATHER_TASK_CHECK(coll_args->args, tl_team);
+    radix = ucc_min(ucc_tl_ucp_kn_radix(
+                        tl_team, coll_args,
+                        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.allgather_kn_radix,
+                        UCC_KN_MODEL_RECURSIVE, size,
+                        ucc_coll_args_msgsize(coll_args)),
+                    size);
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_allgather_knomial_rec_start;
+    task->super.progress = ucc_tl_ucp_allgather_knomial_rec_progress;
+    ucc_knomial_pattern_init(size, UCC_TL_TEAM_RANK(tl_team), radix,
+                             &task->allgather_kn.p);
+    *task_h              = &task->super;
+out:
+    return status;
 }
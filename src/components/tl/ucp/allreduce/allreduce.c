@@ -20,6 +20,16 @@ ucc_base_coll_alg_info_t
              .name = "sra_knomial",
              .desc = "recursive k-nomial scatter-reduce followed by k-nomial "
                      "allgather (bw oriented alg)"},
+        [UCC_TL_UCP_ALLREDUCE_ALG_RING] =
+            {.id   = UCC_TL_UCP_ALLREDUCE_ALG_RING,
+             .name = "ring",
+             .desc = "ring reduce-scatter followed by ring allgather with "
+                     "segmented pipelining (bw oriented alg)"},
+        [UCC_TL_UCP_ALLREDUCE_ALG_DBT] =
+            {.id   = UCC_TL_UCP_ALLREDUCE_ALG_DBT,
+             .name = "dbt",
+             .desc = "pipelined reduce and bcast over double binary tree "
+                     "(bw oriented alg for mid size messages)"},
         [UCC_TL_UCP_ALLREDUCE_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
@@ -46,3 +56,18 @@ ucc_status_t ucc_tl_ucp_allreduce_knomial_init(ucc_base_coll_args_t *coll_args,
 out:
     return status;
 }
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t *     team,
+                                            ucc_coll_task_t **    task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+    ALLREDUCE_TASK_CHECK(coll_args->args, tl_team);
+    task    = ucc_tl_ucp_init_task(coll_args, team);
+    *task_h = &task->super;
+    status  = ucc_tl_ucp_allreduce_ring_init_common(task);
+out:
+    return status;
+}
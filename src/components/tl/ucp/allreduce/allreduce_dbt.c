@@ -0,0 +1,345 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "allreduce.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Double binary tree allreduce
+   1. The vector is split into fragments of at most ALLREDUCE_DBT_FRAG_SIZE
+      bytes, each fragment is split in halves and every half is reduced to
+      the root of one tree of the double binary tree
+      (coll_patterns/double_binary_tree.h) and broadcast back over the same
+      tree.
+   2. A single tree leaves the send link of the leaves unused on the way up
+      (and the receive link on the way down). In the double binary tree a
+      leaf of one tree is interior in the other one, so both links of every
+      rank carry data and each tree only carries half of the vector.
+   3. Up to ALLREDUCE_DBT_PIPELINE_DEPTH fragments are in flight, so the
+      reduce of fragment i + 1 overlaps with the bcast of fragment i and the
+      tree depth is paid once per collective rather than once per fragment.
+   4. Interior ranks need a scratch for the vectors of their (at most two)
+      children, sized for the largest half fragment. */
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_dbt_send_children(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t       *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t     *team = TASK_TEAM(task);
+    ucc_dbt_single_tree_t *t    = &task->dbt.t;
+    size_t                 data_size =
+        args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+    int                    i;
+    ucc_status_t           status;
+
+    for (i = 0; i < t->n_children; i++) {
+        status = ucc_tl_ucp_send_nb(args->dst.info.buffer, data_size,
+                                    args->dst.info.mem_type, t->children[i],
+                                    team, task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_dbt_frag_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t     *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t       *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t     *team = TASK_TEAM(task);
+    ucc_dbt_single_tree_t *t    = &task->dbt.t;
+    ucc_memory_type_t      mtype = args->dst.info.mem_type;
+    size_t                 count = args->dst.info.count;
+    size_t                 data_size =
+        count * ucc_dt_size(args->dst.info.datatype);
+    void                  *sbuf  = UCC_IS_INPLACE(*args)
+                                       ? args->dst.info.buffer
+                                       : args->src.info.buffer;
+    void                  *data;
+    ucc_status_t           status;
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    if (task->dbt.phase == UCC_ALLREDUCE_DBT_PHASE_REDUCE) {
+        data = sbuf;
+        if (t->n_children > 0) {
+            /* the root of the tree completes avg */
+            status = ucc_tl_ucp_reduce_multi(
+                sbuf, task->dbt.scratch, args->dst.info.buffer, t->n_children,
+                count, data_size, args->dst.info.datatype, mtype, task,
+                args->op == UCC_OP_AVG && t->parent == UCC_DBT_PEER_NULL);
+            if (ucc_unlikely(UCC_OK != status)) {
+                tl_error(UCC_TASK_LIB(task), "failed to perform dt reduction");
+                task->super.super.status = status;
+                return status;
+            }
+            data = args->dst.info.buffer;
+        } else if (t->parent == UCC_DBT_PEER_NULL &&
+                   sbuf != args->dst.info.buffer) {
+            /* single rank team */
+            status = ucc_mc_memcpy(args->dst.info.buffer, sbuf, data_size,
+                                   mtype, mtype);
+            if (ucc_unlikely(UCC_OK != status)) {
+                task->super.super.status = status;
+                return status;
+            }
+        }
+        if (t->parent != UCC_DBT_PEER_NULL) {
+            /* the result of the parent can not arrive before the parent
+               got the data of this rank, so dst may be reused for it */
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(data, data_size, mtype, t->parent,
+                                             team, task),
+                          task, out);
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(args->dst.info.buffer, data_size,
+                                             mtype, t->parent, team, task),
+                          task, out);
+            task->dbt.phase = UCC_ALLREDUCE_DBT_PHASE_BCAST;
+            if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+                return task->super.super.status;
+            }
+        }
+        task->dbt.phase = UCC_ALLREDUCE_DBT_PHASE_BCAST;
+    }
+    if (task->dbt.phase == UCC_ALLREDUCE_DBT_PHASE_BCAST) {
+        UCPCHECK_GOTO(ucc_tl_ucp_allreduce_dbt_send_children(task), task, out);
+        task->dbt.phase = UCC_ALLREDUCE_DBT_PHASE_SEND;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_dbt_frag_task_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t     *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t       *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t     *team = TASK_TEAM(task);
+    ucc_dbt_single_tree_t *t    = &task->dbt.t;
+    size_t                 data_size =
+        args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+    int                    i;
+    ucc_status_t           status;
+
+    ucc_tl_ucp_task_reset(task);
+    task->dbt.phase = UCC_ALLREDUCE_DBT_PHASE_REDUCE;
+    if (data_size == 0) {
+        /* the half of a single element fragment */
+        task->super.super.status = UCC_OK;
+        return ucc_task_complete(coll_task);
+    }
+    for (i = 0; i < t->n_children; i++) {
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(PTR_OFFSET(task->dbt.scratch,
+                                                    i * data_size),
+                                         data_size, args->dst.info.mem_type,
+                                         t->children[i], team, task),
+                      task, out);
+    }
+
+    status = ucc_tl_ucp_allreduce_dbt_frag_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_dbt_frag_task_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->dbt.scratch_mc_header) {
+        global_st = ucc_mc_free(task->dbt.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+static ucc_status_t ucc_tl_ucp_allreduce_dbt_frag_start(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+
+    return ucc_schedule_start(schedule);
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_dbt_frag_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+    ucc_status_t    status;
+
+    status = ucc_schedule_finalize(task);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_dbt_frag_setup(ucc_schedule_pipelined_t *schedule_p,
+                                    ucc_schedule_t *frag, int frag_num)
+{
+    ucc_coll_args_t *args       = &schedule_p->super.super.bargs.args;
+    size_t           dt_size    = ucc_dt_size(args->dst.info.datatype);
+    int              n_frags    = schedule_p->n_frags_total;
+    size_t           frag_count = args->dst.info.count / n_frags;
+    size_t           left       = args->dst.info.count % n_frags;
+    size_t           offset     = frag_num * frag_count + left;
+    size_t           half;
+    ucc_coll_args_t *targs;
+    int              i;
+
+    if (frag_num < left) {
+        frag_count++;
+        offset -= left - frag_num;
+    }
+    for (i = 0; i < 2; i++) {
+        /* 1st tree takes the larger half */
+        half  = i ? frag_count / 2 : frag_count - frag_count / 2;
+        targs = &frag->tasks[i]->bargs.args;
+        targs->src.info.buffer =
+            PTR_OFFSET(args->src.info.buffer, offset * dt_size);
+        targs->dst.info.buffer =
+            PTR_OFFSET(args->dst.info.buffer, offset * dt_size);
+        targs->src.info.count = half;
+        targs->dst.info.count = half;
+        offset += half;
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_dbt_frag_init(ucc_base_coll_args_t     *coll_args,
+                                   ucc_schedule_pipelined_t *sp,
+                                   ucc_base_team_t          *team,
+                                   ucc_schedule_t          **frag_p)
+{
+    ucc_tl_ucp_team_t    *tl_team  = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_schedule_t       *schedule = ucc_tl_ucp_get_schedule(tl_team, coll_args);
+    ucc_coll_args_t      *args     = &coll_args->args;
+    size_t                max_half = ucc_div_round_up(
+        ucc_div_round_up(args->dst.info.count, sp->n_frags_total), 2);
+    ucc_dbt_single_tree_t trees[2];
+    ucc_tl_ucp_task_t    *task;
+    ucc_status_t          status;
+    int                   i;
+
+    ucc_dbt_build_trees(UCC_TL_TEAM_RANK(tl_team), UCC_TL_TEAM_SIZE(tl_team),
+                        &trees[0], &trees[1]);
+    for (i = 0; i < 2; i++) {
+        task                = ucc_tl_ucp_init_task(coll_args, team);
+        task->super.post    = ucc_tl_ucp_allreduce_dbt_frag_task_start;
+        task->super.progress = ucc_tl_ucp_allreduce_dbt_frag_progress;
+        task->super.finalize = ucc_tl_ucp_allreduce_dbt_frag_task_finalize;
+        task->dbt.t                 = trees[i];
+        task->dbt.scratch           = NULL;
+        task->dbt.scratch_mc_header = NULL;
+        if (trees[i].n_children > 0 && max_half > 0) {
+            status = ucc_mc_alloc(&task->dbt.scratch_mc_header,
+                                  trees[i].n_children * max_half *
+                                      ucc_dt_size(args->dst.info.datatype),
+                                  args->dst.info.mem_type);
+            if (ucc_unlikely(UCC_OK != status)) {
+                tl_error(UCC_TASK_LIB(task),
+                         "failed to allocate scratch buffer");
+                ucc_tl_ucp_put_task(task);
+                return status;
+            }
+            task->dbt.scratch = task->dbt.scratch_mc_header->addr;
+        }
+        ucc_schedule_add_task(schedule, &task->super);
+        ucc_task_subscribe_dep(&schedule->super, &task->super,
+                               UCC_EVENT_SCHEDULE_STARTED);
+    }
+    schedule->super.finalize = ucc_tl_ucp_allreduce_dbt_frag_finalize;
+    schedule->super.post     = ucc_tl_ucp_allreduce_dbt_frag_start;
+    *frag_p                  = schedule;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_allreduce_dbt_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+    ucc_status_t status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(schedule, "ucp_allreduce_dbt_done", 0);
+    status = ucc_schedule_pipelined_finalize(task);
+    ucc_tl_ucp_put_schedule_pipelined(schedule);
+    return status;
+}
+
+static ucc_status_t ucc_tl_ucp_allreduce_dbt_start(ucc_coll_task_t *task)
+{
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(task, "ucp_allreduce_dbt_start", 0);
+    return ucc_schedule_pipelined_post(task);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_dbt_init(ucc_base_coll_args_t *coll_args,
+                                           ucc_base_team_t      *team,
+                                           ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t        *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_lib_config_t  *cfg     = &UCC_TL_UCP_TEAM_LIB(tl_team)->cfg;
+    size_t                    count   = coll_args->args.dst.info.count;
+    size_t                    msgsize =
+        count * ucc_dt_size(coll_args->args.dst.info.datatype);
+    ucc_schedule_pipelined_t *schedule_p;
+    int                       n_frags, pipeline_depth;
+    ucc_status_t              status;
+
+    ALLREDUCE_TASK_CHECK(coll_args->args, tl_team);
+    n_frags = 1;
+    if (cfg->allreduce_dbt_frag_size > 0 &&
+        msgsize > cfg->allreduce_dbt_frag_size) {
+        /* fragments are not smaller than a single element */
+        n_frags = ucc_min(ucc_div_round_up(msgsize,
+                                           cfg->allreduce_dbt_frag_size),
+                          count);
+    }
+    pipeline_depth = ucc_max(ucc_min(n_frags, cfg->allreduce_dbt_pipeline_depth),
+                             1);
+
+    schedule_p = ucc_tl_ucp_get_schedule_pipelined(tl_team);
+    if (!schedule_p) {
+        tl_error(team->context->lib, "failed to allocate pipelined schedule");
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = ucc_schedule_pipelined_init(
+        coll_args, team, ucc_tl_ucp_allreduce_dbt_frag_init,
+        ucc_tl_ucp_allreduce_dbt_frag_setup, pipeline_depth, n_frags, 0,
+        schedule_p);
+    if (UCC_OK != status) {
+        tl_error(team->context->lib, "failed to init pipelined schedule");
+        ucc_tl_ucp_put_schedule_pipelined(schedule_p);
+        return status;
+    }
+    schedule_p->super.super.finalize       = ucc_tl_ucp_allreduce_dbt_finalize;
+    schedule_p->super.super.triggered_post = ucc_triggered_post;
+    schedule_p->super.super.post           = ucc_tl_ucp_allreduce_dbt_start;
+    *task_h                                = &schedule_p->super.super;
+out:
+    return status;
+}
@@ -167,6 +167,19 @@ out:
     return task->super.super.status;
 }
 
+static inline ucc_kn_radix_t
+ucc_tl_ucp_allreduce_knomial_radix(ucc_tl_ucp_task_t *task)
+{
+    size_t     data_size = TASK_ARGS(task).dst.info.count *
+                           ucc_dt_size(TASK_ARGS(task).dst.info.datatype);
+    ucc_rank_t size      = (ucc_rank_t)task->subset.map.ep_num;
+
+    return ucc_min(ucc_tl_ucp_kn_radix(TASK_TEAM(task), &task->super.bargs,
+                                       TASK_LIB(task)->cfg.allreduce_kn_radix,
+                                       UCC_KN_MODEL_RECURSIVE, size, data_size),
+                   size);
+}
+
 ucc_status_t ucc_tl_ucp_allreduce_knomial_start(ucc_coll_task_t *coll_task)
 {
     ucc_tl_ucp_task_t *task      = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
@@ -181,8 +194,7 @@ ucc_status_t ucc_tl_ucp_allreduce_knomial_start(ucc_coll_task_t *coll_task)
                (TASK_ARGS(task).src.info.mem_type ==
                TASK_ARGS(task).dst.info.mem_type));
     ucc_knomial_pattern_init(size, rank,
-                             ucc_min(UCC_TL_UCP_TEAM_LIB(team)->
-                                     cfg.allreduce_kn_radix, size),
+                             ucc_tl_ucp_allreduce_knomial_radix(task),
                              &task->allreduce_kn.p);
     ucc_tl_ucp_task_reset(task);
     task->super.super.status = UCC_INPROGRESS;
@@ -199,9 +211,7 @@ ucc_status_t ucc_tl_ucp_allreduce_knomial_init_common(ucc_tl_ucp_task_t *task)
     size_t             count     = TASK_ARGS(task).dst.info.count;
     ucc_datatype_t     dt        = TASK_ARGS(task).dst.info.datatype;
     size_t             data_size = count * ucc_dt_size(dt);
-    ucc_rank_t         size      = (ucc_rank_t)task->subset.map.ep_num;
-    ucc_kn_radix_t     radix =
-        ucc_min(TASK_LIB(task)->cfg.allreduce_kn_radix, size);
+    ucc_kn_radix_t     radix     = ucc_tl_ucp_allreduce_knomial_radix(task);
     ucc_status_t       status;
 
     task->super.post     = ucc_tl_ucp_allreduce_knomial_start;
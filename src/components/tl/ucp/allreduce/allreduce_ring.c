@@ -0,0 +1,274 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "allreduce.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Ring allreduce: ring reduce-scatter followed by ring allgather.
+   Buffer is split into team size blocks, every block is split into n_segs
+   segments. Reduce-scatter is progressed by units (step x segment): the
+   transfer of unit k + 1 is posted before the reduction of unit k so that
+   the reduction overlaps the communication. Two scratch segments are used
+   in turns for the incoming data. */
+
+static inline void
+ucc_tl_ucp_allreduce_ring_seg(ucc_tl_ucp_task_t *task, ucc_rank_t block,
+                              uint32_t seg, size_t *offset, size_t *count)
+{
+    size_t     total   = TASK_ARGS(task).dst.info.count;
+    ucc_rank_t size    = (ucc_rank_t)task->subset.map.ep_num;
+    size_t     b_count = ucc_buffer_block_count(total, size, block);
+    uint32_t   n_segs  = task->allreduce_ring.n_segs;
+
+    *offset = ucc_buffer_block_offset(total, size, block) +
+              ucc_buffer_block_offset(b_count, n_segs, seg);
+    *count  = ucc_buffer_block_count(b_count, n_segs, seg);
+}
+
+static ucc_status_t ucc_tl_ucp_allreduce_ring_post_unit(ucc_tl_ucp_task_t *task,
+                                                        uint32_t unit)
+{
+    ucc_coll_args_t   *args     = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_rank_t         size     = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         rank     = task->subset.myrank;
+    uint32_t           n_segs   = task->allreduce_ring.n_segs;
+    ucc_rank_t         step     = unit / n_segs;
+    uint32_t           seg      = unit % n_segs;
+    ucc_memory_type_t  mem_type = args->dst.info.mem_type;
+    size_t             dt_size  = ucc_dt_size(args->dst.info.datatype);
+    ucc_rank_t         sendto   = ucc_ep_map_eval(task->subset.map,
+                                                  (rank + 1) % size);
+    ucc_rank_t         recvfrom = ucc_ep_map_eval(task->subset.map,
+                                                  (rank - 1 + size) % size);
+    void              *sbuf;
+    void              *scratch;
+    size_t             offset, count;
+    ucc_status_t       status;
+
+    /* first step sends the local data, next steps send the block reduced
+       at the previous step */
+    sbuf = (step == 0 && !UCC_IS_INPLACE(*args)) ? args->src.info.buffer
+                                                 : args->dst.info.buffer;
+    ucc_tl_ucp_allreduce_ring_seg(task, (rank - step + size) % size, seg,
+                                  &offset, &count);
+    status = ucc_tl_ucp_send_nb(PTR_OFFSET(sbuf, offset * dt_size),
+                                count * dt_size, mem_type, sendto, team, task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    scratch = PTR_OFFSET(task->allreduce_ring.scratch,
+                         (unit % 2) * task->allreduce_ring.scratch_seg_size);
+    ucc_tl_ucp_allreduce_ring_seg(task, (rank - step - 1 + size) % size, seg,
+                                  &offset, &count);
+    return ucc_tl_ucp_recv_nb(scratch, count * dt_size, mem_type, recvfrom,
+                              team, task);
+}
+
+static ucc_status_t
+ucc_tl_ucp_allreduce_ring_reduce_unit(ucc_tl_ucp_task_t *task, uint32_t unit)
+{
+    ucc_coll_args_t *args    = &TASK_ARGS(task);
+    ucc_rank_t       size    = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t       rank    = task->subset.myrank;
+    uint32_t         n_segs  = task->allreduce_ring.n_segs;
+    ucc_rank_t       step    = unit / n_segs;
+    ucc_datatype_t   dt      = args->dst.info.datatype;
+    size_t           dt_size = ucc_dt_size(dt);
+    void            *sbuf    = UCC_IS_INPLACE(*args) ? args->dst.info.buffer
+                                                     : args->src.info.buffer;
+    void            *scratch;
+    size_t           offset, count;
+    int              is_avg;
+
+    ucc_tl_ucp_allreduce_ring_seg(task, (rank - step - 1 + size) % size,
+                                  unit % n_segs, &offset, &count);
+    if (count == 0) {
+        return UCC_OK;
+    }
+    scratch = PTR_OFFSET(task->allreduce_ring.scratch,
+                         (unit % 2) * task->allreduce_ring.scratch_seg_size);
+    is_avg  = args->op == UCC_OP_AVG && step == size - 2;
+    return ucc_tl_ucp_reduce_multi(
+        PTR_OFFSET(sbuf, offset * dt_size), scratch,
+        PTR_OFFSET(args->dst.info.buffer, offset * dt_size), 1, count,
+        count * dt_size, dt, args->dst.info.mem_type, task, is_avg);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task     = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args     = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_rank_t         size     = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         rank     = task->subset.myrank;
+    uint32_t           n_segs   = task->allreduce_ring.n_segs;
+    uint32_t           n_units  = (size - 1) * n_segs;
+    void              *rbuf     = args->dst.info.buffer;
+    ucc_memory_type_t  mem_type = args->dst.info.mem_type;
+    size_t             dt_size  = ucc_dt_size(args->dst.info.datatype);
+    size_t             total    = args->dst.info.count;
+    ucc_rank_t         sendto   = ucc_ep_map_eval(task->subset.map,
+                                                  (rank + 1) % size);
+    ucc_rank_t         recvfrom = ucc_ep_map_eval(task->subset.map,
+                                                  (rank - 1 + size) % size);
+    ucc_rank_t         step, block;
+    uint32_t           unit;
+    ucc_status_t       status;
+
+    /* reduce-scatter: units up to "unit" are posted, "unit" is not reduced */
+    while ((unit = task->allreduce_ring.unit) < n_units) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        if (n_segs > 1 && unit + 1 < n_units) {
+            UCPCHECK_GOTO(ucc_tl_ucp_allreduce_ring_post_unit(task, unit + 1),
+                          task, out);
+        }
+        status = ucc_tl_ucp_allreduce_ring_reduce_unit(task, unit);
+        if (ucc_unlikely(UCC_OK != status)) {
+            tl_error(UCC_TASK_LIB(task), "failed to perform dt reduction");
+            task->super.super.status = status;
+            return status;
+        }
+        if (n_segs == 1 && unit + 1 < n_units) {
+            /* next send depends on the reduction of this unit */
+            UCPCHECK_GOTO(ucc_tl_ucp_allreduce_ring_post_unit(task, unit + 1),
+                          task, out);
+        }
+        task->allreduce_ring.unit++;
+    }
+
+    /* allgather: rank owns the reduced block rank + 1 */
+    while ((step = task->allreduce_ring.unit - n_units) < size - 1) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        block = (rank + 1 - step + size) % size;
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_send_nb(
+                PTR_OFFSET(rbuf, ucc_buffer_block_offset(total, size, block) *
+                                     dt_size),
+                ucc_buffer_block_count(total, size, block) * dt_size, mem_type,
+                sendto, team, task),
+            task, out);
+        block = (rank - step + size) % size;
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_recv_nb(
+                PTR_OFFSET(rbuf, ucc_buffer_block_offset(total, size, block) *
+                                     dt_size),
+                ucc_buffer_block_count(total, size, block) * dt_size, mem_type,
+                recvfrom, team, task),
+            task, out);
+        task->allreduce_ring.unit++;
+    }
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allreduce_ring_done", 0);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_allreduce_ring_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    task->allreduce_ring.unit = 0;
+
+    if (task->subset.map.ep_num == 1) {
+        if (!UCC_IS_INPLACE(*args)) {
+            status = ucc_mc_memcpy(args->dst.info.buffer,
+                                   args->src.info.buffer,
+                                   args->dst.info.count *
+                                       ucc_dt_size(args->dst.info.datatype),
+                                   args->dst.info.mem_type,
+                                   args->src.info.mem_type);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return ucc_task_complete(coll_task);
+    }
+    status = ucc_tl_ucp_allreduce_ring_post_unit(task, 0);
+    if (ucc_unlikely(UCC_OK != status)) {
+        task->super.super.status = status;
+        return status;
+    }
+    status = ucc_tl_ucp_allreduce_ring_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->allreduce_ring.scratch_mc_header) {
+        global_st = ucc_mc_free(task->allreduce_ring.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+ucc_status_t ucc_tl_ucp_allreduce_ring_init_common(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t *args      = &TASK_ARGS(task);
+    ucc_rank_t       size      = (ucc_rank_t)task->subset.map.ep_num;
+    size_t           dt_size   = ucc_dt_size(args->dst.info.datatype);
+    size_t           seg_size  = TASK_LIB(task)->cfg.allreduce_ring_seg_size;
+    size_t           max_block = ucc_buffer_block_count(args->dst.info.count,
+                                                        size, 0);
+    size_t           seg_count = ucc_max(seg_size / dt_size, 1);
+    uint32_t         n_segs;
+    ucc_status_t     status;
+
+    n_segs = ucc_max((max_block + seg_count - 1) / seg_count, 1);
+    task->allreduce_ring.n_segs            = n_segs;
+    task->allreduce_ring.scratch_seg_size  =
+        ucc_buffer_block_count(max_block, n_segs, 0) * dt_size;
+    task->allreduce_ring.scratch_mc_header = NULL;
+    task->super.post     = ucc_tl_ucp_allreduce_ring_start;
+    task->super.progress = ucc_tl_ucp_allreduce_ring_progress;
+    task->super.finalize = ucc_tl_ucp_allreduce_ring_finalize;
+    if (size == 1 || task->allreduce_ring.scratch_seg_size == 0) {
+        return UCC_OK;
+    }
+    status = ucc_mc_alloc(&task->allreduce_ring.scratch_mc_header,
+                          (n_segs > 1 ? 2 : 1) *
+                              task->allreduce_ring.scratch_seg_size,
+                          args->dst.info.mem_type);
+    if (ucc_unlikely(status != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+        return status;
+    }
+    task->allreduce_ring.scratch =
+        task->allreduce_ring.scratch_mc_header->addr;
+    return UCC_OK;
+}
@@ -62,7 +62,7 @@ static ucc_status_t ucc_tl_ucp_allreduce_sra_knomial_frag_setup(
     ucc_datatype_t   dt      = args->dst.info.datatype;
     size_t           dt_size = ucc_dt_size(dt);
     ucc_coll_args_t *targs;
-    int              n_frags    = schedule_p->super.n_tasks;
+    int              n_frags    = schedule_p->n_frags_total;
     size_t           frag_count = args->dst.info.count / n_frags;
     size_t           left       = args->dst.info.count % n_frags;
     size_t           offset     = frag_num * frag_count + left;
@@ -103,7 +103,11 @@ static ucc_status_t ucc_tl_ucp_allreduce_sra_knomial_frag_init(
     ucc_status_t         status;
     ucc_kn_radix_t       radix, cfg_radix;
 
-    cfg_radix = UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.allreduce_sra_kn_radix;
+    cfg_radix = ucc_tl_ucp_kn_radix(
+        tl_team, coll_args,
+        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.allreduce_sra_kn_radix,
+        UCC_KN_MODEL_SRA, UCC_TL_TEAM_SIZE(tl_team),
+        count * ucc_dt_size(coll_args->args.dst.info.datatype));
     radix = ucc_knomial_pattern_get_min_radix(cfg_radix,
                                               UCC_TL_TEAM_SIZE(tl_team), count);
 
@@ -24,6 +24,11 @@ ucc_base_coll_alg_info_t
             {.id   = UCC_TL_UCP_ALLTOALL_ALG_ONESIDED,
              .name = "onesided",
              .desc = "naive, linear one-sided implementation"},
+        [UCC_TL_UCP_ALLTOALL_ALG_BRUCK] =
+            {.id   = UCC_TL_UCP_ALLTOALL_ALG_BRUCK,
+             .name = "bruck",
+             .desc = "O(log N) radix-r Bruck with packed staging buffers "
+                     "(latency oriented alg)"},
         [UCC_TL_UCP_ALLTOALL_ALG_LAST] = {.id = 0, .name = NULL, .desc = NULL}};
 
 ucc_status_t ucc_tl_ucp_alltoall_init(ucc_tl_ucp_task_t *task)
@@ -80,8 +85,30 @@ ucc_status_t ucc_tl_ucp_alltoall_onesided_init(ucc_base_coll_args_t *coll_args,
     *task_h              = &task->super;
     task->super.post     = ucc_tl_ucp_alltoall_onesided_start;
     task->super.progress = ucc_tl_ucp_alltoall_onesided_progress;
+    /* completion is detected by polling pSync */
+    ucc_tl_ucp_task_set_polling(task);
     status               = UCC_OK;
 out:
     return status;
 }
 
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    ALLTOALL_TASK_CHECK(coll_args->args, tl_team);
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_alltoall_bruck_init_common(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        goto out;
+    }
+    *task_h = &task->super;
+out:
+    return status;
+}
@@ -13,13 +13,18 @@
 enum {
     UCC_TL_UCP_ALLTOALL_ALG_PAIRWISE,
     UCC_TL_UCP_ALLTOALL_ALG_ONESIDED,
+    UCC_TL_UCP_ALLTOALL_ALG_BRUCK,
     UCC_TL_UCP_ALLTOALL_ALG_LAST
 };
 
 extern ucc_base_coll_alg_info_t
     ucc_tl_ucp_alltoall_algs[UCC_TL_UCP_ALLTOALL_ALG_LAST + 1];
 
-#define UCC_TL_UCP_ALLTOALL_DEFAULT_ALG_SELECT_STR "alltoall:0-inf:@0"
+/* Bruck is used when per-peer blocks are small: total size up to 1k on
+   small teams and up to 64k on teams of 64+ ranks */
+#define UCC_TL_UCP_ALLTOALL_DEFAULT_ALG_SELECT_STR                             \
+    "alltoall:0-1k:[1-63]:@2#alltoall:1k-inf:[1-63]:@0#"                       \
+    "alltoall:0-64k:[64-inf]:@2#alltoall:64k-inf:[64-inf]:@0"
 
 ucc_status_t ucc_tl_ucp_alltoall_init(ucc_tl_ucp_task_t *task);
 
@@ -33,6 +38,12 @@ ucc_status_t ucc_tl_ucp_alltoall_onesided_init(ucc_base_coll_args_t *coll_args,
                                                ucc_base_team_t *     team,
                                                ucc_coll_task_t **    task_h);
 
+ucc_status_t ucc_tl_ucp_alltoall_bruck_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_init_common(ucc_tl_ucp_task_t *task);
+
 #define ALLTOALL_CHECK_INPLACE(_args, _team)                \
     do {                                                    \
         if (UCC_IS_INPLACE(_args)) {                        \
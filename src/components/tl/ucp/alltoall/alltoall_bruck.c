@@ -0,0 +1,228 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "alltoall.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "utils/ucc_math.h"
+#include "tl_ucp_sendrecv.h"
+
+/* Radix-r Bruck alltoall, O(log_r N) steps:
+   1. local rotation: tmp[i] = src[(rank + i) % N]
+   2. step with distance dist = r^k: for every digit d = 1..r-1 the blocks
+      whose k-th digit (base r) is d are packed and sent to rank + d * dist,
+      the blocks received from rank - d * dist replace them in tmp
+   3. inverse rotation: dst[(rank - i) % N] = tmp[i]
+   Blocks with the same digit come in runs of dist consecutive blocks, so
+   pack/unpack copy whole runs. Scratch holds tmp and the send/recv staging
+   buffers, N blocks each. */
+
+static inline void ucc_tl_ucp_alltoall_bruck_copy(void *dst, const void *src,
+                                                  size_t            len,
+                                                  ucc_memory_type_t mem_type)
+{
+    if (mem_type == UCC_MEMORY_TYPE_HOST) {
+        memcpy(dst, src, len);
+    } else {
+        ucc_mc_memcpy(dst, src, len, mem_type, mem_type);
+    }
+}
+
+/* Packs (or unpacks if !pack) the blocks of tmp with digit d at distance
+   dist into/from stage, returns the number of blocks */
+static inline ucc_rank_t
+ucc_tl_ucp_alltoall_bruck_pack(void *tmp, void *stage, ucc_rank_t size,
+                               ucc_rank_t dist, ucc_rank_t radix,
+                               ucc_rank_t d, size_t block_size,
+                               ucc_memory_type_t mem_type, int pack)
+{
+    ucc_rank_t n = 0;
+    ucc_rank_t i, run;
+
+    for (i = d * dist; i < size; i += dist * radix) {
+        run = ucc_min(dist, size - i);
+        if (pack) {
+            ucc_tl_ucp_alltoall_bruck_copy(PTR_OFFSET(stage, n * block_size),
+                                           PTR_OFFSET(tmp, i * block_size),
+                                           run * block_size, mem_type);
+        } else {
+            ucc_tl_ucp_alltoall_bruck_copy(PTR_OFFSET(tmp, i * block_size),
+                                           PTR_OFFSET(stage, n * block_size),
+                                           run * block_size, mem_type);
+        }
+        n += run;
+    }
+    return n;
+}
+
+static void ucc_tl_ucp_alltoall_bruck_unpack_step(ucc_tl_ucp_task_t *task,
+                                                  size_t block_size)
+{
+    ucc_rank_t        size     = UCC_TL_TEAM_SIZE(TASK_TEAM(task));
+    ucc_rank_t        dist     = task->alltoall_bruck.dist;
+    ucc_rank_t        radix    = task->alltoall_bruck.radix;
+    ucc_memory_type_t mem_type = TASK_ARGS(task).dst.info.mem_type;
+    void             *tmp      = task->alltoall_bruck.scratch;
+    void             *rstage   = PTR_OFFSET(tmp, 2 * size * block_size);
+    ucc_rank_t        d;
+
+    for (d = 1; d < radix && d * dist < size; d++) {
+        rstage = PTR_OFFSET(rstage, ucc_tl_ucp_alltoall_bruck_pack(
+                                        tmp, rstage, size, dist, radix, d,
+                                        block_size, mem_type, 0) *
+                                        block_size);
+    }
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task       = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = TASK_TEAM(task);
+    ucc_rank_t         rank       = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         size       = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         radix      = task->alltoall_bruck.radix;
+    ucc_memory_type_t  mem_type   = TASK_ARGS(task).dst.info.mem_type;
+    size_t             block_size = (TASK_ARGS(task).src.info.count / size) *
+                                    ucc_dt_size(TASK_ARGS(task).src.info.datatype);
+    void              *tmp        = task->alltoall_bruck.scratch;
+    void              *sstage, *rstage;
+    ucc_rank_t         dist, d, n;
+    size_t             len;
+
+    while (1) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        if (task->alltoall_bruck.posted) {
+            ucc_tl_ucp_alltoall_bruck_unpack_step(task, block_size);
+            task->alltoall_bruck.posted = 0;
+            task->alltoall_bruck.dist *= radix;
+        }
+        if ((dist = task->alltoall_bruck.dist) >= size) {
+            break;
+        }
+        sstage = PTR_OFFSET(tmp, size * block_size);
+        rstage = PTR_OFFSET(tmp, 2 * size * block_size);
+        for (d = 1; d < radix && d * dist < size; d++) {
+            n   = ucc_tl_ucp_alltoall_bruck_pack(tmp, sstage, size, dist, radix,
+                                                 d, block_size, mem_type, 1);
+            len = n * block_size;
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(sstage, len, mem_type,
+                                             (rank + d * dist) % size, team,
+                                             task),
+                          task, out);
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(rstage, len, mem_type,
+                                             (rank - d * dist + size) % size,
+                                             team, task),
+                          task, out);
+            sstage = PTR_OFFSET(sstage, len);
+            rstage = PTR_OFFSET(rstage, len);
+        }
+        task->alltoall_bruck.posted = 1;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    /* inverse rotation: tmp[i] -> dst[(rank - i) % size] */
+    for (n = 0; n < size; n++) {
+        ucc_tl_ucp_alltoall_bruck_copy(
+            PTR_OFFSET(TASK_ARGS(task).dst.info.buffer,
+                       ((rank - n + size) % size) * block_size),
+            PTR_OFFSET(tmp, n * block_size), block_size, mem_type);
+    }
+    task->super.super.status = UCC_OK;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_alltoall_bruck_done", 0);
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task       = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team       = TASK_TEAM(task);
+    ucc_rank_t         rank       = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         size       = UCC_TL_TEAM_SIZE(team);
+    void              *sbuf       = TASK_ARGS(task).src.info.buffer;
+    ucc_memory_type_t  smem       = TASK_ARGS(task).src.info.mem_type;
+    ucc_memory_type_t  rmem       = TASK_ARGS(task).dst.info.mem_type;
+    size_t             block_size = (TASK_ARGS(task).src.info.count / size) *
+                                    ucc_dt_size(TASK_ARGS(task).src.info.datatype);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_alltoall_bruck_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    task->alltoall_bruck.dist   = 1;
+    task->alltoall_bruck.posted = 0;
+
+    /* local rotation: src[(rank + i) % size] -> tmp[i] */
+    status = ucc_mc_memcpy(task->alltoall_bruck.scratch,
+                           PTR_OFFSET(sbuf, rank * block_size),
+                           (size - rank) * block_size, rmem, smem);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    if (rank > 0) {
+        status = ucc_mc_memcpy(PTR_OFFSET(task->alltoall_bruck.scratch,
+                                          (size - rank) * block_size),
+                               sbuf, rank * block_size, rmem, smem);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+
+    status = ucc_tl_ucp_alltoall_bruck_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st;
+
+    global_st = ucc_mc_free(task->alltoall_bruck.scratch_mc_header);
+    if (ucc_unlikely(global_st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+ucc_status_t ucc_tl_ucp_alltoall_bruck_init_common(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_rank_t         radix = UCC_TL_UCP_TEAM_LIB(team)->cfg.alltoall_bruck_radix;
+    ucc_status_t       status;
+
+    if (task->super.bargs.mask & UCC_BASE_CARGS_RADIX) {
+        radix = task->super.bargs.radix;
+    }
+    task->alltoall_bruck.radix = ucc_max(ucc_min(radix, size), 2);
+    status = ucc_mc_alloc(&task->alltoall_bruck.scratch_mc_header,
+                          ucc_max(3 * args->src.info.count *
+                                      ucc_dt_size(args->src.info.datatype),
+                                  1),
+                          args->dst.info.mem_type);
+    if (ucc_unlikely(UCC_OK != status)) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+        return status;
+    }
+    task->alltoall_bruck.scratch =
+        task->alltoall_bruck.scratch_mc_header->addr;
+    task->super.post     = ucc_tl_ucp_alltoall_bruck_start;
+    task->super.progress = ucc_tl_ucp_alltoall_bruck_progress;
+    task->super.finalize = ucc_tl_ucp_alltoall_bruck_finalize;
+    return UCC_OK;
+}
@@ -11,6 +11,23 @@
 ucc_status_t ucc_tl_ucp_alltoallv_pairwise_start(ucc_coll_task_t *task);
 ucc_status_t ucc_tl_ucp_alltoallv_pairwise_progress(ucc_coll_task_t *task);
 
+ucc_base_coll_alg_info_t
+    ucc_tl_ucp_alltoallv_algs[UCC_TL_UCP_ALLTOALLV_ALG_LAST + 1] = {
+        [UCC_TL_UCP_ALLTOALLV_ALG_PAIRWISE] =
+            {.id   = UCC_TL_UCP_ALLTOALLV_ALG_PAIRWISE,
+             .name = "pairwise",
+             .desc = "pairwise two-sided implementation"},
+        [UCC_TL_UCP_ALLTOALLV_ALG_SPARSE] =
+            {.id   = UCC_TL_UCP_ALLTOALLV_ALG_SPARSE,
+             .name = "sparse",
+             .desc = "pairwise exchange with non zero count peers only"},
+        [UCC_TL_UCP_ALLTOALLV_ALG_NODE] =
+            {.id   = UCC_TL_UCP_ALLTOALLV_ALG_NODE,
+             .name = "node",
+             .desc = "node aggregated: gather to node leaders, leader "
+                     "exchange, scatter from leaders (host memory only)"},
+        [UCC_TL_UCP_ALLTOALLV_ALG_LAST] = {.id = 0, .name = NULL, .desc = NULL}};
+
 ucc_status_t ucc_tl_ucp_alltoallv_init(ucc_tl_ucp_task_t *task)
 {
     ucc_status_t status;
@@ -36,3 +53,43 @@ ucc_status_t ucc_tl_ucp_alltoallv_pairwise_init(ucc_base_coll_args_t *coll_args,
 out:
     return status;
 }
+
+ucc_status_t ucc_tl_ucp_alltoallv_sparse_init(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    ALLTOALLV_TASK_CHECK(coll_args->args, tl_team);
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_alltoallv_sparse_init_common(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        goto out;
+    }
+    *task_h = &task->super;
+out:
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_node_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    ALLTOALLV_TASK_CHECK(coll_args->args, tl_team);
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_alltoallv_node_init_common(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        goto out;
+    }
+    *task_h = &task->super;
+out:
+    return status;
+}
@@ -10,6 +10,16 @@
 #include "../tl_ucp.h"
 #include "../tl_ucp_coll.h"
 
+enum {
+    UCC_TL_UCP_ALLTOALLV_ALG_PAIRWISE,
+    UCC_TL_UCP_ALLTOALLV_ALG_SPARSE,
+    UCC_TL_UCP_ALLTOALLV_ALG_NODE,
+    UCC_TL_UCP_ALLTOALLV_ALG_LAST
+};
+
+extern ucc_base_coll_alg_info_t
+    ucc_tl_ucp_alltoallv_algs[UCC_TL_UCP_ALLTOALLV_ALG_LAST + 1];
+
 ucc_status_t ucc_tl_ucp_alltoallv_init(ucc_tl_ucp_task_t *task);
 
 ucc_status_t ucc_tl_ucp_alltoallv_pairwise_init(ucc_base_coll_args_t *coll_args,
@@ -18,6 +28,18 @@ ucc_status_t ucc_tl_ucp_alltoallv_pairwise_init(ucc_base_coll_args_t *coll_args,
 
 ucc_status_t ucc_tl_ucp_alltoallv_pairwise_init_common(ucc_tl_ucp_task_t *task);
 
+ucc_status_t ucc_tl_ucp_alltoallv_sparse_init(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_alltoallv_sparse_init_common(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_alltoallv_node_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_alltoallv_node_init_common(ucc_tl_ucp_task_t *task);
+
 #define ALLTOALLV_CHECK_INPLACE(_args, _team)               \
     do {                                                    \
         if (UCC_IS_INPLACE(_args)) {                        \
@@ -43,4 +65,15 @@ ucc_status_t ucc_tl_ucp_alltoallv_pairwise_init_common(ucc_tl_ucp_task_t *task);
     ALLTOALLV_CHECK_INPLACE((_args), (_team));          \
     ALLTOALLV_CHECK_USERDEFINED_DT((_args), (_team));
 
+static inline int ucc_tl_ucp_alltoallv_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_TL_UCP_ALLTOALLV_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_tl_ucp_alltoallv_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
+
 #endif
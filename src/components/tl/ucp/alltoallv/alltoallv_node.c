@@ -0,0 +1,650 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "alltoallv.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_team.h"
+#include "components/topo/ucc_topo.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "tl_ucp_sendrecv.h"
+
+/* Node aggregated alltoallv: the number of messages goes from size^2 down
+   to nnodes^2 + 2 * size.
+   1. every rank sends its byte counts and its send data packed in the
+      team rank order to the leader (lowest team rank) of its node
+   2. leaders exchange the counts and then the data of the blocks between
+      their nodes, the block for node b holds rows of the local ranks and
+      columns of the ranks of b
+   3. leader sends to every local rank the data destined to it packed in
+      the source team rank order, the rank unpacks it with its own recv
+      counts and displacements
+   Zero size data messages are skipped, the counts are always sent.
+
+   Team map (ucc_rank_t): ranks[size] - team ranks grouped by node,
+   pos[size] - position of the team rank in ranks, node_of[size],
+   node_start[nnodes + 1].
+   Leader metadata (uint64_t, bytes):
+   hdr[lsize][size]  - counts of the local ranks
+   cnt[size][lsize]  - counts from every rank (rows in ranks order) to the
+                       local ranks
+   soff[size][lsize] - offset of the (rank, local rank) block in gather or
+                       exchange buffer, holds the counts sent to the other
+                       leaders during the step 2 counts exchange
+   goff[lsize + 1], xsoff[nnodes + 1], xroff[nnodes + 1], cur[nnodes] -
+                       offsets in gather, exchange send and recv buffers.
+   Non leader metadata is hdr[size] with its own counts. */
+
+enum {
+    UCC_TL_UCP_ALLTOALLV_NODE_PHASE_COUNTS,
+    UCC_TL_UCP_ALLTOALLV_NODE_PHASE_GATHER,
+    UCC_TL_UCP_ALLTOALLV_NODE_PHASE_EXCHANGE,
+    UCC_TL_UCP_ALLTOALLV_NODE_PHASE_SCATTER,
+    UCC_TL_UCP_ALLTOALLV_NODE_PHASE_UNPACK
+};
+
+#define NODE_BUF_GATHER   0
+#define NODE_BUF_EXCHANGE 1
+#define NODE_BUF_SCATTER  2
+#define NODE_BUF_LAST     3
+/* non leader ranks */
+#define NODE_BUF_SEND     0
+#define NODE_BUF_RECV     1
+
+typedef struct ucc_tl_ucp_alltoallv_node_ctx {
+    ucc_rank_t *ranks;
+    ucc_rank_t *pos;
+    ucc_rank_t *node_of;
+    ucc_rank_t *node_start;
+    ucc_rank_t  size;
+    ucc_rank_t  nnodes;
+    ucc_rank_t  node;
+    ucc_rank_t  ns;
+    ucc_rank_t  lsize;
+    uint64_t   *hdr;
+    uint64_t   *cnt;
+    uint64_t   *soff;
+    uint64_t   *goff;
+    uint64_t   *xsoff;
+    uint64_t   *xroff;
+    uint64_t   *cur;
+} ucc_tl_ucp_alltoallv_node_ctx_t;
+
+static inline void
+ucc_tl_ucp_alltoallv_node_ctx(ucc_tl_ucp_task_t               *task,
+                              ucc_tl_ucp_alltoallv_node_ctx_t *c)
+{
+    ucc_rank_t size = UCC_TL_TEAM_SIZE(TASK_TEAM(task));
+
+    c->size       = size;
+    c->nnodes     = task->alltoallv_node.nnodes;
+    c->node       = task->alltoallv_node.node;
+    c->ranks      = task->alltoallv_node.map;
+    c->pos        = c->ranks + size;
+    c->node_of    = c->pos + size;
+    c->node_start = c->node_of + size;
+    c->ns         = c->node_start[c->node];
+    c->lsize      = c->node_start[c->node + 1] - c->ns;
+    c->hdr        = task->alltoallv_node.meta;
+    c->cnt        = c->hdr + (size_t)c->lsize * size;
+    c->soff       = c->cnt + (size_t)size * c->lsize;
+    c->goff       = c->soff + (size_t)size * c->lsize;
+    c->xsoff      = c->goff + c->lsize + 1;
+    c->xroff      = c->xsoff + c->nnodes + 1;
+    c->cur        = c->xroff + c->nnodes + 1;
+}
+
+static inline ucc_rank_t
+ucc_tl_ucp_alltoallv_node_size(ucc_tl_ucp_alltoallv_node_ctx_t *c,
+                               ucc_rank_t                       node)
+{
+    return c->node_start[node + 1] - c->node_start[node];
+}
+
+static inline ucc_rank_t
+ucc_tl_ucp_alltoallv_node_leader(ucc_tl_ucp_alltoallv_node_ctx_t *c,
+                                 ucc_rank_t                       node)
+{
+    return c->ranks[c->node_start[node]];
+}
+
+static void *ucc_tl_ucp_alltoallv_node_alloc(ucc_tl_ucp_task_t *task, int idx,
+                                             size_t size)
+{
+    task->alltoallv_node.bufs[idx] =
+        ucc_malloc(ucc_max(size, 1), "alltoallv_node_buf");
+    if (!task->alltoallv_node.bufs[idx]) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes", size);
+    }
+    return task->alltoallv_node.bufs[idx];
+}
+
+static void ucc_tl_ucp_alltoallv_node_free_bufs(ucc_tl_ucp_task_t *task)
+{
+    int i;
+
+    for (i = 0; i < NODE_BUF_LAST; i++) {
+        ucc_free(task->alltoallv_node.bufs[i]);
+        task->alltoallv_node.bufs[i] = NULL;
+    }
+}
+
+/* Byte counts of the rank in the team rank order, returns the total */
+static size_t ucc_tl_ucp_alltoallv_node_counts(ucc_coll_args_t *args,
+                                               ucc_rank_t size, uint64_t *hdr)
+{
+    size_t     dt_size = ucc_dt_size(args->src.info_v.datatype);
+    size_t     total   = 0;
+    ucc_rank_t r;
+
+    for (r = 0; r < size; r++) {
+        hdr[r] = ucc_coll_args_get_count(args, args->src.info_v.counts, r) *
+                 dt_size;
+        total += hdr[r];
+    }
+    return total;
+}
+
+static void ucc_tl_ucp_alltoallv_node_pack(ucc_coll_args_t *args,
+                                           ucc_rank_t size, const uint64_t *hdr,
+                                           void *dst)
+{
+    size_t     dt_size = ucc_dt_size(args->src.info_v.datatype);
+    ucc_rank_t r;
+
+    for (r = 0; r < size; r++) {
+        memcpy(dst,
+               PTR_OFFSET(args->src.info_v.buffer,
+                          ucc_coll_args_get_displacement(
+                              args, args->src.info_v.displacements, r) *
+                              dt_size),
+               hdr[r]);
+        dst = PTR_OFFSET(dst, hdr[r]);
+    }
+}
+
+static void ucc_tl_ucp_alltoallv_node_unpack(ucc_coll_args_t *args,
+                                             ucc_rank_t size, const void *src)
+{
+    size_t     dt_size = ucc_dt_size(args->dst.info_v.datatype);
+    ucc_rank_t r;
+    size_t     len;
+
+    for (r = 0; r < size; r++) {
+        len = ucc_coll_args_get_count(args, args->dst.info_v.counts, r) *
+              dt_size;
+        memcpy(PTR_OFFSET(args->dst.info_v.buffer,
+                          ucc_coll_args_get_displacement(
+                              args, args->dst.info_v.displacements, r) *
+                              dt_size),
+               src, len);
+        src = PTR_OFFSET(src, len);
+    }
+}
+
+/* Leader: counts of the local ranks arrived. Posts the recv of their data
+   and the exchange of the counts with the other leaders */
+static ucc_status_t ucc_tl_ucp_alltoallv_node_gather(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t              *team = TASK_TEAM(task);
+    ucc_tl_ucp_alltoallv_node_ctx_t c;
+    ucc_rank_t                      i, j, r, b, nb;
+    uint64_t                       *xhdr;
+    void                           *gbuf;
+
+    ucc_tl_ucp_alltoallv_node_ctx(task, &c);
+    for (i = 0; i < c.lsize; i++) {
+        c.goff[i + 1] = c.goff[i];
+        for (r = 0; r < c.size; r++) {
+            c.goff[i + 1] += c.hdr[i * c.size + r];
+        }
+        for (j = 0; j < c.lsize; j++) {
+            c.cnt[(c.ns + i) * c.lsize + j] =
+                c.hdr[i * c.size + c.ranks[c.ns + j]];
+        }
+    }
+    gbuf = ucc_tl_ucp_alltoallv_node_alloc(task, NODE_BUF_GATHER,
+                                           c.goff[c.lsize]);
+    if (!gbuf) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    ucc_tl_ucp_alltoallv_node_pack(&TASK_ARGS(task), c.size, c.hdr, gbuf);
+    for (i = 1; i < c.lsize; i++) {
+        if (c.goff[i + 1] > c.goff[i]) {
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(PTR_OFFSET(gbuf, c.goff[i]),
+                                             c.goff[i + 1] - c.goff[i],
+                                             UCC_MEMORY_TYPE_HOST,
+                                             c.ranks[c.ns + i], team, task),
+                          task, out);
+        }
+    }
+
+    /* block for node b: rows - local ranks, columns - ranks of b */
+    xhdr = c.soff;
+    for (i = 0; i < c.lsize; i++) {
+        for (r = 0; r < c.size; r++) {
+            b = c.node_of[r];
+            if (b == c.node) {
+                continue;
+            }
+            nb = ucc_tl_ucp_alltoallv_node_size(&c, b);
+            xhdr[(size_t)c.lsize * c.node_start[b] + i * nb +
+                 (c.pos[r] - c.node_start[b])] = c.hdr[i * c.size + r];
+        }
+    }
+    for (i = 1; i < c.nnodes; i++) {
+        b  = (c.node + i) % c.nnodes;
+        nb = ucc_tl_ucp_alltoallv_node_size(&c, b);
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_send_nb(xhdr + (size_t)c.lsize * c.node_start[b],
+                               (size_t)c.lsize * nb * sizeof(uint64_t),
+                               UCC_MEMORY_TYPE_HOST,
+                               ucc_tl_ucp_alltoallv_node_leader(&c, b), team,
+                               task),
+            task, out);
+        b  = (c.node - i + c.nnodes) % c.nnodes;
+        nb = ucc_tl_ucp_alltoallv_node_size(&c, b);
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_recv_nb(c.cnt + (size_t)c.node_start[b] * c.lsize,
+                               (size_t)nb * c.lsize * sizeof(uint64_t),
+                               UCC_MEMORY_TYPE_HOST,
+                               ucc_tl_ucp_alltoallv_node_leader(&c, b), team,
+                               task),
+            task, out);
+    }
+    task->alltoallv_node.phase = UCC_TL_UCP_ALLTOALLV_NODE_PHASE_GATHER;
+    return UCC_OK;
+out:
+    return task->super.super.status;
+}
+
+/* Leader: data of the local ranks and the counts of the other nodes
+   arrived. Packs and exchanges the blocks between the nodes */
+static ucc_status_t
+ucc_tl_ucp_alltoallv_node_exchange(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t              *team = TASK_TEAM(task);
+    ucc_tl_ucp_alltoallv_node_ctx_t c;
+    ucc_rank_t                      i, j, r, b, row;
+    uint64_t                        off, len;
+    void                           *gbuf, *xbuf, *xrbuf;
+
+    ucc_tl_ucp_alltoallv_node_ctx(task, &c);
+    gbuf = task->alltoallv_node.bufs[NODE_BUF_GATHER];
+    memset(c.cur, 0, c.nnodes * sizeof(uint64_t));
+    for (i = 0; i < c.lsize; i++) {
+        for (r = 0; r < c.size; r++) {
+            c.cur[c.node_of[r]] += c.hdr[i * c.size + r];
+        }
+    }
+    c.xsoff[0] = 0;
+    c.xroff[0] = 0;
+    for (b = 0; b < c.nnodes; b++) {
+        len = 0;
+        if (b != c.node) {
+            for (row = c.node_start[b]; row < c.node_start[b + 1]; row++) {
+                for (j = 0; j < c.lsize; j++) {
+                    len += c.cnt[row * c.lsize + j];
+                }
+            }
+        }
+        c.xroff[b + 1] = c.xroff[b] + len;
+        c.xsoff[b + 1] = c.xsoff[b] + ((b != c.node) ? c.cur[b] : 0);
+        c.cur[b]       = c.xsoff[b];
+    }
+    xbuf = ucc_tl_ucp_alltoallv_node_alloc(task, NODE_BUF_EXCHANGE,
+                                           c.xsoff[c.nnodes] +
+                                               c.xroff[c.nnodes]);
+    if (!xbuf) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    xrbuf = PTR_OFFSET(xbuf, c.xsoff[c.nnodes]);
+
+    /* rows are walked in order and ranks of a node are ascending, so the
+       blocks of every node are packed row major */
+    for (i = 0; i < c.lsize; i++) {
+        off = c.goff[i];
+        for (r = 0; r < c.size; r++) {
+            len = c.hdr[i * c.size + r];
+            b   = c.node_of[r];
+            if (b == c.node) {
+                c.soff[(c.ns + i) * c.lsize + c.pos[r] - c.ns] = off;
+            } else {
+                memcpy(PTR_OFFSET(xbuf, c.cur[b]), PTR_OFFSET(gbuf, off), len);
+                c.cur[b] += len;
+            }
+            off += len;
+        }
+    }
+    for (b = 0; b < c.nnodes; b++) {
+        if (b == c.node) {
+            continue;
+        }
+        off = c.xroff[b];
+        for (row = c.node_start[b]; row < c.node_start[b + 1]; row++) {
+            for (j = 0; j < c.lsize; j++) {
+                c.soff[row * c.lsize + j] = off;
+                off += c.cnt[row * c.lsize + j];
+            }
+        }
+    }
+
+    for (i = 1; i < c.nnodes; i++) {
+        b   = (c.node + i) % c.nnodes;
+        len = c.xsoff[b + 1] - c.xsoff[b];
+        if (len) {
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(
+                              PTR_OFFSET(xbuf, c.xsoff[b]), len,
+                              UCC_MEMORY_TYPE_HOST,
+                              ucc_tl_ucp_alltoallv_node_leader(&c, b), team,
+                              task),
+                          task, out);
+        }
+        b   = (c.node - i + c.nnodes) % c.nnodes;
+        len = c.xroff[b + 1] - c.xroff[b];
+        if (len) {
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(
+                              PTR_OFFSET(xrbuf, c.xroff[b]), len,
+                              UCC_MEMORY_TYPE_HOST,
+                              ucc_tl_ucp_alltoallv_node_leader(&c, b), team,
+                              task),
+                          task, out);
+        }
+    }
+    task->alltoallv_node.phase = UCC_TL_UCP_ALLTOALLV_NODE_PHASE_EXCHANGE;
+    return UCC_OK;
+out:
+    return task->super.super.status;
+}
+
+static inline void *
+ucc_tl_ucp_alltoallv_node_block(ucc_tl_ucp_task_t               *task,
+                                ucc_tl_ucp_alltoallv_node_ctx_t *c,
+                                ucc_rank_t src, ucc_rank_t j)
+{
+    void *buf = task->alltoallv_node.bufs[NODE_BUF_GATHER];
+
+    if (c->node_of[src] != c->node) {
+        buf = PTR_OFFSET(task->alltoallv_node.bufs[NODE_BUF_EXCHANGE],
+                         c->xsoff[c->nnodes]);
+    }
+    return PTR_OFFSET(buf, c->soff[c->pos[src] * c->lsize + j]);
+}
+
+/* Leader: all the data of the node arrived. Sends it to the local ranks in
+   the source rank order, own data goes to dst directly */
+static ucc_status_t ucc_tl_ucp_alltoallv_node_scatter(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t              *team = TASK_TEAM(task);
+    ucc_coll_args_t                *args = &TASK_ARGS(task);
+    size_t                          rdt  = ucc_dt_size(args->dst.info_v.datatype);
+    ucc_tl_ucp_alltoallv_node_ctx_t c;
+    ucc_rank_t                      j, s;
+    uint64_t                        total, start, len;
+    void                           *sbuf;
+
+    ucc_tl_ucp_alltoallv_node_ctx(task, &c);
+    total = 0;
+    for (s = 0; s < c.size; s++) {
+        for (j = 1; j < c.lsize; j++) {
+            total += c.cnt[s * c.lsize + j];
+        }
+    }
+    sbuf = ucc_tl_ucp_alltoallv_node_alloc(task, NODE_BUF_SCATTER, total);
+    if (!sbuf) {
+        return UCC_ERR_NO_MEMORY;
+    }
+    total = 0;
+    for (j = 1; j < c.lsize; j++) {
+        start = total;
+        for (s = 0; s < c.size; s++) {
+            len = c.cnt[c.pos[s] * c.lsize + j];
+            memcpy(PTR_OFFSET(sbuf, total),
+                   ucc_tl_ucp_alltoallv_node_block(task, &c, s, j), len);
+            total += len;
+        }
+        if (total > start) {
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(PTR_OFFSET(sbuf, start),
+                                             total - start,
+                                             UCC_MEMORY_TYPE_HOST,
+                                             c.ranks[c.ns + j], team, task),
+                          task, out);
+        }
+    }
+    for (s = 0; s < c.size; s++) {
+        memcpy(PTR_OFFSET(args->dst.info_v.buffer,
+                          ucc_coll_args_get_displacement(
+                              args, args->dst.info_v.displacements, s) *
+                              rdt),
+               ucc_tl_ucp_alltoallv_node_block(task, &c, s, 0),
+               c.cnt[c.pos[s] * c.lsize]);
+    }
+    task->alltoallv_node.phase = UCC_TL_UCP_ALLTOALLV_NODE_PHASE_SCATTER;
+    return UCC_OK;
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_node_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       status;
+
+    while (UCC_OK == ucc_tl_ucp_test(task)) {
+        switch (task->alltoallv_node.phase) {
+        case UCC_TL_UCP_ALLTOALLV_NODE_PHASE_COUNTS:
+            status = ucc_tl_ucp_alltoallv_node_gather(task);
+            break;
+        case UCC_TL_UCP_ALLTOALLV_NODE_PHASE_GATHER:
+            status = ucc_tl_ucp_alltoallv_node_exchange(task);
+            break;
+        case UCC_TL_UCP_ALLTOALLV_NODE_PHASE_EXCHANGE:
+            status = ucc_tl_ucp_alltoallv_node_scatter(task);
+            break;
+        case UCC_TL_UCP_ALLTOALLV_NODE_PHASE_UNPACK:
+            ucc_tl_ucp_alltoallv_node_unpack(
+                &TASK_ARGS(task), UCC_TL_TEAM_SIZE(TASK_TEAM(task)),
+                task->alltoallv_node.bufs[NODE_BUF_RECV]);
+            /* fall through */
+        default:
+            ucc_tl_ucp_alltoallv_node_free_bufs(task);
+            task->super.super.status = UCC_OK;
+            goto out;
+        }
+        if (ucc_unlikely(UCC_OK != status)) {
+            task->super.super.status = status;
+            goto out;
+        }
+    }
+    return task->super.super.status;
+out:
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_alltoallv_node_done", 0);
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_node_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t              *task = ucc_derived_of(coll_task,
+                                                          ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t              *team = TASK_TEAM(task);
+    ucc_coll_args_t                *args = &TASK_ARGS(task);
+    ucc_rank_t                      grank = UCC_TL_TEAM_RANK(team);
+    ucc_tl_ucp_alltoallv_node_ctx_t c;
+    ucc_rank_t                      i, leader;
+    size_t                          total;
+    void                           *buf;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_alltoallv_node_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    ucc_tl_ucp_alltoallv_node_ctx(task, &c);
+    leader = ucc_tl_ucp_alltoallv_node_leader(&c, c.node);
+
+    if (grank == leader) {
+        ucc_tl_ucp_alltoallv_node_counts(args, c.size, c.hdr);
+        c.goff[0] = 0;
+        for (i = 1; i < c.lsize; i++) {
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(c.hdr + (size_t)i * c.size,
+                                             c.size * sizeof(uint64_t),
+                                             UCC_MEMORY_TYPE_HOST,
+                                             c.ranks[c.ns + i], team, task),
+                          task, out);
+        }
+        task->alltoallv_node.phase = UCC_TL_UCP_ALLTOALLV_NODE_PHASE_COUNTS;
+    } else {
+        total = ucc_tl_ucp_alltoallv_node_counts(args, c.size, c.hdr);
+        buf   = ucc_tl_ucp_alltoallv_node_alloc(task, NODE_BUF_SEND, total);
+        if (!buf) {
+            return UCC_ERR_NO_MEMORY;
+        }
+        ucc_tl_ucp_alltoallv_node_pack(args, c.size, c.hdr, buf);
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(c.hdr, c.size * sizeof(uint64_t),
+                                         UCC_MEMORY_TYPE_HOST, leader, team,
+                                         task),
+                      task, out);
+        if (total) {
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(buf, total, UCC_MEMORY_TYPE_HOST,
+                                             leader, team, task),
+                          task, out);
+        }
+        total = ucc_coll_args_get_total_count(args, args->dst.info_v.counts,
+                                              c.size) *
+                ucc_dt_size(args->dst.info_v.datatype);
+        buf   = ucc_tl_ucp_alltoallv_node_alloc(task, NODE_BUF_RECV, total);
+        if (!buf) {
+            return UCC_ERR_NO_MEMORY;
+        }
+        if (total) {
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(buf, total, UCC_MEMORY_TYPE_HOST,
+                                             leader, team, task),
+                          task, out);
+        }
+        task->alltoallv_node.phase = UCC_TL_UCP_ALLTOALLV_NODE_PHASE_UNPACK;
+    }
+
+    ucc_tl_ucp_alltoallv_node_progress(&task->super);
+    if (UCC_INPROGRESS == task->super.super.status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+out:
+    return ucc_task_complete(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_node_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_tl_ucp_alltoallv_node_free_bufs(task);
+    ucc_free(task->alltoallv_node.meta);
+    ucc_free(task->alltoallv_node.map);
+    return ucc_tl_ucp_coll_finalize(&task->super);
+}
+
+/* Groups the team ranks by node, nodes are numbered in the order of their
+   lowest team rank, which is the node leader */
+static ucc_status_t ucc_tl_ucp_alltoallv_node_map_init(ucc_tl_ucp_task_t *task,
+                                                       ucc_topo_t        *topo)
+{
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         n_hosts = topo->topo->nnodes;
+    ucc_rank_t        *ranks, *pos, *node_of, *node_start;
+    ucc_rank_t         r, b, nnodes, ctx_rank, host;
+
+    ranks = ucc_malloc((3 * size + n_hosts + 1) * sizeof(ucc_rank_t),
+                       "alltoallv_node_map");
+    if (!ranks) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes for map",
+                 (3 * size + n_hosts + 1) * sizeof(ucc_rank_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    pos        = ranks + size;
+    node_of    = pos + size;
+    node_start = node_of + size;
+
+    /* node_start holds the node index of every host first */
+    for (r = 0; r < n_hosts; r++) {
+        node_start[r] = UCC_RANK_MAX;
+    }
+    nnodes = 0;
+    for (r = 0; r < size; r++) {
+        ctx_rank = ucc_ep_map_eval(topo->set.map,
+                                   ucc_ep_map_eval(UCC_TL_TEAM_MAP(team), r));
+        host     = topo->topo->procs[ctx_rank].host_id;
+        if (node_start[host] == UCC_RANK_MAX) {
+            node_start[host] = nnodes++;
+        }
+        node_of[r] = node_start[host];
+    }
+    memset(node_start, 0, (nnodes + 1) * sizeof(ucc_rank_t));
+    for (r = 0; r < size; r++) {
+        node_start[node_of[r] + 1]++;
+    }
+    for (b = 0; b < nnodes; b++) {
+        node_start[b + 1] += node_start[b];
+    }
+    /* pos is used as the fill counter of the node while ranks are placed */
+    for (r = 0; r < size; r++) {
+        b              = node_of[r];
+        pos[r]         = node_start[b];
+        ranks[pos[r]]  = r;
+        node_start[b] += 1;
+    }
+    for (b = nnodes; b > 0; b--) {
+        node_start[b] = node_start[b - 1];
+    }
+    node_start[0] = 0;
+
+    task->alltoallv_node.map    = ranks;
+    task->alltoallv_node.nnodes = nnodes;
+    task->alltoallv_node.node   = node_of[UCC_TL_TEAM_RANK(team)];
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_node_init_common(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t              *team      = TASK_TEAM(task);
+    ucc_team_t                     *core_team = UCC_TL_CORE_TEAM(team);
+    ucc_coll_args_t                *args      = &TASK_ARGS(task);
+    ucc_rank_t                      size      = UCC_TL_TEAM_SIZE(team);
+    ucc_tl_ucp_alltoallv_node_ctx_t c;
+    size_t                          meta_size;
+    ucc_status_t                    status;
+
+    if (!core_team || !core_team->topo ||
+        args->src.info_v.mem_type != UCC_MEMORY_TYPE_HOST ||
+        args->dst.info_v.mem_type != UCC_MEMORY_TYPE_HOST) {
+        tl_debug(UCC_TASK_LIB(task), "node aggregated alltoallv requires "
+                 "team topo and host buffers, using sparse alg");
+        return ucc_tl_ucp_alltoallv_sparse_init_common(task);
+    }
+    status = ucc_tl_ucp_alltoallv_node_map_init(task, core_team->topo);
+    if (UCC_OK != status) {
+        return status;
+    }
+    ucc_tl_ucp_alltoallv_node_ctx(task, &c);
+    if (UCC_TL_TEAM_RANK(team) == ucc_tl_ucp_alltoallv_node_leader(&c, c.node)) {
+        meta_size = 3 * (size_t)c.lsize * size + c.lsize + 1 +
+                    3 * (size_t)c.nnodes + 2;
+    } else {
+        meta_size = size;
+    }
+    task->alltoallv_node.meta =
+        ucc_malloc(meta_size * sizeof(uint64_t), "alltoallv_node_meta");
+    if (!task->alltoallv_node.meta) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes for meta",
+                 meta_size * sizeof(uint64_t));
+        ucc_free(task->alltoallv_node.map);
+        return UCC_ERR_NO_MEMORY;
+    }
+    memset(task->alltoallv_node.bufs, 0, sizeof(task->alltoallv_node.bufs));
+    task->super.post     = ucc_tl_ucp_alltoallv_node_start;
+    task->super.progress = ucc_tl_ucp_alltoallv_node_progress;
+    task->super.finalize = ucc_tl_ucp_alltoallv_node_finalize;
+    return UCC_OK;
+}
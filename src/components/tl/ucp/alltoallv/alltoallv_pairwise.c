@@ -118,6 +118,8 @@ ucc_status_t ucc_tl_ucp_alltoallv_pairwise_init_common(ucc_tl_ucp_task_t *task)
     task->super.post     = ucc_tl_ucp_alltoallv_pairwise_start;
     task->super.progress = ucc_tl_ucp_alltoallv_pairwise_progress;
 
+    /* progress loop posts new requests while polling the worker */
+    ucc_tl_ucp_task_set_polling(task);
     task->n_polls = ucc_min(1, task->n_polls);
     if (UCC_TL_UCP_TEAM_CTX(team)->cfg.pre_reg_mem) {
         if (args->flags & UCC_COLL_ARGS_FLAG_CONTIG_SRC_BUFFER) {
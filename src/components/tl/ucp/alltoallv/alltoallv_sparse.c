@@ -0,0 +1,153 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "alltoallv.h"
+#include "core/ucc_progress_queue.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "tl_ucp_sendrecv.h"
+
+/* Pairwise alltoallv over the peers with non zero counts only. The peer
+   lists are built at start in the pairwise order (recv from rank + step,
+   send to rank - step), so that at every moment the ranks target different
+   peers, zero count peers neither take a step nor a slot of the window of
+   outstanding requests. */
+
+ucc_status_t ucc_tl_ucp_alltoallv_sparse_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task   = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_coll_args_t   *args   = &TASK_ARGS(task);
+    ptrdiff_t          sbuf   = (ptrdiff_t)args->src.info_v.buffer;
+    ptrdiff_t          rbuf   = (ptrdiff_t)args->dst.info_v.buffer;
+    ucc_memory_type_t  smem   = args->src.info_v.mem_type;
+    ucc_memory_type_t  rmem   = args->dst.info_v.mem_type;
+    ucc_rank_t         gsize  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t        *speers = task->alltoallv_sparse.peers;
+    ucc_rank_t        *rpeers = task->alltoallv_sparse.peers + gsize;
+    ucc_rank_t         n_send = task->alltoallv_sparse.n_send;
+    ucc_rank_t         n_recv = task->alltoallv_sparse.n_recv;
+    int                polls  = 0;
+    ucc_rank_t         peer;
+    int                posts, nreqs;
+    size_t             rdt_size, sdt_size, data_size, data_displ;
+
+    posts    = UCC_TL_UCP_TEAM_LIB(team)->cfg.alltoallv_pairwise_num_posts;
+    nreqs    = (posts > gsize || posts == 0) ? gsize : posts;
+    sdt_size = ucc_dt_size(args->src.info_v.datatype);
+    rdt_size = ucc_dt_size(args->dst.info_v.datatype);
+    while ((task->send_posted < n_send || task->recv_posted < n_recv) &&
+           (polls++ < task->n_polls)) {
+        ucp_worker_progress(UCC_TL_UCP_TEAM_CTX(team)->ucp_worker);
+        while ((task->recv_posted < n_recv) &&
+               ((task->recv_posted - task->recv_completed) < nreqs)) {
+            peer       = rpeers[task->recv_posted];
+            data_size  = ucc_coll_args_get_count(args, args->dst.info_v.counts,
+                                                 peer) * rdt_size;
+            data_displ = ucc_coll_args_get_displacement(
+                             args, args->dst.info_v.displacements, peer) *
+                         rdt_size;
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb((void *)(rbuf + data_displ),
+                                             data_size, rmem, peer, team, task),
+                          task, out);
+            polls = 0;
+        }
+        while ((task->send_posted < n_send) &&
+               ((task->send_posted - task->send_completed) < nreqs)) {
+            peer       = speers[task->send_posted];
+            data_size  = ucc_coll_args_get_count(args, args->src.info_v.counts,
+                                                 peer) * sdt_size;
+            data_displ = ucc_coll_args_get_displacement(
+                             args, args->src.info_v.displacements, peer) *
+                         sdt_size;
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb((void *)(sbuf + data_displ),
+                                             data_size, smem, peer, team, task),
+                          task, out);
+            polls = 0;
+        }
+    }
+    if ((task->send_posted < n_send) || (task->recv_posted < n_recv)) {
+        return task->super.super.status;
+    }
+    task->super.super.status = ucc_tl_ucp_test(task);
+out:
+    if (task->super.super.status != UCC_INPROGRESS) {
+        UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task,
+                                         "ucp_alltoallv_sparse_done", 0);
+    }
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_sparse_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task   = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_coll_args_t   *args   = &TASK_ARGS(task);
+    ucc_rank_t         grank  = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         gsize  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t        *speers = task->alltoallv_sparse.peers;
+    ucc_rank_t        *rpeers = task->alltoallv_sparse.peers + gsize;
+    ucc_rank_t         step, n_send, n_recv, peer;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_alltoallv_sparse_start",
+                                     0);
+    ucc_tl_ucp_task_reset(task);
+
+    /* counts may be changed by the user between the posts of the task */
+    n_send = 0;
+    n_recv = 0;
+    for (step = 0; step < gsize; step++) {
+        peer = (grank + step) % gsize;
+        if (ucc_coll_args_get_count(args, args->dst.info_v.counts, peer)) {
+            rpeers[n_recv++] = peer;
+        }
+        peer = (grank - step + gsize) % gsize;
+        if (ucc_coll_args_get_count(args, args->src.info_v.counts, peer)) {
+            speers[n_send++] = peer;
+        }
+    }
+    task->alltoallv_sparse.n_send = n_send;
+    task->alltoallv_sparse.n_recv = n_recv;
+
+    ucc_tl_ucp_alltoallv_sparse_progress(&task->super);
+    if (UCC_INPROGRESS == task->super.super.status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_sparse_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_free(task->alltoallv_sparse.peers);
+    return ucc_tl_ucp_coll_finalize(&task->super);
+}
+
+ucc_status_t ucc_tl_ucp_alltoallv_sparse_init_common(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_rank_t         size = UCC_TL_TEAM_SIZE(team);
+
+    task->alltoallv_sparse.peers =
+        ucc_malloc(2 * size * sizeof(ucc_rank_t), "alltoallv_sparse_peers");
+    if (!task->alltoallv_sparse.peers) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes for peers",
+                 2 * size * sizeof(ucc_rank_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    task->super.post     = ucc_tl_ucp_alltoallv_sparse_start;
+    task->super.progress = ucc_tl_ucp_alltoallv_sparse_progress;
+    task->super.finalize = ucc_tl_ucp_alltoallv_sparse_finalize;
+
+    /* progress loop posts new requests while polling the worker */
+    ucc_tl_ucp_task_set_polling(task);
+    task->n_polls = ucc_min(1, task->n_polls);
+    return UCC_OK;
+}
@@ -7,8 +7,23 @@
 #include "tl_ucp.h"
 #include "barrier.h"
 
-ucc_status_t ucc_tl_ucp_barrier_knomial_start(ucc_coll_task_t *task);
-ucc_status_t ucc_tl_ucp_barrier_knomial_progress(ucc_coll_task_t *task);
+ucc_base_coll_alg_info_t
+    ucc_tl_ucp_barrier_algs[UCC_TL_UCP_BARRIER_ALG_LAST + 1] = {
+        [UCC_TL_UCP_BARRIER_ALG_KNOMIAL] =
+            {.id   = UCC_TL_UCP_BARRIER_ALG_KNOMIAL,
+             .name = "knomial",
+             .desc = "recursive k-ing with arbitrary radix"},
+        [UCC_TL_UCP_BARRIER_ALG_DISSEMINATION] =
+            {.id   = UCC_TL_UCP_BARRIER_ALG_DISSEMINATION,
+             .name = "dissemination",
+             .desc = "dissemination with arbitrary radix, no extra ranks"},
+        [UCC_TL_UCP_BARRIER_ALG_HIERARCHICAL] =
+            {.id   = UCC_TL_UCP_BARRIER_ALG_HIERARCHICAL,
+             .name = "hierarchical",
+             .desc = "intra node fan-in/fan-out around dissemination among "
+                     "node leaders"},
+        [UCC_TL_UCP_BARRIER_ALG_LAST] = {
+            .id = 0, .name = NULL, .desc = NULL}};
 
 ucc_status_t ucc_tl_ucp_barrier_init(ucc_tl_ucp_task_t *task)
 {
@@ -16,3 +31,29 @@ ucc_status_t ucc_tl_ucp_barrier_init(ucc_tl_ucp_task_t *task)
     task->super.progress = ucc_tl_ucp_barrier_knomial_progress;
     return UCC_OK;
 }
+
+ucc_status_t ucc_tl_ucp_barrier_knomial_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+
+    task    = ucc_tl_ucp_init_task(coll_args, team);
+    ucc_tl_ucp_barrier_init(task);
+    *task_h = &task->super;
+    return UCC_OK;
+}
+
+ucc_status_t
+ucc_tl_ucp_barrier_dissemination_init(ucc_base_coll_args_t *coll_args,
+                                      ucc_base_team_t      *team,
+                                      ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_barrier_dissemination_start;
+    task->super.progress = ucc_tl_ucp_barrier_dissemination_progress;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
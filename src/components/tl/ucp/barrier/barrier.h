@@ -8,6 +8,58 @@
 #include "../tl_ucp.h"
 #include "../tl_ucp_coll.h"
 
+enum {
+    UCC_TL_UCP_BARRIER_ALG_KNOMIAL,
+    UCC_TL_UCP_BARRIER_ALG_DISSEMINATION,
+    UCC_TL_UCP_BARRIER_ALG_HIERARCHICAL,
+    UCC_TL_UCP_BARRIER_ALG_LAST
+};
+
+extern ucc_base_coll_alg_info_t
+    ucc_tl_ucp_barrier_algs[UCC_TL_UCP_BARRIER_ALG_LAST + 1];
+
+#define UCC_TL_UCP_BARRIER_DEFAULT_ALG_SELECT_STR                              \
+    "barrier:@knomial"
+
 ucc_status_t ucc_tl_ucp_barrier_init(ucc_tl_ucp_task_t *task);
 
+ucc_status_t ucc_tl_ucp_barrier_knomial_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h);
+ucc_status_t ucc_tl_ucp_barrier_knomial_start(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_barrier_knomial_progress(ucc_coll_task_t *task);
+
+/* Dissemination barrier with radix k: ceil(log_k(size)) rounds, no extra
+   ranks, uses barrier_dissemination_radix from config */
+ucc_status_t
+ucc_tl_ucp_barrier_dissemination_init(ucc_base_coll_args_t *coll_args,
+                                      ucc_base_team_t      *team,
+                                      ucc_coll_task_t     **task_h);
+ucc_status_t ucc_tl_ucp_barrier_dissemination_start(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_barrier_dissemination_progress(ucc_coll_task_t *task);
+
+enum {
+    UCC_BARRIER_HIER_PHASE_FANIN,  /* local ranks signal node leader */
+    UCC_BARRIER_HIER_PHASE_INTER,  /* dissemination among node leaders */
+    UCC_BARRIER_HIER_PHASE_FANOUT  /* node leader releases local ranks */
+};
+
+/* Hierarchical barrier: fan-in to node leaders, dissemination among them and
+   fan-out, falls back to dissemination if team topo is not available */
+ucc_status_t ucc_tl_ucp_barrier_hier_init(ucc_base_coll_args_t *coll_args,
+                                          ucc_base_team_t      *team,
+                                          ucc_coll_task_t     **task_h);
+ucc_status_t ucc_tl_ucp_barrier_hier_start(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_barrier_hier_progress(ucc_coll_task_t *task);
+
+static inline int ucc_tl_ucp_barrier_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_TL_UCP_BARRIER_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_tl_ucp_barrier_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
 #endif
@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "barrier.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* Dissemination barrier: at the round with distance dist = radix^i every
+   rank signals the ranks (rank + j * dist) and waits for the ranks
+   (rank - j * dist), j = 1 .. radix - 1, skipping the distances that
+   exceed the team size. After the round a rank has heard (directly or
+   transitively) from the radix^(i + 1) - 1 preceding ranks, so the barrier
+   takes ceil(log_radix(size)) rounds on any team size, unlike the knomial
+   barrier that serves the extra ranks with two more steps. */
+
+ucc_status_t ucc_tl_ucp_barrier_dissemination_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         rank  = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_kn_radix_t     radix = task->dissemination.radix;
+    ucc_memory_type_t  mtype = UCC_MEMORY_TYPE_UNKNOWN;
+    ucc_rank_t         dist, step;
+    ucc_kn_radix_t     j;
+
+    while (UCC_INPROGRESS != ucc_tl_ucp_test(task)) {
+        dist = task->dissemination.dist;
+        if (dist >= size) {
+            ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+            task->super.super.status = UCC_OK;
+            UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_diss_done",
+                                             0);
+            break;
+        }
+        for (j = 1; j < radix && j * dist < size; j++) {
+            step = j * dist;
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(NULL, 0, mtype,
+                                             (rank + step) % size, team, task),
+                          task, out);
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(NULL, 0, mtype,
+                                             (rank + size - step) % size, team,
+                                             task),
+                          task, out);
+        }
+        task->dissemination.dist = dist * radix;
+    }
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_barrier_dissemination_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_rank_t         size = UCC_TL_TEAM_SIZE(team);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_diss_start", 0);
+    task->dissemination.dist  = 1;
+    task->dissemination.radix = ucc_max(
+        ucc_min(ucc_tl_ucp_kn_radix(
+                    team, &coll_task->bargs,
+                    UCC_TL_UCP_TEAM_LIB(team)->cfg.barrier_dissemination_radix,
+                    UCC_KN_MODEL_TREE, size, 0),
+                size),
+        2);
+    ucc_tl_ucp_task_reset(task);
+    status = ucc_tl_ucp_barrier_dissemination_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
@@ -0,0 +1,223 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "barrier.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_team.h"
+#include "components/topo/ucc_topo.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* Hierarchical (two level tree) barrier
+   1. Team ranks are grouped by node, the lowest team rank of the node is
+      the node leader.
+   2. Local ranks signal their leader (fan-in over shared memory), leaders
+      run the dissemination barrier among themselves (see
+      barrier_dissemination.c, radix from barrier_dissemination_radix), then
+      release the local ranks (fan-out).
+   3. Only ceil(log_k(nnodes)) rounds of messages cross the network and each
+      of them is sent by one process per node, instead of all the processes
+      of the node competing for the NIC. */
+
+static inline int ucc_tl_ucp_barrier_hier_is_leader(ucc_tl_ucp_task_t *task)
+{
+    return task->barrier_hier.locals[0] ==
+           UCC_TL_TEAM_RANK(TASK_TEAM(task));
+}
+
+ucc_status_t ucc_tl_ucp_barrier_hier_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task    = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         nnodes  = task->barrier_hier.nnodes;
+    ucc_rank_t         node    = task->barrier_hier.node;
+    ucc_rank_t        *leaders = task->barrier_hier.leaders;
+    ucc_kn_radix_t     radix   = task->barrier_hier.radix;
+    ucc_memory_type_t  mtype   = UCC_MEMORY_TYPE_UNKNOWN;
+    ucc_rank_t         dist, step, i;
+    ucc_kn_radix_t     j;
+
+    while (UCC_INPROGRESS != ucc_tl_ucp_test(task)) {
+        switch (task->barrier_hier.phase) {
+        case UCC_BARRIER_HIER_PHASE_FANIN:
+            if (!ucc_tl_ucp_barrier_hier_is_leader(task)) {
+                /* signal to leader and release from it are both done */
+                goto completed;
+            }
+            task->barrier_hier.phase = UCC_BARRIER_HIER_PHASE_INTER;
+            break;
+        case UCC_BARRIER_HIER_PHASE_INTER:
+            dist = task->barrier_hier.dist;
+            if (dist >= nnodes) {
+                for (i = 1; i < task->barrier_hier.lsize; i++) {
+                    UCPCHECK_GOTO(ucc_tl_ucp_send_nb(
+                                      NULL, 0, mtype,
+                                      task->barrier_hier.locals[i], team, task),
+                                  task, out);
+                }
+                task->barrier_hier.phase = UCC_BARRIER_HIER_PHASE_FANOUT;
+                break;
+            }
+            for (j = 1; j < radix && j * dist < nnodes; j++) {
+                step = j * dist;
+                UCPCHECK_GOTO(ucc_tl_ucp_send_nb(NULL, 0, mtype,
+                                                 leaders[(node + step) % nnodes],
+                                                 team, task),
+                              task, out);
+                UCPCHECK_GOTO(
+                    ucc_tl_ucp_recv_nb(NULL, 0, mtype,
+                                       leaders[(node + nnodes - step) % nnodes],
+                                       team, task),
+                    task, out);
+            }
+            task->barrier_hier.dist = dist * radix;
+            break;
+        case UCC_BARRIER_HIER_PHASE_FANOUT:
+            goto completed;
+        }
+    }
+    return task->super.super.status;
+completed:
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_hier_done", 0);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_barrier_hier_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task   = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_rank_t        *locals = task->barrier_hier.locals;
+    ucc_memory_type_t  mtype  = UCC_MEMORY_TYPE_UNKNOWN;
+    ucc_rank_t         i;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_hier_start", 0);
+    task->barrier_hier.phase = UCC_BARRIER_HIER_PHASE_FANIN;
+    task->barrier_hier.dist  = 1;
+    ucc_tl_ucp_task_reset(task);
+    if (ucc_tl_ucp_barrier_hier_is_leader(task)) {
+        for (i = 1; i < task->barrier_hier.lsize; i++) {
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(NULL, 0, mtype, locals[i], team,
+                                             task),
+                          task, out);
+        }
+    } else {
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(NULL, 0, mtype, locals[0], team,
+                                         task),
+                      task, out);
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(NULL, 0, mtype, locals[0], team,
+                                         task),
+                      task, out);
+    }
+    status = ucc_tl_ucp_barrier_hier_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t ucc_tl_ucp_barrier_hier_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    ucc_free(task->barrier_hier.map);
+    return ucc_tl_ucp_coll_finalize(&task->super);
+}
+
+/* Nodes are numbered in the order of their lowest team rank, map holds the
+   node index of every host followed by the leaders of the nodes and the
+   ranks of the node of this rank (leader first) */
+static ucc_status_t ucc_tl_ucp_barrier_hier_map_init(ucc_tl_ucp_task_t *task,
+                                                     ucc_topo_t        *topo)
+{
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         rank    = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         n_hosts = topo->topo->nnodes;
+    ucc_rank_t        *host_node, *leaders, *locals;
+    ucc_rank_t         r, nnodes, lsize, ctx_rank, my_host;
+
+    host_node = ucc_malloc((n_hosts + 2 * size) * sizeof(ucc_rank_t),
+                           "barrier_hier_map");
+    if (!host_node) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate %zd bytes for map",
+                 (n_hosts + 2 * size) * sizeof(ucc_rank_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    leaders = host_node + n_hosts;
+    locals  = leaders + size;
+    for (r = 0; r < n_hosts; r++) {
+        host_node[r] = UCC_RANK_MAX;
+    }
+#define HOST_OF(_r)                                                            \
+    topo->topo                                                                 \
+        ->procs[ucc_ep_map_eval(topo->set.map,                                 \
+                                ucc_ep_map_eval(UCC_TL_TEAM_MAP(team), (_r)))] \
+        .host_id
+    my_host = HOST_OF(rank);
+    nnodes  = 0;
+    lsize   = 0;
+    for (r = 0; r < size; r++) {
+        ctx_rank = HOST_OF(r);
+        if (host_node[ctx_rank] == UCC_RANK_MAX) {
+            host_node[ctx_rank] = nnodes;
+            leaders[nnodes++]   = r;
+        }
+        if (ctx_rank == my_host) {
+            locals[lsize++] = r;
+        }
+    }
+#undef HOST_OF
+    task->barrier_hier.map     = host_node;
+    task->barrier_hier.leaders = leaders;
+    task->barrier_hier.locals  = locals;
+    task->barrier_hier.nnodes  = nnodes;
+    task->barrier_hier.lsize   = lsize;
+    task->barrier_hier.node    = host_node[my_host];
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_barrier_hier_init(ucc_base_coll_args_t *coll_args,
+                                          ucc_base_team_t      *team,
+                                          ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team   = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_team_t        *core_team = UCC_TL_CORE_TEAM(tl_team);
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    if (!core_team || !core_team->topo) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team), "hierarchical barrier requires "
+                 "team topo, using dissemination alg");
+        return ucc_tl_ucp_barrier_dissemination_init(coll_args, team, task_h);
+    }
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_barrier_hier_map_init(task, core_team->topo);
+    if (UCC_OK != status) {
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    task->barrier_hier.radix = ucc_max(
+        ucc_min(ucc_tl_ucp_kn_radix(
+                    tl_team, coll_args,
+                    UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.barrier_dissemination_radix,
+                    UCC_KN_MODEL_TREE, task->barrier_hier.nnodes, 0),
+                task->barrier_hier.nnodes),
+        2);
+    task->super.post     = ucc_tl_ucp_barrier_hier_start;
+    task->super.progress = ucc_tl_ucp_barrier_hier_progress;
+    task->super.finalize = ucc_tl_ucp_barrier_hier_finalize;
+    *task_h              = &task->super;
+    return UCC_OK;
+}
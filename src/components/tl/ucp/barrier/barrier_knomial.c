@@ -114,11 +114,14 @@ ucc_status_t ucc_tl_ucp_barrier_knomial_start(ucc_coll_task_t *coll_task)
 
     UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_barrier_kn_start", 0);
     task->barrier.phase = UCC_KN_PHASE_INIT;
-    ucc_knomial_pattern_init(size, rank,
-                             ucc_min(UCC_TL_UCP_TEAM_LIB(team)->
-                                     cfg.barrier_kn_radix, size),
-                             &task->barrier.p);
-    task->super.super.status = UCC_INPROGRESS;
+    ucc_knomial_pattern_init(
+        size, rank,
+        ucc_min(ucc_tl_ucp_kn_radix(team, &coll_task->bargs,
+                                    UCC_TL_UCP_TEAM_LIB(team)->cfg.barrier_kn_radix,
+                                    UCC_KN_MODEL_RECURSIVE, size, 0),
+                size),
+        &task->barrier.p);
+    ucc_tl_ucp_task_reset(task);
     status = ucc_tl_ucp_barrier_knomial_progress(&task->super);
     if (UCC_INPROGRESS == status) {
         ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
@@ -19,6 +19,16 @@ ucc_base_coll_alg_info_t
              .name = "sag_knomial",
              .desc = "recursive k-nomial scatter followed by k-nomial "
                      "allgather (bw oriented alg)"},
+        [UCC_TL_UCP_BCAST_ALG_PIPELINED] =
+            {.id   = UCC_TL_UCP_BCAST_ALG_PIPELINED,
+             .name = "pipelined",
+             .desc = "fragmented bcast pipelined over k-ary tree or chain "
+                     "(bw oriented alg for large messages)"},
+        [UCC_TL_UCP_BCAST_ALG_DBT] =
+            {.id   = UCC_TL_UCP_BCAST_ALG_DBT,
+             .name = "dbt",
+             .desc = "fragmented bcast pipelined over double binary tree "
+                     "(bw oriented alg for mid size messages)"},
         [UCC_TL_UCP_BCAST_ALG_LAST] = {
             .id = 0, .name = NULL, .desc = NULL}};
 
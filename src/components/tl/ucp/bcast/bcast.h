@@ -11,9 +11,21 @@
 enum {
     UCC_TL_UCP_BCAST_ALG_KNOMIAL,
     UCC_TL_UCP_BCAST_ALG_SAG_KNOMIAL,
+    UCC_TL_UCP_BCAST_ALG_PIPELINED,
+    UCC_TL_UCP_BCAST_ALG_DBT,
     UCC_TL_UCP_BCAST_ALG_LAST
 };
 
+enum {
+    UCC_BCAST_PIPELINED_PHASE_RECV, /* waiting for the fragment of parent */
+    UCC_BCAST_PIPELINED_PHASE_SEND  /* forwarding the fragment to children */
+};
+
+enum {
+    UCC_BCAST_DBT_PHASE_RECV, /* waiting for the half fragment of parent */
+    UCC_BCAST_DBT_PHASE_SEND  /* forwarding the half fragment to children */
+};
+
 extern ucc_base_coll_alg_info_t
              ucc_tl_ucp_bcast_algs[UCC_TL_UCP_BCAST_ALG_LAST + 1];
 ucc_status_t ucc_tl_ucp_bcast_init(ucc_tl_ucp_task_t *task);
@@ -24,8 +36,21 @@ ucc_status_t
 ucc_tl_ucp_bcast_sag_knomial_init(ucc_base_coll_args_t *coll_args,
                               ucc_base_team_t *team, ucc_coll_task_t **task_h);
 
-#define UCC_TL_UCP_BCAST_DEFAULT_ALG_SELECT_STR              \
-    "bcast:0-32k:@0#bcast:32k-inf:@1"
+/* Fragmented bcast pipelined over a k-ary tree (chain for k = 1), uses
+   bcast_pipeline_radix, frag_size and depth from config */
+ucc_status_t
+ucc_tl_ucp_bcast_pipelined_init(ucc_base_coll_args_t *coll_args,
+                                ucc_base_team_t *team, ucc_coll_task_t **task_h);
+
+/* Fragmented bcast pipelined over double binary tree of non root ranks,
+   uses bcast_dbt_frag_size and depth from config */
+ucc_status_t
+ucc_tl_ucp_bcast_dbt_init(ucc_base_coll_args_t *coll_args,
+                          ucc_base_team_t *team, ucc_coll_task_t **task_h);
+
+#define UCC_TL_UCP_BCAST_DEFAULT_ALG_SELECT_STR                           \
+    "bcast:0-32k:@0#bcast:32k-8m:[1-31]:@1#bcast:32k-1m:[32-inf]:@dbt#" \
+    "bcast:1m-8m:[32-inf]:@1#bcast:8m-inf:@pipelined"
 
 static inline int ucc_tl_ucp_bcast_alg_from_str(const char *str)
 {
@@ -0,0 +1,267 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "bcast.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Double binary tree bcast
+   1. The double binary tree (coll_patterns/double_binary_tree.h) is built
+      over the size - 1 non root ranks (vranks 1 .. size - 1), the root sends
+      the first half of every fragment to the root of the first tree and the
+      second half to the root of the second one.
+   2. Every non root rank is interior in at most one tree, so it forwards
+      one half of the data to at most two children and only receives the
+      other half, i.e. the send link of the leaves of the single binary tree
+      is used as well and each tree carries half of the message.
+   3. As in the pipelined bcast the message is split into fragments of at
+      most BCAST_DBT_FRAG_SIZE bytes, up to BCAST_DBT_PIPELINE_DEPTH of them
+      in flight. */
+
+static void ucc_tl_ucp_bcast_dbt_build_tree(ucc_rank_t rank, ucc_rank_t root,
+                                            ucc_rank_t size, int tree,
+                                            ucc_dbt_single_tree_t *t)
+{
+    ucc_rank_t            vrank = VRANK(rank, root, size);
+    ucc_dbt_single_tree_t trees[2];
+    int                   i;
+
+    if (vrank == 0) {
+        t->parent     = UCC_DBT_PEER_NULL;
+        t->n_children = 0;
+        if (size > 1) {
+            t->children[t->n_children++] =
+                INV_VRANK(ucc_dbt_root(size - 1, tree) + 1, root, size);
+        }
+        return;
+    }
+    ucc_dbt_build_trees(vrank - 1, size - 1, &trees[0], &trees[1]);
+    *t = trees[tree];
+    t->parent = (t->parent == UCC_DBT_PEER_NULL)
+                    ? root
+                    : INV_VRANK(t->parent + 1, root, size);
+    for (i = 0; i < t->n_children; i++) {
+        t->children[i] = INV_VRANK(t->children[i] + 1, root, size);
+    }
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_dbt_send_children(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t       *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t     *team = TASK_TEAM(task);
+    ucc_dbt_single_tree_t *t    = &task->dbt.t;
+    size_t                 data_size =
+        args->src.info.count * ucc_dt_size(args->src.info.datatype);
+    int                    i;
+    ucc_status_t           status;
+
+    for (i = 0; i < t->n_children; i++) {
+        status = ucc_tl_ucp_send_nb(args->src.info.buffer, data_size,
+                                    args->src.info.mem_type, t->children[i],
+                                    team, task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_dbt_frag_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    if (task->dbt.phase == UCC_BCAST_DBT_PHASE_RECV) {
+        UCPCHECK_GOTO(ucc_tl_ucp_bcast_dbt_send_children(task), task, out);
+        task->dbt.phase = UCC_BCAST_DBT_PHASE_SEND;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_dbt_frag_task_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    size_t             data_size =
+        args->src.info.count * ucc_dt_size(args->src.info.datatype);
+    ucc_status_t       status;
+
+    ucc_tl_ucp_task_reset(task);
+    if (data_size == 0) {
+        /* the half of a single element fragment */
+        task->super.super.status = UCC_OK;
+        return ucc_task_complete(coll_task);
+    }
+    if (task->dbt.t.parent == UCC_DBT_PEER_NULL) {
+        UCPCHECK_GOTO(ucc_tl_ucp_bcast_dbt_send_children(task), task, out);
+        task->dbt.phase = UCC_BCAST_DBT_PHASE_SEND;
+    } else {
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(args->src.info.buffer, data_size,
+                                         args->src.info.mem_type,
+                                         task->dbt.t.parent, team, task),
+                      task, out);
+        task->dbt.phase = UCC_BCAST_DBT_PHASE_RECV;
+    }
+
+    status = ucc_tl_ucp_bcast_dbt_frag_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_dbt_frag_start(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+
+    return ucc_schedule_start(schedule);
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_dbt_frag_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+    ucc_status_t    status;
+
+    status = ucc_schedule_finalize(task);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_dbt_frag_setup(ucc_schedule_pipelined_t *schedule_p,
+                                ucc_schedule_t *frag, int frag_num)
+{
+    ucc_coll_args_t *args       = &schedule_p->super.super.bargs.args;
+    size_t           dt_size    = ucc_dt_size(args->src.info.datatype);
+    int              n_frags    = schedule_p->n_frags_total;
+    size_t           frag_count = args->src.info.count / n_frags;
+    size_t           left       = args->src.info.count % n_frags;
+    size_t           offset     = frag_num * frag_count + left;
+    size_t           half;
+    ucc_coll_args_t *targs;
+    int              i;
+
+    if (frag_num < left) {
+        frag_count++;
+        offset -= left - frag_num;
+    }
+    for (i = 0; i < 2; i++) {
+        /* 1st tree takes the larger half */
+        half  = i ? frag_count / 2 : frag_count - frag_count / 2;
+        targs = &frag->tasks[i]->bargs.args;
+        targs->src.info.buffer =
+            PTR_OFFSET(args->src.info.buffer, offset * dt_size);
+        targs->src.info.count = half;
+        offset += half;
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_dbt_frag_init(ucc_base_coll_args_t     *coll_args,
+                               ucc_schedule_pipelined_t *sp, //NOLINT
+                               ucc_base_team_t          *team,
+                               ucc_schedule_t          **frag_p)
+{
+    ucc_tl_ucp_team_t *tl_team  = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_schedule_t    *schedule = ucc_tl_ucp_get_schedule(tl_team, coll_args);
+    ucc_tl_ucp_task_t *task;
+    int                i;
+
+    for (i = 0; i < 2; i++) {
+        task = ucc_tl_ucp_init_task(coll_args, team);
+        ucc_tl_ucp_bcast_dbt_build_tree(
+            UCC_TL_TEAM_RANK(tl_team), (ucc_rank_t)coll_args->args.root,
+            UCC_TL_TEAM_SIZE(tl_team), i, &task->dbt.t);
+        task->super.post     = ucc_tl_ucp_bcast_dbt_frag_task_start;
+        task->super.progress = ucc_tl_ucp_bcast_dbt_frag_progress;
+
+        ucc_schedule_add_task(schedule, &task->super);
+        ucc_task_subscribe_dep(&schedule->super, &task->super,
+                               UCC_EVENT_SCHEDULE_STARTED);
+    }
+    schedule->super.finalize = ucc_tl_ucp_bcast_dbt_frag_finalize;
+    schedule->super.post     = ucc_tl_ucp_bcast_dbt_frag_start;
+    *frag_p                  = schedule;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_dbt_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+    ucc_status_t status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(schedule, "ucp_bcast_dbt_done", 0);
+    status = ucc_schedule_pipelined_finalize(task);
+    ucc_tl_ucp_put_schedule_pipelined(schedule);
+    return status;
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_dbt_start(ucc_coll_task_t *task)
+{
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(task, "ucp_bcast_dbt_start", 0);
+    return ucc_schedule_pipelined_post(task);
+}
+
+ucc_status_t ucc_tl_ucp_bcast_dbt_init(ucc_base_coll_args_t *coll_args,
+                                       ucc_base_team_t      *team,
+                                       ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t        *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_lib_config_t  *cfg     = &UCC_TL_UCP_TEAM_LIB(tl_team)->cfg;
+    size_t                    count   = coll_args->args.src.info.count;
+    size_t                    msgsize =
+        count * ucc_dt_size(coll_args->args.src.info.datatype);
+    ucc_schedule_pipelined_t *schedule_p;
+    int                       n_frags, pipeline_depth;
+    ucc_status_t              status;
+
+    n_frags = 1;
+    if (cfg->bcast_dbt_frag_size > 0 && msgsize > cfg->bcast_dbt_frag_size) {
+        /* fragments are not smaller than a single element */
+        n_frags = ucc_min(ucc_div_round_up(msgsize, cfg->bcast_dbt_frag_size),
+                          count);
+    }
+    pipeline_depth = ucc_max(ucc_min(n_frags, cfg->bcast_dbt_pipeline_depth), 1);
+
+    schedule_p = ucc_tl_ucp_get_schedule_pipelined(tl_team);
+    if (!schedule_p) {
+        tl_error(team->context->lib, "failed to allocate pipelined schedule");
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = ucc_schedule_pipelined_init(
+        coll_args, team, ucc_tl_ucp_bcast_dbt_frag_init,
+        ucc_tl_ucp_bcast_dbt_frag_setup, pipeline_depth, n_frags, 0,
+        schedule_p);
+    if (UCC_OK != status) {
+        tl_error(team->context->lib, "failed to init pipelined schedule");
+        ucc_tl_ucp_put_schedule_pipelined(schedule_p);
+        return status;
+    }
+    schedule_p->super.super.finalize       = ucc_tl_ucp_bcast_dbt_finalize;
+    schedule_p->super.super.triggered_post = ucc_triggered_post;
+    schedule_p->super.super.post           = ucc_tl_ucp_bcast_dbt_start;
+    *task_h                                = &schedule_p->super.super;
+    return UCC_OK;
+}
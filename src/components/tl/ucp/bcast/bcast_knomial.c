@@ -78,7 +78,12 @@ ucc_status_t ucc_tl_ucp_bcast_knomial_start(ucc_coll_task_t *coll_task)
     ucc_tl_ucp_task_reset(task);
 
     task->bcast_kn.radix =
-        ucc_min(UCC_TL_UCP_TEAM_LIB(team)->cfg.bcast_kn_radix, size);
+        ucc_min(ucc_tl_ucp_kn_radix(team, &coll_task->bargs,
+                                    UCC_TL_UCP_TEAM_LIB(team)->cfg.bcast_kn_radix,
+                                    UCC_KN_MODEL_TREE, size,
+                                    TASK_ARGS(task).src.info.count *
+                                    ucc_dt_size(TASK_ARGS(task).src.info.datatype)),
+                size);
     CALC_KN_TREE_DIST(size, task->bcast_kn.radix, task->bcast_kn.dist);
 
     status = ucc_tl_ucp_bcast_knomial_progress(&task->super);
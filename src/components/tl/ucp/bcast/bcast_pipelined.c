@@ -0,0 +1,253 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "bcast.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Pipelined bcast for large messages
+   1. The message is split into fragments of at most BCAST_PIPELINE_FRAG_SIZE
+      bytes, every fragment is broadcast over a k-ary tree of vranks (root is
+      vrank 0, children of vrank v are k * v + 1 .. k * v + k). With k = 1
+      the tree is a chain.
+   2. Up to BCAST_PIPELINE_DEPTH fragments are in flight: a rank forwards
+      fragment i to its children as soon as it arrives, while receiving
+      fragment i + 1, so all the tree links carry data at the same time and
+      the time is ~ (n_frags + depth(tree)) * k * T(frag) instead of
+      depth(tree) * k * T(msg) of the store-and-forward tree. */
+
+static inline ucc_rank_t ucc_tl_ucp_bcast_pipelined_n_children(ucc_rank_t vrank,
+                                                               ucc_rank_t size,
+                                                               ucc_kn_radix_t k)
+{
+    size_t first = (size_t)vrank * k + 1;
+
+    if (first >= size) {
+        return 0;
+    }
+    return ucc_min(k, size - first);
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_pipelined_send_children(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_kn_radix_t     k     = task->bcast_pipelined.radix;
+    size_t             data_size =
+        args->src.info.count * ucc_dt_size(args->src.info.datatype);
+    ucc_rank_t         i, n;
+    ucc_status_t       status;
+
+    n = ucc_tl_ucp_bcast_pipelined_n_children(vrank, size, k);
+    for (i = 0; i < n; i++) {
+        status = ucc_tl_ucp_send_nb(args->src.info.buffer, data_size,
+                                    args->src.info.mem_type,
+                                    INV_VRANK(vrank * k + 1 + i, root, size),
+                                    team, task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_pipelined_frag_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    if (task->bcast_pipelined.phase == UCC_BCAST_PIPELINED_PHASE_RECV) {
+        UCPCHECK_GOTO(ucc_tl_ucp_bcast_pipelined_send_children(task), task,
+                      out);
+        task->bcast_pipelined.phase = UCC_BCAST_PIPELINED_PHASE_SEND;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_pipelined_frag_task_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_status_t       status;
+
+    ucc_tl_ucp_task_reset(task);
+    if (vrank == 0) {
+        UCPCHECK_GOTO(ucc_tl_ucp_bcast_pipelined_send_children(task), task,
+                      out);
+        task->bcast_pipelined.phase = UCC_BCAST_PIPELINED_PHASE_SEND;
+    } else {
+        UCPCHECK_GOTO(
+            ucc_tl_ucp_recv_nb(args->src.info.buffer,
+                               args->src.info.count *
+                                   ucc_dt_size(args->src.info.datatype),
+                               args->src.info.mem_type,
+                               INV_VRANK((vrank - 1) /
+                                             task->bcast_pipelined.radix,
+                                         root, size),
+                               team, task),
+            task, out);
+        task->bcast_pipelined.phase = UCC_BCAST_PIPELINED_PHASE_RECV;
+    }
+
+    status = ucc_tl_ucp_bcast_pipelined_frag_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_pipelined_frag_start(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+
+    return ucc_schedule_start(schedule);
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_pipelined_frag_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+    ucc_status_t    status;
+
+    status = ucc_schedule_finalize(task);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_pipelined_frag_setup(ucc_schedule_pipelined_t *schedule_p,
+                                      ucc_schedule_t *frag, int frag_num)
+{
+    ucc_coll_args_t *args       = &schedule_p->super.super.bargs.args;
+    size_t           dt_size    = ucc_dt_size(args->src.info.datatype);
+    int              n_frags    = schedule_p->n_frags_total;
+    size_t           frag_count = args->src.info.count / n_frags;
+    size_t           left       = args->src.info.count % n_frags;
+    size_t           offset     = frag_num * frag_count + left;
+    ucc_coll_args_t *targs;
+
+    if (frag_num < left) {
+        frag_count++;
+        offset -= left - frag_num;
+    }
+    targs                  = &frag->tasks[0]->bargs.args;
+    targs->src.info.buffer = PTR_OFFSET(args->src.info.buffer,
+                                        offset * dt_size);
+    targs->src.info.count  = frag_count;
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_bcast_pipelined_frag_init(ucc_base_coll_args_t     *coll_args,
+                                     ucc_schedule_pipelined_t *sp, //NOLINT
+                                     ucc_base_team_t          *team,
+                                     ucc_schedule_t          **frag_p)
+{
+    ucc_tl_ucp_team_t *tl_team  = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_schedule_t    *schedule = ucc_tl_ucp_get_schedule(tl_team, coll_args);
+    ucc_tl_ucp_task_t *task;
+
+    task = ucc_tl_ucp_init_task(coll_args, team);
+    task->bcast_pipelined.radix =
+        ucc_max(UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.bcast_pipeline_radix, 1);
+    task->super.post     = ucc_tl_ucp_bcast_pipelined_frag_task_start;
+    task->super.progress = ucc_tl_ucp_bcast_pipelined_frag_progress;
+
+    ucc_schedule_add_task(schedule, &task->super);
+    ucc_task_subscribe_dep(&schedule->super, &task->super,
+                           UCC_EVENT_SCHEDULE_STARTED);
+    schedule->super.finalize = ucc_tl_ucp_bcast_pipelined_frag_finalize;
+    schedule->super.post     = ucc_tl_ucp_bcast_pipelined_frag_start;
+    *frag_p                  = schedule;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_pipelined_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+    ucc_status_t status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(schedule, "ucp_bcast_pipelined_done", 0);
+    status = ucc_schedule_pipelined_finalize(task);
+    ucc_tl_ucp_put_schedule_pipelined(schedule);
+    return status;
+}
+
+static ucc_status_t ucc_tl_ucp_bcast_pipelined_start(ucc_coll_task_t *task)
+{
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(task, "ucp_bcast_pipelined_start", 0);
+    return ucc_schedule_pipelined_post(task);
+}
+
+ucc_status_t ucc_tl_ucp_bcast_pipelined_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t        *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_lib_config_t  *cfg     = &UCC_TL_UCP_TEAM_LIB(tl_team)->cfg;
+    size_t                    count   = coll_args->args.src.info.count;
+    size_t                    msgsize =
+        count * ucc_dt_size(coll_args->args.src.info.datatype);
+    ucc_schedule_pipelined_t *schedule_p;
+    int                       n_frags, pipeline_depth;
+    ucc_status_t              status;
+
+    n_frags = 1;
+    if (cfg->bcast_pipeline_frag_size > 0 &&
+        msgsize > cfg->bcast_pipeline_frag_size) {
+        /* fragments are not smaller than a single element */
+        n_frags = ucc_min(ucc_div_round_up(msgsize,
+                                           cfg->bcast_pipeline_frag_size),
+                          count);
+    }
+    pipeline_depth = ucc_max(ucc_min(n_frags, cfg->bcast_pipeline_depth), 1);
+
+    schedule_p = ucc_tl_ucp_get_schedule_pipelined(tl_team);
+    if (!schedule_p) {
+        tl_error(team->context->lib, "failed to allocate pipelined schedule");
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = ucc_schedule_pipelined_init(
+        coll_args, team, ucc_tl_ucp_bcast_pipelined_frag_init,
+        ucc_tl_ucp_bcast_pipelined_frag_setup, pipeline_depth, n_frags, 0,
+        schedule_p);
+    if (UCC_OK != status) {
+        tl_error(team->context->lib, "failed to init pipelined schedule");
+        ucc_tl_ucp_put_schedule_pipelined(schedule_p);
+        return status;
+    }
+    schedule_p->super.super.finalize       = ucc_tl_ucp_bcast_pipelined_finalize;
+    schedule_p->super.super.triggered_post = ucc_triggered_post;
+    schedule_p->super.super.post           = ucc_tl_ucp_bcast_pipelined_start;
+    *task_h                                = &schedule_p->super.super;
+    return UCC_OK;
+}
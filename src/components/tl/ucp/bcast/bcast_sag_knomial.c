@@ -69,7 +69,11 @@ ucc_tl_ucp_bcast_sag_knomial_init(ucc_base_coll_args_t *coll_args,
     ucc_status_t         status;
     ucc_kn_radix_t       radix, cfg_radix;
 
-    cfg_radix = UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.bcast_sag_kn_radix;
+    cfg_radix = ucc_tl_ucp_kn_radix(
+        tl_team, coll_args,
+        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.bcast_sag_kn_radix,
+        UCC_KN_MODEL_SRA, UCC_TL_TEAM_SIZE(tl_team),
+        count * ucc_dt_size(coll_args->args.src.info.datatype));
     radix = ucc_knomial_pattern_get_min_radix(cfg_radix,
                                               UCC_TL_TEAM_SIZE(tl_team), count);
 
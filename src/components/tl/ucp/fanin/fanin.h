@@ -0,0 +1,23 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef FANIN_H_
+#define FANIN_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+enum {
+    UCC_FANIN_KN_PHASE_INIT,
+    UCC_FANIN_KN_PHASE_LOOP, /* receives from the children of the iteration */
+    UCC_FANIN_KN_PHASE_SEND  /* send to the parent (proxy for extra rank) */
+};
+
+ucc_status_t ucc_tl_ucp_fanin_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_fanin_knomial_start(ucc_coll_task_t *task);
+
+ucc_status_t ucc_tl_ucp_fanin_knomial_progress(ucc_coll_task_t *task);
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "fanin.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/recursive_knomial.h"
+#include "utils/ucc_math.h"
+
+/* Knomial fanin: the knomial pattern is built over vranks so that the root
+   is loop rank 0. Extra ranks signal their proxies, then at every iteration
+   the ranks with zero loop digit wait for the zero byte messages of their
+   children while the other ranks send to the parent and complete. Unlike
+   barrier the signals travel in one direction only. */
+
+#define SAVE_STATE(_phase)                                            \
+    do {                                                              \
+        task->fanin_fanout.phase = _phase;                            \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_fanin_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t     *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t     *team  = TASK_TEAM(task);
+    ucc_rank_t             size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t             root  = (ucc_rank_t)TASK_ARGS(task).root;
+    ucc_rank_t             vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_knomial_pattern_t *p     = &task->fanin_fanout.p;
+    ucc_kn_radix_t         radix = p->radix;
+    ucc_memory_type_t      mtype = UCC_MEMORY_TYPE_UNKNOWN;
+    ucc_rank_t             peer;
+    ucc_kn_radix_t         loop_step, digit;
+
+    switch (task->fanin_fanout.phase) {
+    case UCC_FANIN_KN_PHASE_LOOP:
+        goto UCC_FANIN_KN_PHASE_LOOP;
+    case UCC_FANIN_KN_PHASE_SEND:
+        goto UCC_FANIN_KN_PHASE_SEND;
+    default:
+        break;
+    }
+
+    if (KN_NODE_EXTRA == p->node_type) {
+        peer = ucc_knomial_pattern_get_proxy(p, vrank);
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(NULL, 0, mtype,
+                                         INV_VRANK(peer, root, size), team,
+                                         task),
+                      task, out);
+        goto UCC_FANIN_KN_PHASE_SEND;
+    }
+    if (KN_NODE_PROXY == p->node_type) {
+        /* completion is checked together with the first loop iteration */
+        peer = ucc_knomial_pattern_get_extra(p, vrank);
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(NULL, 0, mtype,
+                                         INV_VRANK(peer, root, size), team,
+                                         task),
+                      task, out);
+    }
+
+    while (!ucc_knomial_pattern_loop_done(p)) {
+        if (0 == ucc_knomial_pattern_loop_digit(p, vrank)) {
+            for (loop_step = 1; loop_step < radix; loop_step++) {
+                peer = ucc_knomial_pattern_get_loop_peer(p, vrank, size,
+                                                         loop_step);
+                if (peer == UCC_KN_PEER_NULL) {
+                    continue;
+                }
+                UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(NULL, 0, mtype,
+                                                 INV_VRANK(peer, root, size),
+                                                 team, task),
+                              task, out);
+            }
+        }
+    UCC_FANIN_KN_PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(UCC_FANIN_KN_PHASE_LOOP);
+            return UCC_INPROGRESS;
+        }
+        digit = ucc_knomial_pattern_loop_digit(p, vrank);
+        if (digit != 0) {
+            peer = ucc_knomial_pattern_get_loop_peer(p, vrank, size,
+                                                     radix - digit);
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(NULL, 0, mtype,
+                                             INV_VRANK(peer, root, size), team,
+                                             task),
+                          task, out);
+            goto UCC_FANIN_KN_PHASE_SEND;
+        }
+        ucc_knomial_pattern_next_iteration(p);
+    }
+    goto completion;
+
+UCC_FANIN_KN_PHASE_SEND:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(UCC_FANIN_KN_PHASE_SEND);
+        return UCC_INPROGRESS;
+    }
+
+completion:
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_fanin_kn_done", 0);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_fanin_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_rank_t         size = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root = (ucc_rank_t)TASK_ARGS(task).root;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_fanin_kn_start", 0);
+    task->fanin_fanout.phase = UCC_FANIN_KN_PHASE_INIT;
+    ucc_knomial_pattern_init(
+        size, VRANK(UCC_TL_TEAM_RANK(team), root, size),
+        ucc_min(ucc_tl_ucp_kn_radix(team, &coll_task->bargs,
+                                    UCC_TL_UCP_TEAM_LIB(team)->cfg.fanin_kn_radix,
+                                    UCC_KN_MODEL_TREE, size, 0),
+                size),
+        &task->fanin_fanout.p);
+    ucc_tl_ucp_task_reset(task);
+    status = ucc_tl_ucp_fanin_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
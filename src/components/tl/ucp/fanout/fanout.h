@@ -0,0 +1,23 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef FANOUT_H_
+#define FANOUT_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+enum {
+    UCC_FANOUT_KN_PHASE_INIT,
+    UCC_FANOUT_KN_PHASE_RECV, /* recv from the parent (proxy for extra rank) */
+    UCC_FANOUT_KN_PHASE_SEND  /* sends to the children */
+};
+
+ucc_status_t ucc_tl_ucp_fanout_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_fanout_knomial_start(ucc_coll_task_t *task);
+
+ucc_status_t ucc_tl_ucp_fanout_knomial_progress(ucc_coll_task_t *task);
+
+#endif
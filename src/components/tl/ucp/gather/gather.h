@@ -0,0 +1,24 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#ifndef GATHER_H_
+#define GATHER_H_
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+enum {
+    UCC_GATHER_KN_PHASE_INIT,
+    UCC_GATHER_KN_PHASE_RECV, /* waits for the data of the subtree */
+    UCC_GATHER_KN_PHASE_SEND  /* waits for the send to the parent */
+};
+
+/* Knomial tree gather, uses gather_kn_radix from config */
+ucc_status_t ucc_tl_ucp_gather_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_gather_knomial_start(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_gather_knomial_progress(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_gather_knomial_finalize(ucc_coll_task_t *task);
+
+#endif
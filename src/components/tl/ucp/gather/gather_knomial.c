@@ -0,0 +1,192 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "gather.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* Knomial tree gather: ranks are arranged in a knomial tree over vranks
+   (root is vrank 0), every rank receives the blocks of its children
+   subtrees and forwards the blocks of its own subtree, which are contiguous
+   in vrank order, to the parent in a single message. The data volume
+   reaching the root is (size - 1) blocks, unlike allgather based emulation
+   where every rank receives the full vector. */
+
+static inline size_t ucc_tl_ucp_gather_kn_block(ucc_tl_ucp_task_t *task,
+                                                ucc_memory_type_t *mtype)
+{
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+
+    if (UCC_TL_TEAM_RANK(team) == args->root) {
+        *mtype = args->dst.info.mem_type;
+        return args->dst.info.count / UCC_TL_TEAM_SIZE(team) *
+               ucc_dt_size(args->dst.info.datatype);
+    }
+    *mtype = args->src.info.mem_type;
+    return args->src.info.count * ucc_dt_size(args->src.info.datatype);
+}
+
+ucc_status_t ucc_tl_ucp_gather_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_rank_t         dist  = task->kn_tree.dist;
+    ucc_memory_type_t  mtype;
+    size_t             block;
+    ucc_rank_t         n, child, n_contig, vparent;
+    ucc_status_t       status;
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    if (task->kn_tree.phase == UCC_GATHER_KN_PHASE_RECV) {
+        block = ucc_tl_ucp_gather_kn_block(task, &mtype);
+        if (vrank == 0) {
+            if (ucc_kn_tree_wrapped_child(root, size, task->kn_tree.radix,
+                                          &child, &n)) {
+                n_contig = ucc_kn_tree_n_contig(child, n, root, size);
+                status   = ucc_mc_memcpy(
+                    PTR_OFFSET(args->dst.info.buffer,
+                               INV_VRANK(child, root, size) * block),
+                    task->kn_tree.scratch, n_contig * block, mtype, mtype);
+                if (ucc_likely(UCC_OK == status)) {
+                    status = ucc_mc_memcpy(
+                        args->dst.info.buffer,
+                        PTR_OFFSET(task->kn_tree.scratch, n_contig * block),
+                        (n - n_contig) * block, mtype, mtype);
+                }
+                if (ucc_unlikely(UCC_OK != status)) {
+                    task->super.super.status = status;
+                    return status;
+                }
+            }
+        } else {
+            n       = ucc_kn_tree_subtree_size(vrank, dist, size);
+            vparent = ucc_kn_tree_parent(vrank, dist, task->kn_tree.radix);
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(task->kn_tree.scratch, n * block,
+                                             mtype,
+                                             INV_VRANK(vparent, root, size),
+                                             team, task),
+                          task, out);
+            task->kn_tree.phase = UCC_GATHER_KN_PHASE_SEND;
+            if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+                return task->super.super.status;
+            }
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_gather_kn_done", 0);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_gather_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_kn_radix_t     radix = task->kn_tree.radix;
+    ucc_rank_t         dist  = task->kn_tree.dist;
+    void              *rbuf;
+    ucc_memory_type_t  mtype;
+    size_t             block;
+    ucc_rank_t         d, child, n, vparent;
+    ucc_kn_radix_t     j;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_gather_kn_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    block               = ucc_tl_ucp_gather_kn_block(task, &mtype);
+    task->kn_tree.phase = UCC_GATHER_KN_PHASE_RECV;
+
+    if (vrank == 0) {
+        if (!UCC_IS_INPLACE(*args)) {
+            status = ucc_mc_memcpy(
+                PTR_OFFSET(args->dst.info.buffer, root * block),
+                args->src.info.buffer, block, mtype, args->src.info.mem_type);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+    } else if (ucc_kn_tree_subtree_size(vrank, dist, size) == 1) {
+        /* leaf: own block goes to the parent directly from src */
+        vparent = ucc_kn_tree_parent(vrank, dist, radix);
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(args->src.info.buffer, block, mtype,
+                                         INV_VRANK(vparent, root, size), team,
+                                         task),
+                      task, out);
+        task->kn_tree.phase = UCC_GATHER_KN_PHASE_SEND;
+    } else {
+        status = ucc_mc_memcpy(task->kn_tree.scratch, args->src.info.buffer,
+                               block, mtype, mtype);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+
+    for (d = 1; d < dist && task->kn_tree.phase == UCC_GATHER_KN_PHASE_RECV;
+         d *= radix) {
+        for (j = 1; j < radix; j++) {
+            child = vrank + j * d;
+            if (child >= size) {
+                break;
+            }
+            n = ucc_kn_tree_subtree_size(child, d, size);
+            if (vrank != 0) {
+                rbuf = PTR_OFFSET(task->kn_tree.scratch, (child - vrank) * block);
+            } else if (ucc_kn_tree_n_contig(child, n, root, size) < n) {
+                rbuf = task->kn_tree.scratch;
+            } else {
+                rbuf = PTR_OFFSET(args->dst.info.buffer,
+                                  INV_VRANK(child, root, size) * block);
+            }
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(rbuf, n * block, mtype,
+                                             INV_VRANK(child, root, size),
+                                             team, task),
+                          task, out);
+        }
+    }
+
+    status = ucc_tl_ucp_gather_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_gather_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->kn_tree.scratch_mc_header) {
+        global_st = ucc_mc_free(task->kn_tree.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
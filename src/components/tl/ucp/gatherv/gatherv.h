@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef GATHERV_H_
+#define GATHERV_H_
+
+#include "../tl_ucp.h"
+#include "../tl_ucp_coll.h"
+
+enum {
+    UCC_TL_UCP_GATHERV_ALG_LINEAR,
+    UCC_TL_UCP_GATHERV_ALG_KNOMIAL,
+    UCC_TL_UCP_GATHERV_ALG_LAST
+};
+
+extern ucc_base_coll_alg_info_t
+    ucc_tl_ucp_gatherv_algs[UCC_TL_UCP_GATHERV_ALG_LAST + 1];
+
+enum {
+    UCC_GATHERV_KN_PHASE_COUNTS, /* waits for the counts of the subtree */
+    UCC_GATHERV_KN_PHASE_DATA,   /* waits for the data of the subtree */
+    UCC_GATHERV_KN_PHASE_SEND    /* waits for the completion of the sends */
+};
+
+ucc_status_t ucc_tl_ucp_gatherv_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_gatherv_linear_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_gatherv_linear_init_common(ucc_tl_ucp_task_t *task);
+
+/* Knomial tree with aggregation, uses gatherv_kn_radix from config */
+ucc_status_t ucc_tl_ucp_gatherv_knomial_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h);
+
+ucc_status_t ucc_tl_ucp_gatherv_knomial_init_common(ucc_tl_ucp_task_t *task);
+
+#define GATHERV_TASK_CHECK(_args, _team)                                       \
+    do {                                                                       \
+        if (UCC_TL_TEAM_RANK(_team) == (_args).root &&                         \
+            !UCC_IS_INPLACE(_args) &&                                          \
+            (_args).dst.info_v.mem_type != (_args).src.info.mem_type) {        \
+            tl_error(UCC_TL_TEAM_LIB(_team),                                   \
+                     "assymetric src/dst memory types are not supported yet"); \
+            status = UCC_ERR_NOT_SUPPORTED;                                    \
+            goto out;                                                          \
+        }                                                                      \
+    } while (0)
+
+static inline int ucc_tl_ucp_gatherv_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_TL_UCP_GATHERV_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_tl_ucp_gatherv_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
+
+#endif
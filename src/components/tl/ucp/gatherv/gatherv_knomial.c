@@ -0,0 +1,417 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "gatherv.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Knomial tree gatherv with aggregation: ranks are arranged in a knomial
+   tree over vranks (root is vrank 0) and every non leaf rank forwards the
+   data of its whole subtree, packed in vrank order, to the parent in a single
+   message. This replaces size - 1 messages at the root by log(size) rounds
+   of at most radix - 1 messages, which pays off for small counts.
+   Only the root knows all the counts, so each rank first sends to its
+   parent the counts of its subtree (one uint64_t per rank, host memory).
+   Children of the root skip it since the root takes them from its args. */
+
+#define GATHERV_KN_FOR_EACH_CHILD(_vrank, _dist, _radix, _size, _child, _d, \
+                                  _j)                                       \
+    for ((_d) = 1; (_d) < (_dist); (_d) *= (_radix))                        \
+        for ((_j) = 1; (_j) < (_radix) &&                                   \
+                       ((_child) = (_vrank) + (_j) * (_d)) < (_size);       \
+             (_j)++)
+
+static inline size_t ucc_tl_ucp_gatherv_kn_dt_size(ucc_tl_ucp_task_t *task,
+                                                   ucc_memory_type_t *mtype)
+{
+    ucc_coll_args_t *args = &TASK_ARGS(task);
+
+    if (UCC_TL_TEAM_RANK(TASK_TEAM(task)) == args->root) {
+        *mtype = args->dst.info_v.mem_type;
+        return ucc_dt_size(args->dst.info_v.datatype);
+    }
+    *mtype = args->src.info.mem_type;
+    return ucc_dt_size(args->src.info.datatype);
+}
+
+/* Total count of the subtree [child, child + n) taken from the root args */
+static inline size_t ucc_tl_ucp_gatherv_kn_root_total(ucc_coll_args_t *args,
+                                                      ucc_rank_t child,
+                                                      ucc_rank_t n,
+                                                      ucc_rank_t size)
+{
+    size_t     total = 0;
+    ucc_rank_t i;
+
+    for (i = child; i < child + n; i++) {
+        total += ucc_coll_args_get_count(
+            args, args->dst.info_v.counts,
+            INV_VRANK(i, (ucc_rank_t)args->root, size));
+    }
+    return total;
+}
+
+static inline size_t ucc_tl_ucp_gatherv_kn_sum(const uint64_t *counts,
+                                               ucc_rank_t      n)
+{
+    size_t     total = 0;
+    ucc_rank_t i;
+
+    for (i = 0; i < n; i++) {
+        total += counts[i];
+    }
+    return total;
+}
+
+static ucc_status_t ucc_tl_ucp_gatherv_kn_post_data(ucc_tl_ucp_task_t *task)
+{
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_coll_args_t   *args   = &TASK_ARGS(task);
+    ucc_rank_t         size   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root   = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank  = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_kn_radix_t     radix  = task->kn_treev.radix;
+    size_t             offset = 0;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size, len;
+    ucc_rank_t         d, child, n;
+    ucc_kn_radix_t     j;
+    void              *rbuf;
+    ucc_status_t       status;
+
+    dt_size = ucc_tl_ucp_gatherv_kn_dt_size(task, &mtype);
+    if (vrank != 0) {
+        /* own data goes first */
+        offset = task->kn_treev.counts[0] * dt_size;
+    }
+    GATHERV_KN_FOR_EACH_CHILD(vrank, task->kn_treev.dist, radix, size, child,
+                              d, j) {
+        n = ucc_kn_tree_subtree_size(child, d, size);
+        if (vrank != 0) {
+            len  = ucc_tl_ucp_gatherv_kn_sum(
+                       task->kn_treev.counts + (child - vrank), n) * dt_size;
+            rbuf = PTR_OFFSET(task->kn_treev.scratch, offset);
+        } else if (n == 1) {
+            len  = ucc_coll_args_get_count(args, args->dst.info_v.counts,
+                                           INV_VRANK(child, root, size)) *
+                   dt_size;
+            rbuf = PTR_OFFSET(args->dst.info_v.buffer,
+                              ucc_coll_args_get_displacement(
+                                  args, args->dst.info_v.displacements,
+                                  INV_VRANK(child, root, size)) * dt_size);
+        } else {
+            len  = ucc_tl_ucp_gatherv_kn_root_total(args, child, n, size) *
+                   dt_size;
+            rbuf = PTR_OFFSET(task->kn_treev.scratch, offset);
+        }
+        status = ucc_tl_ucp_recv_nb(rbuf, len, mtype,
+                                    INV_VRANK(child, root, size), team, task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+        if (vrank != 0 || n > 1) {
+            offset += len;
+        }
+    }
+    return UCC_OK;
+}
+
+/* Root: copies the aggregated data of multi rank subtrees from scratch to
+   the user displacements */
+static ucc_status_t ucc_tl_ucp_gatherv_kn_unpack(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(TASK_TEAM(task));
+    ucc_rank_t         root    = (ucc_rank_t)args->root;
+    ucc_kn_radix_t     radix   = task->kn_treev.radix;
+    size_t             dt_size = ucc_dt_size(args->dst.info_v.datatype);
+    ucc_memory_type_t  mtype   = args->dst.info_v.mem_type;
+    size_t             offset  = 0;
+    size_t             len;
+    ucc_rank_t         d, child, n, i, peer;
+    ucc_kn_radix_t     j;
+    ucc_status_t       status;
+
+    GATHERV_KN_FOR_EACH_CHILD(0, task->kn_treev.dist, radix, size, child, d,
+                              j) {
+        n = ucc_kn_tree_subtree_size(child, d, size);
+        if (n == 1) {
+            continue;
+        }
+        for (i = child; i < child + n; i++) {
+            peer   = INV_VRANK(i, root, size);
+            len    = ucc_coll_args_get_count(args, args->dst.info_v.counts,
+                                             peer) * dt_size;
+            status = ucc_mc_memcpy(
+                PTR_OFFSET(args->dst.info_v.buffer,
+                           ucc_coll_args_get_displacement(
+                               args, args->dst.info_v.displacements, peer) *
+                               dt_size),
+                PTR_OFFSET(task->kn_treev.scratch, offset), len, mtype, mtype);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+            offset += len;
+        }
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_rank_t         dist  = task->kn_treev.dist;
+    ucc_rank_t         n     = ucc_kn_tree_subtree_size(vrank, dist, size);
+    ucc_rank_t         vparent, parent;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size;
+    ucc_status_t       status;
+
+    vparent = ucc_kn_tree_parent(vrank, dist, task->kn_treev.radix);
+    parent  = INV_VRANK(vparent, root, size);
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    switch (task->kn_treev.phase) {
+    case UCC_GATHERV_KN_PHASE_COUNTS:
+        dt_size = ucc_tl_ucp_gatherv_kn_dt_size(task, &mtype);
+        task->kn_treev.total = ucc_tl_ucp_gatherv_kn_sum(task->kn_treev.counts,
+                                                         n);
+        if (vparent != 0) {
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(task->kn_treev.counts,
+                                             n * sizeof(uint64_t),
+                                             UCC_MEMORY_TYPE_HOST, parent,
+                                             team, task),
+                          task, out);
+        }
+        if (task->kn_treev.scratch_mc_header) {
+            /* persistent collective restarted */
+            ucc_mc_free(task->kn_treev.scratch_mc_header);
+        }
+        status = ucc_mc_alloc(&task->kn_treev.scratch_mc_header,
+                              ucc_max(task->kn_treev.total * dt_size, 1),
+                              mtype);
+        if (ucc_unlikely(UCC_OK != status)) {
+            task->kn_treev.scratch_mc_header = NULL;
+            tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+            task->super.super.status = status;
+            return status;
+        }
+        task->kn_treev.scratch = task->kn_treev.scratch_mc_header->addr;
+        status = ucc_mc_memcpy(task->kn_treev.scratch, args->src.info.buffer,
+                               args->src.info.count * dt_size, mtype, mtype);
+        if (ucc_unlikely(UCC_OK != status)) {
+            task->super.super.status = status;
+            return status;
+        }
+        UCPCHECK_GOTO(ucc_tl_ucp_gatherv_kn_post_data(task), task, out);
+        task->kn_treev.phase = UCC_GATHERV_KN_PHASE_DATA;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        /* fall through */
+    case UCC_GATHERV_KN_PHASE_DATA:
+        if (vrank == 0) {
+            status = ucc_tl_ucp_gatherv_kn_unpack(task);
+            if (ucc_unlikely(UCC_OK != status)) {
+                task->super.super.status = status;
+                return status;
+            }
+            break;
+        }
+        dt_size = ucc_tl_ucp_gatherv_kn_dt_size(task, &mtype);
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(task->kn_treev.scratch,
+                                         task->kn_treev.total * dt_size, mtype,
+                                         parent, team, task),
+                      task, out);
+        task->kn_treev.phase = UCC_GATHERV_KN_PHASE_SEND;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        break;
+    default:
+        break;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_gatherv_kn_done", 0);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_kn_radix_t     radix = task->kn_treev.radix;
+    ucc_rank_t         dist  = task->kn_treev.dist;
+    ucc_rank_t         d, child, vparent;
+    ucc_kn_radix_t     j;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_gatherv_kn_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    dt_size = ucc_tl_ucp_gatherv_kn_dt_size(task, &mtype);
+
+    if (vrank == 0) {
+        if (!UCC_IS_INPLACE(*args)) {
+            status = ucc_mc_memcpy(
+                PTR_OFFSET(args->dst.info_v.buffer,
+                           ucc_coll_args_get_displacement(
+                               args, args->dst.info_v.displacements, root) *
+                               dt_size),
+                args->src.info.buffer,
+                ucc_coll_args_get_count(args, args->dst.info_v.counts, root) *
+                    dt_size,
+                mtype, args->src.info.mem_type);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+        UCPCHECK_GOTO(ucc_tl_ucp_gatherv_kn_post_data(task), task, out);
+        task->kn_treev.phase = UCC_GATHERV_KN_PHASE_DATA;
+    } else if (ucc_kn_tree_subtree_size(vrank, dist, size) == 1) {
+        /* leaf: own count (unless the parent is the root) and data go to the
+           parent directly */
+        vparent              = ucc_kn_tree_parent(vrank, dist, radix);
+        task->kn_treev.total = args->src.info.count;
+        if (vparent != 0) {
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(&task->kn_treev.total,
+                                             sizeof(uint64_t),
+                                             UCC_MEMORY_TYPE_HOST,
+                                             INV_VRANK(vparent, root, size),
+                                             team, task),
+                          task, out);
+        }
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(args->src.info.buffer,
+                                         args->src.info.count * dt_size, mtype,
+                                         INV_VRANK(vparent, root, size), team,
+                                         task),
+                      task, out);
+        task->kn_treev.phase = UCC_GATHERV_KN_PHASE_SEND;
+    } else {
+        task->kn_treev.counts[0] = args->src.info.count;
+        GATHERV_KN_FOR_EACH_CHILD(vrank, dist, radix, size, child, d, j) {
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(
+                              task->kn_treev.counts + (child - vrank),
+                              ucc_kn_tree_subtree_size(child, d, size) *
+                                  sizeof(uint64_t),
+                              UCC_MEMORY_TYPE_HOST,
+                              INV_VRANK(child, root, size), team, task),
+                          task, out);
+        }
+        task->kn_treev.phase = UCC_GATHERV_KN_PHASE_COUNTS;
+    }
+
+    status = ucc_tl_ucp_gatherv_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->kn_treev.scratch_mc_header) {
+        global_st = ucc_mc_free(task->kn_treev.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    ucc_free(task->kn_treev.counts);
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+ucc_status_t ucc_tl_ucp_gatherv_knomial_init_common(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args   = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_rank_t         size   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root   = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank  = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    size_t             scratch_size = 0;
+    ucc_rank_t         d, child, n;
+    ucc_kn_radix_t     j, radix;
+    ucc_status_t       status;
+
+    task->super.post     = ucc_tl_ucp_gatherv_knomial_start;
+    task->super.progress = ucc_tl_ucp_gatherv_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_gatherv_knomial_finalize;
+
+    radix = ucc_tl_ucp_kn_radix(team, &task->super.bargs,
+                                UCC_TL_UCP_TEAM_LIB(team)->cfg.gatherv_kn_radix,
+                                UCC_KN_MODEL_TREE, size, 0);
+    radix = ucc_max(ucc_min(radix, size), 2);
+    task->kn_treev.radix             = radix;
+    task->kn_treev.dist              = ucc_kn_tree_dist(vrank, size, radix);
+    task->kn_treev.counts            = NULL;
+    task->kn_treev.scratch           = NULL;
+    task->kn_treev.scratch_mc_header = NULL;
+
+    if (vrank != 0) {
+        /* scratch of non leaf ranks is allocated once the counts of the
+           subtree are known */
+        n = ucc_kn_tree_subtree_size(vrank, task->kn_treev.dist, size);
+        if (n > 1) {
+            task->kn_treev.counts =
+                ucc_malloc(n * sizeof(uint64_t), "gatherv_kn_counts");
+            if (!task->kn_treev.counts) {
+                tl_error(UCC_TL_TEAM_LIB(team),
+                         "failed to allocate %zd bytes for counts",
+                         n * sizeof(uint64_t));
+                return UCC_ERR_NO_MEMORY;
+            }
+        }
+        return UCC_OK;
+    }
+    GATHERV_KN_FOR_EACH_CHILD(0, task->kn_treev.dist, radix, size, child, d,
+                              j) {
+        n = ucc_kn_tree_subtree_size(child, d, size);
+        if (n > 1) {
+            scratch_size += ucc_tl_ucp_gatherv_kn_root_total(args, child, n,
+                                                             size);
+        }
+    }
+    if (scratch_size == 0) {
+        return UCC_OK;
+    }
+    status = ucc_mc_alloc(&task->kn_treev.scratch_mc_header,
+                          scratch_size * ucc_dt_size(args->dst.info_v.datatype),
+                          args->dst.info_v.mem_type);
+    if (ucc_unlikely(UCC_OK != status)) {
+        tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate scratch buffer");
+        return status;
+    }
+    task->kn_treev.scratch = task->kn_treev.scratch_mc_header->addr;
+    return UCC_OK;
+}
@@ -6,11 +6,32 @@
 #include "config.h"
 #include "reduce.h"
 
+ucc_base_coll_alg_info_t
+    ucc_tl_ucp_reduce_algs[UCC_TL_UCP_REDUCE_ALG_LAST + 1] = {
+        [UCC_TL_UCP_REDUCE_ALG_KNOMIAL] =
+            {.id   = UCC_TL_UCP_REDUCE_ALG_KNOMIAL,
+             .name = "knomial",
+             .desc = "reduce over knomial tree with arbitrary radix "
+                     "(latency oriented alg)"},
+        [UCC_TL_UCP_REDUCE_ALG_SRG_KNOMIAL] =
+            {.id   = UCC_TL_UCP_REDUCE_ALG_SRG_KNOMIAL,
+             .name = "srg_knomial",
+             .desc = "recursive k-nomial reduce_scatter followed by gather "
+                     "of the reduced segments to root (bw oriented alg)"},
+        [UCC_TL_UCP_REDUCE_ALG_PIPELINED] =
+            {.id   = UCC_TL_UCP_REDUCE_ALG_PIPELINED,
+             .name = "pipelined",
+             .desc = "fragmented reduce pipelined over knomial tree, "
+                     "binomial by default (mid size messages)"},
+        [UCC_TL_UCP_REDUCE_ALG_LAST] = {
+            .id = 0, .name = NULL, .desc = NULL}};
+
 ucc_status_t ucc_tl_ucp_reduce_knomial_start(ucc_coll_task_t *task);
 ucc_status_t ucc_tl_ucp_reduce_knomial_progress(ucc_coll_task_t *task);
 ucc_status_t ucc_tl_ucp_reduce_knomial_finalize(ucc_coll_task_t *task);
 
-ucc_status_t ucc_tl_ucp_reduce_init(ucc_tl_ucp_task_t *task)
+static ucc_status_t ucc_tl_ucp_reduce_knomial_setup(ucc_tl_ucp_task_t *task,
+                                                    ucc_kn_radix_t     radix)
 {
     ucc_coll_args_t   *args      = &TASK_ARGS(task);
     ucc_tl_ucp_team_t *team      = TASK_TEAM(task);
@@ -33,8 +54,7 @@ ucc_status_t ucc_tl_ucp_reduce_init(ucc_tl_ucp_task_t *task)
     task->super.post      = ucc_tl_ucp_reduce_knomial_start;
     task->super.progress  = ucc_tl_ucp_reduce_knomial_progress;
     task->super.finalize  = ucc_tl_ucp_reduce_knomial_finalize;
-    task->reduce_kn.radix =
-        ucc_min(UCC_TL_UCP_TEAM_LIB(team)->cfg.reduce_kn_radix, team_size);
+    task->reduce_kn.radix = radix;
     CALC_KN_TREE_DIST(team_size, task->reduce_kn.radix,
                       task->reduce_kn.max_dist);
     isleaf = (vrank % task->reduce_kn.radix != 0 || vrank == team_size - 1);
@@ -51,3 +71,60 @@ ucc_status_t ucc_tl_ucp_reduce_init(ucc_tl_ucp_task_t *task)
     }
     return status;
 }
+
+ucc_status_t ucc_tl_ucp_reduce_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args      = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team      = TASK_TEAM(task);
+    ucc_rank_t         team_size = UCC_TL_TEAM_SIZE(team);
+    size_t             data_size;
+
+    if (args->root == UCC_TL_TEAM_RANK(team)) {
+        data_size = args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+    } else {
+        data_size = args->src.info.count * ucc_dt_size(args->src.info.datatype);
+    }
+    return ucc_tl_ucp_reduce_knomial_setup(
+        task, ucc_min(ucc_tl_ucp_kn_radix(
+                          team, &task->super.bargs,
+                          UCC_TL_UCP_TEAM_LIB(team)->cfg.reduce_kn_radix,
+                          UCC_KN_MODEL_TREE, team_size, data_size),
+                      team_size));
+}
+
+ucc_status_t ucc_tl_ucp_reduce_knomial_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_reduce_init(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    *task_h = &task->super;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_knomial_init_r(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h,
+                                              ucc_kn_radix_t        radix)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_reduce_knomial_setup(
+        task, ucc_min(radix, UCC_TL_TEAM_SIZE(tl_team)));
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    *task_h = &task->super;
+    return UCC_OK;
+}
@@ -7,6 +7,19 @@
 #define REDUCE_H_
 #include "../tl_ucp_reduce.h"
 
+enum {
+    UCC_TL_UCP_REDUCE_ALG_KNOMIAL,
+    UCC_TL_UCP_REDUCE_ALG_SRG_KNOMIAL,
+    UCC_TL_UCP_REDUCE_ALG_PIPELINED,
+    UCC_TL_UCP_REDUCE_ALG_LAST
+};
+
+extern ucc_base_coll_alg_info_t
+    ucc_tl_ucp_reduce_algs[UCC_TL_UCP_REDUCE_ALG_LAST + 1];
+
+#define UCC_TL_UCP_REDUCE_DEFAULT_ALG_SELECT_STR                               \
+    "reduce:0-32k:@knomial#reduce:32k-1m:@pipelined#reduce:1m-inf:@srg_knomial"
+
 /* A set of convenience macros used to implement sw based progress
    of the reduce algorithm that uses kn pattern */
 enum {
@@ -30,4 +43,39 @@ enum {
 
 ucc_status_t ucc_tl_ucp_reduce_init(ucc_tl_ucp_task_t *task);
 
+/* Knomial tree reduce with the given radix, the scratch is sized for the
+   count of coll_args */
+ucc_status_t ucc_tl_ucp_reduce_knomial_init_r(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h,
+                                              ucc_kn_radix_t        radix);
+
+ucc_status_t ucc_tl_ucp_reduce_knomial_init(ucc_base_coll_args_t *coll_args,
+                                            ucc_base_team_t      *team,
+                                            ucc_coll_task_t     **task_h);
+
+/* Scatter-reduce-gather: knomial reduce_scatter followed by the gather of
+   the reduced segments to the root, uses reduce_srg_kn_radix from config */
+ucc_status_t
+ucc_tl_ucp_reduce_srg_knomial_init(ucc_base_coll_args_t *coll_args,
+                                   ucc_base_team_t      *team,
+                                   ucc_coll_task_t     **task_h);
+
+/* Fragmented knomial tree reduce (binomial by default), uses
+   reduce_pipeline_radix, frag_size and depth from config */
+ucc_status_t ucc_tl_ucp_reduce_pipelined_init(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h);
+
+static inline int ucc_tl_ucp_reduce_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_TL_UCP_REDUCE_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_tl_ucp_reduce_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
+
 #endif
@@ -0,0 +1,174 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "reduce.h"
+#include "utils/ucc_math.h"
+
+/* Segmented pipelined reduce: the vector is split into fragments reduced
+   by independent knomial tree tasks (binomial with the default
+   reduce_pipeline_radix), up to pipeline depth of them in flight. An inner
+   rank of the tree reduces fragment i while the fragments i + 1, .. are
+   being received from its children, so for mid size messages the tree
+   depth is paid once per fragment rather than once per vector. */
+
+static ucc_status_t ucc_tl_ucp_reduce_pipelined_frag_start(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+
+    return ucc_schedule_start(schedule);
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_pipelined_frag_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(task, ucc_schedule_t);
+    ucc_status_t    status;
+
+    status = ucc_schedule_finalize(task);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+static inline size_t ucc_tl_ucp_reduce_pipelined_count(ucc_coll_args_t *args,
+                                                       ucc_base_team_t *team,
+                                                       size_t *dt_size)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+
+    if (UCC_TL_TEAM_RANK(tl_team) == args->root) {
+        *dt_size = ucc_dt_size(args->dst.info.datatype);
+        return args->dst.info.count;
+    }
+    *dt_size = ucc_dt_size(args->src.info.datatype);
+    return args->src.info.count;
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_pipelined_frag_setup(ucc_schedule_pipelined_t *schedule_p,
+                                       ucc_schedule_t *frag, int frag_num)
+{
+    ucc_coll_args_t *args    = &schedule_p->super.super.bargs.args;
+    int              n_frags = schedule_p->n_frags_total;
+    ucc_coll_args_t *targs   = &frag->tasks[0]->bargs.args;
+    size_t           dt_size, count, frag_count, left, offset;
+
+    count      = ucc_tl_ucp_reduce_pipelined_count(
+        args, schedule_p->super.super.team, &dt_size);
+    frag_count = count / n_frags;
+    left       = count % n_frags;
+    offset     = frag_num * frag_count + left;
+    if (frag_num < left) {
+        frag_count++;
+        offset -= left - frag_num;
+    }
+    targs->src.info.buffer = PTR_OFFSET(args->src.info.buffer,
+                                        offset * dt_size);
+    targs->dst.info.buffer = PTR_OFFSET(args->dst.info.buffer,
+                                        offset * dt_size);
+    targs->src.info.count  = frag_count;
+    targs->dst.info.count  = frag_count;
+    return UCC_OK;
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_pipelined_frag_init(ucc_base_coll_args_t     *coll_args,
+                                      ucc_schedule_pipelined_t *sp,
+                                      ucc_base_team_t          *team,
+                                      ucc_schedule_t          **frag_p)
+{
+    ucc_tl_ucp_team_t   *tl_team  = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_schedule_t      *schedule = ucc_tl_ucp_get_schedule(tl_team, coll_args);
+    ucc_base_coll_args_t args     = *coll_args;
+    int                  n_frags  = sp->n_frags_total;
+    ucc_coll_task_t     *task;
+    size_t               dt_size, count;
+    ucc_status_t         status;
+
+    /* scratch of the fragment task is sized for the largest fragment */
+    count = ucc_tl_ucp_reduce_pipelined_count(&coll_args->args, team,
+                                              &dt_size);
+    args.args.src.info.count = ucc_div_round_up(count, n_frags);
+    args.args.dst.info.count = args.args.src.info.count;
+    status                   = ucc_tl_ucp_reduce_knomial_init_r(
+        &args, team, &task,
+        ucc_max(UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.reduce_pipeline_radix, 2));
+    if (UCC_OK != status) {
+        tl_error(UCC_TL_TEAM_LIB(tl_team),
+                 "failed to init reduce_knomial task");
+        ucc_tl_ucp_put_schedule(schedule);
+        return status;
+    }
+    ucc_schedule_add_task(schedule, task);
+    ucc_task_subscribe_dep(&schedule->super, task, UCC_EVENT_SCHEDULE_STARTED);
+    schedule->super.finalize = ucc_tl_ucp_reduce_pipelined_frag_finalize;
+    schedule->super.post     = ucc_tl_ucp_reduce_pipelined_frag_start;
+    *frag_p                  = schedule;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_reduce_pipelined_finalize(ucc_coll_task_t *task)
+{
+    ucc_schedule_pipelined_t *schedule =
+        ucc_derived_of(task, ucc_schedule_pipelined_t);
+    ucc_status_t status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(schedule, "ucp_reduce_pipelined_done", 0);
+    status = ucc_schedule_pipelined_finalize(task);
+    ucc_tl_ucp_put_schedule_pipelined(schedule);
+    return status;
+}
+
+static ucc_status_t ucc_tl_ucp_reduce_pipelined_start(ucc_coll_task_t *task)
+{
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(task, "ucp_reduce_pipelined_start", 0);
+    return ucc_schedule_pipelined_post(task);
+}
+
+ucc_status_t ucc_tl_ucp_reduce_pipelined_init(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t        *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_lib_config_t  *cfg     = &UCC_TL_UCP_TEAM_LIB(tl_team)->cfg;
+    ucc_schedule_pipelined_t *schedule_p;
+    int                       n_frags, pipeline_depth;
+    size_t                    count, dt_size, msgsize;
+    ucc_status_t              status;
+
+    count   = ucc_tl_ucp_reduce_pipelined_count(&coll_args->args, team,
+                                                &dt_size);
+    msgsize = count * dt_size;
+    n_frags = 1;
+    if (cfg->reduce_pipeline_frag_size > 0 &&
+        msgsize > cfg->reduce_pipeline_frag_size) {
+        /* fragments are not smaller than a single element */
+        n_frags = ucc_min(ucc_div_round_up(msgsize,
+                                           cfg->reduce_pipeline_frag_size),
+                          count);
+    }
+    pipeline_depth = ucc_max(ucc_min(n_frags, cfg->reduce_pipeline_depth), 1);
+
+    schedule_p = ucc_tl_ucp_get_schedule_pipelined(tl_team);
+    if (!schedule_p) {
+        tl_error(team->context->lib, "failed to allocate pipelined schedule");
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = ucc_schedule_pipelined_init(
+        coll_args, team, ucc_tl_ucp_reduce_pipelined_frag_init,
+        ucc_tl_ucp_reduce_pipelined_frag_setup, pipeline_depth, n_frags, 0,
+        schedule_p);
+    if (UCC_OK != status) {
+        tl_error(team->context->lib, "failed to init pipelined schedule");
+        ucc_tl_ucp_put_schedule_pipelined(schedule_p);
+        return status;
+    }
+    schedule_p->super.super.finalize       = ucc_tl_ucp_reduce_pipelined_finalize;
+    schedule_p->super.super.triggered_post = ucc_triggered_post;
+    schedule_p->super.super.post           = ucc_tl_ucp_reduce_pipelined_start;
+    *task_h                                = &schedule_p->super.super;
+    return UCC_OK;
+}
@@ -0,0 +1,253 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "reduce.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "coll_patterns/sra_knomial.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+#include "../reduce_scatter/reduce_scatter.h"
+
+/* SRG - scatter-reduce-gather knomial algorithm
+   1. The algorithm performs collective reduce operation as a sequence of
+      K-nomial Reduce-Scatter followed by the gather of the reduced segments
+      to the root, i.e. the SRA allreduce (allreduce_sra_knomial.c) with the
+      allgather replaced by gather (Rabenseifner2004,
+      https://doi.org/10.1007/978-3-540-24685-5_1).
+   2. The algorithm targets Large message sizes: every rank sends and
+      receives about 2 * (size - 1) / size of the vector instead of
+      log(size) full vectors of the tree reduce.
+   3. After the reduce-scatter the segment of a non EXTRA rank is located in
+      its dst at the offset given by ucc_sra_kn_get_offset_and_seglen. The
+      segments are ordered by the knomial pattern and not by rank, so instead
+      of a gather tree (which would need packing of non contiguous segments)
+      every rank sends its segment directly into the dst of the root. The
+      data volume reaching the root is the same, without extra copies.
+   4. Non root ranks have no dst, a scratch of the vector size holds their
+      reduce-scatter result and is owned by the gather task.
+ */
+
+static ucc_status_t
+ucc_tl_ucp_reduce_srg_knomial_gather_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_reduce_srg_kn_gather_done",
+                                     0);
+    return task->super.super.status;
+}
+
+static inline int ucc_tl_ucp_reduce_srg_knomial_is_extra(ucc_rank_t     rank,
+                                                         ucc_rank_t     size,
+                                                         ucc_kn_radix_t radix)
+{
+    ucc_knomial_pattern_t p;
+
+    ucc_knomial_pattern_init(size, rank, radix, &p);
+    return KN_NODE_EXTRA == p.node_type;
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_srg_knomial_gather_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task    = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         rank    = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root    = (ucc_rank_t)args->root;
+    ucc_kn_radix_t     radix   = task->reduce_srg_kn.radix;
+    size_t             count   = args->dst.info.count;
+    size_t             dt_size = ucc_dt_size(args->dst.info.datatype);
+    ucc_memory_type_t  mtype   = args->dst.info.mem_type;
+    ptrdiff_t          offset;
+    size_t             seglen;
+    ucc_rank_t         peer;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task,
+                                     "ucp_reduce_srg_kn_gather_start", 0);
+    ucc_tl_ucp_task_reset(task);
+
+    if (rank == root) {
+        for (peer = 0; peer < size; peer++) {
+            if (peer == root ||
+                ucc_tl_ucp_reduce_srg_knomial_is_extra(peer, size, radix)) {
+                continue;
+            }
+            ucc_sra_kn_get_offset_and_seglen(count, dt_size, peer, size, radix,
+                                             &offset, &seglen);
+            if (seglen == 0) {
+                continue;
+            }
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(
+                              PTR_OFFSET(args->dst.info.buffer, offset),
+                              seglen * dt_size, mtype, peer, team, task),
+                          task, out);
+        }
+    } else if (!ucc_tl_ucp_reduce_srg_knomial_is_extra(rank, size, radix)) {
+        ucc_sra_kn_get_offset_and_seglen(count, dt_size, rank, size, radix,
+                                         &offset, &seglen);
+        if (seglen > 0) {
+            UCPCHECK_GOTO(ucc_tl_ucp_send_nb(
+                              PTR_OFFSET(args->dst.info.buffer, offset),
+                              seglen * dt_size, mtype, root, team, task),
+                          task, out);
+        }
+    }
+
+    status = ucc_tl_ucp_reduce_srg_knomial_gather_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_srg_knomial_gather_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->reduce_srg_kn.scratch_mc_header) {
+        global_st = ucc_mc_free(task->reduce_srg_kn.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_srg_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(coll_task, ucc_schedule_t);
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(schedule, "ucp_reduce_srg_kn_start", 0);
+    return ucc_schedule_start(schedule);
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_srg_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_schedule_t *schedule = ucc_derived_of(coll_task, ucc_schedule_t);
+    ucc_status_t    status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(schedule, "ucp_reduce_srg_kn_done", 0);
+    status = ucc_schedule_finalize(coll_task);
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
+
+ucc_status_t
+ucc_tl_ucp_reduce_srg_knomial_init(ucc_base_coll_args_t *coll_args,
+                                   ucc_base_team_t      *team,
+                                   ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t      *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_coll_args_t        *args    = &coll_args->args;
+    ucc_rank_t              size    = UCC_TL_TEAM_SIZE(tl_team);
+    int                     is_root = UCC_TL_TEAM_RANK(tl_team) == args->root;
+    ucc_base_coll_args_t    rs_args = *coll_args;
+    ucc_mc_buffer_header_t *scratch = NULL;
+    ucc_coll_buffer_info_t *info;
+    ucc_schedule_t         *schedule;
+    ucc_coll_task_t        *rs_task;
+    ucc_tl_ucp_task_t      *task;
+    ucc_kn_radix_t          radix, cfg_radix;
+    ucc_status_t            status;
+
+    info = is_root ? &args->dst.info : &args->src.info;
+    if (is_root && !UCC_IS_INPLACE(*args) &&
+        args->src.info.mem_type != args->dst.info.mem_type) {
+        tl_debug(UCC_TL_TEAM_LIB(tl_team),
+                 "asymmetric src/dst memory types are not supported");
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+    if (info->count < size) {
+        /* less than an element per rank, nothing to scatter */
+        return ucc_tl_ucp_reduce_knomial_init(coll_args, team, task_h);
+    }
+
+    cfg_radix = ucc_tl_ucp_kn_radix(
+        tl_team, coll_args,
+        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.reduce_srg_kn_radix,
+        UCC_KN_MODEL_SRA, size, info->count * ucc_dt_size(info->datatype));
+    radix = ucc_knomial_pattern_get_min_radix(cfg_radix, size, info->count);
+
+    /* reduce_scatter leaves the segment of the rank in dst of the root and
+       in the scratch of the other ranks */
+    if (is_root) {
+        if (UCC_IS_INPLACE(*args)) {
+            rs_args.args.src.info = args->dst.info;
+        }
+    } else {
+        status = ucc_mc_alloc(&scratch,
+                              info->count * ucc_dt_size(info->datatype),
+                              info->mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            tl_error(UCC_TL_TEAM_LIB(tl_team),
+                     "failed to allocate scratch buffer");
+            return status;
+        }
+        rs_args.args.flags          &= ~UCC_COLL_ARGS_FLAG_IN_PLACE;
+        rs_args.args.dst.info        = args->src.info;
+        rs_args.args.dst.info.buffer = scratch->addr;
+    }
+
+    schedule = ucc_tl_ucp_get_schedule(tl_team, coll_args);
+    /* 1st step of reduce: knomial reduce_scatter */
+    status = ucc_tl_ucp_reduce_scatter_knomial_init_r(&rs_args, team, &rs_task,
+                                                      radix);
+    if (UCC_OK != status) {
+        tl_error(UCC_TL_TEAM_LIB(tl_team),
+                 "failed to init reduce_scatter_knomial task");
+        goto out;
+    }
+    ucc_schedule_add_task(schedule, rs_task);
+    ucc_task_subscribe_dep(&schedule->super, rs_task,
+                           UCC_EVENT_SCHEDULE_STARTED);
+
+    /* 2nd step of reduce: gather of the segments to root, subscribes
+       to completion event of reduce_scatter task */
+    task                 = ucc_tl_ucp_init_task(&rs_args, team);
+    task->super.post     = ucc_tl_ucp_reduce_srg_knomial_gather_start;
+    task->super.progress = ucc_tl_ucp_reduce_srg_knomial_gather_progress;
+    task->super.finalize = ucc_tl_ucp_reduce_srg_knomial_gather_finalize;
+    task->reduce_srg_kn.radix             = radix;
+    task->reduce_srg_kn.scratch_mc_header = scratch;
+    ucc_schedule_add_task(schedule, &task->super);
+    ucc_task_subscribe_dep(rs_task, &task->super, UCC_EVENT_COMPLETED);
+
+    schedule->super.post           = ucc_tl_ucp_reduce_srg_knomial_start;
+    schedule->super.progress       = NULL;
+    schedule->super.finalize       = ucc_tl_ucp_reduce_srg_knomial_finalize;
+    schedule->super.triggered_post = ucc_triggered_post;
+    *task_h                        = &schedule->super;
+    return UCC_OK;
+out:
+    if (scratch) {
+        ucc_mc_free(scratch);
+    }
+    ucc_tl_ucp_put_schedule(schedule);
+    return status;
+}
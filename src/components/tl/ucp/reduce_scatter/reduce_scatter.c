@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce_scatter.h"
+
+ucc_base_coll_alg_info_t
+    ucc_tl_ucp_reduce_scatter_algs[UCC_TL_UCP_REDUCE_SCATTER_ALG_LAST + 1] = {
+        [UCC_TL_UCP_REDUCE_SCATTER_ALG_KNOMIAL] =
+            {.id   = UCC_TL_UCP_REDUCE_SCATTER_ALG_KNOMIAL,
+             .name = "knomial",
+             .desc = "recursive k-ing with arbitrary radix"},
+        [UCC_TL_UCP_REDUCE_SCATTER_ALG_RING] =
+            {.id   = UCC_TL_UCP_REDUCE_SCATTER_ALG_RING,
+             .name = "ring",
+             .desc = "O(N) ring implementation (bw oriented alg)"},
+        [UCC_TL_UCP_REDUCE_SCATTER_ALG_LAST] = {
+            .id = 0, .name = NULL, .desc = NULL}};
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t *args   = &TASK_ARGS(task);
+    ucc_status_t     status = UCC_OK;
+
+    REDUCE_SCATTER_TASK_CHECK(*args, args->src.info.mem_type,
+                              args->dst.info.mem_type, TASK_TEAM(task));
+    status = ucc_tl_ucp_reduce_scatter_ring_init_common(task);
+out:
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_init(ucc_base_coll_args_t *coll_args,
+                                                 ucc_base_team_t      *team,
+                                                 ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_reduce_scatter_init(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        return status;
+    }
+    *task_h = &task->super;
+    return UCC_OK;
+}
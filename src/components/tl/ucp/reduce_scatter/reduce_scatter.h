@@ -7,15 +7,60 @@
 #define REDUCE_SCATTER_H_
 #include "../tl_ucp_reduce.h"
 
-/* Base interface signature: uses reduce_scatter_kn_radix from config. */
+enum {
+    UCC_TL_UCP_REDUCE_SCATTER_ALG_KNOMIAL,
+    UCC_TL_UCP_REDUCE_SCATTER_ALG_RING,
+    UCC_TL_UCP_REDUCE_SCATTER_ALG_LAST
+};
 
+extern ucc_base_coll_alg_info_t
+    ucc_tl_ucp_reduce_scatter_algs[UCC_TL_UCP_REDUCE_SCATTER_ALG_LAST + 1];
+
+#define UCC_TL_UCP_REDUCE_SCATTER_DEFAULT_ALG_SELECT_STR                       \
+    "reduce_scatter:0-64k:@knomial#reduce_scatter:64k-inf:@ring"
+
+#define REDUCE_SCATTER_TASK_CHECK(_args, _src_mem, _dst_mem, _team)            \
+    do {                                                                       \
+        if (!UCC_IS_INPLACE(_args) && ((_src_mem) != (_dst_mem))) {            \
+            tl_error(UCC_TL_TEAM_LIB(_team),                                   \
+                     "assymetric src/dst memory types are not supported yet"); \
+            status = UCC_ERR_NOT_SUPPORTED;                                    \
+            goto out;                                                          \
+        }                                                                      \
+    } while (0)
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_init(ucc_tl_ucp_task_t *task);
+
+/* Recursive k-ing reduce-scatter of the rank ordered blocks (user
+   collective), uses reduce_scatter_kn_radix from config */
 ucc_status_t
 ucc_tl_ucp_reduce_scatter_knomial_init(ucc_base_coll_args_t *coll_args,
                                        ucc_base_team_t      *team,
                                        ucc_coll_task_t     **task_h);
 
-/* Internal interface to KN reduce scatter with custom radix */
+/* Internal interface to KN reduce scatter with custom radix, data layout of
+   SRA knomial allreduce */
 ucc_status_t ucc_tl_ucp_reduce_scatter_knomial_init_r(
     ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
     ucc_coll_task_t **task_h, ucc_kn_radix_t radix);
+
+/* Ring reduce-scatter, also serves reduce-scatterv */
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_init(ucc_base_coll_args_t *coll_args,
+                                                 ucc_base_team_t      *team,
+                                                 ucc_coll_task_t     **task_h);
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_init_common(ucc_tl_ucp_task_t *task);
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_start(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_progress(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_finalize(ucc_coll_task_t *task);
+
+static inline int ucc_tl_ucp_reduce_scatter_alg_from_str(const char *str)
+{
+    int i;
+    for (i = 0; i < UCC_TL_UCP_REDUCE_SCATTER_ALG_LAST; i++) {
+        if (0 == strcasecmp(str, ucc_tl_ucp_reduce_scatter_algs[i].name)) {
+            break;
+        }
+    }
+    return i;
+}
 #endif
@@ -6,6 +6,7 @@
 
 #include "config.h"
 #include "tl_ucp_reduce.h"
+#include "reduce_scatter.h"
 #include "tl_ucp_sendrecv.h"
 #include "core/ucc_progress_queue.h"
 #include "coll_patterns/sra_knomial.h"
@@ -263,18 +264,299 @@ ucc_status_t ucc_tl_ucp_reduce_scatter_knomial_init_r(
     return UCC_OK;
 }
 
+/* Recursive k-ing reduce-scatter of the rank ordered blocks, the reverse of
+   the rank ordered knomial allgather: at every step the range of blocks of
+   the group of radix_pow * radix loop ranks is split between its radix
+   subgroups (see ucc_knomial_pattern_loop_range), rank sends every peer the
+   range of the peer's subgroup and reduces the range of its own subgroup
+   received from the peers. Extra rank sends its vector to the proxy and
+   gets its reduced block back. Scratch holds the partial result (whole
+   vector) followed by the receive area. */
+static inline size_t
+ucc_tl_ucp_reduce_scatter_knomial_recv_blocks(ucc_knomial_pattern_t *pattern,
+                                              ucc_rank_t size, ucc_rank_t rank)
+{
+    ucc_knomial_pattern_t p = *pattern;
+    size_t                max, n_peers;
+    ucc_rank_t            start, n_blocks;
+    ucc_kn_radix_t        loop_step;
+
+    if (KN_NODE_EXTRA == p.node_type) {
+        return 0;
+    }
+    max = (KN_NODE_PROXY == p.node_type) ? size : 0;
+    while (!ucc_knomial_pattern_loop_done_backward(&p)) {
+        n_peers = 0;
+        for (loop_step = 1; loop_step < p.radix; loop_step++) {
+            if (ucc_knomial_pattern_get_loop_peer(&p, rank, size, loop_step) !=
+                UCC_KN_PEER_NULL) {
+                n_peers++;
+            }
+        }
+        ucc_knomial_pattern_loop_range(&p, size, rank, &start, &n_blocks);
+        max = ucc_max(max, n_peers * n_blocks);
+        ucc_knomial_pattern_next_iteration_backward(&p);
+    }
+    return max;
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_scatter_knomial_rec_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t     *task      = ucc_derived_of(coll_task,
+                                                      ucc_tl_ucp_task_t);
+    ucc_coll_args_t       *args      = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t     *team      = TASK_TEAM(task);
+    ucc_knomial_pattern_t *p         = &task->reduce_scatter_kn.p;
+    ucc_kn_radix_t         radix     = p->radix;
+    uint8_t                node_type = p->node_type;
+    ucc_memory_type_t      mem_type  = args->dst.info.mem_type;
+    ucc_datatype_t         dt        = args->dst.info.datatype;
+    ucc_rank_t             size      = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t             rank      = task->subset.myrank;
+    size_t                 b_count   = UCC_IS_INPLACE(*args)
+                                           ? args->dst.info.count / size
+                                           : args->dst.info.count;
+    size_t                 data_size = b_count * ucc_dt_size(dt);
+    void                  *scratch   = task->reduce_scatter_kn.scratch;
+    void                  *rcv       = PTR_OFFSET(scratch, size * data_size);
+    void                  *sbuf      = UCC_IS_INPLACE(*args)
+                                           ? args->dst.info.buffer
+                                           : args->src.info.buffer;
+    void                  *rbuf      = UCC_IS_INPLACE(*args)
+                                           ? PTR_OFFSET(args->dst.info.buffer,
+                                                        rank * data_size)
+                                           : args->dst.info.buffer;
+    ucc_rank_t             peer, start, n_blocks, n_peers;
+    ucc_kn_radix_t         loop_step;
+    ucc_status_t           status;
+    void                  *data;
+
+    UCC_KN_GOTO_PHASE(task->reduce_scatter_kn.phase);
+    if (KN_NODE_EXTRA == node_type) {
+        peer = ucc_ep_map_eval(task->subset.map,
+                               ucc_knomial_pattern_get_proxy(p, rank));
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(sbuf, size * data_size, mem_type,
+                                         peer, team, task),
+                      task, out);
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(rbuf, data_size, mem_type, peer,
+                                         team, task),
+                      task, out);
+    }
+    if (KN_NODE_PROXY == node_type) {
+        peer = ucc_ep_map_eval(task->subset.map,
+                               ucc_knomial_pattern_get_extra(p, rank));
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(rcv, size * data_size, mem_type,
+                                         peer, team, task),
+                      task, out);
+    }
+UCC_KN_PHASE_EXTRA:
+    if (KN_NODE_PROXY == node_type || KN_NODE_EXTRA == node_type) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(UCC_KN_PHASE_EXTRA);
+            return task->super.super.status;
+        }
+        if (KN_NODE_EXTRA == node_type) {
+            goto completion;
+        }
+        status = ucc_dt_reduce(sbuf, rcv, scratch, size * b_count, dt,
+                               mem_type, args);
+        if (ucc_unlikely(UCC_OK != status)) {
+            tl_error(UCC_TASK_LIB(task), "failed to perform dt reduction");
+            task->super.super.status = status;
+            return status;
+        }
+        task->reduce_scatter_kn.sbuf = scratch;
+    }
+    while (!ucc_knomial_pattern_loop_done_backward(p)) {
+        data = task->reduce_scatter_kn.sbuf;
+        for (loop_step = 1; loop_step < radix; loop_step++) {
+            peer = ucc_knomial_pattern_get_loop_peer(p, rank, size, loop_step);
+            if (peer == UCC_KN_PEER_NULL)
+                continue;
+            ucc_knomial_pattern_loop_range(p, size, peer, &start, &n_blocks);
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_send_nb(PTR_OFFSET(data, start * data_size),
+                                   n_blocks * data_size, mem_type,
+                                   ucc_ep_map_eval(task->subset.map, peer),
+                                   team, task),
+                task, out);
+        }
+        ucc_knomial_pattern_loop_range(p, size, rank, &start, &n_blocks);
+        data = rcv;
+        for (loop_step = 1; loop_step < radix; loop_step++) {
+            peer = ucc_knomial_pattern_get_loop_peer(p, rank, size, loop_step);
+            if (peer == UCC_KN_PEER_NULL)
+                continue;
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_recv_nb(data, n_blocks * data_size, mem_type,
+                                   ucc_ep_map_eval(task->subset.map, peer),
+                                   team, task),
+                task, out);
+            data = PTR_OFFSET(data, n_blocks * data_size);
+        }
+    UCC_KN_PHASE_LOOP:
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            SAVE_STATE(UCC_KN_PHASE_LOOP);
+            return task->super.super.status;
+        }
+        n_peers = 0;
+        for (loop_step = 1; loop_step < radix; loop_step++) {
+            if (ucc_knomial_pattern_get_loop_peer(p, rank, size, loop_step) !=
+                UCC_KN_PEER_NULL) {
+                n_peers++;
+            }
+        }
+        ucc_knomial_pattern_loop_range(p, size, rank, &start, &n_blocks);
+        if (n_peers > 0 && n_blocks * b_count > 0) {
+            /* every block gets its last contribution at iteration 0 */
+            status = ucc_tl_ucp_reduce_multi(
+                PTR_OFFSET(task->reduce_scatter_kn.sbuf, start * data_size),
+                rcv, PTR_OFFSET(scratch, start * data_size), n_peers,
+                n_blocks * b_count, n_blocks * data_size, dt, mem_type, task,
+                args->op == UCC_OP_AVG &&
+                    ucc_knomial_pattern_loop_first_iteration(p));
+            if (ucc_unlikely(UCC_OK != status)) {
+                tl_error(UCC_TASK_LIB(task), "failed to perform dt reduction");
+                task->super.super.status = status;
+                return status;
+            }
+            task->reduce_scatter_kn.sbuf = scratch;
+        }
+        ucc_knomial_pattern_next_iteration_backward(p);
+    }
+    data = PTR_OFFSET(task->reduce_scatter_kn.sbuf, rank * data_size);
+    if (data != rbuf) {
+        status = ucc_mc_memcpy(rbuf, data, data_size, mem_type, mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            task->super.super.status = status;
+            return status;
+        }
+    }
+    if (KN_NODE_PROXY == node_type) {
+        peer = ucc_ep_map_eval(task->subset.map,
+                               ucc_knomial_pattern_get_extra(p, rank));
+        UCPCHECK_GOTO(ucc_tl_ucp_send_nb(PTR_OFFSET(data, data_size),
+                                         data_size, mem_type, peer, team,
+                                         task),
+                      task, out);
+    } else {
+        goto completion;
+    }
+UCC_KN_PHASE_PROXY:
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        SAVE_STATE(UCC_KN_PHASE_PROXY);
+        return task->super.super.status;
+    }
+completion:
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_reduce_scatter_kn_done",
+                                     0);
+out:
+    return task->super.super.status;
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_scatter_knomial_rec_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_reduce_scatter_kn_start",
+                                     0);
+    ucc_tl_ucp_task_reset(task);
+    task->reduce_scatter_kn.phase = UCC_KN_PHASE_INIT;
+    ucc_knomial_pattern_init_backward(task->subset.map.ep_num,
+                                      task->subset.myrank,
+                                      task->reduce_scatter_kn.p.radix,
+                                      &task->reduce_scatter_kn.p);
+    task->reduce_scatter_kn.sbuf = UCC_IS_INPLACE(*args)
+                                       ? args->dst.info.buffer
+                                       : args->src.info.buffer;
+
+    status = ucc_tl_ucp_reduce_scatter_knomial_rec_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_scatter_knomial_rec_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->reduce_scatter_kn.scratch_mc_header) {
+        global_st = ucc_mc_free(task->reduce_scatter_kn.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
 ucc_status_t
 ucc_tl_ucp_reduce_scatter_knomial_init(ucc_base_coll_args_t *coll_args,
-                                       ucc_base_team_t *     team,
-                                       ucc_coll_task_t **    task_h)
+                                       ucc_base_team_t      *team,
+                                       ucc_coll_task_t     **task_h)
 {
     ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_coll_args_t   *args    = &coll_args->args;
     ucc_rank_t         size    = UCC_TL_TEAM_SIZE(tl_team);
-    size_t             count   = coll_args->args.dst.info.count;
-    ucc_kn_radix_t     radix, cfg_radix;
+    ucc_rank_t         rank    = UCC_TL_TEAM_RANK(tl_team);
+    size_t             b_count = UCC_IS_INPLACE(*args)
+                                     ? args->dst.info.count / size
+                                     : args->dst.info.count;
+    size_t             data_size;
+    ucc_tl_ucp_task_t *task;
+    ucc_kn_radix_t     radix;
+    ucc_status_t       status = UCC_OK;
 
-    cfg_radix = UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.reduce_scatter_kn_radix;
-    radix = ucc_knomial_pattern_get_min_radix(cfg_radix, size, count);
-    return ucc_tl_ucp_reduce_scatter_knomial_init_r(coll_args, team, task_h,
-                                                    radix);
+    REDUCE_SCATTER_TASK_CHECK(*args, args->src.info.mem_type,
+                              args->dst.info.mem_type, tl_team);
+    radix = ucc_min(ucc_tl_ucp_kn_radix(
+                        tl_team, coll_args,
+                        UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.reduce_scatter_kn_radix,
+                        UCC_KN_MODEL_RECURSIVE, size,
+                        ucc_coll_args_msgsize(coll_args)),
+                    size);
+    task                 = ucc_tl_ucp_init_task(coll_args, team);
+    task->super.post     = ucc_tl_ucp_reduce_scatter_knomial_rec_start;
+    task->super.progress = ucc_tl_ucp_reduce_scatter_knomial_rec_progress;
+    task->super.finalize = ucc_tl_ucp_reduce_scatter_knomial_rec_finalize;
+    ucc_knomial_pattern_init_backward(size, rank, radix,
+                                      &task->reduce_scatter_kn.p);
+    task->reduce_scatter_kn.scratch           = NULL;
+    task->reduce_scatter_kn.scratch_mc_header = NULL;
+
+    data_size = b_count * ucc_dt_size(args->dst.info.datatype);
+    if (KN_NODE_EXTRA != task->reduce_scatter_kn.p.node_type &&
+        data_size > 0) {
+        status = ucc_mc_alloc(
+            &task->reduce_scatter_kn.scratch_mc_header,
+            (size + ucc_tl_ucp_reduce_scatter_knomial_recv_blocks(
+                        &task->reduce_scatter_kn.p, size, rank)) *
+                data_size,
+            args->dst.info.mem_type);
+        if (ucc_unlikely(UCC_OK != status)) {
+            tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+            ucc_tl_ucp_put_task(task);
+            return status;
+        }
+        task->reduce_scatter_kn.scratch =
+            task->reduce_scatter_kn.scratch_mc_header->addr;
+    }
+    *task_h = &task->super;
+out:
+    return status;
 }
@@ -0,0 +1,278 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce_scatter.h"
+#include "core/ucc_progress_queue.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Ring reduce-scatter: at step s rank sends to rank + 1 the partial result
+   of block rank - s - 1 and receives from rank - 1 the partial result of
+   block rank - s - 2, which is reduced with the local contribution. After
+   size - 1 steps the block of the rank is complete. Scratch holds the
+   received block and the partial result, a largest block each.
+   The same task serves reduce-scatterv: block sizes are given by
+   dst.info_v.counts and src holds their concatenation. */
+
+#define RS_RING_IS_V(_args)                                                    \
+    ((_args)->coll_type == UCC_COLL_TYPE_REDUCE_SCATTERV)
+
+static inline ucc_datatype_t
+ucc_tl_ucp_reduce_scatter_ring_dt(ucc_coll_args_t *args)
+{
+    return RS_RING_IS_V(args) ? args->dst.info_v.datatype
+                              : args->dst.info.datatype;
+}
+
+static inline ucc_memory_type_t
+ucc_tl_ucp_reduce_scatter_ring_mem_type(ucc_coll_args_t *args)
+{
+    return RS_RING_IS_V(args) ? args->dst.info_v.mem_type
+                              : args->dst.info.mem_type;
+}
+
+static inline void *ucc_tl_ucp_reduce_scatter_ring_rbuf(ucc_coll_args_t *args)
+{
+    return RS_RING_IS_V(args) ? args->dst.info_v.buffer
+                              : args->dst.info.buffer;
+}
+
+static inline void
+ucc_tl_ucp_reduce_scatter_ring_block(ucc_tl_ucp_task_t *task, ucc_rank_t block,
+                                     size_t *offset, size_t *count)
+{
+    ucc_coll_args_t *args = &TASK_ARGS(task);
+    ucc_rank_t       size = (ucc_rank_t)task->subset.map.ep_num;
+    size_t           total;
+    ucc_rank_t       i;
+
+    if (RS_RING_IS_V(args)) {
+        *offset = 0;
+        for (i = 0; i < block; i++) {
+            *offset +=
+                ucc_coll_args_get_count(args, args->dst.info_v.counts, i);
+        }
+        *count = ucc_coll_args_get_count(args, args->dst.info_v.counts, block);
+        return;
+    }
+    total   = UCC_IS_INPLACE(*args) ? args->dst.info.count
+                                    : args->src.info.count;
+    *offset = ucc_buffer_block_offset(total, size, block);
+    *count  = ucc_buffer_block_count(total, size, block);
+}
+
+static ucc_status_t ucc_tl_ucp_reduce_scatter_ring_post(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args     = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team     = TASK_TEAM(task);
+    ucc_rank_t         size     = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t         rank     = task->subset.myrank;
+    ucc_rank_t         step     = task->reduce_scatter_ring.step;
+    ucc_memory_type_t  mem_type = ucc_tl_ucp_reduce_scatter_ring_mem_type(args);
+    size_t             dt_size  =
+        ucc_dt_size(ucc_tl_ucp_reduce_scatter_ring_dt(args));
+    void              *scratch  = task->reduce_scatter_ring.scratch;
+    size_t             slot     = task->reduce_scatter_ring.slot_size;
+    void              *sbuf     = UCC_IS_INPLACE(*args)
+                                      ? ucc_tl_ucp_reduce_scatter_ring_rbuf(args)
+                                      : args->src.info.buffer;
+    size_t             offset, count;
+    ucc_status_t       status;
+
+    /* first step sends the local data, next steps send the block reduced
+       at the previous step */
+    ucc_tl_ucp_reduce_scatter_ring_block(task, (rank - step - 1 + size) % size,
+                                         &offset, &count);
+    if (step > 0) {
+        sbuf   = PTR_OFFSET(scratch, slot);
+        offset = 0;
+    }
+    status = ucc_tl_ucp_send_nb(PTR_OFFSET(sbuf, offset * dt_size),
+                                count * dt_size, mem_type,
+                                ucc_ep_map_eval(task->subset.map,
+                                                (rank + 1) % size),
+                                team, task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        return status;
+    }
+    ucc_tl_ucp_reduce_scatter_ring_block(task, (rank - step - 2 + 2 * size) %
+                                         size, &offset, &count);
+    return ucc_tl_ucp_recv_nb(scratch, count * dt_size, mem_type,
+                              ucc_ep_map_eval(task->subset.map,
+                                              (rank - 1 + size) % size),
+                              team, task);
+}
+
+static ucc_status_t
+ucc_tl_ucp_reduce_scatter_ring_reduce(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t *args    = &TASK_ARGS(task);
+    ucc_rank_t       size    = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_rank_t       rank    = task->subset.myrank;
+    ucc_rank_t       step    = task->reduce_scatter_ring.step;
+    ucc_datatype_t   dt      = ucc_tl_ucp_reduce_scatter_ring_dt(args);
+    size_t           dt_size = ucc_dt_size(dt);
+    void            *scratch = task->reduce_scatter_ring.scratch;
+    void            *rbuf    = ucc_tl_ucp_reduce_scatter_ring_rbuf(args);
+    void            *sbuf    = UCC_IS_INPLACE(*args) ? rbuf
+                                                     : args->src.info.buffer;
+    int              last    = (step == size - 2);
+    size_t           offset, count;
+    void            *dst;
+
+    ucc_tl_ucp_reduce_scatter_ring_block(task, (rank - step - 2 + 2 * size) %
+                                         size, &offset, &count);
+    if (count == 0) {
+        return UCC_OK;
+    }
+    if (!last) {
+        dst = PTR_OFFSET(scratch, task->reduce_scatter_ring.slot_size);
+    } else {
+        /* block of the rank: in place result stays at its offset */
+        dst = UCC_IS_INPLACE(*args) ? PTR_OFFSET(rbuf, offset * dt_size)
+                                    : rbuf;
+    }
+    return ucc_tl_ucp_reduce_multi(
+        PTR_OFFSET(sbuf, offset * dt_size), scratch, dst, 1, count,
+        count * dt_size, dt, ucc_tl_ucp_reduce_scatter_ring_mem_type(args),
+        task, last && args->op == UCC_OP_AVG);
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_rank_t         size = (ucc_rank_t)task->subset.map.ep_num;
+    ucc_status_t       status;
+
+    while (1) {
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        if (task->reduce_scatter_ring.posted) {
+            status = ucc_tl_ucp_reduce_scatter_ring_reduce(task);
+            if (ucc_unlikely(UCC_OK != status)) {
+                tl_error(UCC_TASK_LIB(task), "failed to perform dt reduction");
+                task->super.super.status = status;
+                return status;
+            }
+            task->reduce_scatter_ring.posted = 0;
+            task->reduce_scatter_ring.step++;
+        }
+        if (task->reduce_scatter_ring.step == size - 1) {
+            break;
+        }
+        UCPCHECK_GOTO(ucc_tl_ucp_reduce_scatter_ring_post(task), task, out);
+        task->reduce_scatter_ring.posted = 1;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_reduce_scatter_ring_done",
+                                     0);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    size_t             offset, count;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_reduce_scatter_ring_start",
+                                     0);
+    ucc_tl_ucp_task_reset(task);
+    task->reduce_scatter_ring.step   = 0;
+    task->reduce_scatter_ring.posted = 0;
+
+    if (task->subset.map.ep_num == 1) {
+        if (!UCC_IS_INPLACE(*args)) {
+            ucc_tl_ucp_reduce_scatter_ring_block(task, 0, &offset, &count);
+            status = ucc_mc_memcpy(
+                ucc_tl_ucp_reduce_scatter_ring_rbuf(args),
+                args->src.info.buffer,
+                count * ucc_dt_size(ucc_tl_ucp_reduce_scatter_ring_dt(args)),
+                ucc_tl_ucp_reduce_scatter_ring_mem_type(args),
+                args->src.info.mem_type);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+        task->super.super.status = UCC_OK;
+        return ucc_task_complete(coll_task);
+    }
+    status = ucc_tl_ucp_reduce_scatter_ring_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->reduce_scatter_ring.scratch_mc_header) {
+        global_st = ucc_mc_free(task->reduce_scatter_ring.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+ucc_status_t ucc_tl_ucp_reduce_scatter_ring_init_common(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t *args      = &TASK_ARGS(task);
+    ucc_rank_t       size      = (ucc_rank_t)task->subset.map.ep_num;
+    size_t           dt_size   =
+        ucc_dt_size(ucc_tl_ucp_reduce_scatter_ring_dt(args));
+    size_t           max_block = 0;
+    size_t           offset;
+    ucc_rank_t       i;
+    ucc_status_t     status;
+
+    if (RS_RING_IS_V(args)) {
+        for (i = 0; i < size; i++) {
+            max_block = ucc_max(max_block,
+                                ucc_coll_args_get_count(
+                                    args, args->dst.info_v.counts, i));
+        }
+    } else {
+        /* first block is the largest one */
+        ucc_tl_ucp_reduce_scatter_ring_block(task, 0, &offset, &max_block);
+    }
+    task->reduce_scatter_ring.slot_size         = max_block * dt_size;
+    task->reduce_scatter_ring.scratch           = NULL;
+    task->reduce_scatter_ring.scratch_mc_header = NULL;
+    task->super.post     = ucc_tl_ucp_reduce_scatter_ring_start;
+    task->super.progress = ucc_tl_ucp_reduce_scatter_ring_progress;
+    task->super.finalize = ucc_tl_ucp_reduce_scatter_ring_finalize;
+    if (size == 1 || max_block == 0) {
+        return UCC_OK;
+    }
+    status = ucc_mc_alloc(&task->reduce_scatter_ring.scratch_mc_header,
+                          2 * task->reduce_scatter_ring.slot_size,
+                          ucc_tl_ucp_reduce_scatter_ring_mem_type(args));
+    if (ucc_unlikely(UCC_OK != status)) {
+        tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+        return status;
+    }
+    task->reduce_scatter_ring.scratch =
+        task->reduce_scatter_ring.scratch_mc_header->addr;
+    return UCC_OK;
+}
@@ -0,0 +1,23 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "reduce_scatterv.h"
+#include "../reduce_scatter/reduce_scatter.h"
+
+/* Ring reduce-scatter task serves the variable block sizes as well */
+ucc_status_t ucc_tl_ucp_reduce_scatterv_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t *args   = &TASK_ARGS(task);
+    ucc_status_t     status = UCC_OK;
+
+    REDUCE_SCATTER_TASK_CHECK(*args, args->src.info.mem_type,
+                              args->dst.info_v.mem_type, TASK_TEAM(task));
+    status = ucc_tl_ucp_reduce_scatter_ring_init_common(task);
+out:
+    return status;
+}
@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+#include "config.h"
+#include "scatter.h"
+#include "core/ucc_mc.h"
+
+ucc_status_t ucc_tl_ucp_scatter_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args   = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_rank_t         rank   = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         size   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root   = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank  = VRANK(rank, root, size);
+    size_t             scratch_size = 0;
+    ucc_memory_type_t  mtype;
+    size_t             block;
+    ucc_rank_t         n, child;
+    ucc_kn_radix_t     radix;
+    ucc_status_t       status;
+
+    if (rank == root) {
+        if (!UCC_IS_INPLACE(*args) &&
+            args->src.info.mem_type != args->dst.info.mem_type) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "assymetric src/dst memory types are not supported yet");
+            return UCC_ERR_NOT_SUPPORTED;
+        }
+        block = args->src.info.count / size *
+                ucc_dt_size(args->src.info.datatype);
+        mtype = args->src.info.mem_type;
+    } else {
+        block = args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+        mtype = args->dst.info.mem_type;
+    }
+    task->super.post     = ucc_tl_ucp_scatter_kn_tree_start;
+    task->super.progress = ucc_tl_ucp_scatter_kn_tree_progress;
+    task->super.finalize = ucc_tl_ucp_scatter_kn_tree_finalize;
+
+    radix = ucc_tl_ucp_kn_radix(team, &task->super.bargs,
+                                UCC_TL_UCP_TEAM_LIB(team)->cfg.scatter_kn_radix,
+                                UCC_KN_MODEL_SCATTER, size, block * size);
+    radix = ucc_max(ucc_min(radix, size), 2);
+    task->kn_tree.radix             = radix;
+    task->kn_tree.dist              = ucc_kn_tree_dist(vrank, size, radix);
+    task->kn_tree.scratch           = NULL;
+    task->kn_tree.scratch_mc_header = NULL;
+
+    /* Non leaf ranks receive the blocks of their subtree in vrank order.
+       The root sends directly from src, only the subtree wrapping around the
+       end of the team is packed into scratch. */
+    if (rank == root) {
+        if (ucc_kn_tree_wrapped_child(root, size, radix, &child, &n)) {
+            scratch_size = n * block;
+        }
+    } else {
+        n = ucc_kn_tree_subtree_size(vrank, task->kn_tree.dist, size);
+        if (n > 1) {
+            scratch_size = n * block;
+        }
+    }
+    if (scratch_size == 0) {
+        return UCC_OK;
+    }
+    status = ucc_mc_alloc(&task->kn_tree.scratch_mc_header, scratch_size,
+                          mtype);
+    if (ucc_unlikely(UCC_OK != status)) {
+        tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate scratch buffer");
+        return status;
+    }
+    task->kn_tree.scratch = task->kn_tree.scratch_mc_header->addr;
+    return UCC_OK;
+}
@@ -8,14 +8,29 @@
 #include "../tl_ucp.h"
 #include "../tl_ucp_coll.h"
 
-/* Base interface signature: uses scatter_kn_radix from config. */
+enum {
+    UCC_SCATTER_KN_TREE_PHASE_RECV, /* waits for the data of the subtree */
+    UCC_SCATTER_KN_TREE_PHASE_SEND  /* waits for the sends to the children */
+};
+
+/* Knomial tree scatter of the rank ordered blocks (user collective), uses
+   scatter_kn_radix from config */
+ucc_status_t ucc_tl_ucp_scatter_init(ucc_tl_ucp_task_t *task);
+
+ucc_status_t ucc_tl_ucp_scatter_kn_tree_start(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_scatter_kn_tree_progress(ucc_coll_task_t *task);
+ucc_status_t ucc_tl_ucp_scatter_kn_tree_finalize(ucc_coll_task_t *task);
+
+/* Base interface signature: uses scatter_kn_radix from config, data layout
+   of SAG knomial bcast */
 
 ucc_status_t
 ucc_tl_ucp_scatter_knomial_init(ucc_base_coll_args_t *coll_args,
                                 ucc_base_team_t      *team,
                                 ucc_coll_task_t     **task_h);
 
-/* Internal interface to KN scatter with custom radix */
+/* Internal interface to KN scatter with custom radix, data layout of SAG
+   knomial bcast */
 ucc_status_t ucc_tl_ucp_scatter_knomial_init_r(
     ucc_base_coll_args_t *coll_args, ucc_base_team_t *team,
     ucc_coll_task_t **task_h, ucc_kn_radix_t radix);
@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "scatter.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+
+/* Knomial tree scatter, inverse of the knomial tree gather: every rank
+   receives the blocks of its subtree (contiguous in vrank order, root is
+   vrank 0) from the parent in a single message and forwards to every child
+   the part of its subtree. Unlike scatter_knomial.c it delivers the rank
+   ordered blocks of the user scatter. */
+
+static inline size_t ucc_tl_ucp_scatter_kn_block(ucc_tl_ucp_task_t *task,
+                                                 ucc_memory_type_t *mtype)
+{
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+
+    if (UCC_TL_TEAM_RANK(team) == args->root) {
+        *mtype = args->src.info.mem_type;
+        return args->src.info.count / UCC_TL_TEAM_SIZE(team) *
+               ucc_dt_size(args->src.info.datatype);
+    }
+    *mtype = args->dst.info.mem_type;
+    return args->dst.info.count * ucc_dt_size(args->dst.info.datatype);
+}
+
+/* Sends to every child its subtree blocks, for the root these are read from
+   the rank ordered src buffer */
+static ucc_status_t ucc_tl_ucp_scatter_kn_send_children(ucc_tl_ucp_task_t *task,
+                                                        void *sbuf,
+                                                        size_t block,
+                                                        ucc_memory_type_t mtype)
+{
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_kn_radix_t     radix = task->kn_tree.radix;
+    ucc_rank_t         d, child, n, n_contig;
+    ucc_kn_radix_t     j;
+    void              *buf;
+    ucc_status_t       status;
+
+    for (d = 1; d < task->kn_tree.dist; d *= radix) {
+        for (j = 1; j < radix; j++) {
+            child = vrank + j * d;
+            if (child >= size) {
+                break;
+            }
+            n = ucc_kn_tree_subtree_size(child, d, size);
+            if (vrank != 0) {
+                buf = PTR_OFFSET(sbuf, (child - vrank) * block);
+            } else {
+                buf      = PTR_OFFSET(sbuf, INV_VRANK(child, root, size) * block);
+                n_contig = ucc_kn_tree_n_contig(child, n, root, size);
+                if (n_contig < n) {
+                    status = ucc_mc_memcpy(task->kn_tree.scratch, buf,
+                                           n_contig * block, mtype, mtype);
+                    if (ucc_likely(UCC_OK == status)) {
+                        status = ucc_mc_memcpy(
+                            PTR_OFFSET(task->kn_tree.scratch, n_contig * block),
+                            sbuf, (n - n_contig) * block, mtype, mtype);
+                    }
+                    if (ucc_unlikely(UCC_OK != status)) {
+                        return status;
+                    }
+                    buf = task->kn_tree.scratch;
+                }
+            }
+            status = ucc_tl_ucp_send_nb(buf, n * block, mtype,
+                                        INV_VRANK(child, root, size), team,
+                                        task);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_tl_ucp_scatter_kn_tree_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_memory_type_t  mtype;
+    size_t             block;
+    ucc_status_t       status;
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    if (task->kn_tree.phase == UCC_SCATTER_KN_TREE_PHASE_RECV) {
+        block = ucc_tl_ucp_scatter_kn_block(task, &mtype);
+        UCPCHECK_GOTO(ucc_tl_ucp_scatter_kn_send_children(
+                          task, task->kn_tree.scratch, block, mtype),
+                      task, out);
+        status = ucc_mc_memcpy(args->dst.info.buffer, task->kn_tree.scratch,
+                               block, mtype, mtype);
+        if (ucc_unlikely(UCC_OK != status)) {
+            task->super.super.status = status;
+            return status;
+        }
+        task->kn_tree.phase = UCC_SCATTER_KN_TREE_PHASE_SEND;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_scatter_kn_tree_done", 0);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_scatter_kn_tree_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_rank_t         dist  = task->kn_tree.dist;
+    ucc_memory_type_t  mtype;
+    size_t             block;
+    ucc_rank_t         vparent;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_scatter_kn_tree_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    block               = ucc_tl_ucp_scatter_kn_block(task, &mtype);
+    task->kn_tree.phase = UCC_SCATTER_KN_TREE_PHASE_SEND;
+
+    if (vrank == 0) {
+        UCPCHECK_GOTO(ucc_tl_ucp_scatter_kn_send_children(
+                          task, args->src.info.buffer, block, mtype),
+                      task, out);
+        if (!UCC_IS_INPLACE(*args)) {
+            status = ucc_mc_memcpy(
+                args->dst.info.buffer,
+                PTR_OFFSET(args->src.info.buffer, root * block), block,
+                args->dst.info.mem_type, mtype);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+    } else {
+        vparent = ucc_kn_tree_parent(vrank, dist, task->kn_tree.radix);
+        if (ucc_kn_tree_subtree_size(vrank, dist, size) == 1) {
+            /* leaf: receives its own block only */
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(args->dst.info.buffer, block,
+                                             mtype,
+                                             INV_VRANK(vparent, root, size),
+                                             team, task),
+                          task, out);
+        } else {
+            UCPCHECK_GOTO(
+                ucc_tl_ucp_recv_nb(task->kn_tree.scratch,
+                                   ucc_kn_tree_subtree_size(vrank, dist, size) *
+                                       block,
+                                   mtype, INV_VRANK(vparent, root, size), team,
+                                   task),
+                task, out);
+            task->kn_tree.phase = UCC_SCATTER_KN_TREE_PHASE_RECV;
+        }
+    }
+
+    status = ucc_tl_ucp_scatter_kn_tree_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_scatter_kn_tree_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->kn_tree.scratch_mc_header) {
+        global_st = ucc_mc_free(task->kn_tree.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
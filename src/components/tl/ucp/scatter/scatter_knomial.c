@@ -254,7 +254,10 @@ ucc_tl_ucp_scatter_knomial_init(ucc_base_coll_args_t *coll_args,
     size_t             count   = coll_args->args.src.info.count;
     ucc_kn_radix_t     radix, cfg_radix;
 
-    cfg_radix = UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.scatter_kn_radix;
+    cfg_radix = ucc_tl_ucp_kn_radix(
+        tl_team, coll_args, UCC_TL_UCP_TEAM_LIB(tl_team)->cfg.scatter_kn_radix,
+        UCC_KN_MODEL_SCATTER, UCC_TL_TEAM_SIZE(tl_team),
+        count * ucc_dt_size(coll_args->args.src.info.datatype));
     radix = ucc_knomial_pattern_get_min_radix(cfg_radix,
                                               UCC_TL_TEAM_SIZE(tl_team), count);
     return ucc_tl_ucp_scatter_knomial_init_r(coll_args, team, task_h, radix);
@@ -0,0 +1,71 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "scatterv.h"
+
+ucc_base_coll_alg_info_t
+    ucc_tl_ucp_scatterv_algs[UCC_TL_UCP_SCATTERV_ALG_LAST + 1] = {
+        [UCC_TL_UCP_SCATTERV_ALG_LINEAR] =
+            {.id   = UCC_TL_UCP_SCATTERV_ALG_LINEAR,
+             .name = "linear",
+             .desc = "root sends to every rank directly"},
+        [UCC_TL_UCP_SCATTERV_ALG_KNOMIAL] =
+            {.id   = UCC_TL_UCP_SCATTERV_ALG_KNOMIAL,
+             .name = "knomial",
+             .desc = "knomial tree, non leaf ranks forward the aggregated data of their subtree"},
+        [UCC_TL_UCP_SCATTERV_ALG_LAST] = {.id = 0, .name = NULL, .desc = NULL}};
+
+ucc_status_t ucc_tl_ucp_scatterv_init(ucc_tl_ucp_task_t *task)
+{
+    ucc_status_t status;
+
+    SCATTERV_TASK_CHECK(TASK_ARGS(task), TASK_TEAM(task));
+    status = ucc_tl_ucp_scatterv_linear_init_common(task);
+out:
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_linear_init(ucc_base_coll_args_t *coll_args,
+                                             ucc_base_team_t      *team,
+                                             ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    SCATTERV_TASK_CHECK(coll_args->args, tl_team);
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_scatterv_linear_init_common(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        goto out;
+    }
+    *task_h = &task->super;
+out:
+    return status;
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_knomial_init(ucc_base_coll_args_t *coll_args,
+                                              ucc_base_team_t      *team,
+                                              ucc_coll_task_t     **task_h)
+{
+    ucc_tl_ucp_team_t *tl_team = ucc_derived_of(team, ucc_tl_ucp_team_t);
+    ucc_tl_ucp_task_t *task;
+    ucc_status_t       status;
+
+    SCATTERV_TASK_CHECK(coll_args->args, tl_team);
+    task   = ucc_tl_ucp_init_task(coll_args, team);
+    status = ucc_tl_ucp_scatterv_knomial_init_common(task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_tl_ucp_put_task(task);
+        goto out;
+    }
+    *task_h = &task->super;
+out:
+    return status;
+}
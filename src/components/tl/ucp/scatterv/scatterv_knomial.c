@@ -0,0 +1,386 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "scatterv.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Knomial tree scatterv with aggregation, inverse of the knomial gatherv:
+   every non leaf rank receives the data of its whole subtree, packed in
+   vrank order (root is vrank 0), from the parent in a single message and
+   forwards to every child its part. Since only the root knows all the
+   counts, the data of a multi rank subtree is preceded by the counts of the
+   subtree (one uint64_t per rank, host memory). Leaves know their own count
+   and get the data only. */
+
+#define SCATTERV_KN_FOR_EACH_CHILD(_vrank, _dist, _radix, _size, _child, _d, \
+                                   _j)                                       \
+    for ((_d) = 1; (_d) < (_dist); (_d) *= (_radix))                         \
+        for ((_j) = 1; (_j) < (_radix) &&                                    \
+                       ((_child) = (_vrank) + (_j) * (_d)) < (_size);        \
+             (_j)++)
+
+static inline size_t ucc_tl_ucp_scatterv_kn_dt_size(ucc_tl_ucp_task_t *task,
+                                                    ucc_memory_type_t *mtype)
+{
+    ucc_coll_args_t *args = &TASK_ARGS(task);
+
+    if (UCC_TL_TEAM_RANK(TASK_TEAM(task)) == args->root) {
+        *mtype = args->src.info_v.mem_type;
+        return ucc_dt_size(args->src.info_v.datatype);
+    }
+    *mtype = args->dst.info.mem_type;
+    return ucc_dt_size(args->dst.info.datatype);
+}
+
+static inline size_t ucc_tl_ucp_scatterv_kn_sum(const uint64_t *counts,
+                                                ucc_rank_t      n)
+{
+    size_t     total = 0;
+    ucc_rank_t i;
+
+    for (i = 0; i < n; i++) {
+        total += counts[i];
+    }
+    return total;
+}
+
+/* Root: packs the data of multi rank subtrees from the user displacements
+   into scratch and sends counts and data to every child */
+static ucc_status_t ucc_tl_ucp_scatterv_kn_root_send(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args    = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team    = TASK_TEAM(task);
+    ucc_rank_t         size    = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root    = (ucc_rank_t)args->root;
+    ucc_kn_radix_t     radix   = task->kn_treev.radix;
+    uint64_t          *counts  = task->kn_treev.counts;
+    size_t             offset  = 0;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size, len;
+    ucc_rank_t         d, child, n, i;
+    ucc_kn_radix_t     j;
+    void              *sbuf;
+    ucc_status_t       status;
+
+    dt_size = ucc_tl_ucp_scatterv_kn_dt_size(task, &mtype);
+    SCATTERV_KN_FOR_EACH_CHILD(0, task->kn_treev.dist, radix, size, child, d,
+                               j) {
+        n = ucc_kn_tree_subtree_size(child, d, size);
+        if (n == 1) {
+            sbuf = PTR_OFFSET(args->src.info_v.buffer,
+                              ucc_coll_args_get_displacement(
+                                  args, args->src.info_v.displacements,
+                                  INV_VRANK(child, root, size)) * dt_size);
+            len  = counts[child] * dt_size;
+        } else {
+            status = ucc_tl_ucp_send_nb(counts + child, n * sizeof(uint64_t),
+                                        UCC_MEMORY_TYPE_HOST,
+                                        INV_VRANK(child, root, size), team,
+                                        task);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+            sbuf = PTR_OFFSET(task->kn_treev.scratch, offset);
+            len  = 0;
+            for (i = child; i < child + n; i++) {
+                status = ucc_mc_memcpy(
+                    PTR_OFFSET(sbuf, len),
+                    PTR_OFFSET(args->src.info_v.buffer,
+                               ucc_coll_args_get_displacement(
+                                   args, args->src.info_v.displacements,
+                                   INV_VRANK(i, root, size)) * dt_size),
+                    counts[i] * dt_size, mtype, mtype);
+                if (ucc_unlikely(UCC_OK != status)) {
+                    return status;
+                }
+                len += counts[i] * dt_size;
+            }
+            offset += len;
+        }
+        status = ucc_tl_ucp_send_nb(sbuf, len, mtype,
+                                    INV_VRANK(child, root, size), team, task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+    return UCC_OK;
+}
+
+/* Non leaf non root rank: forwards to every child its part of the subtree
+   data received from the parent */
+static ucc_status_t ucc_tl_ucp_scatterv_kn_forward(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args   = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_rank_t         size   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root   = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank  = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_kn_radix_t     radix  = task->kn_treev.radix;
+    uint64_t          *counts = task->kn_treev.counts;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size, len, offset;
+    ucc_rank_t         d, child, n;
+    ucc_kn_radix_t     j;
+    ucc_status_t       status;
+
+    dt_size = ucc_tl_ucp_scatterv_kn_dt_size(task, &mtype);
+    offset  = counts[0] * dt_size;
+    SCATTERV_KN_FOR_EACH_CHILD(vrank, task->kn_treev.dist, radix, size, child,
+                               d, j) {
+        n = ucc_kn_tree_subtree_size(child, d, size);
+        if (n > 1) {
+            status = ucc_tl_ucp_send_nb(counts + (child - vrank),
+                                        n * sizeof(uint64_t),
+                                        UCC_MEMORY_TYPE_HOST,
+                                        INV_VRANK(child, root, size), team,
+                                        task);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+        len    = ucc_tl_ucp_scatterv_kn_sum(counts + (child - vrank), n) *
+                 dt_size;
+        status = ucc_tl_ucp_send_nb(PTR_OFFSET(task->kn_treev.scratch, offset),
+                                    len, mtype, INV_VRANK(child, root, size),
+                                    team, task);
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+        offset += len;
+    }
+    return ucc_mc_memcpy(args->dst.info.buffer, task->kn_treev.scratch,
+                         counts[0] * dt_size, args->dst.info.mem_type, mtype);
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_knomial_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_rank_t         dist  = task->kn_treev.dist;
+    ucc_rank_t         vparent;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size;
+    ucc_status_t       status;
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    switch (task->kn_treev.phase) {
+    case UCC_SCATTERV_KN_PHASE_COUNTS:
+        dt_size              = ucc_tl_ucp_scatterv_kn_dt_size(task, &mtype);
+        vparent              = ucc_kn_tree_parent(vrank, dist,
+                                                  task->kn_treev.radix);
+        task->kn_treev.total = ucc_tl_ucp_scatterv_kn_sum(
+            task->kn_treev.counts, ucc_kn_tree_subtree_size(vrank, dist, size));
+        if (task->kn_treev.scratch_mc_header) {
+            /* persistent collective restarted */
+            ucc_mc_free(task->kn_treev.scratch_mc_header);
+        }
+        status = ucc_mc_alloc(&task->kn_treev.scratch_mc_header,
+                              ucc_max(task->kn_treev.total * dt_size, 1),
+                              mtype);
+        if (ucc_unlikely(UCC_OK != status)) {
+            task->kn_treev.scratch_mc_header = NULL;
+            tl_error(UCC_TASK_LIB(task), "failed to allocate scratch buffer");
+            task->super.super.status = status;
+            return status;
+        }
+        task->kn_treev.scratch = task->kn_treev.scratch_mc_header->addr;
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(task->kn_treev.scratch,
+                                         task->kn_treev.total * dt_size, mtype,
+                                         INV_VRANK(vparent, root, size), team,
+                                         task),
+                      task, out);
+        task->kn_treev.phase = UCC_SCATTERV_KN_PHASE_DATA;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        /* fall through */
+    case UCC_SCATTERV_KN_PHASE_DATA:
+        UCPCHECK_GOTO(ucc_tl_ucp_scatterv_kn_forward(task), task, out);
+        task->kn_treev.phase = UCC_SCATTERV_KN_PHASE_SEND;
+        if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+            return task->super.super.status;
+        }
+        break;
+    default:
+        break;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_scatterv_kn_done", 0);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_knomial_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task  = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args  = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team  = TASK_TEAM(task);
+    ucc_rank_t         size  = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root  = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    ucc_rank_t         dist  = task->kn_treev.dist;
+    ucc_rank_t         i, vparent;
+    ucc_memory_type_t  mtype;
+    size_t             dt_size;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_scatterv_kn_start", 0);
+    ucc_tl_ucp_task_reset(task);
+    dt_size              = ucc_tl_ucp_scatterv_kn_dt_size(task, &mtype);
+    task->kn_treev.phase = UCC_SCATTERV_KN_PHASE_SEND;
+
+    if (vrank == 0) {
+        for (i = 0; i < size; i++) {
+            task->kn_treev.counts[i] = ucc_coll_args_get_count(
+                args, args->src.info_v.counts, INV_VRANK(i, root, size));
+        }
+        UCPCHECK_GOTO(ucc_tl_ucp_scatterv_kn_root_send(task), task, out);
+        if (!UCC_IS_INPLACE(*args)) {
+            status = ucc_mc_memcpy(
+                args->dst.info.buffer,
+                PTR_OFFSET(args->src.info_v.buffer,
+                           ucc_coll_args_get_displacement(
+                               args, args->src.info_v.displacements, root) *
+                               dt_size),
+                task->kn_treev.counts[0] * dt_size, args->dst.info.mem_type,
+                mtype);
+            if (ucc_unlikely(UCC_OK != status)) {
+                return status;
+            }
+        }
+    } else {
+        vparent = ucc_kn_tree_parent(vrank, dist, task->kn_treev.radix);
+        if (ucc_kn_tree_subtree_size(vrank, dist, size) == 1) {
+            /* leaf: receives its own data only */
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(args->dst.info.buffer,
+                                             args->dst.info.count * dt_size,
+                                             mtype,
+                                             INV_VRANK(vparent, root, size),
+                                             team, task),
+                          task, out);
+        } else {
+            UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(
+                              task->kn_treev.counts,
+                              ucc_kn_tree_subtree_size(vrank, dist, size) *
+                                  sizeof(uint64_t),
+                              UCC_MEMORY_TYPE_HOST,
+                              INV_VRANK(vparent, root, size), team, task),
+                          task, out);
+            task->kn_treev.phase = UCC_SCATTERV_KN_PHASE_COUNTS;
+        }
+    }
+
+    status = ucc_tl_ucp_scatterv_knomial_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_knomial_finalize(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_status_t       st, global_st = UCC_OK;
+
+    if (task->kn_treev.scratch_mc_header) {
+        global_st = ucc_mc_free(task->kn_treev.scratch_mc_header);
+        if (ucc_unlikely(global_st != UCC_OK)) {
+            tl_error(UCC_TASK_LIB(task), "failed to free scratch buffer");
+        }
+    }
+    ucc_free(task->kn_treev.counts);
+    st = ucc_tl_ucp_coll_finalize(&task->super);
+    if (ucc_unlikely(st != UCC_OK)) {
+        tl_error(UCC_TASK_LIB(task), "failed finalize collective");
+        global_st = st;
+    }
+    return global_st;
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_knomial_init_common(ucc_tl_ucp_task_t *task)
+{
+    ucc_coll_args_t   *args   = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team   = TASK_TEAM(task);
+    ucc_rank_t         size   = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         root   = (ucc_rank_t)args->root;
+    ucc_rank_t         vrank  = VRANK(UCC_TL_TEAM_RANK(team), root, size);
+    size_t             scratch_size = 0;
+    ucc_rank_t         d, child, n, i;
+    ucc_kn_radix_t     j, radix;
+    ucc_status_t       status;
+
+    task->super.post     = ucc_tl_ucp_scatterv_knomial_start;
+    task->super.progress = ucc_tl_ucp_scatterv_knomial_progress;
+    task->super.finalize = ucc_tl_ucp_scatterv_knomial_finalize;
+
+    radix = ucc_tl_ucp_kn_radix(team, &task->super.bargs,
+                                UCC_TL_UCP_TEAM_LIB(team)->cfg.scatterv_kn_radix,
+                                UCC_KN_MODEL_TREE, size, 0);
+    radix = ucc_max(ucc_min(radix, size), 2);
+    task->kn_treev.radix             = radix;
+    task->kn_treev.dist              = ucc_kn_tree_dist(vrank, size, radix);
+    task->kn_treev.counts            = NULL;
+    task->kn_treev.scratch           = NULL;
+    task->kn_treev.scratch_mc_header = NULL;
+
+    /* root keeps the counts of all the vranks, non leaf ranks the counts of
+       their subtree; scratch of non root ranks is allocated once the counts
+       are known */
+    n = ucc_kn_tree_subtree_size(vrank, task->kn_treev.dist, size);
+    if (n > 1 || vrank == 0) {
+        task->kn_treev.counts =
+            ucc_malloc(n * sizeof(uint64_t), "scatterv_kn_counts");
+        if (!task->kn_treev.counts) {
+            tl_error(UCC_TL_TEAM_LIB(team),
+                     "failed to allocate %zd bytes for counts",
+                     n * sizeof(uint64_t));
+            return UCC_ERR_NO_MEMORY;
+        }
+    }
+    if (vrank != 0) {
+        return UCC_OK;
+    }
+    SCATTERV_KN_FOR_EACH_CHILD(0, task->kn_treev.dist, radix, size, child, d,
+                               j) {
+        n = ucc_kn_tree_subtree_size(child, d, size);
+        if (n == 1) {
+            continue;
+        }
+        for (i = child; i < child + n; i++) {
+            scratch_size += ucc_coll_args_get_count(
+                args, args->src.info_v.counts, INV_VRANK(i, root, size));
+        }
+    }
+    if (scratch_size == 0) {
+        return UCC_OK;
+    }
+    status = ucc_mc_alloc(&task->kn_treev.scratch_mc_header,
+                          scratch_size * ucc_dt_size(args->src.info_v.datatype),
+                          args->src.info_v.mem_type);
+    if (ucc_unlikely(UCC_OK != status)) {
+        tl_error(UCC_TL_TEAM_LIB(team), "failed to allocate scratch buffer");
+        ucc_free(task->kn_treev.counts);
+        return status;
+    }
+    task->kn_treev.scratch = task->kn_treev.scratch_mc_header->addr;
+    return UCC_OK;
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "tl_ucp.h"
+#include "scatterv.h"
+#include "core/ucc_progress_queue.h"
+#include "core/ucc_mc.h"
+#include "tl_ucp_sendrecv.h"
+#include "utils/ucc_coll_utils.h"
+
+/* Linear scatterv: the root sends to every rank its data directly from src */
+
+ucc_status_t ucc_tl_ucp_scatterv_linear_progress(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+
+    if (UCC_INPROGRESS == ucc_tl_ucp_test(task)) {
+        return task->super.super.status;
+    }
+    ucc_assert(UCC_TL_UCP_TASK_P2P_COMPLETE(task));
+    task->super.super.status = UCC_OK;
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_scatterv_linear_done", 0);
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_linear_start(ucc_coll_task_t *coll_task)
+{
+    ucc_tl_ucp_task_t *task = ucc_derived_of(coll_task, ucc_tl_ucp_task_t);
+    ucc_coll_args_t   *args = &TASK_ARGS(task);
+    ucc_tl_ucp_team_t *team = TASK_TEAM(task);
+    ucc_rank_t         size = UCC_TL_TEAM_SIZE(team);
+    ucc_rank_t         rank = UCC_TL_TEAM_RANK(team);
+    ucc_rank_t         root = (ucc_rank_t)args->root;
+    size_t             dt_size;
+    ucc_rank_t         peer;
+    void              *sbuf;
+    ucc_status_t       status;
+
+    UCC_TL_UCP_PROFILE_REQUEST_EVENT(coll_task, "ucp_scatterv_linear_start", 0);
+    ucc_tl_ucp_task_reset(task);
+
+    if (rank != root) {
+        UCPCHECK_GOTO(ucc_tl_ucp_recv_nb(args->dst.info.buffer,
+                                         args->dst.info.count *
+                                             ucc_dt_size(args->dst.info.datatype),
+                                         args->dst.info.mem_type, root, team,
+                                         task),
+                      task, out);
+    } else {
+        dt_size = ucc_dt_size(args->src.info_v.datatype);
+        for (peer = 0; peer < size; peer++) {
+            sbuf = PTR_OFFSET(args->src.info_v.buffer,
+                              ucc_coll_args_get_displacement(
+                                  args, args->src.info_v.displacements, peer) *
+                                  dt_size);
+            if (peer != root) {
+                UCPCHECK_GOTO(ucc_tl_ucp_send_nb(
+                                  sbuf,
+                                  ucc_coll_args_get_count(
+                                      args, args->src.info_v.counts, peer) *
+                                      dt_size,
+                                  args->src.info_v.mem_type, peer, team, task),
+                              task, out);
+            } else if (!UCC_IS_INPLACE(*args)) {
+                status = ucc_mc_memcpy(
+                    args->dst.info.buffer, sbuf,
+                    ucc_coll_args_get_count(args, args->src.info_v.counts,
+                                            peer) * dt_size,
+                    args->dst.info.mem_type, args->src.info_v.mem_type);
+                if (ucc_unlikely(UCC_OK != status)) {
+                    return status;
+                }
+            }
+        }
+    }
+
+    status = ucc_tl_ucp_scatterv_linear_progress(&task->super);
+    if (UCC_INPROGRESS == status) {
+        ucc_progress_enqueue(UCC_TL_CORE_CTX(team)->pq, &task->super);
+        return UCC_OK;
+    }
+    return ucc_task_complete(coll_task);
+out:
+    return task->super.super.status;
+}
+
+ucc_status_t ucc_tl_ucp_scatterv_linear_init_common(ucc_tl_ucp_task_t *task)
+{
+    task->super.post     = ucc_tl_ucp_scatterv_linear_start;
+    task->super.progress = ucc_tl_ucp_scatterv_linear_progress;
+    return UCC_OK;
+}
@@ -8,15 +8,28 @@
 #include "utils/ucc_malloc.h"
 #include "core/ucc_mc.h"
 #include "components/mc/base/ucc_mc_base.h"
+#include "barrier/barrier.h"
 #include "allreduce/allreduce.h"
 #include "bcast/bcast.h"
 #include "alltoall/alltoall.h"
+#include "alltoallv/alltoallv.h"
+#include "allgather/allgather.h"
+#include "reduce/reduce.h"
+#include "reduce_scatter/reduce_scatter.h"
+#include "gatherv/gatherv.h"
+#include "scatterv/scatterv.h"
 
 ucc_status_t ucc_tl_ucp_get_lib_attr(const ucc_base_lib_t *lib,
                                      ucc_base_lib_attr_t  *base_attr);
 ucc_status_t ucc_tl_ucp_get_context_attr(const ucc_base_context_t *context,
                                          ucc_base_ctx_attr_t      *base_attr);
 
+#define UCC_TL_UCP_KN_AUTO_DOC                                                 \
+    "0 - auto: selected by the knomial cost model per message size (see "     \
+    "UCC_TL_UCP_KN_MODEL), fixed radix "                                       \
+    UCC_PP_MAKE_STRING(UCC_TL_UCP_KN_DEFAULT_RADIX)                            \
+    " if the model is disabled or not calibrated"
+
 static ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
     {"", "", NULL, ucc_offsetof(ucc_tl_ucp_lib_config_t, super),
      UCC_CONFIG_TYPE_TABLE(ucc_tl_lib_config_table)},
@@ -27,6 +40,11 @@ static ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, alltoall_pairwise_num_posts),
      UCC_CONFIG_TYPE_UINT},
 
+    {"ALLTOALL_BRUCK_RADIX", "2",
+     "Radix of the Bruck alltoall algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, alltoall_bruck_radix),
+     UCC_CONFIG_TYPE_UINT},
+
     {"ALLTOALLV_PAIRWISE_NUM_POSTS", "1",
      "Maximum number of outstanding send and receive messages in alltoallv "
      "pairwise algorithm",
@@ -39,18 +57,26 @@ static ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      "other KN_RADIX values",
      ucc_offsetof(ucc_tl_ucp_lib_config_t, kn_radix), UCC_CONFIG_TYPE_UINT},
 
-    {"BARRIER_KN_RADIX", "4",
-     "Radix of the recursive-knomial barrier algorithm",
+    {"BARRIER_KN_RADIX", "0",
+     "Radix of the recursive-knomial barrier algorithm, " UCC_TL_UCP_KN_AUTO_DOC,
      ucc_offsetof(ucc_tl_ucp_lib_config_t, barrier_kn_radix),
      UCC_CONFIG_TYPE_UINT},
 
-    {"ALLREDUCE_KN_RADIX", "4",
-     "Radix of the recursive-knomial allreduce algorithm",
+    {"BARRIER_DISSEMINATION_RADIX", "0",
+     "Radix of the dissemination barrier algorithm, also used among node "
+     "leaders by the hierarchical barrier, " UCC_TL_UCP_KN_AUTO_DOC,
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, barrier_dissemination_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"ALLREDUCE_KN_RADIX", "0",
+     "Radix of the recursive-knomial allreduce algorithm, "
+     UCC_TL_UCP_KN_AUTO_DOC,
      ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_kn_radix),
      UCC_CONFIG_TYPE_UINT},
 
-    {"ALLREDUCE_SRA_KN_RADIX", "4",
-     "Radix of the scatter-reduce-allgather (SRA) knomial allreduce algorithm",
+    {"ALLREDUCE_SRA_KN_RADIX", "0",
+     "Radix of the scatter-reduce-allgather (SRA) knomial allreduce algorithm, "
+     UCC_TL_UCP_KN_AUTO_DOC,
      ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_sra_kn_radix),
      UCC_CONFIG_TYPE_UINT},
 
@@ -83,6 +109,24 @@ static ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_sra_kn_seq),
      UCC_CONFIG_TYPE_BOOL},
 
+    {"ALLREDUCE_RING_SEG_SIZE", "64k",
+     "Segment size of the ring allreduce algorithm, reduction of a segment "
+     "is\noverlapped with the transfer of the next one",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_ring_seg_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_DBT_FRAG_SIZE", "256k",
+     "Maximum fragment size of the double binary tree allreduce algorithm, "
+     "each\nfragment is split in halves between the two trees",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_dbt_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"ALLREDUCE_DBT_PIPELINE_DEPTH", "4",
+     "Number of fragments simultaneously progressed by the double binary tree "
+     "\nallreduce algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, allreduce_dbt_pipeline_depth),
+     UCC_CONFIG_TYPE_UINT},
+
     {"REDUCE_SCATTER_KN_RADIX", "4",
      "Radix of the knomial reduce-scatter algorithm",
      ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_scatter_kn_radix),
@@ -92,23 +136,102 @@ static ucc_config_field_t ucc_tl_ucp_lib_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_lib_config_t, allgather_kn_radix),
      UCC_CONFIG_TYPE_UINT},
 
-    {"BCAST_KN_RADIX", "4", "Radix of the recursive-knomial bcast algorithm",
+    {"BCAST_KN_RADIX", "0",
+     "Radix of the recursive-knomial bcast algorithm, " UCC_TL_UCP_KN_AUTO_DOC,
      ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_kn_radix),
      UCC_CONFIG_TYPE_UINT},
 
-    {"BCAST_SAG_KN_RADIX", "4",
-     "Radix of the scatter-allgather (SAG) knomial bcast algorithm",
+    {"BCAST_SAG_KN_RADIX", "0",
+     "Radix of the scatter-allgather (SAG) knomial bcast algorithm, "
+     UCC_TL_UCP_KN_AUTO_DOC,
      ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_sag_kn_radix),
      UCC_CONFIG_TYPE_UINT},
 
-    {"REDUCE_KN_RADIX", "4", "Radix of the knomial tree reduce algorithm",
+    {"BCAST_PIPELINE_RADIX", "2",
+     "Degree of the tree of the pipelined bcast algorithm, 1 - chain",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_pipeline_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"BCAST_PIPELINE_FRAG_SIZE", "512k",
+     "Maximum fragment size of the pipelined bcast algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_pipeline_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"BCAST_PIPELINE_DEPTH", "4",
+     "Number of fragments simultaneously progressed by the pipelined bcast "
+     "algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_pipeline_depth),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"BCAST_DBT_FRAG_SIZE", "256k",
+     "Maximum fragment size of the double binary tree bcast algorithm, each "
+     "\nfragment is split in halves between the two trees",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_dbt_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"BCAST_DBT_PIPELINE_DEPTH", "4",
+     "Number of fragments simultaneously progressed by the double binary tree "
+     "\nbcast algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, bcast_dbt_pipeline_depth),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"REDUCE_KN_RADIX", "0",
+     "Radix of the knomial tree reduce algorithm, " UCC_TL_UCP_KN_AUTO_DOC,
      ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_kn_radix),
      UCC_CONFIG_TYPE_UINT},
 
-    {"SCATTER_KN_RADIX", "4", "Radix of the knomial scatter algorithm",
+    {"REDUCE_SRG_KN_RADIX", "0",
+     "Radix of the scatter-reduce-gather (SRG) knomial reduce algorithm, "
+     UCC_TL_UCP_KN_AUTO_DOC,
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_srg_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"REDUCE_PIPELINE_RADIX", "2",
+     "Radix of the knomial tree used by the pipelined reduce algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_pipeline_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"REDUCE_PIPELINE_FRAG_SIZE", "32k",
+     "Maximum fragment size of the pipelined reduce algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_pipeline_frag_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"REDUCE_PIPELINE_DEPTH", "4",
+     "Number of fragments simultaneously progressed by the pipelined reduce "
+     "algorithm",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, reduce_pipeline_depth),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"SCATTER_KN_RADIX", "0",
+     "Radix of the knomial scatter algorithm, " UCC_TL_UCP_KN_AUTO_DOC,
      ucc_offsetof(ucc_tl_ucp_lib_config_t, scatter_kn_radix),
      UCC_CONFIG_TYPE_UINT},
 
+    {"GATHER_KN_RADIX", "0",
+     "Radix of the knomial tree gather algorithm, " UCC_TL_UCP_KN_AUTO_DOC,
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, gather_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"GATHERV_KN_RADIX", "4",
+     "Radix of the knomial tree gatherv algorithm with aggregation",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, gatherv_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"SCATTERV_KN_RADIX", "4",
+     "Radix of the knomial tree scatterv algorithm with aggregation",
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, scatterv_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"FANIN_KN_RADIX", "0",
+     "Radix of the knomial fanin algorithm, " UCC_TL_UCP_KN_AUTO_DOC,
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, fanin_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"FANOUT_KN_RADIX", "0",
+     "Radix of the knomial fanout algorithm, " UCC_TL_UCP_KN_AUTO_DOC,
+     ucc_offsetof(ucc_tl_ucp_lib_config_t, fanout_kn_radix),
+     UCC_CONFIG_TYPE_UINT},
+
     {"REDUCE_AVG_PRE_OP", "1",
      "Reduce will perform division by team_size in early stages of the algorithm,\n"
      "else - in result",
@@ -141,6 +264,37 @@ static ucs_config_field_t ucc_tl_ucp_context_config_table[] = {
      ucc_offsetof(ucc_tl_ucp_context_config_t, pre_reg_mem),
      UCC_CONFIG_TYPE_UINT},
 
+    {"WAKEUP", "n",
+     "Request UCP wakeup feature and register ucp worker event fd with "
+     "the UCC context so that ucc_context_wait/ucc_collective_wait can sleep "
+     "instead of busy polling. Enabling it may affect UCX transport selection",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, wakeup),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"KN_MODEL", "y",
+     "Calibrate the cost model of knomial algorithms at context creation "
+     "(loopback ping-pong over the ucp worker, the parameters are agreed over "
+     "the context OOB) and use it to select the radix per message size and "
+     "team size for the algorithms with radix set to 0",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, kn_model),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"KN_MODEL_LATENCY", "0",
+     "Network latency used by the knomial cost model, 0 - calibrated",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, kn_model_latency),
+     UCC_CONFIG_TYPE_TIME},
+
+    {"KN_MODEL_OVERHEAD", "0",
+     "Per message CPU overhead used by the knomial cost model, 0 - calibrated",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, kn_model_overhead),
+     UCC_CONFIG_TYPE_TIME},
+
+    {"KN_MODEL_BW", "0",
+     "Bandwidth in bytes per second used by the knomial cost model, "
+     "0 - calibrated",
+     ucc_offsetof(ucc_tl_ucp_context_config_t, kn_model_bw),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
     {NULL}};
 
 UCC_CLASS_DEFINE_NEW_FUNC(ucc_tl_ucp_lib_t, ucc_base_lib_t,
@@ -238,10 +392,24 @@ __attribute__((constructor)) static void tl_ucp_iface_init(void)
     ucc_tl_ucp.super.scoll.allreduce = ucc_tl_ucp_service_allreduce;
     ucc_tl_ucp.super.scoll.allgather = ucc_tl_ucp_service_allgather;
     ucc_tl_ucp.super.scoll.update_id = ucc_tl_ucp_service_update_id;
+    ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_BARRIER)] =
+        ucc_tl_ucp_barrier_algs;
     ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_ALLREDUCE)] =
         ucc_tl_ucp_allreduce_algs;
     ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_BCAST)] =
         ucc_tl_ucp_bcast_algs;
     ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_ALLTOALL)] =
         ucc_tl_ucp_alltoall_algs;
+    ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_ALLTOALLV)] =
+        ucc_tl_ucp_alltoallv_algs;
+    ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_ALLGATHER)] =
+        ucc_tl_ucp_allgather_algs;
+    ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_REDUCE)] =
+        ucc_tl_ucp_reduce_algs;
+    ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_REDUCE_SCATTER)] =
+        ucc_tl_ucp_reduce_scatter_algs;
+    ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_GATHERV)] =
+        ucc_tl_ucp_gatherv_algs;
+    ucc_tl_ucp.super.alg_info[ucc_ilog2(UCC_COLL_TYPE_SCATTERV)] =
+        ucc_tl_ucp_scatterv_algs;
 }
@@ -11,6 +11,7 @@
 #include "core/ucc_ee.h"
 #include "utils/ucc_mpool.h"
 #include "tl_ucp_ep_hash.h"
+#include "coll_patterns/knomial_model.h"
 #include <ucp/api/ucp.h>
 #include <ucs/memory/memory_type.h>
 
@@ -30,6 +31,10 @@
 #define UCC_TL_UCP_PROFILE_REQUEST_EVENT UCC_PROFILE_REQUEST_EVENT
 #define UCC_TL_UCP_PROFILE_REQUEST_FREE UCC_PROFILE_REQUEST_FREE
 
+/* Radix of knomial algorithms configured with radix 0 (auto) when the
+   knomial cost model is not available */
+#define UCC_TL_UCP_KN_DEFAULT_RADIX 4
+
 #define MAX_NR_SEGMENTS 32
 #define ONESIDED_SYNC_SIZE 1
 #define ONESIDED_REDUCE_SIZE 4
@@ -44,21 +49,40 @@ typedef struct ucc_tl_ucp_lib_config {
     ucc_tl_lib_config_t super;
     uint32_t            kn_radix;
     uint32_t            barrier_kn_radix;
+    uint32_t            barrier_dissemination_radix;
     uint32_t            allreduce_kn_radix;
     uint32_t            allreduce_sra_kn_radix;
     uint32_t            reduce_scatter_kn_radix;
     uint32_t            allgather_kn_radix;
     uint32_t            bcast_kn_radix;
     uint32_t            bcast_sag_kn_radix;
+    uint32_t            bcast_pipeline_radix;
+    uint32_t            bcast_pipeline_depth;
+    size_t              bcast_pipeline_frag_size;
+    uint32_t            bcast_dbt_pipeline_depth;
+    size_t              bcast_dbt_frag_size;
     uint32_t            reduce_kn_radix;
+    uint32_t            reduce_srg_kn_radix;
+    uint32_t            reduce_pipeline_radix;
+    uint32_t            reduce_pipeline_depth;
+    size_t              reduce_pipeline_frag_size;
     uint32_t            scatter_kn_radix;
+    uint32_t            gather_kn_radix;
+    uint32_t            gatherv_kn_radix;
+    uint32_t            scatterv_kn_radix;
+    uint32_t            fanin_kn_radix;
+    uint32_t            fanout_kn_radix;
     uint32_t            alltoall_pairwise_num_posts;
+    uint32_t            alltoall_bruck_radix;
     uint32_t            alltoallv_pairwise_num_posts;
     uint32_t            allreduce_sra_kn_n_frags;
     uint32_t            allreduce_sra_kn_pipeline_depth;
     int                 allreduce_sra_kn_seq;
     size_t              allreduce_sra_kn_frag_thresh;
     size_t              allreduce_sra_kn_frag_size;
+    size_t              allreduce_ring_seg_size;
+    uint32_t            allreduce_dbt_pipeline_depth;
+    size_t              allreduce_dbt_frag_size;
     int                 reduce_avg_pre_op;
 } ucc_tl_ucp_lib_config_t;
 
@@ -68,6 +92,11 @@ typedef struct ucc_tl_ucp_context_config {
     uint32_t                n_polls;
     uint32_t                oob_npolls;
     uint32_t                pre_reg_mem;
+    int                     wakeup;
+    int                     kn_model;
+    double                  kn_model_latency;
+    double                  kn_model_overhead;
+    size_t                  kn_model_bw;
 } ucc_tl_ucp_context_config_t;
 
 typedef struct ucc_tl_ucp_lib {
@@ -98,6 +127,9 @@ typedef struct ucc_tl_ucp_context {
     ucc_tl_ucp_remote_info_t ** remote_info;
     uint64_t                    n_rinfo_segs;
     uint64_t                    ucp_memory_types;
+    ucc_kn_model_t              kn_model;
+    int                         kn_model_valid; /*< same model on all the
+                                                    ranks of the context */
 } ucc_tl_ucp_context_t;
 UCC_CLASS_DECLARE(ucc_tl_ucp_context_t, const ucc_base_context_params_t *,
                   const ucc_base_config_t *);
@@ -118,7 +150,10 @@ UCC_CLASS_DECLARE(ucc_tl_ucp_team_t, ucc_base_context_t *,
     (UCC_COLL_TYPE_ALLTOALL | UCC_COLL_TYPE_ALLTOALLV |                        \
      UCC_COLL_TYPE_ALLGATHER | UCC_COLL_TYPE_ALLGATHERV |                      \
      UCC_COLL_TYPE_ALLREDUCE | UCC_COLL_TYPE_BCAST | UCC_COLL_TYPE_BARRIER |   \
-     UCC_COLL_TYPE_REDUCE)
+     UCC_COLL_TYPE_REDUCE | UCC_COLL_TYPE_REDUCE_SCATTER |                     \
+     UCC_COLL_TYPE_REDUCE_SCATTERV | UCC_COLL_TYPE_GATHER |                    \
+     UCC_COLL_TYPE_GATHERV | UCC_COLL_TYPE_SCATTER | UCC_COLL_TYPE_SCATTERV |  \
+     UCC_COLL_TYPE_FANIN | UCC_COLL_TYPE_FANOUT)
 
 #define UCC_TL_UCP_TEAM_LIB(_team)                                             \
     (ucc_derived_of((_team)->super.super.context->lib, ucc_tl_ucp_lib_t))
@@ -143,4 +178,6 @@ void ucc_tl_ucp_pre_register_mem(ucc_tl_ucp_team_t *team, void *addr,
 ucc_status_t ucc_tl_ucp_ctx_remote_populate(ucc_tl_ucp_context_t *ctx,
                                             ucc_mem_map_params_t  map,
                                             ucc_team_oob_coll_t   oob);
+
+void ucc_tl_ucp_kn_model_init(ucc_tl_ucp_context_t *ctx);
 #endif
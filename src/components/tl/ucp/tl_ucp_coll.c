@@ -9,6 +9,8 @@
 #include "core/ucc_mc.h"
 #include "core/ucc_team.h"
 #include "barrier/barrier.h"
+#include "fanin/fanin.h"
+#include "fanout/fanout.h"
 #include "alltoall/alltoall.h"
 #include "alltoallv/alltoallv.h"
 #include "allreduce/allreduce.h"
@@ -16,11 +18,21 @@
 #include "allgatherv/allgatherv.h"
 #include "bcast/bcast.h"
 #include "reduce/reduce.h"
+#include "reduce_scatter/reduce_scatter.h"
+#include "reduce_scatterv/reduce_scatterv.h"
+#include "gather/gather.h"
+#include "gatherv/gatherv.h"
+#include "scatter/scatter.h"
+#include "scatterv/scatterv.h"
 const char
     *ucc_tl_ucp_default_alg_select_str[UCC_TL_UCP_N_DEFAULT_ALG_SELECT_STR] = {
         UCC_TL_UCP_ALLREDUCE_DEFAULT_ALG_SELECT_STR,
         UCC_TL_UCP_BCAST_DEFAULT_ALG_SELECT_STR,
-        UCC_TL_UCP_ALLTOALL_DEFAULT_ALG_SELECT_STR};
+        UCC_TL_UCP_ALLTOALL_DEFAULT_ALG_SELECT_STR,
+        UCC_TL_UCP_ALLGATHER_DEFAULT_ALG_SELECT_STR,
+        UCC_TL_UCP_REDUCE_SCATTER_DEFAULT_ALG_SELECT_STR,
+        UCC_TL_UCP_BARRIER_DEFAULT_ALG_SELECT_STR,
+        UCC_TL_UCP_REDUCE_DEFAULT_ALG_SELECT_STR};
 
 void ucc_tl_ucp_send_completion_cb(void *request, ucs_status_t status,
                                    void *user_data)
@@ -33,6 +45,7 @@ void ucc_tl_ucp_send_completion_cb(void *request, ucs_status_t status,
     }
     task->send_completed++;
     ucp_request_free(request);
+    ucc_tl_ucp_task_ready(task);
 }
 
 void ucc_tl_ucp_recv_completion_cb(void *request, ucs_status_t status,
@@ -47,6 +60,7 @@ void ucc_tl_ucp_recv_completion_cb(void *request, ucs_status_t status,
     }
     task->recv_completed++;
     ucp_request_free(request);
+    ucc_tl_ucp_task_ready(task);
 }
 
 ucc_status_t ucc_tl_ucp_coll_finalize(ucc_coll_task_t *coll_task)
@@ -69,6 +83,12 @@ ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_args_t *coll_args,
     case UCC_COLL_TYPE_BARRIER:
         status = ucc_tl_ucp_barrier_init(task);
         break;
+    case UCC_COLL_TYPE_FANIN:
+        status = ucc_tl_ucp_fanin_init(task);
+        break;
+    case UCC_COLL_TYPE_FANOUT:
+        status = ucc_tl_ucp_fanout_init(task);
+        break;
     case UCC_COLL_TYPE_ALLTOALL:
         status = ucc_tl_ucp_alltoall_init(task);
         break;
@@ -90,6 +110,24 @@ ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_args_t *coll_args,
     case UCC_COLL_TYPE_REDUCE:
         status = ucc_tl_ucp_reduce_init(task);
         break;
+    case UCC_COLL_TYPE_REDUCE_SCATTER:
+        status = ucc_tl_ucp_reduce_scatter_init(task);
+        break;
+    case UCC_COLL_TYPE_REDUCE_SCATTERV:
+        status = ucc_tl_ucp_reduce_scatterv_init(task);
+        break;
+    case UCC_COLL_TYPE_GATHER:
+        status = ucc_tl_ucp_gather_init(task);
+        break;
+    case UCC_COLL_TYPE_GATHERV:
+        status = ucc_tl_ucp_gatherv_init(task);
+        break;
+    case UCC_COLL_TYPE_SCATTER:
+        status = ucc_tl_ucp_scatter_init(task);
+        break;
+    case UCC_COLL_TYPE_SCATTERV:
+        status = ucc_tl_ucp_scatterv_init(task);
+        break;
     default:
         status = UCC_ERR_NOT_SUPPORTED;
     }
@@ -105,12 +143,26 @@ ucc_status_t ucc_tl_ucp_coll_init(ucc_base_coll_args_t *coll_args,
 static inline int alg_id_from_str(ucc_coll_type_t coll_type, const char *str)
 {
     switch (coll_type) {
+    case UCC_COLL_TYPE_BARRIER:
+        return ucc_tl_ucp_barrier_alg_from_str(str);
     case UCC_COLL_TYPE_ALLREDUCE:
         return ucc_tl_ucp_allreduce_alg_from_str(str);
     case UCC_COLL_TYPE_BCAST:
         return ucc_tl_ucp_bcast_alg_from_str(str);
     case UCC_COLL_TYPE_ALLTOALL:
         return ucc_tl_ucp_alltoall_alg_from_str(str);
+    case UCC_COLL_TYPE_ALLTOALLV:
+        return ucc_tl_ucp_alltoallv_alg_from_str(str);
+    case UCC_COLL_TYPE_ALLGATHER:
+        return ucc_tl_ucp_allgather_alg_from_str(str);
+    case UCC_COLL_TYPE_REDUCE:
+        return ucc_tl_ucp_reduce_alg_from_str(str);
+    case UCC_COLL_TYPE_REDUCE_SCATTER:
+        return ucc_tl_ucp_reduce_scatter_alg_from_str(str);
+    case UCC_COLL_TYPE_GATHERV:
+        return ucc_tl_ucp_gatherv_alg_from_str(str);
+    case UCC_COLL_TYPE_SCATTERV:
+        return ucc_tl_ucp_scatterv_alg_from_str(str);
     default:
         break;
     }
@@ -128,6 +180,22 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
     }
 
     switch (coll_type) {
+    case UCC_COLL_TYPE_BARRIER:
+        switch (alg_id) {
+        case UCC_TL_UCP_BARRIER_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_barrier_knomial_init;
+            break;
+        case UCC_TL_UCP_BARRIER_ALG_DISSEMINATION:
+            *init = ucc_tl_ucp_barrier_dissemination_init;
+            break;
+        case UCC_TL_UCP_BARRIER_ALG_HIERARCHICAL:
+            *init = ucc_tl_ucp_barrier_hier_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
     case UCC_COLL_TYPE_ALLREDUCE:
         switch (alg_id) {
         case UCC_TL_UCP_ALLREDUCE_ALG_KNOMIAL:
@@ -136,6 +204,12 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_ALLREDUCE_ALG_SRA_KNOMIAL:
             *init = ucc_tl_ucp_allreduce_sra_knomial_init;
             break;
+        case UCC_TL_UCP_ALLREDUCE_ALG_RING:
+            *init = ucc_tl_ucp_allreduce_ring_init;
+            break;
+        case UCC_TL_UCP_ALLREDUCE_ALG_DBT:
+            *init = ucc_tl_ucp_allreduce_dbt_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
@@ -149,6 +223,12 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_BCAST_ALG_SAG_KNOMIAL:
             *init = ucc_tl_ucp_bcast_sag_knomial_init;
             break;
+        case UCC_TL_UCP_BCAST_ALG_PIPELINED:
+            *init = ucc_tl_ucp_bcast_pipelined_init;
+            break;
+        case UCC_TL_UCP_BCAST_ALG_DBT:
+            *init = ucc_tl_ucp_bcast_dbt_init;
+            break;
         default:
            status = UCC_ERR_INVALID_PARAM;
            break;
@@ -162,6 +242,96 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
         case UCC_TL_UCP_ALLTOALL_ALG_ONESIDED:
             *init = ucc_tl_ucp_alltoall_onesided_init;
             break;
+        case UCC_TL_UCP_ALLTOALL_ALG_BRUCK:
+            *init = ucc_tl_ucp_alltoall_bruck_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
+    case UCC_COLL_TYPE_ALLTOALLV:
+        switch (alg_id) {
+        case UCC_TL_UCP_ALLTOALLV_ALG_PAIRWISE:
+            *init = ucc_tl_ucp_alltoallv_pairwise_init;
+            break;
+        case UCC_TL_UCP_ALLTOALLV_ALG_SPARSE:
+            *init = ucc_tl_ucp_alltoallv_sparse_init;
+            break;
+        case UCC_TL_UCP_ALLTOALLV_ALG_NODE:
+            *init = ucc_tl_ucp_alltoallv_node_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
+    case UCC_COLL_TYPE_ALLGATHER:
+        switch (alg_id) {
+        case UCC_TL_UCP_ALLGATHER_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_allgather_knomial_init;
+            break;
+        case UCC_TL_UCP_ALLGATHER_ALG_RING:
+            *init = ucc_tl_ucp_allgather_ring_init;
+            break;
+        case UCC_TL_UCP_ALLGATHER_ALG_BRUCK:
+            *init = ucc_tl_ucp_allgather_bruck_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
+    case UCC_COLL_TYPE_REDUCE:
+        switch (alg_id) {
+        case UCC_TL_UCP_REDUCE_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_reduce_knomial_init;
+            break;
+        case UCC_TL_UCP_REDUCE_ALG_SRG_KNOMIAL:
+            *init = ucc_tl_ucp_reduce_srg_knomial_init;
+            break;
+        case UCC_TL_UCP_REDUCE_ALG_PIPELINED:
+            *init = ucc_tl_ucp_reduce_pipelined_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
+    case UCC_COLL_TYPE_REDUCE_SCATTER:
+        switch (alg_id) {
+        case UCC_TL_UCP_REDUCE_SCATTER_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_reduce_scatter_knomial_init;
+            break;
+        case UCC_TL_UCP_REDUCE_SCATTER_ALG_RING:
+            *init = ucc_tl_ucp_reduce_scatter_ring_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
+    case UCC_COLL_TYPE_GATHERV:
+        switch (alg_id) {
+        case UCC_TL_UCP_GATHERV_ALG_LINEAR:
+            *init = ucc_tl_ucp_gatherv_linear_init;
+            break;
+        case UCC_TL_UCP_GATHERV_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_gatherv_knomial_init;
+            break;
+        default:
+            status = UCC_ERR_INVALID_PARAM;
+            break;
+        };
+        break;
+    case UCC_COLL_TYPE_SCATTERV:
+        switch (alg_id) {
+        case UCC_TL_UCP_SCATTERV_ALG_LINEAR:
+            *init = ucc_tl_ucp_scatterv_linear_init;
+            break;
+        case UCC_TL_UCP_SCATTERV_ALG_KNOMIAL:
+            *init = ucc_tl_ucp_scatterv_knomial_init;
+            break;
         default:
             status = UCC_ERR_INVALID_PARAM;
             break;
@@ -173,3 +343,22 @@ ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
     }
     return status;
 }
+
+/* Algorithms built on the node layout of the team (core team topo) */
+int ucc_tl_ucp_alg_topo_required(int alg_id, const char *alg_id_str,
+                                 ucc_coll_type_t coll_type)
+{
+    if (alg_id_str) {
+        alg_id = alg_id_from_str(coll_type, alg_id_str);
+    }
+
+    switch (coll_type) {
+    case UCC_COLL_TYPE_BARRIER:
+        return alg_id == UCC_TL_UCP_BARRIER_ALG_HIERARCHICAL;
+    case UCC_COLL_TYPE_ALLTOALLV:
+        return alg_id == UCC_TL_UCP_ALLTOALLV_ALG_NODE;
+    default:
+        break;
+    }
+    return 0;
+}
@@ -10,10 +10,12 @@
 #include "tl_ucp.h"
 #include "schedule/ucc_schedule_pipelined.h"
 #include "coll_patterns/recursive_knomial.h"
+#include "coll_patterns/double_binary_tree.h"
 #include "components/mc/base/ucc_mc_base.h"
 #include "tl_ucp_tag.h"
+#include "core/ucc_progress_queue.h"
 
-#define UCC_TL_UCP_N_DEFAULT_ALG_SELECT_STR 3
+#define UCC_TL_UCP_N_DEFAULT_ALG_SELECT_STR 7
 extern const char
     *ucc_tl_ucp_default_alg_select_str[UCC_TL_UCP_N_DEFAULT_ALG_SELECT_STR];
 
@@ -31,6 +33,74 @@ extern const char
 #define INV_VRANK(_rank, _root, _team_size)                                   \
     (((_rank) + (_root)) % (_team_size))
 
+/* Knomial tree over vranks rooted at vrank 0: returns the distance at which
+   "vrank" is a child, its parent is vrank - ((vrank / dist) % radix) * dist
+   and it owns the subtree [vrank, vrank + dist) clipped to team size.
+   Children of vrank are vrank + j * d, j = 1 .. radix - 1, for
+   d = 1, radix, .. < dist, each owning [child, child + d). For the root the
+   returned value is >= team size. A rank at the end of the team may have
+   dist > 1 but no children (e.g. vrank 14 of 15 with radix 2), leaves are
+   the ranks with ucc_kn_tree_subtree_size() == 1. */
+static inline ucc_rank_t ucc_kn_tree_dist(ucc_rank_t vrank, ucc_rank_t size,
+                                          ucc_kn_radix_t radix)
+{
+    ucc_rank_t dist = 1;
+
+    while (dist < size && ((vrank / dist) % radix) == 0) {
+        dist *= radix;
+    }
+    return dist;
+}
+
+/* Number of ranks in the subtree [vrank, vrank + dist) */
+static inline ucc_rank_t ucc_kn_tree_subtree_size(ucc_rank_t vrank,
+                                                  ucc_rank_t dist,
+                                                  ucc_rank_t size)
+{
+    return ucc_min(dist, size - vrank);
+}
+
+/* Parent of non root vrank, dist is given by ucc_kn_tree_dist */
+static inline ucc_rank_t ucc_kn_tree_parent(ucc_rank_t vrank, ucc_rank_t dist,
+                                            ucc_kn_radix_t radix)
+{
+    return vrank - ((vrank / dist) % radix) * dist;
+}
+
+/* Vranks [vrank, vrank + n) map to ranks starting at INV_VRANK(vrank), of
+   which the returned number is contiguous, the rest wraps around to rank 0 */
+static inline ucc_rank_t ucc_kn_tree_n_contig(ucc_rank_t vrank, ucc_rank_t n,
+                                              ucc_rank_t root, ucc_rank_t size)
+{
+    return ucc_min(n, size - INV_VRANK(vrank, root, size));
+}
+
+/* Finds the child subtree of the root whose ranks wrap around the end of the
+   team (at most one), returns 0 if there is none */
+static inline int ucc_kn_tree_wrapped_child(ucc_rank_t root, ucc_rank_t size,
+                                            ucc_kn_radix_t radix,
+                                            ucc_rank_t *child, ucc_rank_t *n)
+{
+    ucc_rank_t     d, c, nc;
+    ucc_kn_radix_t j;
+
+    for (d = 1; d < size; d *= radix) {
+        for (j = 1; j < radix; j++) {
+            c = j * d;
+            if (c >= size) {
+                break;
+            }
+            nc = ucc_kn_tree_subtree_size(c, d, size);
+            if (ucc_kn_tree_n_contig(c, nc, root, size) < nc) {
+                *child = c;
+                *n     = nc;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
 typedef struct ucc_tl_ucp_task {
     ucc_coll_task_t super;
     uint32_t        send_posted;
@@ -45,33 +115,120 @@ typedef struct ucc_tl_ucp_task {
             int                     phase;
             ucc_knomial_pattern_t   p;
         } barrier;
+        struct {
+            ucc_rank_t              dist;
+            ucc_kn_radix_t          radix;
+        } dissemination;
+        struct {
+            int                     phase;
+            ucc_rank_t              dist;
+            ucc_kn_radix_t          radix;
+            ucc_rank_t              nnodes;
+            ucc_rank_t              node;
+            ucc_rank_t              lsize;
+            ucc_rank_t             *map; /* host to node index, owns
+                                            leaders and locals */
+            ucc_rank_t             *leaders;
+            ucc_rank_t             *locals; /* ranks of my node, leader
+                                               first */
+        } barrier_hier;
+        struct {
+            int                     phase;
+            ucc_knomial_pattern_t   p;
+        } fanin_fanout;
         struct {
             int                     phase;
             ucc_knomial_pattern_t   p;
             void                   *scratch;
             ucc_mc_buffer_header_t *scratch_mc_header;
         } allreduce_kn;
+        struct {
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+            size_t                  scratch_seg_size;
+            uint32_t                n_segs;
+            uint32_t                unit;
+        } allreduce_ring;
         struct {
             int                     phase;
             ucc_knomial_pattern_t   p;
             void                   *scratch;
             ucc_mc_buffer_header_t *scratch_mc_header;
+            void                   *sbuf;
         } reduce_scatter_kn;
+        struct {
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+            size_t                  slot_size;
+            ucc_rank_t              step;
+            int                     posted;
+        } reduce_scatter_ring;
         struct {
             int                     phase;
             ucc_knomial_pattern_t   p;
             ucc_rank_t              recv_dist;
             ptrdiff_t               send_offset;
         } scatter_kn;
+        struct {
+            int                     phase;
+            ucc_kn_radix_t          radix;
+            ucc_rank_t              dist;
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+        } kn_tree; /* gather and scatter knomial trees */
+        struct {
+            int                     phase;
+            ucc_kn_radix_t          radix;
+            ucc_rank_t              dist;
+            uint64_t               *counts;
+            uint64_t                total;
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+        } kn_treev; /* gatherv and scatterv knomial trees */
         struct {
             int                     phase;
             ucc_knomial_pattern_t   p;
             void                   *sbuf;
         } allgather_kn;
+        struct {
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+            ucc_rank_t              dist;
+        } allgather_bruck;
+        struct {
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+            ucc_rank_t              dist;
+            ucc_rank_t              radix;
+            int                     posted;
+        } alltoall_bruck;
+        struct {
+            ucc_rank_t             *peers;
+            ucc_rank_t              n_send;
+            ucc_rank_t              n_recv;
+        } alltoallv_sparse;
+        struct {
+            int                     phase;
+            ucc_rank_t             *map;
+            uint64_t               *meta;
+            void                   *bufs[3];
+            ucc_rank_t              nnodes;
+            ucc_rank_t              node;
+        } alltoallv_node;
         struct {
             ucc_rank_t              dist;
             uint32_t                radix;
         } bcast_kn;
+        struct {
+            int                     phase;
+            ucc_kn_radix_t          radix;
+        } bcast_pipelined;
+        struct {
+            int                     phase;
+            ucc_dbt_single_tree_t   t;
+            void                   *scratch;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+        } dbt; /* allreduce and bcast over one tree of double binary tree */
         struct {
             ucc_rank_t              dist;
             ucc_rank_t              max_dist;
@@ -81,6 +238,10 @@ typedef struct ucc_tl_ucp_task {
             void                   *scratch;
             ucc_mc_buffer_header_t *scratch_mc_header;
         } reduce_kn;
+        struct {
+            ucc_kn_radix_t          radix;
+            ucc_mc_buffer_header_t *scratch_mc_header;
+        } reduce_srg_kn;
     };
 } ucc_tl_ucp_task_t;
 
@@ -171,6 +332,13 @@ ucc_tl_ucp_init_task(ucc_base_coll_args_t *coll_args, ucc_base_team_t *team)
     ucc_tl_ucp_task_t *task    = ucc_tl_ucp_get_task(tl_team);
 
     ucc_coll_task_init(&task->super, coll_args, team);
+    if (ucc_progress_queue_has_ready_list(UCC_TL_CORE_CTX(tl_team)->pq)) {
+        /* ucp worker is progressed once per ucc_context_progress by the
+           registered progress fn, task is progressed only after completion
+           callback of its send/recv */
+        task->super.flags |= UCC_COLL_TASK_FLAG_EVENT_DRIVEN;
+        task->n_polls      = 0;
+    }
     task->tag            = tl_team->seq_num;
     tl_team->seq_num     = (tl_team->seq_num + 1) % UCC_TL_UCP_MAX_COLL_TAG;
     task->super.finalize = ucc_tl_ucp_coll_finalize;
@@ -178,6 +346,24 @@ ucc_tl_ucp_init_task(ucc_base_coll_args_t *coll_args, ucc_base_team_t *team)
     return task;
 }
 
+/* Used by algorithms whose progress does not depend on p2p completions only
+   (e.g. polling of remote memory): such tasks are progressed on every
+   ucc_context_progress call */
+static inline void ucc_tl_ucp_task_set_polling(ucc_tl_ucp_task_t *task)
+{
+    task->super.flags &= ~UCC_COLL_TASK_FLAG_EVENT_DRIVEN;
+    task->n_polls      = TASK_CTX(task)->cfg.n_polls;
+}
+
+/* Notifies progress queue that event driven task got completion */
+static inline void ucc_tl_ucp_task_ready(ucc_tl_ucp_task_t *task)
+{
+    if (task->super.flags & UCC_COLL_TASK_FLAG_EVENT_DRIVEN) {
+        ucc_progress_task_ready(UCC_TL_CORE_CTX(TASK_TEAM(task))->pq,
+                                &task->super);
+    }
+}
+
 #define UCC_TL_UCP_TASK_P2P_COMPLETE(_task)                                    \
     (((_task)->send_posted == (_task)->send_completed) &&                      \
      ((_task)->recv_posted == (_task)->recv_completed))
@@ -197,9 +383,35 @@ static inline ucc_status_t ucc_tl_ucp_test(ucc_tl_ucp_task_t *task)
     return UCC_INPROGRESS;
 }
 
+/* Radix selected by the caller (e.g. autotuner candidate), configured one or,
+   if the configured radix is 0 (auto), the one selected by the knomial cost
+   model of the context for the given team size and message size */
+static inline ucc_kn_radix_t
+ucc_tl_ucp_kn_radix(ucc_tl_ucp_team_t *team, const ucc_base_coll_args_t *bargs,
+                    ucc_kn_radix_t cfg_radix, ucc_kn_model_pattern_t pattern,
+                    ucc_rank_t size, size_t msgsize)
+{
+    ucc_tl_ucp_context_t *ctx = UCC_TL_UCP_TEAM_CTX(team);
+
+    if (bargs->mask & UCC_BASE_CARGS_RADIX) {
+        return bargs->radix;
+    }
+    if (cfg_radix) {
+        return cfg_radix;
+    }
+    if (!ctx->kn_model_valid) {
+        return UCC_TL_UCP_KN_DEFAULT_RADIX;
+    }
+    return ucc_kn_model_get_radix(&ctx->kn_model, pattern, size, msgsize,
+                                  UCC_KN_MODEL_MAX_RADIX);
+}
+
 ucc_status_t ucc_tl_ucp_alg_id_to_init(int alg_id, const char *alg_id_str,
                                        ucc_coll_type_t          coll_type,
                                        ucc_memory_type_t        mem_type,
                                        ucc_base_coll_init_fn_t *init);
 
+int ucc_tl_ucp_alg_topo_required(int alg_id, const char *alg_id_str,
+                                 ucc_coll_type_t coll_type);
+
 #endif
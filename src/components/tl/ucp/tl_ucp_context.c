@@ -10,8 +10,20 @@
 #include "tl_ucp_ep.h"
 #include "utils/ucc_math.h"
 #include "schedule/ucc_schedule_pipelined.h"
+#include "coll_score/ucc_coll_score.h"
 #include <limits.h>
 
+static ucc_status_t ucc_tl_ucp_worker_arm(void *arg)
+{
+    ucs_status_t status = ucp_worker_arm((ucp_worker_h)arg);
+
+    if (UCS_ERR_BUSY == status) {
+        /* worker has pending events, need to progress */
+        return UCC_INPROGRESS;
+    }
+    return ucs_status_to_ucc_status(status);
+}
+
 UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
                     const ucc_base_context_params_t *params,
                     const ucc_base_config_t *config)
@@ -27,6 +39,7 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
     ucp_context_h       ucp_context;
     ucp_worker_h        ucp_worker;
     ucs_status_t        status;
+    int                 efd;
 
     UCC_CLASS_CALL_SUPER_INIT(ucc_tl_context_t, tl_ucp_config->super.tl_lib,
                               params->context);
@@ -45,6 +58,9 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
     if (params->params.mask & UCC_CONTEXT_PARAM_FIELD_MEM_PARAMS) {
         ucp_params.features |= UCP_FEATURE_RMA | UCP_FEATURE_AMO64;
     }
+    if (tl_ucp_config->wakeup) {
+        ucp_params.features |= UCP_FEATURE_WAKEUP;
+    }
     ucp_params.tag_sender_mask = UCC_TL_UCP_TAG_SENDER_MASK;
 
     if (params->estimated_num_ppn > 0) {
@@ -131,6 +147,20 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
         ucc_status = UCC_ERR_NO_MESSAGE;
         goto err_thread_mode;
     }
+    if (tl_ucp_config->wakeup) {
+        status = ucp_worker_get_efd(self->ucp_worker, &efd);
+        if (UCS_OK != status) {
+            tl_warn(self->super.super.lib, "failed to get ucp worker efd, %s",
+                    ucs_status_string(status));
+        } else if (UCC_OK != ucc_context_progress_set_wakeup(
+                                 params->context,
+                                 (ucc_context_progress_fn_t)ucp_worker_progress,
+                                 self->ucp_worker, efd,
+                                 ucc_tl_ucp_worker_arm)) {
+            tl_warn(self->super.super.lib,
+                    "failed to register ucp worker efd");
+        }
+    }
 
     self->remote_info  = NULL;
     self->n_rinfo_segs = 0;
@@ -158,6 +188,7 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_context_t,
         self->eps     = NULL;
         self->ep_hash = kh_init(tl_ucp_ep_hash);
     }
+    ucc_tl_ucp_kn_model_init(self);
     tl_info(self->super.super.lib, "initialized tl context: %p", self);
     return UCC_OK;
 
@@ -587,6 +618,9 @@ ucc_status_t ucc_tl_ucp_get_context_attr(const ucc_base_context_t *context,
         attr->attr.global_work_buffer_size =
             ONESIDED_SYNC_SIZE + ONESIDED_REDUCE_SIZE;
     }
-    attr->topo_required = 0;
+    /* node layout is only exchanged if the tuning selects the node aware
+       algorithms or filters the ranges by nnodes/ppn */
+    attr->topo_required = ucc_coll_score_rules_topo_required(
+        ctx->super.super.lib->score_rules, ucc_tl_ucp_alg_topo_required);
     return UCC_OK;
 }
@@ -0,0 +1,225 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include "tl_ucp.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_time.h"
+
+/* Calibration of the knomial cost model: loopback ping-pong over the ucp
+   worker of the context. Per message overhead is the time to post a send,
+   the per byte cost is the slope of the message time between the small
+   and large messages, the rest of the small message time is the latency.
+   The parameters are agreed (max over the ranks) over the context OOB so
+   that all the ranks select the same radix. */
+
+#define UCC_TL_UCP_KN_MODEL_TAG    ((ucp_tag_t)-1)
+#define UCC_TL_UCP_KN_MODEL_SMALL  8
+#define UCC_TL_UCP_KN_MODEL_LARGE  (64 * 1024)
+#define UCC_TL_UCP_KN_MODEL_WARMUP 4
+#define UCC_TL_UCP_KN_MODEL_ITERS  16
+
+static ucs_status_t ucc_tl_ucp_kn_model_wait(ucp_worker_h     worker,
+                                             ucs_status_ptr_t req)
+{
+    ucs_status_t status;
+
+    if (!UCS_PTR_IS_PTR(req)) {
+        return UCS_PTR_STATUS(req);
+    }
+    do {
+        ucp_worker_progress(worker);
+        status = ucp_request_check_status(req);
+    } while (status == UCS_INPROGRESS);
+    ucp_request_free(req);
+    return status;
+}
+
+/* Average one way time and send post time of the message of size len */
+static ucc_status_t ucc_tl_ucp_kn_model_pingpong(ucc_tl_ucp_context_t *ctx,
+                                                 ucp_ep_h ep, void *sbuf,
+                                                 void *rbuf, size_t len,
+                                                 double *t_msg, double *t_post)
+{
+    ucp_worker_h        worker = ctx->ucp_worker;
+    ucp_request_param_t param;
+    ucs_status_ptr_t    sreq, rreq;
+    ucs_status_t        sst, rst;
+    double              t0 = 0, t_start, post = 0;
+    int                 i;
+
+    param.op_attr_mask = UCP_OP_ATTR_FIELD_DATATYPE;
+    param.datatype     = ucp_dt_make_contig(1);
+    for (i = 0; i < UCC_TL_UCP_KN_MODEL_WARMUP + UCC_TL_UCP_KN_MODEL_ITERS;
+         i++) {
+        if (i == UCC_TL_UCP_KN_MODEL_WARMUP) {
+            t0 = ucc_get_time();
+        }
+        rreq    = ucp_tag_recv_nbx(worker, rbuf, len, UCC_TL_UCP_KN_MODEL_TAG,
+                                   (ucp_tag_t)-1, &param);
+        t_start = ucc_get_time();
+        sreq    = ucp_tag_send_nbx(ep, sbuf, len, UCC_TL_UCP_KN_MODEL_TAG,
+                                   &param);
+        if (i >= UCC_TL_UCP_KN_MODEL_WARMUP) {
+            post += ucc_get_time() - t_start;
+        }
+        sst = ucc_tl_ucp_kn_model_wait(worker, sreq);
+        rst = ucc_tl_ucp_kn_model_wait(worker, rreq);
+        if (UCS_OK != sst || UCS_OK != rst) {
+            tl_debug(ctx->super.super.lib, "kn model ping-pong failed: %s",
+                     ucs_status_string(UCS_OK != sst ? sst : rst));
+            return UCC_ERR_NO_MESSAGE;
+        }
+    }
+    *t_msg  = (ucc_get_time() - t0) / UCC_TL_UCP_KN_MODEL_ITERS;
+    *t_post = post / UCC_TL_UCP_KN_MODEL_ITERS;
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_tl_ucp_kn_model_calibrate(ucc_tl_ucp_context_t *ctx,
+                                                  ucc_kn_model_t *model)
+{
+    ucc_status_t        status = UCC_OK;
+    ucp_address_t      *addr;
+    size_t              addr_len;
+    ucp_ep_params_t     ep_params;
+    ucp_request_param_t param;
+    ucp_ep_h            ep;
+    ucs_status_t        ucs_st;
+    void               *sbuf, *rbuf;
+    double              t_small, t_large, post_small, post_large;
+
+    ucs_st = ucp_worker_get_address(ctx->ucp_worker, &addr, &addr_len);
+    if (UCS_OK != ucs_st) {
+        return ucs_status_to_ucc_status(ucs_st);
+    }
+    ep_params.field_mask = UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+    ep_params.address    = addr;
+    ucs_st               = ucp_ep_create(ctx->ucp_worker, &ep_params, &ep);
+    ucp_worker_release_address(ctx->ucp_worker, addr);
+    if (UCS_OK != ucs_st) {
+        return ucs_status_to_ucc_status(ucs_st);
+    }
+    sbuf = ucc_malloc(2 * UCC_TL_UCP_KN_MODEL_LARGE, "kn_model_buf");
+    if (!sbuf) {
+        tl_error(ctx->super.super.lib,
+                 "failed to allocate %d bytes for kn model buffer",
+                 2 * UCC_TL_UCP_KN_MODEL_LARGE);
+        status = UCC_ERR_NO_MEMORY;
+        goto close_ep;
+    }
+    memset(sbuf, 0, 2 * UCC_TL_UCP_KN_MODEL_LARGE);
+    rbuf   = PTR_OFFSET(sbuf, UCC_TL_UCP_KN_MODEL_LARGE);
+    status = ucc_tl_ucp_kn_model_pingpong(ctx, ep, sbuf, rbuf,
+                                          UCC_TL_UCP_KN_MODEL_SMALL, &t_small,
+                                          &post_small);
+    if (UCC_OK != status) {
+        goto free_buf;
+    }
+    status = ucc_tl_ucp_kn_model_pingpong(ctx, ep, sbuf, rbuf,
+                                          UCC_TL_UCP_KN_MODEL_LARGE, &t_large,
+                                          &post_large);
+    if (UCC_OK != status) {
+        goto free_buf;
+    }
+    model->o = post_small;
+    model->L = ucc_max(t_small - 2 * post_small, 0);
+    model->G = ucc_max(t_large - t_small, 0) /
+               (UCC_TL_UCP_KN_MODEL_LARGE - UCC_TL_UCP_KN_MODEL_SMALL);
+free_buf:
+    ucc_free(sbuf);
+close_ep:
+    param.op_attr_mask = UCP_OP_ATTR_FIELD_FLAGS;
+    param.flags        = 0;
+    ucc_tl_ucp_kn_model_wait(ctx->ucp_worker, ucp_ep_close_nbx(ep, &param));
+    return status;
+}
+
+/* Max of the model parameters over the context ranks */
+static ucc_status_t ucc_tl_ucp_kn_model_agree(ucc_tl_ucp_context_t *ctx,
+                                              ucc_kn_model_t *model)
+{
+    ucc_context_oob_coll_t *oob = &UCC_TL_CTX_OOB(ctx);
+    ucc_kn_model_t         *all;
+    ucc_status_t            status;
+    void                   *req;
+    uint32_t                i;
+
+    all = ucc_malloc(oob->n_oob_eps * sizeof(*all), "kn_model_all");
+    if (!all) {
+        tl_error(ctx->super.super.lib,
+                 "failed to allocate %zd bytes for kn model exchange",
+                 oob->n_oob_eps * sizeof(*all));
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = oob->allgather(model, all, sizeof(*model), oob->coll_info, &req);
+    if (UCC_OK != status) {
+        goto out;
+    }
+    while (UCC_INPROGRESS == (status = oob->req_test(req))) {
+        ucp_worker_progress(ctx->ucp_worker);
+    }
+    oob->req_free(req);
+    if (UCC_OK != status) {
+        goto out;
+    }
+    for (i = 0; i < oob->n_oob_eps; i++) {
+        model->L = ucc_max(model->L, all[i].L);
+        model->o = ucc_max(model->o, all[i].o);
+        model->G = ucc_max(model->G, all[i].G);
+    }
+out:
+    ucc_free(all);
+    return status;
+}
+
+void ucc_tl_ucp_kn_model_init(ucc_tl_ucp_context_t *ctx)
+{
+    ucc_tl_ucp_context_config_t *cfg = &ctx->cfg;
+    ucc_kn_model_t              *m   = &ctx->kn_model;
+    int                          user_model;
+    ucc_status_t                 status;
+
+    ctx->kn_model_valid = 0;
+    if (!cfg->kn_model) {
+        return;
+    }
+    memset(m, 0, sizeof(*m));
+    user_model = (cfg->kn_model_latency > 0) && (cfg->kn_model_overhead > 0) &&
+                 (cfg->kn_model_bw > 0);
+    if (!user_model) {
+        if (!(ctx->super.super.ucc_context->params.mask &
+              UCC_CONTEXT_PARAM_FIELD_OOB)) {
+            /* can't agree on the calibrated model */
+            tl_debug(ctx->super.super.lib,
+                     "knomial cost model requires global context");
+            return;
+        }
+        status = ucc_tl_ucp_kn_model_calibrate(ctx, m);
+        if (UCC_OK != status) {
+            /* all ranks must agree on the model validity */
+            memset(m, 0, sizeof(*m));
+        }
+        status = ucc_tl_ucp_kn_model_agree(ctx, m);
+        if (UCC_OK != status) {
+            tl_debug(ctx->super.super.lib, "failed to agree on kn model");
+            return;
+        }
+    }
+    if (cfg->kn_model_latency > 0) {
+        m->L = cfg->kn_model_latency;
+    }
+    if (cfg->kn_model_overhead > 0) {
+        m->o = cfg->kn_model_overhead;
+    }
+    if (cfg->kn_model_bw > 0) {
+        m->G = 1.0 / cfg->kn_model_bw;
+    }
+    ctx->kn_model_valid = (m->L + m->o > 0) && (m->G > 0);
+    tl_debug(ctx->super.super.lib,
+             "knomial cost model: L %.3f us, o %.3f us, G %.3f ns/KB, %s",
+             m->L * 1e6, m->o * 1e6, m->G * 1e12,
+             ctx->kn_model_valid ? "enabled" : "disabled");
+}
@@ -18,6 +18,7 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_lib_t, const ucc_base_lib_params_t *params,
     memcpy(&self->cfg, tl_ucp_config, sizeof(*tl_ucp_config));
     if (tl_ucp_config->kn_radix > 0) {
         self->cfg.barrier_kn_radix        = tl_ucp_config->kn_radix;
+        self->cfg.barrier_dissemination_radix = tl_ucp_config->kn_radix;
         self->cfg.allreduce_kn_radix      = tl_ucp_config->kn_radix;
         self->cfg.allreduce_sra_kn_radix  = tl_ucp_config->kn_radix;
         self->cfg.reduce_scatter_kn_radix = tl_ucp_config->kn_radix;
@@ -25,7 +26,13 @@ UCC_CLASS_INIT_FUNC(ucc_tl_ucp_lib_t, const ucc_base_lib_params_t *params,
         self->cfg.bcast_kn_radix          = tl_ucp_config->kn_radix;
         self->cfg.bcast_sag_kn_radix      = tl_ucp_config->kn_radix;
         self->cfg.reduce_kn_radix         = tl_ucp_config->kn_radix;
+        self->cfg.reduce_srg_kn_radix     = tl_ucp_config->kn_radix;
         self->cfg.scatter_kn_radix        = tl_ucp_config->kn_radix;
+        self->cfg.gather_kn_radix         = tl_ucp_config->kn_radix;
+        self->cfg.gatherv_kn_radix        = tl_ucp_config->kn_radix;
+        self->cfg.scatterv_kn_radix       = tl_ucp_config->kn_radix;
+        self->cfg.fanin_kn_radix          = tl_ucp_config->kn_radix;
+        self->cfg.fanout_kn_radix         = tl_ucp_config->kn_radix;
     }
     tl_info(&self->super, "initialized lib object: %p", self);
     return UCC_OK;
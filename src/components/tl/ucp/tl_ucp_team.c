@@ -10,6 +10,10 @@
 #include "tl_ucp_sendrecv.h"
 #include "utils/ucc_malloc.h"
 #include "coll_score/ucc_coll_score.h"
+#include "allreduce/allreduce.h"
+#include "allgather/allgather.h"
+#include "bcast/bcast.h"
+#include "reduce_scatter/reduce_scatter.h"
 
 UCC_CLASS_INIT_FUNC(ucc_tl_ucp_team_t, ucc_base_context_t *tl_context,
                     const ucc_base_team_params_t *params)
@@ -116,6 +120,66 @@ err_preconnect:
     return status;
 }
 
+static const struct {
+    ucc_coll_type_t coll_type;
+    int             alg_id;
+} ucc_tl_ucp_tune_algs[] = {
+    {UCC_COLL_TYPE_ALLREDUCE, UCC_TL_UCP_ALLREDUCE_ALG_KNOMIAL},
+    {UCC_COLL_TYPE_ALLREDUCE, UCC_TL_UCP_ALLREDUCE_ALG_SRA_KNOMIAL},
+    {UCC_COLL_TYPE_BCAST,     UCC_TL_UCP_BCAST_ALG_KNOMIAL},
+    {UCC_COLL_TYPE_BCAST,     UCC_TL_UCP_BCAST_ALG_SAG_KNOMIAL},
+    {UCC_COLL_TYPE_ALLGATHER, UCC_TL_UCP_ALLGATHER_ALG_KNOMIAL},
+    {UCC_COLL_TYPE_REDUCE_SCATTER, UCC_TL_UCP_REDUCE_SCATTER_ALG_KNOMIAL},
+};
+
+static const ucc_kn_radix_t ucc_tl_ucp_tune_radices[] = {2, 4, 8};
+
+#define UCC_TL_UCP_N_TUNE_ALGS                                                 \
+    (sizeof(ucc_tl_ucp_tune_algs) / sizeof(ucc_tl_ucp_tune_algs[0]))
+#define UCC_TL_UCP_N_TUNE_RADICES                                              \
+    (sizeof(ucc_tl_ucp_tune_radices) / sizeof(ucc_tl_ucp_tune_radices[0]))
+
+/* Registers the algorithm candidates of the autotuner: every radix based
+   algorithm with a set of radices, radix larger than team size is
+   equivalent to radix = team size and is skipped */
+static ucc_status_t ucc_tl_ucp_team_add_tune_cands(ucc_tl_ucp_team_t *team,
+                                                   ucc_coll_score_t  *score,
+                                                   ucc_memory_type_t *mem_types,
+                                                   int                mt_n)
+{
+    ucc_rank_t              size = UCC_TL_TEAM_SIZE(team);
+    ucc_base_coll_init_fn_t init;
+    ucc_kn_radix_t          radix;
+    ucc_status_t            status;
+    int                     m;
+    unsigned                i, j;
+
+    for (m = 0; m < mt_n; m++) {
+        for (i = 0; i < UCC_TL_UCP_N_TUNE_ALGS; i++) {
+            status = ucc_tl_ucp_alg_id_to_init(
+                ucc_tl_ucp_tune_algs[i].alg_id, NULL,
+                ucc_tl_ucp_tune_algs[i].coll_type, mem_types[m], &init);
+            if (UCC_OK != status) {
+                return status;
+            }
+            for (j = 0; j < UCC_TL_UCP_N_TUNE_RADICES; j++) {
+                radix = ucc_tl_ucp_tune_radices[j];
+                if (j > 0 && radix > size) {
+                    break;
+                }
+                status = ucc_coll_score_add_cand(
+                    score, ucc_tl_ucp_tune_algs[i].coll_type, mem_types[m],
+                    ucc_tl_ucp_tune_algs[i].alg_id, radix, init,
+                    &team->super.super);
+                if (UCC_OK != status) {
+                    return status;
+                }
+            }
+        }
+    }
+    return UCC_OK;
+}
+
 ucc_status_t ucc_tl_ucp_team_get_scores(ucc_base_team_t   *tl_team,
                                         ucc_coll_score_t **score_p)
 {
@@ -125,6 +189,7 @@ ucc_status_t ucc_tl_ucp_team_get_scores(ucc_base_team_t   *tl_team,
     int                   mt_n = 0;
     ucc_memory_type_t     mem_types[UCC_MEMORY_TYPE_LAST];
     ucc_coll_score_t     *score;
+    ucc_coll_score_team_info_t info;
     ucc_status_t          status;
     unsigned              i;
 
@@ -157,9 +222,16 @@ ucc_status_t ucc_tl_ucp_team_get_scores(ucc_base_team_t   *tl_team,
             goto err;
         }
     }
-    if (strlen(lib->super.super.score_str) > 0) {
-        status = ucc_coll_score_update_from_str(
-            lib->super.super.score_str, score, UCC_TL_TEAM_SIZE(team), NULL,
+    if (UCC_TL_CORE_CTX(team)->tune_cfg.enable) {
+        status = ucc_tl_ucp_team_add_tune_cands(team, score, mem_types, mt_n);
+        if (UCC_OK != status) {
+            goto err;
+        }
+    }
+    if (lib->super.super.score_rules) {
+        ucc_coll_score_team_info_init(&team->super.super, &info);
+        status = ucc_coll_score_update_from_rules(
+            lib->super.super.score_rules, score, &info, NULL,
             &team->super.super, UCC_TL_UCP_DEFAULT_SCORE,
             ucc_tl_ucp_alg_id_to_init);
 
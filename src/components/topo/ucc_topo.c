@@ -216,6 +216,36 @@ int ucc_topo_is_single_node(ucc_topo_t *topo)
     return 0;
 }
 
+ucc_status_t ucc_topo_get_shape(ucc_topo_t *topo, ucc_ep_map_t map,
+                                ucc_rank_t size, ucc_rank_t *nnodes,
+                                ucc_rank_t *ppn)
+{
+    ucc_rank_t  n_hosts = topo->topo->nnodes;
+    ucc_rank_t *n_procs;
+    ucc_rank_t  i, ctx_rank;
+
+    n_procs = ucc_calloc(n_hosts, sizeof(ucc_rank_t), "n_procs");
+    if (!n_procs) {
+        ucc_error("failed to allocate %zd bytes for n_procs",
+                  n_hosts * sizeof(ucc_rank_t));
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (i = 0; i < size; i++) {
+        ctx_rank = ucc_ep_map_eval(topo->set.map, ucc_ep_map_eval(map, i));
+        n_procs[topo->topo->procs[ctx_rank].host_id]++;
+    }
+    *nnodes = 0;
+    *ppn    = 0;
+    for (i = 0; i < n_hosts; i++) {
+        if (n_procs[i]) {
+            (*nnodes)++;
+            *ppn = ucc_max(*ppn, n_procs[i]);
+        }
+    }
+    ucc_free(n_procs);
+    return UCC_OK;
+}
+
 ucc_status_t ucc_topo_get_all_sockets(ucc_topo_t *topo, ucc_sbgp_t **sbgps,
                                       int *n_sbgps)
 {
@@ -73,6 +73,13 @@ void         ucc_topo_cleanup(ucc_topo_t *subset_topo);
 ucc_sbgp_t *ucc_topo_get_sbgp(ucc_topo_t *topo, ucc_sbgp_type_t type);
 
 int ucc_topo_is_single_node(ucc_topo_t *topo);
+/* Computes the shape of the subgroup of topo: ranks 0..size-1 of the
+   subgroup are mapped to topo ranks with map. Returns the number of nodes
+   spanned by the subgroup and max number of its processes per node. */
+ucc_status_t ucc_topo_get_shape(ucc_topo_t *topo, ucc_ep_map_t map,
+                                ucc_rank_t size, ucc_rank_t *nnodes,
+                                ucc_rank_t *ppn);
+
 /* Returns the array of ALL existing socket subgroups of given topo */
 ucc_status_t ucc_topo_get_all_sockets(ucc_topo_t *topo, ucc_sbgp_t **sbgps,
                                       int *n_sbgps);
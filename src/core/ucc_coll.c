@@ -106,8 +106,6 @@ static ucc_status_t ucc_coll_args_check_mem_type(ucc_coll_args_t *coll_args,
             UCC_BUFFER_INFO_CHECK_MEM_TYPE(coll_args->src.info_v);
         }
         return UCC_OK;
-    case UCC_COLL_TYPE_GATHER:
-    	// TODO: Check logic for Gather once implemented
     case UCC_COLL_TYPE_REDUCE:
         if (!UCC_IS_ROOT(*coll_args, rank)) {
             UCC_BUFFER_INFO_CHECK_MEM_TYPE(coll_args->src.info);
@@ -118,6 +116,14 @@ static ucc_status_t ucc_coll_args_check_mem_type(ucc_coll_args_t *coll_args,
         	}
         }
         return UCC_OK;
+    case UCC_COLL_TYPE_GATHER:
+        if (UCC_IS_ROOT(*coll_args, rank)) {
+            UCC_BUFFER_INFO_CHECK_MEM_TYPE(coll_args->dst.info);
+        }
+        if (!(UCC_IS_INPLACE(*coll_args) && UCC_IS_ROOT(*coll_args, rank))) {
+            UCC_BUFFER_INFO_CHECK_MEM_TYPE(coll_args->src.info);
+        }
+        return UCC_OK;
     case UCC_COLL_TYPE_GATHERV:
         if (UCC_IS_ROOT(*coll_args, rank)) {
             UCC_BUFFER_INFO_CHECK_MEM_TYPE(coll_args->dst.info_v);
@@ -148,6 +154,36 @@ static ucc_status_t ucc_coll_args_check_mem_type(ucc_coll_args_t *coll_args,
     };
 }
 
+static ucc_status_t ucc_coll_tune_completed_handler(ucc_coll_task_t *parent,
+                                                    ucc_coll_task_t *task)
+{
+    ucc_team_t *team = parent->bargs.team;
+
+    ucc_coll_tuner_sample(team->tuner, &parent->bargs, parent->tune_cand,
+                          ucc_get_time() - parent->start_time);
+    return UCC_OK;
+}
+
+static inline ucc_status_t ucc_team_coll_init(ucc_team_t           *team,
+                                              ucc_base_coll_args_t *op_args,
+                                              ucc_coll_task_t     **task)
+{
+    ucc_status_t status;
+    int          cand;
+
+    if (ucc_likely(!team->tuner)) {
+        return ucc_coll_init(team->score_map, op_args, task);
+    }
+    status = ucc_coll_tuner_coll_init(team->tuner, op_args, task, &cand);
+    if (UCC_OK == status && cand >= 0) {
+        (*task)->flags    |= UCC_COLL_TASK_FLAG_TUNE;
+        (*task)->tune_cand = cand;
+        ucc_event_manager_subscribe(&(*task)->em, UCC_EVENT_COMPLETED, *task,
+                                    ucc_coll_tune_completed_handler);
+    }
+    return status;
+}
+
 UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_init,
                       (coll_args, request, team), ucc_coll_args_t *coll_args,
                       ucc_coll_req_h *request, ucc_team_h team)
@@ -176,7 +212,19 @@ UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_init,
     UCC_COPY_PARAM_BY_FIELD(&op_args.args, coll_args, UCC_COLL_ARGS_FIELD_FLAGS,
                             flags);
 
-    status = ucc_coll_init(team->score_map, &op_args, &task);
+    if (team->fusion) {
+        if (ucc_coll_fusion_check(team->fusion, &op_args.args)) {
+            status = ucc_coll_fusion_req_init(team->fusion, &op_args, &task);
+        } else {
+            /* keep the order of fused and regular collectives */
+            status = ucc_coll_fusion_flush(team->fusion);
+            if (ucc_likely(status >= 0)) {
+                status = ucc_team_coll_init(team, &op_args, &task);
+            }
+        }
+    } else {
+        status = ucc_team_coll_init(team, &op_args, &task);
+    }
 
     if (UCC_ERR_NOT_SUPPORTED == status) {
         ucc_debug("failed to init collective: not supported");
@@ -204,14 +252,50 @@ UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_post, (request),
                       ucc_coll_req_h request)
 {
     ucc_coll_task_t *task = ucc_derived_of(request, ucc_coll_task_t);
+    ucc_context_t   *ctx;
+    ucc_status_t     status;
 
     ucc_debug("coll_post: req %p, seq_num %u", task, task->seq_num);
 
-    if (UCC_COLL_TIMEOUT_REQUIRED(task)) {
+    if (UCC_IS_PERSISTENT(task->bargs.args)) {
+        /* persistent request keeps its selection, tag and resources between
+           posts: all the algorithms reset their progress state in post fn,
+           so it is only required that previous instance is completed */
+        if (ucc_unlikely(task->super.status == UCC_INPROGRESS)) {
+            ucc_error("persistent req %p, seq_num %u is posted while still "
+                      "in progress", task, task->seq_num);
+            return UCC_ERR_INVALID_PARAM;
+        }
+    }
+
+    if (UCC_COLL_TIMEOUT_REQUIRED(task) ||
+        (task->flags & UCC_COLL_TASK_FLAG_TUNE)) {
         task->start_time = ucc_get_time();
     }
 
-    return task->post(task);
+    ctx = task->team->context->ucc_context;
+    if (ctx->pt) {
+        /* status is set here so that the request can be tested right
+           after post, actual post is done by the progress thread */
+        task->super.status = UCC_INPROGRESS;
+        ucc_context_progress_thread_post(ctx, task);
+        return UCC_OK;
+    }
+
+    status = task->post(task);
+    if (ucc_unlikely(ctx->n_waiters)) {
+        /* other thread sleeps in ucc_context_wait */
+        ucc_context_wakeup(ctx);
+    }
+    return status;
+}
+
+ucc_status_t ucc_collective_wait(ucc_coll_req_h request, double timeout)
+{
+    ucc_coll_task_t *task = ucc_derived_of(request, ucc_coll_task_t);
+
+    return ucc_context_wait_task(task->team->context->ucc_context, task,
+                                 timeout);
 }
 
 UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_finalize, (request),
@@ -223,18 +307,37 @@ UCC_CORE_PROFILE_FUNC(ucc_status_t, ucc_collective_finalize, (request),
     return task->finalize(task);
 }
 
+/* dummy event of the implicitly triggered task (cuda stream ee) */
+#define UCC_TRIGGERED_EV_IMPLICIT ((ucc_ev_t *)0xFFFF)
+
 static ucc_status_t ucc_triggered_task_finalize(ucc_coll_task_t *task)
 {
     ucc_trace("finalizing triggered ev task %p", task);
-    ucc_free(task);
+    if (task->ev && task->ev != UCC_TRIGGERED_EV_IMPLICIT) {
+        /* event descriptor taken from ee in queue */
+        ucc_ee_ack_event(task->ee, task->ev);
+    }
+    ucc_mpool_put(task);
     return UCC_OK;
 }
 
 static ucc_status_t ucc_triggered_coll_complete(ucc_coll_task_t *parent_task, //NOLINT
                                                 ucc_coll_task_t *task)
 {
+    ucc_ev_t complete_event;
+
     ucc_trace("triggered collective complete, task %p, seq_num %u",
               task, task->seq_num);
+    if (task->ee->ee_type == UCC_EE_CPU_THREAD) {
+        /* compute threads are notified of completion through the ee out
+           queue, ee task end starts the next task of the cpu stream */
+        complete_event.ev_type         = UCC_EVENT_COLLECTIVE_COMPLETE;
+        complete_event.ev_context_size = 0;
+        complete_event.ev_context      = NULL;
+        complete_event.req             = &task->super;
+        ucc_ee_set_event_internal(task->ee, &complete_event,
+                                  &task->ee->event_out_queue);
+    }
     return ucc_mc_ee_task_end(task->ee_task, task->ee->ee_type);
 }
 
@@ -267,16 +370,60 @@ static ucc_status_t ucc_trigger_complete(ucc_coll_task_t *parent_task,
     return UCC_OK;
 }
 
+static void ucc_trigger_set_post_event(ucc_coll_task_t *task)
+{
+    ucc_ev_t post_event;
+
+    post_event.ev_type         = UCC_EVENT_COLLECTIVE_POST;
+    post_event.ev_context_size = 0;
+    post_event.ev_context      = NULL;
+    post_event.req             = &task->triggered_task->super;
+    ucc_ee_set_event_internal(task->ee, &post_event,
+                              &task->ee->event_out_queue);
+}
+
+/* Position in the cpu stream is taken on triggered post, and the compute
+   event is only consumed by the task at the head of the stream. Collectives
+   are triggered in the order of triggered post on all the ranks regardless
+   of the order compute threads set the events. */
+static ucc_status_t ucc_trigger_test_cpu(ucc_coll_task_t *task)
+{
+    ucc_status_t status;
+    ucc_ev_t    *ev;
+
+    if (task->ee_task == NULL) {
+        status = ucc_mc_ee_task_post(task->ee->ee_context,
+                                     task->ee->ee_type, &task->ee_task);
+        if (ucc_unlikely(status != UCC_OK)) {
+            ucc_error("error in ee task post, %s", ucc_status_string(status));
+            task->super.status = status;
+            return status;
+        }
+    }
+    if (UCC_OK != ucc_mc_ee_task_query(task->ee_task, task->ee->ee_type) ||
+        UCC_OK != ucc_ee_get_event_internal(task->ee, &ev,
+                                            &task->ee->event_in_queue)) {
+        return UCC_OK;
+    }
+    ucc_trace("triggered event arrived, ev_task %p", task);
+    task->ev = ev;
+    ucc_trigger_set_post_event(task);
+    task->super.status = UCC_OK;
+    return UCC_OK;
+}
+
 static ucc_status_t ucc_trigger_test(ucc_coll_task_t *task)
 {
     ucc_status_t status;
-    ucc_ev_t     post_event;
     ucc_ev_t    *ev;
 
+    if (task->ee->ee_type == UCC_EE_CPU_THREAD) {
+        return ucc_trigger_test_cpu(task);
+    }
     if (task->ev == NULL) {
         if (task->ee->ee_type == UCC_EE_CUDA_STREAM) {
             /* implicit event triggered */
-            task->ev = (ucc_ev_t *) 0xFFFF; /* dummy event */
+            task->ev = UCC_TRIGGERED_EV_IMPLICIT;
             task->ee_task = NULL;
         } else if (UCC_OK == ucc_ee_get_event_internal(task->ee, &ev,
                                                  &task->ee->event_in_queue)) {
@@ -297,11 +444,7 @@ static ucc_status_t ucc_trigger_test(ucc_coll_task_t *task)
             return status;
         }
 
-        post_event.ev_type         = UCC_EVENT_COLLECTIVE_POST;
-        post_event.ev_context_size = 0;
-        post_event.req             = &task->triggered_task->super;
-        ucc_ee_set_event_internal(task->ee, &post_event,
-                                  &task->ee->event_out_queue);
+        ucc_trigger_set_post_event(task);
     }
 
     if (task->ee_task == NULL ||
@@ -322,16 +465,16 @@ ucc_status_t ucc_triggered_post(ucc_ee_h ee, ucc_ev_t *ev,
         return UCC_ERR_NOT_IMPLEMENTED;
     }
     task->ee = ee;
-    ev_task = ucc_malloc(sizeof(*ev_task), "ev_task");
-    if (!ev_task) {
-        ucc_error("failed to allocate %zd bytes for ev_task",
-                  sizeof(*ev_task));
+    ev_task = ucc_mpool_get(&ee->ev_task_mp);
+    if (ucc_unlikely(!ev_task)) {
+        ucc_error("failed to get ev_task from mpool");
         return UCC_ERR_NO_MEMORY;
     }
 
     ucc_coll_task_init(ev_task, NULL, task->team);
     ev_task->ee             = ee;
     ev_task->ev             = NULL;
+    ev_task->ee_task        = NULL;
     ev_task->triggered_task = task;
     ev_task->flags          = UCC_COLL_TASK_FLAG_INTERNAL;
     ev_task->finalize       = ucc_triggered_task_finalize;
@@ -346,7 +489,7 @@ ucc_status_t ucc_triggered_post(ucc_ee_h ee, ucc_ev_t *ev,
 
     status = ucc_trigger_test(ev_task);
     if (ucc_unlikely(status < 0)) {
-        ucc_free(ev_task);
+        ucc_triggered_task_finalize(ev_task);
         task->super.status = status;
         ucc_task_complete(task);
         return status;
@@ -354,7 +497,7 @@ ucc_status_t ucc_triggered_post(ucc_ee_h ee, ucc_ev_t *ev,
 
     if (ev_task->super.status == UCC_OK) {
         ucc_trigger_complete(ev_task, task);
-        ucc_free(ev_task);
+        ucc_triggered_task_finalize(ev_task);
     } else {
         ucc_progress_enqueue(UCC_TASK_CORE_CTX(ev_task)->pq, ev_task);
     }
@@ -367,7 +510,14 @@ ucc_status_t ucc_collective_triggered_post(ucc_ee_h ee, ucc_ev_t *ev)
 
     ucc_debug("triggered_post: task %p, seq_num %u", task, task->seq_num);
 
-    if (UCC_COLL_TIMEOUT_REQUIRED(task)) {
+    if (UCC_IS_PERSISTENT(task->bargs.args) &&
+        ucc_unlikely(task->super.status == UCC_INPROGRESS)) {
+        ucc_error("persistent req %p, seq_num %u is posted while still "
+                  "in progress", task, task->seq_num);
+        return UCC_ERR_INVALID_PARAM;
+    }
+    if (UCC_COLL_TIMEOUT_REQUIRED(task) ||
+        (task->flags & UCC_COLL_TASK_FLAG_TUNE)) {
         task->start_time = ucc_get_time();
     }
     return task->triggered_post(ee, ev, task);
@@ -0,0 +1,247 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "config.h"
+#include "ucc_coll_fusion.h"
+#include "ucc_team.h"
+#include "ucc_context.h"
+#include "ucc_dt.h"
+#include "components/cl/ucc_cl.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_log.h"
+#include "utils/ucc_math.h"
+#include <limits.h>
+
+ucc_status_t ucc_coll_fusion_init(ucc_team_t *team,
+                                  const ucc_coll_fusion_config_t *cfg,
+                                  ucc_coll_fusion_t **fusion_p)
+{
+    ucc_coll_fusion_t *fusion;
+    ucc_status_t       status;
+
+    fusion = ucc_malloc(sizeof(*fusion), "coll_fusion");
+    if (!fusion) {
+        ucc_error("failed to allocate %zd bytes for coll fusion",
+                  sizeof(*fusion));
+        return UCC_ERR_NO_MEMORY;
+    }
+    fusion->team         = team;
+    fusion->cfg          = *cfg;
+    fusion->cfg.thresh   = ucc_min(cfg->thresh, cfg->buf_size);
+    fusion->cfg.max_reqs = ucc_max(cfg->max_reqs, 1);
+    fusion->bucket       = NULL;
+
+    status = ucc_mpool_init(&fusion->req_mp, 0, sizeof(ucc_coll_fusion_req_t),
+                            0, UCC_CACHE_LINE_SIZE, 16, UINT_MAX, NULL,
+                            UCC_THREAD_SINGLE, "coll_fusion_req_mp");
+    if (UCC_OK != status) {
+        ucc_error("failed to initialize coll fusion req mpool");
+        goto err_req_mp;
+    }
+    /* staging buffer is located right after the bucket struct */
+    status = ucc_mpool_init(&fusion->bucket_mp, 0,
+                            sizeof(ucc_coll_fusion_bucket_t) + cfg->buf_size,
+                            0, UCC_CACHE_LINE_SIZE, 4, UINT_MAX, NULL,
+                            UCC_THREAD_SINGLE, "coll_fusion_bucket_mp");
+    if (UCC_OK != status) {
+        ucc_error("failed to initialize coll fusion bucket mpool");
+        goto err_bucket_mp;
+    }
+    *fusion_p = fusion;
+    return UCC_OK;
+
+err_bucket_mp:
+    ucc_mpool_cleanup(&fusion->req_mp, 1);
+err_req_mp:
+    ucc_free(fusion);
+    return status;
+}
+
+void ucc_coll_fusion_destroy(ucc_coll_fusion_t *fusion)
+{
+    if (fusion->bucket) {
+        ucc_warn("team %p is destroyed with %u fused allreduce requests not "
+                 "completed", fusion->team, fusion->bucket->n_reqs);
+    }
+    ucc_mpool_cleanup(&fusion->bucket_mp, 1);
+    ucc_mpool_cleanup(&fusion->req_mp, 1);
+    ucc_free(fusion);
+}
+
+int ucc_coll_fusion_check(ucc_coll_fusion_t *fusion,
+                          const ucc_coll_args_t *args)
+{
+    uint64_t flags = (args->mask & UCC_COLL_ARGS_FIELD_FLAGS) ? args->flags
+                                                              : 0;
+
+    if (args->coll_type != UCC_COLL_TYPE_ALLREDUCE ||
+        (flags & ~((uint64_t)UCC_COLL_ARGS_FLAG_IN_PLACE)) ||
+        !UCC_DT_IS_PREDEFINED(args->dst.info.datatype) ||
+        args->dst.info.mem_type != UCC_MEMORY_TYPE_HOST ||
+        (!(flags & UCC_COLL_ARGS_FLAG_IN_PLACE) &&
+         args->src.info.mem_type != UCC_MEMORY_TYPE_HOST)) {
+        return 0;
+    }
+    return args->dst.info.count * ucc_dt_size(args->dst.info.datatype) <=
+           fusion->cfg.thresh;
+}
+
+static ucc_status_t ucc_coll_fusion_req_finalize(ucc_coll_task_t *task)
+{
+    ucc_coll_fusion_req_t *req = ucc_derived_of(task, ucc_coll_fusion_req_t);
+
+    if (ucc_unlikely(req->bucket)) {
+        ucc_error("fused request %p is finalized before completion", req);
+        return UCC_ERR_INVALID_PARAM;
+    }
+    ucc_mpool_put(req);
+    return UCC_OK;
+}
+
+static void ucc_coll_fusion_bucket_complete(void *data, ucc_status_t status)
+{
+    ucc_coll_fusion_bucket_t *bucket = data;
+    ucc_coll_fusion_req_t    *req, *tmp;
+    ucc_coll_args_t          *args;
+
+    ucc_list_for_each_safe(req, tmp, &bucket->reqs, super.list_elem) {
+        args = &req->super.bargs.args;
+        if (UCC_OK == status) {
+            memcpy(args->dst.info.buffer, PTR_OFFSET(bucket->buf, req->offset),
+                   args->dst.info.count * ucc_dt_size(bucket->dt));
+        }
+        ucc_list_del(&req->super.list_elem);
+        req->bucket             = NULL;
+        req->super.super.status = status;
+        ucc_task_complete(&req->super);
+    }
+    ucc_mpool_put(bucket);
+}
+
+ucc_status_t ucc_coll_fusion_flush(ucc_coll_fusion_t *fusion)
+{
+    ucc_coll_fusion_bucket_t *bucket = fusion->bucket;
+    ucc_team_t               *team   = fusion->team;
+    ucc_base_coll_args_t      bargs;
+    ucc_coll_task_t          *task;
+    ucc_status_t              status;
+
+    if (!bucket) {
+        return UCC_OK;
+    }
+    fusion->bucket = NULL;
+
+    memset(&bargs, 0, sizeof(bargs));
+    bargs.team               = team;
+    bargs.args.mask          = UCC_COLL_ARGS_FIELD_FLAGS |
+                               UCC_COLL_ARGS_FIELD_CB;
+    bargs.args.flags         = UCC_COLL_ARGS_FLAG_IN_PLACE;
+    bargs.args.coll_type     = UCC_COLL_TYPE_ALLREDUCE;
+    bargs.args.op            = bucket->op;
+    bargs.args.dst.info.buffer   = bucket->buf;
+    bargs.args.dst.info.count    = bucket->size / ucc_dt_size(bucket->dt);
+    bargs.args.dst.info.datatype = bucket->dt;
+    bargs.args.dst.info.mem_type = UCC_MEMORY_TYPE_HOST;
+    bargs.args.src.info          = bargs.args.dst.info;
+    bargs.args.cb.cb             = ucc_coll_fusion_bucket_complete;
+    bargs.args.cb.data           = bucket;
+
+    status = ucc_coll_init(team->score_map, &bargs, &task);
+    if (ucc_unlikely(UCC_OK != status)) {
+        ucc_error("failed to init fused allreduce of %u requests, %s",
+                  bucket->n_reqs, ucc_status_string(status));
+        ucc_coll_fusion_bucket_complete(bucket, status);
+        return status;
+    }
+    /* task is finalized by ucc_task_complete right after the completion
+       callback */
+    task->cb      = bargs.args.cb;
+    task->flags  |= UCC_COLL_TASK_FLAG_CB | UCC_COLL_TASK_FLAG_INTERNAL;
+    task->seq_num = team->seq_num++;
+    ucc_debug("coll_fusion: posting fused allreduce, req %p, seq_num %u, "
+              "n_reqs %u, size %zd", task, task->seq_num, bucket->n_reqs,
+              bucket->size);
+    status = task->post(task);
+    if (ucc_unlikely(status < 0)) {
+        ucc_error("failed to post fused allreduce of %u requests, %s",
+                  bucket->n_reqs, ucc_status_string(status));
+        task->finalize(task);
+        ucc_coll_fusion_bucket_complete(bucket, status);
+    }
+    return status;
+}
+
+static ucc_status_t ucc_coll_fusion_req_post(ucc_coll_task_t *task)
+{
+    ucc_coll_fusion_req_t    *req    = ucc_derived_of(task,
+                                                      ucc_coll_fusion_req_t);
+    ucc_coll_fusion_t        *fusion = req->fusion;
+    ucc_coll_args_t          *args   = &task->bargs.args;
+    ucc_coll_fusion_bucket_t *bucket = fusion->bucket;
+    ucc_datatype_t            dt     = args->dst.info.datatype;
+    size_t                    size   = args->dst.info.count * ucc_dt_size(dt);
+    ucc_status_t              status;
+
+    if (bucket && (bucket->dt != dt || bucket->op != args->op ||
+                   bucket->size + size > fusion->cfg.buf_size)) {
+        status = ucc_coll_fusion_flush(fusion);
+        if (ucc_unlikely(status < 0)) {
+            return status;
+        }
+        bucket = NULL;
+    }
+    if (!bucket) {
+        bucket = ucc_mpool_get(&fusion->bucket_mp);
+        if (ucc_unlikely(!bucket)) {
+            ucc_error("failed to get coll fusion bucket from mpool");
+            return UCC_ERR_NO_MEMORY;
+        }
+        bucket->fusion = fusion;
+        bucket->dt     = dt;
+        bucket->op     = args->op;
+        bucket->size   = 0;
+        bucket->n_reqs = 0;
+        bucket->buf    = PTR_OFFSET(bucket, sizeof(*bucket));
+        ucc_list_head_init(&bucket->reqs);
+        fusion->bucket = bucket;
+    }
+    memcpy(PTR_OFFSET(bucket->buf, bucket->size),
+           UCC_IS_INPLACE(*args) ? args->dst.info.buffer
+                                 : args->src.info.buffer,
+           size);
+    task->super.status = UCC_INPROGRESS;
+    req->bucket        = bucket;
+    req->offset        = bucket->size;
+    bucket->size      += size;
+    bucket->n_reqs++;
+    ucc_list_add_tail(&bucket->reqs, &task->list_elem);
+
+    if (bucket->n_reqs >= fusion->cfg.max_reqs ||
+        bucket->size >= fusion->cfg.buf_size) {
+        return ucc_coll_fusion_flush(fusion);
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_coll_fusion_req_init(ucc_coll_fusion_t *fusion,
+                                      ucc_base_coll_args_t *bargs,
+                                      ucc_coll_task_t **task)
+{
+    ucc_coll_fusion_req_t *req = ucc_mpool_get(&fusion->req_mp);
+
+    if (ucc_unlikely(!req)) {
+        ucc_error("failed to get coll fusion request from mpool");
+        return UCC_ERR_NO_MEMORY;
+    }
+    ucc_coll_task_init(&req->super, bargs,
+                       &fusion->team->cl_teams[0]->super);
+    req->super.flags    = UCC_COLL_TASK_FLAG_FUSED;
+    req->super.post     = ucc_coll_fusion_req_post;
+    req->super.finalize = ucc_coll_fusion_req_finalize;
+    req->fusion         = fusion;
+    req->bucket         = NULL;
+    *task               = &req->super;
+    return UCC_OK;
+}
@@ -0,0 +1,85 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_COLL_FUSION_H_
+#define UCC_COLL_FUSION_H_
+
+#include "ucc/api/ucc.h"
+#include "utils/ucc_list.h"
+#include "utils/ucc_mpool.h"
+#include "schedule/ucc_schedule.h"
+
+/* Team level fusion of small allreduce operations.
+   Allreduce requests with host buffers and size below the fusion threshold
+   are not posted individually: their source data is packed into the staging
+   buffer of the current bucket. The bucket is fired as a single in-place
+   allreduce selected through the team score map when
+     - the staging buffer or max number of requests is reached,
+     - a request with different datatype/op is posted,
+     - any other collective is initialized on the team,
+     - ucc_team_flush is called.
+   All the triggers are defined by the sequence of collective calls on the
+   team, which is the same on every rank, so the ranks fuse the same
+   requests and the fused allreduces get the same seq_num everywhere.
+   Context progress, test and wait do not fire the bucket: completion of
+   a fused request requires one of the triggers above. Results are copied
+   back to the destination buffers of the requests on completion of the
+   fused collective. */
+
+typedef struct ucc_team ucc_team_t;
+
+typedef struct ucc_coll_fusion_config {
+    size_t   thresh;   /*< max message size of fused allreduce, 0 - off */
+    size_t   buf_size; /*< staging buffer size of a bucket */
+    uint32_t max_reqs; /*< max number of requests in a bucket */
+} ucc_coll_fusion_config_t;
+
+typedef struct ucc_coll_fusion        ucc_coll_fusion_t;
+
+typedef struct ucc_coll_fusion_bucket {
+    ucc_coll_fusion_t *fusion;
+    ucc_list_link_t    reqs;
+    ucc_datatype_t     dt;
+    ucc_reduction_op_t op;
+    size_t             size; /*< packed bytes */
+    uint32_t           n_reqs;
+    void              *buf;
+} ucc_coll_fusion_bucket_t;
+
+struct ucc_coll_fusion {
+    ucc_team_t               *team;
+    ucc_coll_fusion_config_t  cfg;
+    ucc_coll_fusion_bucket_t *bucket; /*< bucket being filled, or NULL */
+    ucc_mpool_t               req_mp;
+    ucc_mpool_t               bucket_mp;
+};
+
+typedef struct ucc_coll_fusion_req {
+    ucc_coll_task_t           super;
+    ucc_coll_fusion_t        *fusion;
+    /* bucket the request is packed to, NULL if it is not posted or
+       completed */
+    ucc_coll_fusion_bucket_t *bucket;
+    size_t                    offset;
+} ucc_coll_fusion_req_t;
+
+ucc_status_t ucc_coll_fusion_init(ucc_team_t *team,
+                                  const ucc_coll_fusion_config_t *cfg,
+                                  ucc_coll_fusion_t **fusion);
+
+void ucc_coll_fusion_destroy(ucc_coll_fusion_t *fusion);
+
+/* Returns 1 if the collective can be fused */
+int ucc_coll_fusion_check(ucc_coll_fusion_t *fusion,
+                          const ucc_coll_args_t *args);
+
+ucc_status_t ucc_coll_fusion_req_init(ucc_coll_fusion_t *fusion,
+                                      ucc_base_coll_args_t *bargs,
+                                      ucc_coll_task_t **task);
+
+/* Fires the bucket being filled, if any */
+ucc_status_t ucc_coll_fusion_flush(ucc_coll_fusion_t *fusion);
+
+#endif
@@ -11,6 +11,16 @@
 #include "utils/ucc_log.h"
 #include "utils/ucc_list.h"
 #include "ucc_progress_queue.h"
+#include "utils/ucc_time.h"
+#include "utils/ucc_math.h"
+#include "utils/ucc_atomic.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <sched.h>
+#include <errno.h>
+#include <float.h>
+#include <string.h>
 
 static uint32_t ucc_context_seq_num = 0;
 static ucc_config_field_t ucc_context_config_table[] = {
@@ -21,10 +31,81 @@ static ucc_config_field_t ucc_context_config_table[] = {
      UCC_CONFIG_TYPE_UINT},
 
     {"LOCK_FREE_PROGRESS_Q", "0",
-     "Enable lock free progress queue optimization",
+     "Progress queue used by multi-threaded context. 0 - spinlocked list, "
+     "1 - lock free queue with fixed number of slots, 2 - scalable MPMC ring "
+     "that progresses all outstanding tasks per progress call",
      ucc_offsetof(ucc_context_config_t, lock_free_progress_q),
      UCC_CONFIG_TYPE_UINT},
 
+    {"PROGRESS_Q_READY_LIST", "n",
+     "Single threaded context only. Progress event driven tasks (e.g. p2p "
+     "based TL/UCP collectives) only after completion of their operations "
+     "instead of polling every outstanding task on each progress call",
+     ucc_offsetof(ucc_context_config_t, ready_list_progress_q),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"WAIT_SPIN_TIME", "50us",
+     "Time ucc_context_wait/ucc_collective_wait busy poll the context before "
+     "going to sleep on the event fds of the context components",
+     ucc_offsetof(ucc_context_config_t, wait_spin_time), UCC_CONFIG_TYPE_TIME},
+
+    {"WAIT_SLEEP_MAX", "1ms",
+     "Max duration of a single sleep in ucc_context_wait/ucc_collective_wait. "
+     "Bounds the latency of the progress that is not signaled by event fd",
+     ucc_offsetof(ucc_context_config_t, wait_sleep_max), UCC_CONFIG_TYPE_TIME},
+
+    {"PROGRESS_THREAD", "n",
+     "Start asynchronous progress thread for the context. The thread posts "
+     "and progresses collectives, application threads only post and test "
+     "them: ucc_context_progress becomes no-op. Components of the context "
+     "are created in UCC_THREAD_MULTIPLE mode regardless of the lib thread "
+     "mode",
+     ucc_offsetof(ucc_context_config_t, progress_thread),
+     UCC_CONFIG_TYPE_BOOL},
+
+    {"PROGRESS_THREAD_AFFINITY", "-1",
+     "CPU core the progress thread is bound to, -1 - not bound",
+     ucc_offsetof(ucc_context_config_t, progress_thread_affinity),
+     UCC_CONFIG_TYPE_INT},
+
+    {"FUSION_ALLREDUCE_THRESH", "0",
+     "Allreduce operations on host memory with message size up to this "
+     "threshold are fused into a single allreduce of a team level staging "
+     "buffer. Partially filled buffer is posted by the next non fused "
+     "collective or by ucc_team_flush. 0 - disable fusion",
+     ucc_offsetof(ucc_context_config_t, fusion.thresh),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"FUSION_BUFFER_SIZE", "64k",
+     "Size of the staging buffer of fused allreduce: fused operation is "
+     "posted once the buffer is full",
+     ucc_offsetof(ucc_context_config_t, fusion.buf_size),
+     UCC_CONFIG_TYPE_MEMUNITS},
+
+    {"FUSION_MAX_REQS", "64",
+     "Maximum number of requests fused into a single allreduce",
+     ucc_offsetof(ucc_context_config_t, fusion.max_reqs),
+     UCC_CONFIG_TYPE_UINT},
+
+    {"AUTOTUNE", "n",
+     "Learn the algorithm selection of the team from measured latencies. "
+     "For every message size bucket (power of 2) the collectives of the "
+     "warm-up window rotate through the algorithm candidates of the "
+     "components, then the candidate with min latency (max over the team) "
+     "is used. Only supported in UCC_THREAD_SINGLE mode",
+     ucc_offsetof(ucc_context_config_t, tune.enable), UCC_CONFIG_TYPE_BOOL},
+
+    {"AUTOTUNE_ITERS", "16",
+     "Number of collectives sampled per algorithm candidate and message "
+     "size bucket during the autotuning warm-up window",
+     ucc_offsetof(ucc_context_config_t, tune.n_iters), UCC_CONFIG_TYPE_UINT},
+
+    {"AUTOTUNE_FILE", "",
+     "File the learned selection is appended to on team destroy by rank 0, "
+     "in the form of UCC_<COMPONENT>_TUNE=<str> lines that can be used by "
+     "later jobs",
+     ucc_offsetof(ucc_context_config_t, tune.file), UCC_CONFIG_TYPE_STRING},
+
     {"ESTIMATED_NUM_PPN", "0",
      "An optimization hint of how many endpoints created on this context reside"
      " on the same node",
@@ -454,6 +535,55 @@ poll:
     return UCC_OK;
 }
 
+static void ucc_context_wait_cleanup(ucc_context_t *ctx)
+{
+    if (ctx->wait_wakeup_fd >= 0) {
+        close(ctx->wait_wakeup_fd);
+        ctx->wait_wakeup_fd = -1;
+    }
+    if (ctx->wait_epfd >= 0) {
+        close(ctx->wait_epfd);
+        ctx->wait_epfd = -1;
+    }
+}
+
+static ucc_status_t ucc_context_wait_init(ucc_context_t        *ctx,
+                                          ucc_context_config_t *config)
+{
+    struct epoll_event ev;
+
+    ctx->wait_spin_time = config->wait_spin_time;
+    ctx->wait_sleep_max = config->wait_sleep_max;
+    ctx->n_waiters      = 0;
+    ctx->wait_wakeup_fd = -1;
+    ctx->wait_epfd      = epoll_create1(EPOLL_CLOEXEC);
+    if (ctx->wait_epfd < 0) {
+        ucc_error("failed to create epoll fd: %m");
+        return UCC_ERR_NO_MESSAGE;
+    }
+    ctx->wait_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ctx->wait_wakeup_fd < 0) {
+        ucc_error("failed to create eventfd: %m");
+        goto err;
+    }
+    memset(&ev, 0, sizeof(ev));
+    ev.events  = EPOLLIN;
+    ev.data.fd = ctx->wait_wakeup_fd;
+    if (0 != epoll_ctl(ctx->wait_epfd, EPOLL_CTL_ADD, ctx->wait_wakeup_fd,
+                       &ev)) {
+        ucc_error("failed to add eventfd to epoll set: %m");
+        goto err;
+    }
+    return UCC_OK;
+err:
+    ucc_context_wait_cleanup(ctx);
+    return UCC_ERR_NO_MESSAGE;
+}
+
+static ucc_status_t ucc_context_progress_thread_start(ucc_context_t *ctx,
+                                                      ucc_context_config_t *config);
+static void ucc_context_progress_thread_stop(ucc_context_t *ctx);
+
 ucc_status_t ucc_context_create(ucc_lib_h lib,
                                 const ucc_context_params_t *params,
                                 const ucc_context_config_h  config,
@@ -481,14 +611,32 @@ ucc_status_t ucc_context_create(ucc_lib_h lib,
     ctx->rank          = UCC_RANK_MAX;
     ctx->lib           = lib;
     ctx->ids.pool_size = config->team_ids_pool_size;
+    ctx->fusion_cfg    = config->fusion;
+    ctx->tune_cfg      = config->tune;
+    ctx->tune_cfg.file = NULL;
     ucc_list_head_init(&ctx->progress_list);
+    if (config->tune.enable && strlen(config->tune.file)) {
+        ctx->tune_cfg.file = ucc_strdup(config->tune.file, "tune_file");
+        if (!ctx->tune_cfg.file) {
+            ucc_error("failed to duplicate tune file name");
+            ucc_free(ctx);
+            status = UCC_ERR_NO_MEMORY;
+            goto error;
+        }
+    }
+    status = ucc_context_wait_init(ctx, config);
+    if (UCC_OK != status) {
+        goto error_ctx;
+    }
     ucc_copy_context_params(&ctx->params, params);
     ucc_copy_context_params(&b_params.params, params);
     b_params.context           = ctx;
     b_params.estimated_num_eps = config->estimated_num_eps;
     b_params.estimated_num_ppn = config->estimated_num_ppn;
     b_params.prefix            = lib->full_prefix;
-    b_params.thread_mode       = lib->attr.thread_mode;
+    /* progress thread runs concurrently with application thread */
+    b_params.thread_mode       = config->progress_thread ? UCC_THREAD_MULTIPLE
+                                                         : lib->attr.thread_mode;
     if (params->mask & UCC_CONTEXT_PARAM_FIELD_OOB) {
         ctx->rank = params->oob.oob_ep;
     }
@@ -559,8 +707,12 @@ ucc_status_t ucc_context_create(ucc_lib_h lib,
                         (params->mask & UCC_CONTEXT_PARAM_FIELD_TYPE))
                            ? UCC_THREAD_SINGLE
                            : lib->attr.thread_mode;
+    if (config->progress_thread) {
+        ctx->thread_mode = UCC_THREAD_MULTIPLE;
+    }
     status           = ucc_progress_queue_init(&ctx->pq, ctx->thread_mode,
-                                               config->lock_free_progress_q);
+                                               config->lock_free_progress_q,
+                                               config->ready_list_progress_q);
     if (UCC_OK != status) {
         ucc_error("failed to init progress queue for context %p", ctx);
         goto error_ctx_create;
@@ -646,6 +798,12 @@ ucc_status_t ucc_context_create(ucc_lib_h lib,
             goto error_ctx_create;
         }
     }
+    if (config->progress_thread) {
+        status = ucc_context_progress_thread_start(ctx, config);
+        if (UCC_OK != status) {
+            goto error_ctx_create;
+        }
+    }
     ucc_info("created ucc context %p for lib %s", ctx, lib->full_prefix);
     *context = ctx;
     return UCC_OK;
@@ -657,6 +815,8 @@ error_ctx_create:
     }
     ucc_free(ctx->cl_ctx);
 error_ctx:
+    ucc_context_wait_cleanup(ctx);
+    ucc_free(ctx->tune_cfg.file);
     ucc_free(ctx);
 error:
     return status;
@@ -690,6 +850,10 @@ ucc_status_t ucc_context_destroy(ucc_context_t *context)
         }
         ucc_tl_context_put(context->service_ctx);
     }
+    if (context->pt) {
+        ucc_context_progress_thread_stop(context);
+    }
+    ucc_free(context->tune_cfg.file);
     if (UCC_OK != ucc_context_free_attr(&context->attr)) {
         ucc_error("failed to free context attributes");
     }
@@ -710,6 +874,7 @@ ucc_status_t ucc_context_destroy(ucc_context_t *context)
     }
     ucc_context_topo_cleanup(context->topo);
     ucc_progress_queue_finalize(context->pq);
+    ucc_context_wait_cleanup(context);
     ucc_free(context->addr_storage.storage);
     ucc_free(context->all_tls.names);
     ucc_free(context->tl_ctx);
@@ -722,6 +887,8 @@ typedef struct ucc_context_progress_entry {
     ucc_list_link_t            list_elem;
     ucc_context_progress_fn_t  fn;
     void                      *arg;
+    int                        fd;
+    ucc_context_arm_fn_t       arm;
 } ucc_context_progress_entry_t;
 
 ucc_status_t ucc_context_progress_register(ucc_context_t *ctx,
@@ -737,10 +904,38 @@ ucc_status_t ucc_context_progress_register(ucc_context_t *ctx,
     }
     entry->fn  = fn;
     entry->arg = progress_arg;
+    entry->fd  = -1;
+    entry->arm = NULL;
     ucc_list_add_tail(&ctx->progress_list, &entry->list_elem);
     return UCC_OK;
 }
 
+ucc_status_t ucc_context_progress_set_wakeup(ucc_context_t *ctx,
+                                             ucc_context_progress_fn_t fn,
+                                             void *progress_arg, int fd,
+                                             ucc_context_arm_fn_t arm)
+{
+    ucc_context_progress_entry_t *entry;
+    struct epoll_event            ev;
+
+    ucc_list_for_each(entry, &ctx->progress_list, list_elem) {
+        if (entry->fn == fn && entry->arg == progress_arg) {
+            memset(&ev, 0, sizeof(ev));
+            ev.events  = EPOLLIN;
+            ev.data.fd = fd;
+            if (0 != epoll_ctl(ctx->wait_epfd, EPOLL_CTL_ADD, fd, &ev)) {
+                ucc_error("failed to add fd %d to epoll set: %m", fd);
+                return UCC_ERR_NO_MESSAGE;
+            }
+            entry->fd  = fd;
+            entry->arm = arm;
+            return UCC_OK;
+        }
+    }
+    ucc_error("progress fn %p is not registered", fn);
+    return UCC_ERR_NOT_FOUND;
+}
+
 void ucc_context_progress_deregister(ucc_context_t *ctx,
                                      ucc_context_progress_fn_t fn,
                                      void *progress_arg)
@@ -748,6 +943,9 @@ void ucc_context_progress_deregister(ucc_context_t *ctx,
     ucc_context_progress_entry_t *entry, *tmp;
     ucc_list_for_each_safe(entry, tmp, &ctx->progress_list, list_elem) {
         if (entry->fn == fn && entry->arg == progress_arg) {
+            if (entry->fd >= 0) {
+                epoll_ctl(ctx->wait_epfd, EPOLL_CTL_DEL, entry->fd, NULL);
+            }
             ucc_list_del(&entry->list_elem);
             ucc_free(entry);
             return;
@@ -756,21 +954,262 @@ void ucc_context_progress_deregister(ucc_context_t *ctx,
     ucc_assert(0);
 }
 
-ucc_status_t ucc_context_progress(ucc_context_h context)
+/* returns number of completed tasks or error status */
+static inline int ucc_context_progress_tasks(ucc_context_t *context)
 {
-    ucc_status_t                  status;
     ucc_context_progress_entry_t *entry;
+
     /* progress registered progress fns */
     ucc_list_for_each(entry, &context->progress_list, list_elem) {
         entry->fn(entry->arg);
     }
+    return ucc_progress_queue(context->pq);
+}
+
+ucc_status_t ucc_context_progress(ucc_context_h context)
+{
+    ucc_status_t status;
+
+    if (context->pt) {
+        /* collectives are progressed by the progress thread */
+        return UCC_OK;
+    }
+
     /* the fn below returns int - number of completed tasks.
        TODO : do we need to handle it ? Maybe return to user
        as int as well? */
-    status = (ucc_status_t)ucc_progress_queue(context->pq);
+    status = (ucc_status_t)ucc_context_progress_tasks(context);
     return (status >= 0 ? UCC_OK : status);
 }
 
+void ucc_context_wakeup(ucc_context_t *ctx)
+{
+    uint64_t val = 1;
+
+    if (sizeof(val) != write(ctx->wait_wakeup_fd, &val, sizeof(val))) {
+        ucc_debug("failed to signal wakeup fd: %m");
+    }
+}
+
+/* Sleeps until one of the event fds is signaled or timeout expires. If some
+   progress fn has no event fd it only yields the cpu. */
+static ucc_status_t ucc_context_wait_events(ucc_context_t *ctx,
+                                            double timeout)
+{
+    ucc_context_progress_entry_t *entry;
+    struct epoll_event            ev;
+    ucc_status_t                  status;
+    uint64_t                      val;
+    int                           n;
+
+    ucc_list_for_each(entry, &ctx->progress_list, list_elem) {
+        if (entry->fd < 0) {
+            sched_yield();
+            return UCC_OK;
+        }
+    }
+    /* waiters counter is incremented before arming so that a task posted by
+       other thread after the last progress call wakes us up */
+    ucc_atomic_add32(&ctx->n_waiters, 1);
+    ucc_list_for_each(entry, &ctx->progress_list, list_elem) {
+        status = entry->arm(entry->arg);
+        if (UCC_OK != status) {
+            ucc_atomic_sub32(&ctx->n_waiters, 1);
+            /* UCC_INPROGRESS: pending events, go back to progress */
+            return (status == UCC_INPROGRESS) ? UCC_OK : status;
+        }
+    }
+    n = epoll_wait(ctx->wait_epfd, &ev, 1, (int)(timeout * 1e3) + 1);
+    ucc_atomic_sub32(&ctx->n_waiters, 1);
+    if (n < 0 && errno != EINTR) {
+        ucc_error("epoll_wait failed: %m");
+        return UCC_ERR_NO_MESSAGE;
+    }
+    if (n > 0 && ev.data.fd == ctx->wait_wakeup_fd) {
+        /* drain the counter, fd is non blocking */
+        if (sizeof(val) != read(ctx->wait_wakeup_fd, &val, sizeof(val))) {
+            ucc_debug("failed to read wakeup fd: %m");
+        }
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_context_wait_task(ucc_context_t *ctx, ucc_coll_task_t *task,
+                                   double timeout)
+{
+    double       start    = ucc_get_time();
+    double       deadline = (timeout < 0) ? DBL_MAX : start + timeout;
+    double       now;
+    ucc_status_t status;
+    int          n;
+
+    if (ctx->pt) {
+        /* progress thread drives the context, only wait for the task */
+        while (task && task->super.status == UCC_INPROGRESS) {
+            if (ucc_get_time() >= deadline) {
+                return UCC_INPROGRESS;
+            }
+            sched_yield();
+        }
+        return task ? task->super.status : UCC_OK;
+    }
+
+    for (;;) {
+        n = ucc_context_progress_tasks(ctx);
+        if (ucc_unlikely(n < 0)) {
+            return (ucc_status_t)n;
+        }
+        if (task) {
+            if (task->super.status != UCC_INPROGRESS) {
+                return task->super.status;
+            }
+        } else if (n > 0) {
+            return UCC_OK;
+        }
+        now = ucc_get_time();
+        if (now >= deadline) {
+            return UCC_INPROGRESS;
+        }
+        if (now - start < ctx->wait_spin_time) {
+            continue;
+        }
+        status = ucc_context_wait_events(
+            ctx, ucc_min(deadline - now, ctx->wait_sleep_max));
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+    }
+}
+
+ucc_status_t ucc_context_wait(ucc_context_h context, double timeout)
+{
+    return ucc_context_wait_task(context, NULL, timeout);
+}
+
+void ucc_context_progress_thread_post(ucc_context_t   *ctx,
+                                      ucc_coll_task_t *task)
+{
+    ucc_mpmc_queue_enqueue(&ctx->pt->post_q, &task->list_elem);
+    if (ucc_unlikely(ctx->n_waiters)) {
+        ucc_context_wakeup(ctx);
+    }
+}
+
+/* posts the tasks handed off by application threads, returns number of
+   posted tasks */
+static int ucc_context_progress_thread_post_pending(ucc_context_t *ctx)
+{
+    ucc_list_link_t *elem;
+    ucc_coll_task_t *task;
+    ucc_status_t     status;
+    int              n = 0;
+
+    while (NULL != (elem = ucc_mpmc_queue_dequeue(&ctx->pt->post_q))) {
+        task   = ucc_container_of(elem, ucc_coll_task_t, list_elem);
+        status = task->post(task);
+        if (ucc_unlikely(status < 0)) {
+            ucc_error("failed to post task %p, seq_num %u, %s", task,
+                      task->seq_num, ucc_status_string(status));
+            /* application only tests the request status */
+            task->super.status = status;
+        }
+        n++;
+    }
+    return n;
+}
+
+static void *ucc_context_progress_thread(void *arg)
+{
+    ucc_context_t *ctx  = arg;
+    double         last = ucc_get_time();
+    int            n, n_completed;
+
+    while (!ctx->pt->stop) {
+        n           = ucc_context_progress_thread_post_pending(ctx);
+        n_completed = ucc_context_progress_tasks(ctx);
+        if (ucc_unlikely(n_completed < 0)) {
+            ucc_error("progress thread failed to progress context %p, %s",
+                      ctx, ucc_status_string((ucc_status_t)n_completed));
+        } else {
+            n += n_completed;
+        }
+        if (n > 0) {
+            last = ucc_get_time();
+            continue;
+        }
+        /* no activity for wait_spin_time: sleep on event fds same as
+           ucc_context_wait, new posts and stop signal wake the thread up */
+        if (ucc_get_time() - last >= ctx->wait_spin_time) {
+            ucc_context_wait_events(ctx, ctx->wait_sleep_max);
+        }
+    }
+    return NULL;
+}
+
+static ucc_status_t
+ucc_context_progress_thread_start(ucc_context_t        *ctx,
+                                  ucc_context_config_t *config)
+{
+    ucc_context_progress_thread_t *pt;
+    cpu_set_t                      cpuset;
+    ucc_status_t                   status;
+    int                            ret;
+
+    pt = ucc_malloc(sizeof(*pt), "progress_thread");
+    if (!pt) {
+        ucc_error("failed to allocate %zd bytes for progress thread",
+                  sizeof(*pt));
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = ucc_mpmc_queue_init(&pt->post_q, UCC_MPMC_QUEUE_DEFAULT_SIZE);
+    if (UCC_OK != status) {
+        goto err_queue;
+    }
+    pt->stop     = 0;
+    pt->affinity = config->progress_thread_affinity;
+    ctx->pt      = pt;
+    ret = pthread_create(&pt->thread, NULL, ucc_context_progress_thread, ctx);
+    if (ret) {
+        ucc_error("failed to create progress thread: %s", strerror(ret));
+        status = UCC_ERR_NO_RESOURCE;
+        goto err_thread;
+    }
+    if (pt->affinity >= 0) {
+        CPU_ZERO(&cpuset);
+        CPU_SET(pt->affinity, &cpuset);
+        ret = pthread_setaffinity_np(pt->thread, sizeof(cpuset), &cpuset);
+        if (ret) {
+            ucc_warn("failed to bind progress thread to core %d: %s",
+                     pt->affinity, strerror(ret));
+        }
+    }
+    ucc_info("started progress thread for context %p, core %d", ctx,
+             pt->affinity);
+    return UCC_OK;
+
+err_thread:
+    ctx->pt = NULL;
+    ucc_mpmc_queue_destroy(&pt->post_q);
+err_queue:
+    ucc_free(pt);
+    return status;
+}
+
+static void ucc_context_progress_thread_stop(ucc_context_t *ctx)
+{
+    ucc_context_progress_thread_t *pt = ctx->pt;
+
+    pt->stop = 1;
+    ucc_context_wakeup(ctx);
+    pthread_join(pt->thread, NULL);
+    if (ucc_mpmc_queue_size(&pt->post_q)) {
+        ucc_warn("context %p is destroyed with collectives not posted", ctx);
+    }
+    ctx->pt = NULL;
+    ucc_mpmc_queue_destroy(&pt->post_q);
+    ucc_free(pt);
+}
+
 static ucc_status_t ucc_context_pack_addr(ucc_context_t             *context,
                                           ucc_context_addr_len_t    *addr_len,
                                           int                       *n_packed,
@@ -10,7 +10,11 @@
 #include "ucc_progress_queue.h"
 #include "utils/ucc_list.h"
 #include "utils/ucc_proc_info.h"
+#include "utils/ucc_mpmc_queue.h"
+#include "ucc_coll_fusion.h"
+#include "coll_score/ucc_coll_score_tune.h"
 #include "components/topo/ucc_topo.h"
+#include <pthread.h>
 
 typedef struct ucc_lib_info          ucc_lib_info_t;
 typedef struct ucc_cl_context        ucc_cl_context_t;
@@ -19,6 +23,10 @@ typedef struct ucc_cl_context_config ucc_cl_context_config_t;
 typedef struct ucc_tl_team           ucc_tl_team_t;
 
 typedef unsigned (*ucc_context_progress_fn_t)(void *progress_arg);
+/* Arms the event fd of the progress source. Returns UCC_OK if armed and
+   UCC_INPROGRESS if there are pending events, i.e. progress has to be
+   called before going to sleep */
+typedef ucc_status_t (*ucc_context_arm_fn_t)(void *progress_arg);
 typedef struct ucc_context_progress {
     ucc_context_progress_fn_t progress_fn;
     void                     *progress_arg;
@@ -44,6 +52,16 @@ typedef struct ucc_addr_storage {
     ucc_rank_t rank;
 } ucc_addr_storage_t;
 
+/* Asynchronous progress thread of the context: collectives posted by the
+   application are handed off to the thread through post_q, the thread posts
+   them and progresses pq and registered progress fns */
+typedef struct ucc_context_progress_thread {
+    pthread_t        thread;
+    volatile int     stop;
+    int              affinity;
+    ucc_mpmc_queue_t post_q;
+} ucc_context_progress_thread_t;
+
 typedef struct ucc_context {
     ucc_lib_info_t          *lib;
     ucc_context_params_t     params;
@@ -67,6 +85,17 @@ typedef struct ucc_context {
     ucc_context_topo_t      *topo;
     uint64_t                 cl_flags;
     ucc_tl_team_t           *service_team;
+    int                      wait_epfd; /*< aggregates event fds of progress
+                                          fns, used by ucc_context_wait */
+    int                      wait_wakeup_fd; /*< eventfd to wake up waiting
+                                               thread */
+    uint32_t                 n_waiters;
+    double                   wait_spin_time;
+    double                   wait_sleep_max;
+    ucc_context_progress_thread_t *pt; /*< NULL if progress thread is not
+                                         enabled */
+    ucc_coll_fusion_config_t fusion_cfg;
+    ucc_coll_tune_config_t   tune_cfg;
 } ucc_context_t;
 
 typedef struct ucc_context_config {
@@ -77,6 +106,13 @@ typedef struct ucc_context_config {
     uint32_t                  estimated_num_eps;
     uint32_t                  estimated_num_ppn;
     uint32_t                  lock_free_progress_q;
+    int                       ready_list_progress_q;
+    double                    wait_spin_time;
+    double                    wait_sleep_max;
+    int                       progress_thread;
+    int                       progress_thread_affinity;
+    ucc_coll_fusion_config_t  fusion;
+    ucc_coll_tune_config_t    tune;
     uint32_t                  internal_oob;
 } ucc_context_config_t;
 
@@ -91,6 +127,27 @@ ucc_status_t ucc_context_progress_register(ucc_context_t *ctx,
                                            ucc_context_progress_fn_t fn,
                                            void *progress_arg);
 
+/* Associates event fd with progress fn registered before. ucc_context_wait
+   can only sleep if all the registered progress fns have event fd: otherwise
+   it keeps polling */
+ucc_status_t ucc_context_progress_set_wakeup(ucc_context_t *ctx,
+                                             ucc_context_progress_fn_t fn,
+                                             void *progress_arg, int fd,
+                                             ucc_context_arm_fn_t arm);
+
+/* Progresses context until task is completed (or any task is completed if
+   task is NULL) or timeout expires, busy polling for wait_spin_time and
+   sleeping on event fds afterwards */
+ucc_status_t ucc_context_wait_task(ucc_context_t *ctx, ucc_coll_task_t *task,
+                                   double timeout);
+
+void ucc_context_wakeup(ucc_context_t *ctx);
+
+/* Hands off the task to the context progress thread which calls task->post.
+   Must only be used if ctx->pt is not NULL */
+void ucc_context_progress_thread_post(ucc_context_t *ctx,
+                                      ucc_coll_task_t *task);
+
 void         ucc_context_progress_deregister(ucc_context_t *ctx,
                                              ucc_context_progress_fn_t fn,
                                              void *progress_arg);
@@ -7,8 +7,10 @@
 #include "ucc_team.h"
 #include "ucc_ee.h"
 #include "ucc_lib.h"
+#include "ucc_mc.h"
 #include "components/cl/ucc_cl.h"
 #include "components/tl/ucc_tl.h"
+#include <limits.h>
 
 const char *ucc_ee_ev_names[] = {
     [UCC_EVENT_COLLECTIVE_POST]     = "COLL_POST",
@@ -20,7 +22,15 @@ const char *ucc_ee_ev_names[] = {
 ucc_status_t ucc_ee_create(ucc_team_h team, const ucc_ee_params_t *params,
                            ucc_ee_h *ee_p)
 {
-    ucc_ee_t *ee;
+    ucc_thread_mode_t tm = team->contexts[0]->thread_mode;
+    ucc_ee_t         *ee;
+    void             *ee_context;
+    ucc_status_t      status;
+
+    if (params->ee_type == UCC_EE_CPU_THREAD) {
+        /* events are set by compute threads concurrently with progress */
+        tm = UCC_THREAD_MULTIPLE;
+    }
 
     ee = ucc_malloc(sizeof(ucc_ee_t), "ucc execution engine");
     if (!ee) {
@@ -32,44 +42,91 @@ ucc_status_t ucc_ee_create(ucc_team_h team, const ucc_ee_params_t *params,
     ee->team = team;
     ee->ee_type = params->ee_type;
     ee->ee_context_size = params->ee_context_size;
-    ee->ee_context = params->ee_context;
-    ucc_spinlock_init(&ee->lock, 0);
-    ucc_queue_head_init(&ee->event_in_queue);
-    ucc_queue_head_init(&ee->event_out_queue);
+    /* cpu thread ee replaces user context with its ordered stream of ee
+       tasks, other ees use user context as is */
+    status = ucc_mc_ee_context_create(params->ee_context, ee->ee_type,
+                                      &ee_context);
+    if (UCC_OK != status) {
+        ucc_error("failed to create ee context");
+        goto err_ee_context;
+    }
+    ee->ee_context = ee_context;
+    status = ucc_mpool_init(&ee->event_desc_mp, 0, sizeof(ucc_event_desc_t),
+                            0, UCC_CACHE_LINE_SIZE, 32, UINT_MAX, NULL, tm,
+                            "ee_event_desc_mp");
+    if (UCC_OK != status) {
+        ucc_error("failed to init ee event descriptors mpool");
+        goto err_desc_mp;
+    }
+    status = ucc_mpool_init(&ee->ev_task_mp, 0, sizeof(ucc_coll_task_t), 0,
+                            UCC_CACHE_LINE_SIZE, 16, UINT_MAX, NULL, tm,
+                            "ee_ev_task_mp");
+    if (UCC_OK != status) {
+        ucc_error("failed to init ee ev task mpool");
+        goto err_task_mp;
+    }
+    status = ucc_mpmc_queue_init(&ee->event_in_queue, UCC_EE_QUEUE_SIZE);
+    if (UCC_OK != status) {
+        goto err_in_queue;
+    }
+    status = ucc_mpmc_queue_init(&ee->event_out_queue, UCC_EE_QUEUE_SIZE);
+    if (UCC_OK != status) {
+        goto err_out_queue;
+    }
     *ee_p = ee;
 
     ucc_info("ee is created: %p ee_context: %p",
               ee, params->ee_context);
 
     return UCC_OK;
+
+err_out_queue:
+    ucc_mpmc_queue_destroy(&ee->event_in_queue);
+err_in_queue:
+    ucc_mpool_cleanup(&ee->ev_task_mp, 1);
+err_task_mp:
+    ucc_mpool_cleanup(&ee->event_desc_mp, 1);
+err_desc_mp:
+    ucc_mc_ee_context_destroy(ee->ee_context, ee->ee_type);
+err_ee_context:
+    ucc_free(ee);
+    return status;
 }
 
 ucc_status_t ucc_ee_destroy(ucc_ee_h ee)
 {
+    ucc_list_link_t *elem;
+
     ucc_info("ee is destroyed: %p", ee);
-    ucc_spinlock_destroy(&ee->lock);
+    /* release the events that were never consumed */
+    while (NULL != (elem = ucc_mpmc_queue_dequeue(&ee->event_in_queue))) {
+        ucc_mpool_put(ucc_container_of(elem, ucc_event_desc_t, list_elem));
+    }
+    while (NULL != (elem = ucc_mpmc_queue_dequeue(&ee->event_out_queue))) {
+        ucc_mpool_put(ucc_container_of(elem, ucc_event_desc_t, list_elem));
+    }
+    ucc_mpmc_queue_destroy(&ee->event_out_queue);
+    ucc_mpmc_queue_destroy(&ee->event_in_queue);
+    ucc_mpool_cleanup(&ee->ev_task_mp, 1);
+    ucc_mpool_cleanup(&ee->event_desc_mp, 1);
+    ucc_mc_ee_context_destroy(ee->ee_context, ee->ee_type);
     ucc_free(ee);
 
     return UCC_OK;
 }
 
-ucc_status_t ucc_ee_get_event_internal(ucc_ee_h ee, ucc_ev_t **ev, ucc_queue_head_t *queue)
+ucc_status_t ucc_ee_get_event_internal(ucc_ee_h ee, ucc_ev_t **ev,
+                                       ucc_mpmc_queue_t *queue)
 {
     ucc_event_desc_t *event_desc;
-    ucc_queue_elem_t *elem;
+    ucc_list_link_t  *elem;
 
-    ucc_spin_lock(&ee->lock);
-    if (ucc_queue_is_empty(queue)) {
-        ucc_spin_unlock(&ee->lock);
+    elem = ucc_mpmc_queue_dequeue(queue);
+    if (!elem) {
         return UCC_ERR_NOT_FOUND;
     }
 
-    elem = ucc_queue_pull(queue);
-    ucc_spin_unlock(&ee->lock);
-
-    ucc_assert(elem);
-
-    event_desc = ucc_container_of(elem, ucc_event_desc_t, queue);
+    event_desc = ucc_container_of(elem, ucc_event_desc_t, list_elem);
     *ev = &event_desc->ev;
 
     ucc_info("EE Event Get. ee:%p, queue:%p ev_type:%s ",
@@ -89,15 +146,16 @@ ucc_status_t ucc_ee_ack_event(ucc_ee_h ee, //NOLINT
 
     event_desc = ucc_container_of(ev, ucc_event_desc_t, ev);
     /* TODO destroy event context */
-    ucc_free(event_desc);
+    ucc_mpool_put(event_desc);
     return UCC_OK;
 }
 
-ucc_status_t ucc_ee_set_event_internal(ucc_ee_h ee, ucc_ev_t *ev, ucc_queue_head_t *queue)
+ucc_status_t ucc_ee_set_event_internal(ucc_ee_h ee, ucc_ev_t *ev,
+                                       ucc_mpmc_queue_t *queue)
 {
     ucc_event_desc_t *event_desc;
 
-    event_desc = ucc_malloc(sizeof(ucc_event_desc_t), "event descriptor");
+    event_desc = ucc_mpool_get(&ee->event_desc_mp);
     if (ucc_unlikely(!event_desc)) {
         ucc_error("failed to allocate ucc event descriptor");
         return UCC_ERR_NO_MEMORY;
@@ -105,9 +163,7 @@ ucc_status_t ucc_ee_set_event_internal(ucc_ee_h ee, ucc_ev_t *ev, ucc_queue_head
 
     event_desc->ev = *ev;
 
-    ucc_spin_lock(&ee->lock);
-    ucc_queue_push(queue, &event_desc->queue);
-    ucc_spin_unlock(&ee->lock);
+    ucc_mpmc_queue_enqueue(queue, &event_desc->list_elem);
     ucc_info("EE Event Set. ee:%p, queue:%p ev_type:%s ",
                 ee, queue, ucc_ee_ev_names[ev->ev_type]);
 
@@ -8,27 +8,35 @@
 
 #include "ucc/api/ucc.h"
 #include "utils/ucc_datastruct.h"
-#include "utils/ucc_queue.h"
-#include "utils/ucc_spinlock.h"
+#include "utils/ucc_mpool.h"
+#include "utils/ucc_mpmc_queue.h"
+
+#define UCC_EE_QUEUE_SIZE 256
 
 extern const char *ucc_ee_ev_names[];
 
+/* Event descriptors and triggered ev tasks are allocated from per EE
+   mpools, event queues are lock-free rings (spinlocked list is only used
+   if ring overflows) */
 typedef struct ucc_ee {
     ucc_team_h       team;
     ucc_ee_type_t    ee_type;
-    ucc_spinlock_t   lock;
-    ucc_queue_head_t event_in_queue;
-    ucc_queue_head_t event_out_queue;
+    ucc_mpmc_queue_t event_in_queue;
+    ucc_mpmc_queue_t event_out_queue;
+    ucc_mpool_t      event_desc_mp;
+    ucc_mpool_t      ev_task_mp;
     size_t           ee_context_size;
     char             *ee_context;
 } ucc_ee_t;
 
 typedef struct ucc_event_desc {
-    ucc_queue_elem_t queue;
-    ucc_ev_t ev;
+    ucc_list_link_t list_elem;
+    ucc_ev_t        ev;
 } ucc_event_desc_t;
 
-ucc_status_t ucc_ee_get_event_internal(ucc_ee_h ee, ucc_ev_t **ev, ucc_queue_head_t *queue);
+ucc_status_t ucc_ee_get_event_internal(ucc_ee_h ee, ucc_ev_t **ev,
+                                       ucc_mpmc_queue_t *queue);
 
-ucc_status_t ucc_ee_set_event_internal(ucc_ee_h ee, ucc_ev_t *ev, ucc_queue_head_t *queue);
+ucc_status_t ucc_ee_set_event_internal(ucc_ee_h ee, ucc_ev_t *ev,
+                                       ucc_mpmc_queue_t *queue);
 #endif
@@ -17,6 +17,7 @@ ucc_global_config_t ucc_global_config = {
     .profile_mode     = 0,
     .profile_file     = "",
     .profile_log_size = 0,
+    .tune_file        = "",
 };
 
 ucc_config_field_t ucc_global_config_table[] =
@@ -49,6 +50,15 @@ ucc_config_field_t ucc_global_config_table[] =
     ucc_offsetof(ucc_global_config_t, profile_log_size),
     UCC_CONFIG_TYPE_MEMUNITS},
 
+    {"TUNE_FILE", "",
+    "File with the score settings of the components, one setting per line in\n"
+    "the format UCC_<COMPONENT>_TUNE=<str> (see UCC_<COMPONENT>_TUNE for the\n"
+    "format of <str>). Lines starting with \"#\" are ignored. The settings of\n"
+    "the file are applied before the UCC_<COMPONENT>_TUNE variables, so the\n"
+    "latter take precedence. The output of ucc_tune and UCC_AUTOTUNE_FILE can\n"
+    "be used as the tuning file.",
+    ucc_offsetof(ucc_global_config_t, tune_file), UCC_CONFIG_TYPE_STRING},
+
     {NULL}
 };
 
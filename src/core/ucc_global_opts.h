@@ -31,6 +31,9 @@ typedef struct ucc_global_config {
 
     /* Limit for profiling log size */
     size_t                     profile_log_size;
+
+    /* Tuning file with UCC_<COMPONENT>_TUNE settings */
+    char                       *tune_file;
 } ucc_global_config_t;
 
 extern ucc_global_config_t ucc_global_config;
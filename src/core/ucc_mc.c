@@ -243,6 +243,29 @@ ucc_status_t ucc_mc_finalize()
     return UCC_OK;
 }
 
+ucc_status_t ucc_mc_ee_context_create(void *user_context,
+                                     ucc_ee_type_t ee_type,
+                                     void **ee_context)
+{
+    if (NULL == ee_ops[ee_type] ||
+        NULL == ee_ops[ee_type]->ee_context_create) {
+        /* user ee_context is used as is */
+        *ee_context = user_context;
+        return UCC_OK;
+    }
+    return ee_ops[ee_type]->ee_context_create(user_context, ee_context);
+}
+
+ucc_status_t ucc_mc_ee_context_destroy(void *ee_context,
+                                       ucc_ee_type_t ee_type)
+{
+    if (NULL == ee_ops[ee_type] ||
+        NULL == ee_ops[ee_type]->ee_context_destroy) {
+        return UCC_OK;
+    }
+    return ee_ops[ee_type]->ee_context_destroy(ee_context);
+}
+
 ucc_status_t ucc_mc_ee_task_post(void *ee_context, ucc_ee_type_t ee_type,
                                  void **ee_task)
 {
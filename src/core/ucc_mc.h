@@ -31,6 +31,13 @@ ucc_status_t ucc_mc_flush(ucc_memory_type_t mem_type);
 
 ucc_status_t ucc_mc_finalize();
 
+ucc_status_t ucc_mc_ee_context_create(void *user_context,
+                                     ucc_ee_type_t ee_type,
+                                     void **ee_context);
+
+ucc_status_t ucc_mc_ee_context_destroy(void *ee_context,
+                                      ucc_ee_type_t ee_type);
+
 ucc_status_t ucc_mc_ee_task_post(void *ee_context, ucc_ee_type_t ee_type,
                                  void **ee_task);
 
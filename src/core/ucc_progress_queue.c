@@ -6,15 +6,16 @@
 #include "config.h"
 #include "ucc_progress_queue.h"
 
-ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq);
+ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq, int ready_list);
 ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq, uint32_t lock_free_progress_q);
 
 ucc_status_t ucc_progress_queue_init(ucc_progress_queue_t **pq,
                                      ucc_thread_mode_t      tm,
-                                     uint32_t lock_free_progress_q)
+                                     uint32_t lock_free_progress_q,
+                                     int ready_list)
 {
     if (tm == UCC_THREAD_SINGLE) {
-        return ucc_pq_st_init(pq);
+        return ucc_pq_st_init(pq, ready_list);
     } else { // TODO also for UCC_THREAD_FUNNELED?
         return ucc_pq_mt_init(pq, lock_free_progress_q);
     }
@@ -8,17 +8,29 @@
 
 #include "ucc/api/ucc.h"
 #include "schedule/ucc_schedule.h"
+
+/* Progress queue implementations for multi-threaded context, selected by
+   UCC_LOCK_FREE_PROGRESS_Q */
+enum {
+    UCC_PQ_MT_LOCKED    = 0, /* spinlocked list */
+    UCC_PQ_MT_LOCK_FREE = 1, /* ucc_lf_queue: fixed lock free slots + list */
+    UCC_PQ_MT_MPMC      = 2  /* ucc_mpmc_queue: MPMC ring + overflow list */
+};
+
 typedef struct ucc_progress_queue ucc_progress_queue_t;
 struct ucc_progress_queue {
     void (*enqueue)(ucc_progress_queue_t *pq, ucc_coll_task_t *task);
     void (*dequeue)(ucc_progress_queue_t *pq, ucc_coll_task_t **task);
     int  (*progress)(ucc_progress_queue_t *pq);
     void (*finalize)(ucc_progress_queue_t *pq);
+    /* optional, set only if pq supports ready list mode */
+    void (*task_ready)(ucc_progress_queue_t *pq, ucc_coll_task_t *task);
 };
 
 ucc_status_t ucc_progress_queue_init(ucc_progress_queue_t **pq,
                                      ucc_thread_mode_t tm,
-                                     uint32_t lock_free_progress_q);
+                                     uint32_t lock_free_progress_q,
+                                     int ready_list);
 
 static inline void ucc_progress_enqueue(ucc_progress_queue_t *pq,
                                         ucc_coll_task_t *task)
@@ -31,6 +43,21 @@ static inline int ucc_progress_queue(ucc_progress_queue_t *pq)
     return pq->progress(pq);
 }
 
+/* Returns 1 if tasks flagged with UCC_COLL_TASK_FLAG_EVENT_DRIVEN are only
+   progressed after ucc_progress_task_ready is called for them */
+static inline int ucc_progress_queue_has_ready_list(ucc_progress_queue_t *pq)
+{
+    return pq->task_ready != NULL;
+}
+
+/* Called by component when an event (e.g. p2p completion) that may let the
+   event driven task make progress has happened */
+static inline void ucc_progress_task_ready(ucc_progress_queue_t *pq,
+                                           ucc_coll_task_t *task)
+{
+    pq->task_ready(pq, task);
+}
+
 void ucc_progress_queue_finalize(ucc_progress_queue_t *pq);
 
 #endif
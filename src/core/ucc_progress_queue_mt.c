@@ -11,6 +11,7 @@
 #include "utils/ucc_spinlock.h"
 #include "utils/ucc_list.h"
 #include "utils/ucc_lock_free_queue.h"
+#include "utils/ucc_mpmc_queue.h"
 #include "utils/ucc_coll_utils.h"
 
 typedef struct ucc_pq_mt {
@@ -18,6 +19,11 @@ typedef struct ucc_pq_mt {
     ucc_lf_queue_t       lf_queue;
 } ucc_pq_mt_t;
 
+typedef struct ucc_pq_mt_mpmc {
+    ucc_progress_queue_t super;
+    ucc_mpmc_queue_t     queue;
+} ucc_pq_mt_mpmc_t;
+
 typedef struct ucc_pq_mt_locked {
     ucc_progress_queue_t super;
     ucc_spinlock_t       queue_lock;
@@ -41,6 +47,14 @@ static void ucc_pq_mt_enqueue(ucc_progress_queue_t *pq, ucc_coll_task_t *task)
     ucc_lf_queue_enqueue(&pq_mt->lf_queue, &task->lf_elem);
 }
 
+static void ucc_pq_mpmc_mt_enqueue(ucc_progress_queue_t *pq,
+                                   ucc_coll_task_t *     task)
+{
+    ucc_pq_mt_mpmc_t *pq_mt = ucc_derived_of(pq, ucc_pq_mt_mpmc_t);
+
+    ucc_mpmc_queue_enqueue(&pq_mt->queue, &task->list_elem);
+}
+
 static void ucc_pq_locked_mt_dequeue(ucc_progress_queue_t *pq,
                                      ucc_coll_task_t **    popped_task)
 {
@@ -64,38 +78,84 @@ static void ucc_pq_mt_dequeue(ucc_progress_queue_t *pq,
         elem ? ucc_container_of(elem, ucc_coll_task_t, lf_elem) : NULL;
 }
 
+static void ucc_pq_mpmc_mt_dequeue(ucc_progress_queue_t *pq,
+                                   ucc_coll_task_t **    popped_task)
+{
+    ucc_pq_mt_mpmc_t *pq_mt = ucc_derived_of(pq, ucc_pq_mt_mpmc_t);
+    ucc_list_link_t  *elem  = ucc_mpmc_queue_dequeue(&pq_mt->queue);
+
+    *popped_task = elem ? ucc_container_of(elem, ucc_coll_task_t, list_elem)
+                        : NULL;
+}
+
+/* Progresses single task, returns 1 if task is completed, 0 if it was
+   re-enqueued, or error status */
+static inline int ucc_pq_mt_progress_task(ucc_progress_queue_t *pq,
+                                          ucc_coll_task_t *task,
+                                          double *timestamp)
+{
+    ucc_status_t status;
+
+    if (task->progress) {
+        task->progress(task);
+    }
+    if (UCC_INPROGRESS == task->super.status) {
+        if (UCC_COLL_TIMEOUT_REQUIRED(task)) {
+            if (*timestamp < 0) {
+                *timestamp = ucc_get_time();
+            }
+            if (ucc_unlikely(*timestamp - task->start_time >
+                             task->bargs.args.timeout)) {
+                task->super.status = UCC_ERR_TIMED_OUT;
+                ucc_task_complete(task);
+                return UCC_ERR_TIMED_OUT;
+            }
+        }
+
+        pq->enqueue(pq, task);
+        return 0;
+    }
+    if (ucc_unlikely(0 > (status = ucc_task_complete(task)))) {
+        return status;
+    }
+    return 1;
+}
+
 static int ucc_pq_mt_progress(ucc_progress_queue_t *pq)
 {
-    int              n_progressed =  0;
-    double           timestamp    = -1;
+    double           timestamp = -1;
     ucc_coll_task_t *task;
-    ucc_status_t     status;
 
     pq->dequeue(pq, &task);
     if (task) {
-        if (task->progress) {
-            task->progress(task);
-        }
-        if (UCC_INPROGRESS == task->super.status) {
-            if (UCC_COLL_TIMEOUT_REQUIRED(task)) {
-                if (timestamp < 0) {
-                    timestamp = ucc_get_time();
-                }
-                if (ucc_unlikely(timestamp - task->start_time >
-                                 task->bargs.args.timeout)) {
-                    task->super.status = UCC_ERR_TIMED_OUT;
-                    ucc_task_complete(task);
-                    return UCC_ERR_TIMED_OUT;
-                }
-            }
+        return ucc_pq_mt_progress_task(pq, task, &timestamp);
+    }
+    return 0;
+}
 
-            pq->enqueue(pq, task);
-            return n_progressed;
+/* Goes over all the tasks that were queued at the moment of the call, so that
+   a single ucc_context_progress call makes progress on every outstanding
+   collective rather than on one of them */
+static int ucc_pq_mpmc_mt_progress(ucc_progress_queue_t *pq)
+{
+    ucc_pq_mt_mpmc_t *pq_mt        = ucc_derived_of(pq, ucc_pq_mt_mpmc_t);
+    uint64_t          n_tasks      = ucc_mpmc_queue_size(&pq_mt->queue);
+    int               n_progressed = 0;
+    double            timestamp    = -1;
+    ucc_coll_task_t  *task;
+    uint64_t          i;
+    int               rc;
+
+    for (i = 0; i < n_tasks; i++) {
+        ucc_pq_mpmc_mt_dequeue(pq, &task);
+        if (!task) {
+            break;
         }
-        n_progressed++;
-        if (ucc_unlikely(0 > (status = ucc_task_complete(task)))) {
-            return status;
+        rc = ucc_pq_mt_progress_task(pq, task, &timestamp);
+        if (ucc_unlikely(rc < 0)) {
+            return rc;
         }
+        n_progressed += rc;
     }
     return n_progressed;
 }
@@ -114,10 +174,37 @@ static void ucc_pq_mt_finalize(ucc_progress_queue_t *pq)
     ucc_free(pq_mt);
 }
 
+static void ucc_pq_mpmc_mt_finalize(ucc_progress_queue_t *pq)
+{
+    ucc_pq_mt_mpmc_t *pq_mt = ucc_derived_of(pq, ucc_pq_mt_mpmc_t);
+    ucc_mpmc_queue_destroy(&pq_mt->queue);
+    ucc_free(pq_mt);
+}
+
 ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq,
                             uint32_t lock_free_progress_q)
 {
-    if (lock_free_progress_q) {
+    ucc_status_t status;
+
+    if (lock_free_progress_q == UCC_PQ_MT_MPMC) {
+        ucc_pq_mt_mpmc_t *pq_mt = ucc_malloc(sizeof(*pq_mt), "pq_mt");
+        if (!pq_mt) {
+            ucc_error("failed to allocate %zd bytes for pq_mt", sizeof(*pq_mt));
+            return UCC_ERR_NO_MEMORY;
+        }
+        status = ucc_mpmc_queue_init(&pq_mt->queue,
+                                     UCC_MPMC_QUEUE_DEFAULT_SIZE);
+        if (UCC_OK != status) {
+            ucc_free(pq_mt);
+            return status;
+        }
+        pq_mt->super.enqueue  = ucc_pq_mpmc_mt_enqueue;
+        pq_mt->super.dequeue  = ucc_pq_mpmc_mt_dequeue;
+        pq_mt->super.progress = ucc_pq_mpmc_mt_progress;
+        pq_mt->super.finalize = ucc_pq_mpmc_mt_finalize;
+        pq_mt->super.task_ready = NULL;
+        *pq                   = &pq_mt->super;
+    } else if (lock_free_progress_q == UCC_PQ_MT_LOCK_FREE) {
         ucc_pq_mt_t *pq_mt = ucc_malloc(sizeof(*pq_mt), "pq_mt");
         if (!pq_mt) {
             ucc_error("failed to allocate %zd bytes for pq_mt", sizeof(*pq_mt));
@@ -128,6 +215,7 @@ ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq,
         pq_mt->super.dequeue    = ucc_pq_mt_dequeue;
         pq_mt->super.progress   = ucc_pq_mt_progress;
         pq_mt->super.finalize   = ucc_pq_mt_finalize;
+        pq_mt->super.task_ready = NULL;
         *pq                     = &pq_mt->super;
     } else {
         ucc_pq_mt_locked_t *pq_mt = ucc_malloc(sizeof(*pq_mt), "pq_mt");
@@ -141,6 +229,7 @@ ucc_status_t ucc_pq_mt_init(ucc_progress_queue_t **pq,
         pq_mt->super.dequeue  = ucc_pq_locked_mt_dequeue;
         pq_mt->super.progress = ucc_pq_mt_progress;
         pq_mt->super.finalize = ucc_pq_locked_mt_finalize;
+        pq_mt->super.task_ready = NULL;
         *pq                   = &pq_mt->super;
     }
     return UCC_OK;
@@ -13,8 +13,31 @@
 typedef struct ucc_pq_st {
     ucc_progress_queue_t super;
     ucc_list_link_t      list;
+    /* ready list mode: event driven tasks waiting for completion event */
+    ucc_list_link_t      idle;
 } ucc_pq_st_t;
 
+/* Completes the in progress task with UCC_ERR_TIMED_OUT if its timeout
+   expired, timestamp is taken once per progress call */
+static inline int ucc_pq_st_task_timed_out(ucc_coll_task_t *task,
+                                           double          *timestamp)
+{
+    if (!UCC_COLL_TIMEOUT_REQUIRED(task)) {
+        return 0;
+    }
+    if (*timestamp < 0) {
+        *timestamp = ucc_get_time();
+    }
+    if (ucc_unlikely(*timestamp - task->start_time >
+                     task->bargs.args.timeout)) {
+        task->super.status = UCC_ERR_TIMED_OUT;
+        ucc_list_del(&task->list_elem);
+        ucc_task_complete(task);
+        return 1;
+    }
+    return 0;
+}
+
 static int ucc_pq_st_progress(ucc_progress_queue_t *pq)
 {
     ucc_pq_st_t     *pq_st        = ucc_derived_of(pq, ucc_pq_st_t);
@@ -24,22 +47,58 @@ static int ucc_pq_st_progress(ucc_progress_queue_t *pq)
     ucc_status_t     status;
 
     ucc_list_for_each_safe(task, tmp, &pq_st->list, list_elem) {
+        if (task->progress) {
+            ucc_assert(task->super.status != UCC_OK);
+            task->progress(task);
+        }
+        if (UCC_INPROGRESS == task->super.status) {
+            if (ucc_pq_st_task_timed_out(task, &timestamp)) {
+                return UCC_ERR_TIMED_OUT;
+            }
+            continue;
+        }
+        ucc_list_del(&task->list_elem);
+        n_progressed++;
+        if (0 > (status = ucc_task_complete(task))) {
+            return status;
+        }
+    }
+    return n_progressed;
+}
+
+/* Ready list mode: "list" holds the tasks that have to be progressed, i.e.
+   event driven tasks that got a completion event and all other tasks.
+   Event driven tasks without pending events are parked in "idle" and moved
+   back by ucc_pq_st_task_ready, so the cost of progress call depends on the
+   number of ready tasks rather than on the number of outstanding ones. */
+static int ucc_pq_st_ready_progress(ucc_progress_queue_t *pq)
+{
+    ucc_pq_st_t     *pq_st        = ucc_derived_of(pq, ucc_pq_st_t);
+    int              n_progressed = 0;
+    double           timestamp    = -1;
+    ucc_coll_task_t *task, *tmp;
+    ucc_status_t     status;
+
+    ucc_list_for_each_safe(task, tmp, &pq_st->list, list_elem) {
+        task->flags &= ~UCC_COLL_TASK_FLAG_READY;
         if (task->progress) {
             ucc_assert(task->super.status != UCC_OK);
             task->progress(task);
         }
         if (UCC_INPROGRESS == task->super.status) {
             if (UCC_COLL_TIMEOUT_REQUIRED(task)) {
-                if (timestamp < 0) {
-                    timestamp = ucc_get_time();
-                }
-                if (ucc_unlikely(timestamp - task->start_time >
-                                 task->bargs.args.timeout)) {
-                    task->super.status = UCC_ERR_TIMED_OUT;
-                    ucc_list_del(&task->list_elem);
-                    ucc_task_complete(task);
+                if (ucc_pq_st_task_timed_out(task, &timestamp)) {
                     return UCC_ERR_TIMED_OUT;
                 }
+                /* tasks with timeout stay in the list, see
+                   ucc_pq_st_ready_enqueue */
+                continue;
+            }
+            if ((task->flags & UCC_COLL_TASK_FLAG_EVENT_DRIVEN) &&
+                !(task->flags & UCC_COLL_TASK_FLAG_READY)) {
+                ucc_list_del(&task->list_elem);
+                ucc_list_add_tail(&pq_st->idle, &task->list_elem);
+                task->flags |= UCC_COLL_TASK_FLAG_IDLE;
             }
             continue;
         }
@@ -52,7 +111,6 @@ static int ucc_pq_st_progress(ucc_progress_queue_t *pq)
     return n_progressed;
 }
 
-
 static void ucc_pq_st_enqueue(ucc_progress_queue_t *pq, ucc_coll_task_t *task)
 {
     ucc_pq_st_t *pq_st = ucc_derived_of(pq, ucc_pq_st_t);
@@ -60,13 +118,45 @@ static void ucc_pq_st_enqueue(ucc_progress_queue_t *pq, ucc_coll_task_t *task)
     ucc_list_add_tail(&pq_st->list, &task->list_elem);
 }
 
+static void ucc_pq_st_ready_enqueue(ucc_progress_queue_t *pq,
+                                    ucc_coll_task_t *     task)
+{
+    ucc_pq_st_t *pq_st = ucc_derived_of(pq, ucc_pq_st_t);
+
+    /* tasks with timeout are always progressed so that timeout is detected
+       even if no events arrive */
+    if ((task->flags & UCC_COLL_TASK_FLAG_EVENT_DRIVEN) &&
+        !(task->flags & UCC_COLL_TASK_FLAG_READY) &&
+        !UCC_COLL_TIMEOUT_REQUIRED(task)) {
+        ucc_list_add_tail(&pq_st->idle, &task->list_elem);
+        task->flags |= UCC_COLL_TASK_FLAG_IDLE;
+        return;
+    }
+    ucc_list_add_tail(&pq_st->list, &task->list_elem);
+}
+
+static void ucc_pq_st_task_ready(ucc_progress_queue_t *pq,
+                                 ucc_coll_task_t *     task)
+{
+    ucc_pq_st_t *pq_st = ucc_derived_of(pq, ucc_pq_st_t);
+
+    if (task->flags & UCC_COLL_TASK_FLAG_IDLE) {
+        task->flags &= ~UCC_COLL_TASK_FLAG_IDLE;
+        ucc_list_del(&task->list_elem);
+        ucc_list_add_tail(&pq_st->list, &task->list_elem);
+    }
+    /* if task is not queued yet (event arrived during post) or is already in
+       the list, the flag makes sure it is progressed at least once more */
+    task->flags |= UCC_COLL_TASK_FLAG_READY;
+}
+
 static void ucc_pq_st_finalize(ucc_progress_queue_t *pq)
 {
     ucc_pq_st_t *pq_st = ucc_derived_of(pq, ucc_pq_st_t);
     ucc_free(pq_st);
 }
 
-ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq)
+ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq, int ready_list)
 {
     ucc_pq_st_t *pq_st = ucc_malloc(sizeof(*pq_st), "pq_st");
     if (!pq_st) {
@@ -74,9 +164,17 @@ ucc_status_t ucc_pq_st_init(ucc_progress_queue_t **pq)
         return UCC_ERR_NO_MEMORY;
     }
     ucc_list_head_init(&pq_st->list);
-    pq_st->super.enqueue  = ucc_pq_st_enqueue;
+    ucc_list_head_init(&pq_st->idle);
+    if (ready_list) {
+        pq_st->super.enqueue    = ucc_pq_st_ready_enqueue;
+        pq_st->super.progress   = ucc_pq_st_ready_progress;
+        pq_st->super.task_ready = ucc_pq_st_task_ready;
+    } else {
+        pq_st->super.enqueue    = ucc_pq_st_enqueue;
+        pq_st->super.progress   = ucc_pq_st_progress;
+        pq_st->super.task_ready = NULL;
+    }
     pq_st->super.dequeue  = NULL;
-    pq_st->super.progress = ucc_pq_st_progress;
     pq_st->super.finalize = ucc_pq_st_finalize;
     *pq                   = &pq_st->super;
     return UCC_OK;
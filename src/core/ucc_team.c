@@ -385,6 +385,75 @@ static ucc_status_t ucc_team_build_score_map(ucc_team_t *team)
     return status;
 }
 
+/* Blocking agreement on the latencies of the autotuning candidates. It is
+   called at the same collective init on all the ranks of the team. */
+static ucc_status_t ucc_team_tune_agree(void *arg, double *lat, int n)
+{
+    ucc_team_t             *team   = arg;
+    ucc_subset_t            subset = {.map.type   = UCC_EP_MAP_FULL,
+                                      .map.ep_num = team->size,
+                                      .myrank     = team->rank};
+    ucc_service_coll_req_t *req;
+    double                 *global;
+    ucc_status_t            status;
+
+    global = ucc_malloc(n * sizeof(double), "tune_lat");
+    if (!global) {
+        ucc_error("failed to allocate %zd bytes for tune_lat",
+                  n * sizeof(double));
+        return UCC_ERR_NO_MEMORY;
+    }
+    status = ucc_service_allreduce(team, lat, global, UCC_DT_FLOAT64, n,
+                                   UCC_OP_MAX, subset, &req);
+    if (UCC_OK != status) {
+        goto out;
+    }
+    do {
+        ucc_context_progress(team->contexts[0]);
+        status = ucc_service_coll_test(req);
+    } while (UCC_INPROGRESS == status);
+    ucc_service_coll_finalize(req);
+    if (UCC_OK != status) {
+        ucc_error("autotuning agreement failure: %s",
+                  ucc_status_string(status));
+        goto out;
+    }
+    memcpy(lat, global, n * sizeof(double));
+out:
+    ucc_free(global);
+    return status;
+}
+
+static void ucc_team_tune_export(ucc_team_t *team)
+{
+    const char *file = team->contexts[0]->tune_cfg.file;
+    char       *str;
+    int         len;
+    FILE       *f;
+
+    len = ucc_coll_tuner_str(team->tuner, NULL, 0);
+    if (len <= 0) {
+        return;
+    }
+    str = ucc_malloc(len + 1, "tune_str");
+    if (!str) {
+        ucc_error("failed to allocate %d bytes for tune_str", len + 1);
+        return;
+    }
+    ucc_coll_tuner_str(team->tuner, str, len + 1);
+    ucc_info("team %p autotuned selection:\n%s", team, str);
+    if (file && team->rank == 0) {
+        f = fopen(file, "a");
+        if (!f) {
+            ucc_warn("failed to open autotuning file %s", file);
+        } else {
+            fputs(str, f);
+            fclose(f);
+        }
+    }
+    ucc_free(str);
+}
+
 ucc_status_t ucc_team_create_test_single(ucc_context_t *context,
                                          ucc_team_t    *team)
 {
@@ -400,10 +469,10 @@ ucc_status_t ucc_team_create_test_single(ucc_context_t *context,
     case UCC_TEAM_SERVICE_TEAM:
         if ((context->cl_flags & UCC_BASE_LIB_FLAG_SERVICE_TEAM_REQUIRED) ||
             ((context->cl_flags & UCC_BASE_LIB_FLAG_TEAM_ID_REQUIRED) &&
-             (team->id == 0))) {
+             (team->id == 0)) || context->tune_cfg.enable) {
             /* We need service team either when it is explicitely required
                by any CL/TL (e.g. CL/HIER) or if TEAM_ID is required but
-               not provided by the user */
+               not provided by the user or for the autotuning agreement */
             status = ucc_team_create_service_team(context, team);
             if (UCC_OK != status) {
                 goto out;
@@ -432,6 +501,32 @@ out:
     if (UCC_OK == status) {
         status = ucc_team_build_score_map(team);
     }
+    if (UCC_OK == status && context->fusion_cfg.thresh > 0) {
+        /* fusion state is not protected, progress thread mode also
+           implies UCC_THREAD_MULTIPLE */
+        if (context->thread_mode == UCC_THREAD_SINGLE) {
+            status = ucc_coll_fusion_init(team, &context->fusion_cfg,
+                                          &team->fusion);
+        } else {
+            ucc_debug("allreduce fusion is not supported in thread mode "
+                      "multiple");
+        }
+    }
+    if (UCC_OK == status && context->tune_cfg.enable) {
+        if (context->thread_mode == UCC_THREAD_SINGLE) {
+            status = ucc_coll_tuner_create(team->score_map,
+                                           context->tune_cfg.n_iters,
+                                           ucc_team_tune_agree, team,
+                                           &team->tuner);
+            if (UCC_ERR_NOT_FOUND == status) {
+                ucc_debug("team %p: no algorithm candidates to autotune",
+                          team);
+                status = UCC_OK;
+            }
+        } else {
+            ucc_debug("autotuning is not supported in thread mode multiple");
+        }
+    }
     /* TODO: add team/coll selection and check if some teams are never
              used after selection and clean them up */
     return status;
@@ -481,6 +576,13 @@ static ucc_status_t ucc_team_destroy_single(ucc_team_h team)
         ucc_internal_oob_finalize(&team->bp.params.oob);
     }
 
+    if (team->fusion) {
+        ucc_coll_fusion_destroy(team->fusion);
+    }
+    if (team->tuner) {
+        ucc_team_tune_export(team);
+        ucc_coll_tuner_destroy(team->tuner);
+    }
     ucc_coll_score_free_map(team->score_map);
     ucc_free(team->addr_storage.storage);
     ucc_free(team->ctx_ranks);
@@ -508,6 +610,27 @@ ucc_status_t ucc_team_destroy(ucc_team_h team)
     return ucc_team_destroy_single(team);
 }
 
+ucc_status_t ucc_team_flush(ucc_team_h team)
+{
+    ucc_status_t status;
+
+    if (NULL == team) {
+        ucc_error("ucc_team_flush: invalid team handle: NULL");
+        return UCC_ERR_INVALID_PARAM;
+    }
+
+    if (team->status != UCC_OK) {
+        ucc_error("team %p is used before team_create is completed", team);
+        return UCC_ERR_INVALID_PARAM;
+    }
+
+    if (!team->fusion) {
+        return UCC_OK;
+    }
+    status = ucc_coll_fusion_flush(team->fusion);
+    return (status < 0) ? status : UCC_OK;
+}
+
 static inline int
 find_first_set_and_zero(uint64_t *value) {
     int i;
@@ -13,6 +13,8 @@
 #include "utils/ucc_math.h"
 #include "components/base/ucc_base_iface.h"
 #include "coll_score/ucc_coll_score.h"
+#include "coll_score/ucc_coll_score_tune.h"
+#include "ucc_coll_fusion.h"
 
 typedef struct ucc_context          ucc_context_t;
 typedef struct ucc_cl_team          ucc_cl_team_t;
@@ -47,6 +49,8 @@ typedef struct ucc_team {
                                   type is global (oob provided) */
     ucc_topo_t             *topo;
     ucc_score_map_t        *score_map; /*< score map of CLs */
+    ucc_coll_fusion_t      *fusion; /*< NULL if allreduce fusion is off */
+    ucc_coll_tuner_t       *tuner; /*< NULL if autotuning is off */
     uint32_t                seq_num;
 } ucc_team_t;
 
@@ -0,0 +1,243 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+#include "ucc_dag.h"
+#include "utils/ucc_compiler_def.h"
+#include "utils/ucc_malloc.h"
+
+static ucc_status_t ucc_dag_grow(void **array, void *inline_array,
+                                 uint32_t size, size_t elem_size,
+                                 const char *name)
+{
+    void *p;
+
+    if (*array == inline_array) {
+        p = ucc_malloc(2 * size * elem_size, name);
+        if (p) {
+            memcpy(p, inline_array, size * elem_size);
+        }
+    } else {
+        p = ucc_realloc(*array, 2 * size * elem_size, name);
+    }
+    if (!p) {
+        ucc_error("failed to allocate %zd bytes for %s", 2 * size * elem_size,
+                  name);
+        return UCC_ERR_NO_MEMORY;
+    }
+    *array = p;
+    return UCC_OK;
+}
+
+static inline void ucc_dag_satisfy(ucc_dag_t *dag, uint32_t src,
+                                   ucc_dag_dep_t dep)
+{
+    ucc_dag_edge_t *edge;
+    ucc_dag_node_t *dst;
+    uint32_t        e;
+
+    for (e = dag->nodes[src].edges; e != UCC_DAG_NONE; e = edge->next) {
+        edge = &dag->edges[e];
+        if (edge->dep != dep) {
+            continue;
+        }
+        dst = &dag->nodes[edge->dst];
+        if (++dst->n_deps_satisfied == dst->n_deps) {
+            dag->ready[dag->ready_tail++] = edge->dst;
+        }
+    }
+}
+
+static ucc_status_t ucc_dag_start_node(ucc_dag_t *dag, uint32_t node)
+{
+    ucc_coll_task_t *task = dag->nodes[node].task;
+    ucc_status_t     status;
+
+    ucc_trace_req("dag %p starting node %u, task %p", dag, node, task);
+    task->dag_node   = node;
+    task->start_time = dag->super.start_time;
+    status = dag->node_start ? dag->node_start(dag, node) : task->post(task);
+    if (ucc_unlikely(status < 0)) {
+        ucc_error("dag %p failed to start node %u, task %p, %s", dag, node,
+                  task, ucc_status_string(status));
+        return status;
+    }
+    ucc_dag_satisfy(dag, node, UCC_DAG_DEP_STARTED);
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_dag_dispatch(ucc_dag_t *dag)
+{
+    ucc_status_t status = UCC_OK;
+
+    if (dag->in_dispatch) {
+        /* called from the post of a node, ready nodes are started by the
+           outer loop */
+        return UCC_OK;
+    }
+    dag->in_dispatch = 1;
+    while (dag->ready_head != dag->ready_tail) {
+        status = ucc_dag_start_node(dag, dag->ready[dag->ready_head++]);
+        if (ucc_unlikely(status < 0)) {
+            break;
+        }
+    }
+    dag->in_dispatch = 0;
+    if (ucc_unlikely(status < 0)) {
+        dag->super.super.status = status;
+        return status;
+    }
+    if (dag->n_completed == dag->n_nodes &&
+        dag->super.super.status == UCC_INPROGRESS) {
+        ucc_trace_req("dag %p completed", dag);
+        dag->super.super.status = UCC_OK;
+        ucc_task_complete(&dag->super);
+    }
+    return UCC_OK;
+}
+
+static ucc_status_t ucc_dag_completed_handler(ucc_coll_task_t *parent,
+                                              ucc_coll_task_t *task)
+{
+    ucc_dag_t *dag = ucc_derived_of(task, ucc_dag_t);
+
+    ucc_trace_req("dag %p completed node %u, task %p", dag, parent->dag_node,
+                  parent);
+    dag->n_completed++;
+    ucc_dag_satisfy(dag, parent->dag_node, UCC_DAG_DEP_COMPLETED);
+    return ucc_dag_dispatch(dag);
+}
+
+ucc_status_t ucc_dag_init(ucc_dag_t *dag, ucc_base_coll_args_t *bargs,
+                          ucc_base_team_t *team)
+{
+    dag->nodes       = dag->inline_nodes;
+    dag->ready       = dag->inline_ready;
+    dag->edges       = dag->inline_edges;
+    dag->n_nodes     = 0;
+    dag->max_nodes   = UCC_DAG_INLINE_NODES;
+    dag->n_edges     = 0;
+    dag->max_edges   = UCC_DAG_INLINE_EDGES;
+    dag->in_dispatch = 0;
+    dag->node_start  = NULL;
+    return ucc_coll_task_init(&dag->super, bargs, team);
+}
+
+ucc_status_t ucc_dag_add_node(ucc_dag_t *dag, ucc_coll_task_t *task,
+                              uint32_t *node)
+{
+    ucc_dag_node_t *n;
+    ucc_status_t    status;
+
+    if (dag->n_nodes == dag->max_nodes) {
+        status = ucc_dag_grow((void **)&dag->nodes, dag->inline_nodes,
+                              dag->max_nodes, sizeof(ucc_dag_node_t),
+                              "dag_nodes");
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+        status = ucc_dag_grow((void **)&dag->ready, dag->inline_ready,
+                              dag->max_nodes, sizeof(uint32_t), "dag_ready");
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+        dag->max_nodes *= 2;
+    }
+    if (!(task->flags & UCC_COLL_TASK_FLAG_DAG_NODE)) {
+        /* task used by several nodes is subscribed once */
+        ucc_event_manager_subscribe(&task->em, UCC_EVENT_COMPLETED,
+                                    &dag->super, ucc_dag_completed_handler);
+        task->flags |= UCC_COLL_TASK_FLAG_DAG_NODE;
+    }
+    n                   = &dag->nodes[dag->n_nodes];
+    n->task             = task;
+    n->edges            = UCC_DAG_NONE;
+    n->n_deps           = 0;
+    n->n_deps_satisfied = 0;
+    if (node) {
+        *node = dag->n_nodes;
+    }
+    dag->n_nodes++;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_dag_add_edge(ucc_dag_t *dag, uint32_t src, uint32_t dst,
+                              ucc_dag_dep_t dep)
+{
+    ucc_dag_edge_t *edge;
+    ucc_status_t    status;
+
+    ucc_assert(src < dag->n_nodes && dst < dag->n_nodes && src != dst);
+    if (dag->n_edges == dag->max_edges) {
+        status = ucc_dag_grow((void **)&dag->edges, dag->inline_edges,
+                              dag->max_edges, sizeof(ucc_dag_edge_t),
+                              "dag_edges");
+        if (ucc_unlikely(UCC_OK != status)) {
+            return status;
+        }
+        dag->max_edges *= 2;
+    }
+    edge                  = &dag->edges[dag->n_edges];
+    edge->dst             = dst;
+    edge->dep             = dep;
+    edge->next            = dag->nodes[src].edges;
+    dag->nodes[src].edges = dag->n_edges++;
+    dag->nodes[dst].n_deps++;
+    return UCC_OK;
+}
+
+ucc_status_t ucc_dag_start(ucc_dag_t *dag)
+{
+    uint32_t i;
+
+    dag->n_completed        = 0;
+    dag->ready_head         = 0;
+    dag->ready_tail         = 0;
+    dag->super.super.status = UCC_INPROGRESS;
+    for (i = 0; i < dag->n_nodes; i++) {
+        dag->nodes[i].n_deps_satisfied = 0;
+        if (dag->nodes[i].n_deps == 0) {
+            dag->ready[dag->ready_tail++] = i;
+        }
+    }
+    return ucc_dag_dispatch(dag);
+}
+
+void ucc_dag_cleanup(ucc_dag_t *dag)
+{
+    if (dag->nodes != dag->inline_nodes) {
+        ucc_free(dag->nodes);
+    }
+    if (dag->ready != dag->inline_ready) {
+        ucc_free(dag->ready);
+    }
+    if (dag->edges != dag->inline_edges) {
+        ucc_free(dag->edges);
+    }
+    dag->nodes   = dag->inline_nodes;
+    dag->ready   = dag->inline_ready;
+    dag->edges   = dag->inline_edges;
+    dag->n_nodes = 0;
+    dag->n_edges = 0;
+}
+
+ucc_status_t ucc_dag_finalize(ucc_coll_task_t *task)
+{
+    ucc_dag_t       *dag            = ucc_derived_of(task, ucc_dag_t);
+    ucc_status_t     status_overall = UCC_OK;
+    ucc_coll_task_t *t;
+    ucc_status_t     status;
+    uint32_t         i;
+
+    for (i = 0; i < dag->n_nodes; i++) {
+        t = dag->nodes[i].task;
+        if (t->finalize) {
+            status = t->finalize(t);
+            if (UCC_OK != status) {
+                status_overall = status;
+            }
+        }
+    }
+    ucc_dag_cleanup(dag);
+    return status_overall;
+}
@@ -0,0 +1,93 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+#ifndef UCC_DAG_H_
+#define UCC_DAG_H_
+
+#include "ucc_schedule.h"
+
+/* DAG schedule - task that executes a directed acyclic graph of tasks.
+   Unlike ucc_schedule_t the number of nodes (tasks) and edges (dependencies)
+   is not limited: both are kept in arrays owned by the DAG which grow on
+   demand, small graphs fit into the inline storage so no allocation is done
+   on collective init. Outgoing edges of a node are linked by index in the
+   edges array.
+   Dependencies are tracked by the DAG itself instead of tasks subscribing
+   to each other: every node task has a single listener (the DAG), nodes that
+   become ready are queued and started by the outermost dispatch loop. Task
+   completed from the post of another task does not recurse into the next
+   post.
+   The same task may be used by several nodes (e.g. pipeline fragment that
+   is relaunched), the nodes must be ordered by completion dependencies. */
+
+#define UCC_DAG_INLINE_NODES 8
+#define UCC_DAG_INLINE_EDGES 16
+#define UCC_DAG_NONE         UINT32_MAX
+
+typedef enum ucc_dag_dep {
+    UCC_DAG_DEP_COMPLETED, /*< dst is started after src is completed */
+    UCC_DAG_DEP_STARTED    /*< dst is started after src is started */
+} ucc_dag_dep_t;
+
+typedef struct ucc_dag ucc_dag_t;
+
+/* Starts the task of the node, task->post is used if not set */
+typedef ucc_status_t (*ucc_dag_node_start_fn_t)(ucc_dag_t *dag,
+                                                uint32_t   node);
+
+typedef struct ucc_dag_edge {
+    uint32_t dst;
+    uint32_t next; /*< next outgoing edge of the same node */
+    uint32_t dep;
+} ucc_dag_edge_t;
+
+typedef struct ucc_dag_node {
+    ucc_coll_task_t *task;
+    uint32_t         edges; /*< first outgoing edge */
+    uint32_t         n_deps;
+    uint32_t         n_deps_satisfied;
+} ucc_dag_node_t;
+
+struct ucc_dag {
+    ucc_coll_task_t         super;
+    ucc_dag_node_t         *nodes;
+    ucc_dag_edge_t         *edges;
+    uint32_t               *ready; /*< FIFO of nodes to be started */
+    uint32_t                n_nodes;
+    uint32_t                max_nodes;
+    uint32_t                n_edges;
+    uint32_t                max_edges;
+    uint32_t                ready_head;
+    uint32_t                ready_tail;
+    uint32_t                n_completed;
+    int                     in_dispatch;
+    ucc_dag_node_start_fn_t node_start;
+    ucc_dag_node_t          inline_nodes[UCC_DAG_INLINE_NODES];
+    uint32_t                inline_ready[UCC_DAG_INLINE_NODES];
+    ucc_dag_edge_t          inline_edges[UCC_DAG_INLINE_EDGES];
+};
+
+ucc_status_t ucc_dag_init(ucc_dag_t *dag, ucc_base_coll_args_t *bargs,
+                          ucc_base_team_t *team);
+
+/* Adds the node executing the task, node index is returned in "node" if it
+   is not NULL. Nodes are numbered in the order they are added. */
+ucc_status_t ucc_dag_add_node(ucc_dag_t *dag, ucc_coll_task_t *task,
+                              uint32_t *node);
+
+ucc_status_t ucc_dag_add_edge(ucc_dag_t *dag, uint32_t src, uint32_t dst,
+                              ucc_dag_dep_t dep);
+
+/* Starts the nodes without dependencies, can be called again after the
+   DAG is completed (persistent collectives) */
+ucc_status_t ucc_dag_start(ucc_dag_t *dag);
+
+/* Releases DAG storage, node tasks are not finalized */
+void ucc_dag_cleanup(ucc_dag_t *dag);
+
+/* Finalizes the tasks of all the nodes and releases DAG storage. Can only
+   be used if every task belongs to a single node. */
+ucc_status_t ucc_dag_finalize(ucc_coll_task_t *task);
+
+#endif
@@ -131,6 +131,19 @@ void ucc_schedule_add_task(ucc_schedule_t *schedule, ucc_coll_task_t *task)
 
 ucc_status_t ucc_schedule_start(ucc_schedule_t *schedule)
 {
+    int i;
+
+    if (schedule->super.super.status != UCC_OPERATION_INITIALIZED) {
+        /* schedule is re-posted (persistent collective, completed with
+           success or error): dependencies of the tasks have to be satisfied
+           again. Schedules in initial state are either new or frags
+           prepared by ucc_schedule_pipelined_post, which sets the
+           dependencies of the first frag itself. */
+        for (i = 0; i < schedule->n_tasks; i++) {
+            schedule->tasks[i]->n_deps_satisfied = 0;
+            schedule->tasks[i]->super.status     = UCC_OPERATION_INITIALIZED;
+        }
+    }
     schedule->n_completed_tasks  = 0;
     schedule->super.super.status = UCC_INPROGRESS;
     return ucc_event_manager_notify(&schedule->super,
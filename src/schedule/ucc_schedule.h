@@ -41,8 +41,21 @@ typedef struct ucc_event_manager {
 } ucc_event_manager_t;
 
 enum {
-    UCC_COLL_TASK_FLAG_INTERNAL = UCC_BIT(0),
-    UCC_COLL_TASK_FLAG_CB       = UCC_BIT(1)
+    UCC_COLL_TASK_FLAG_INTERNAL     = UCC_BIT(0),
+    UCC_COLL_TASK_FLAG_CB           = UCC_BIT(1),
+    /* task progress is only needed after ucc_progress_task_ready, used
+       by progress queue in ready list mode */
+    UCC_COLL_TASK_FLAG_EVENT_DRIVEN = UCC_BIT(2),
+    /* progress queue internal flags for event driven tasks */
+    UCC_COLL_TASK_FLAG_READY        = UCC_BIT(3),
+    UCC_COLL_TASK_FLAG_IDLE         = UCC_BIT(4),
+    /* request of team level allreduce fusion, see ucc_coll_fusion.h */
+    UCC_COLL_TASK_FLAG_FUSED        = UCC_BIT(5),
+    /* task is a node of DAG schedule, see ucc_dag.h */
+    UCC_COLL_TASK_FLAG_DAG_NODE     = UCC_BIT(6),
+    /* latency of the task is sampled by the autotuner, see
+       ucc_coll_score_tune.h */
+    UCC_COLL_TASK_FLAG_TUNE         = UCC_BIT(7)
 };
 
 typedef struct ucc_coll_task {
@@ -70,9 +83,11 @@ typedef struct ucc_coll_task {
     uint8_t  n_deps;
     uint8_t  n_deps_satisfied;
     uint8_t  n_deps_base;
+    uint32_t dag_node; /* node of DAG schedule the task is started for */
     double   start_time; /* timestamp of the start time:
                             either post or triggered_post */
     uint32_t seq_num;
+    int      tune_cand; /* autotuner candidate the task is initialized with */
 } ucc_coll_task_t;
 
 typedef struct ucc_context ucc_context_t;
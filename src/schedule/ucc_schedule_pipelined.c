@@ -5,77 +5,38 @@
 #include "ucc_schedule.h"
 #include "ucc_schedule_pipelined.h"
 #include "coll_score/ucc_coll_score.h"
+#include "utils/ucc_malloc.h"
 
-static ucc_status_t ucc_frag_start_handler(ucc_coll_task_t *parent,
-                                           ucc_coll_task_t *task)
+static ucc_status_t ucc_frag_start(ucc_dag_t *dag, uint32_t frag_num)
 {
     ucc_schedule_pipelined_t *schedule =
-        ucc_derived_of(parent, ucc_schedule_pipelined_t);
-    ucc_schedule_t *frag               = ucc_derived_of(task, ucc_schedule_t);
+        ucc_derived_of(dag, ucc_schedule_pipelined_t);
+    ucc_schedule_t *frag = schedule->frags[frag_num % schedule->n_frags];
     ucc_status_t    status;
+    int             i;
 
-    task->start_time = parent->start_time;
+    if (frag_num >= schedule->n_frags) {
+        ucc_trace_req("sched %p restarting frag %d %p", schedule,
+                      frag_num % schedule->n_frags, frag);
+        ucc_assert(frag->super.super.status == UCC_OK);
+        frag->super.super.status = UCC_OPERATION_INITIALIZED;
+        frag->n_completed_tasks  = 0;
+        for (i = 0; i < frag->n_tasks; i++) {
+            frag->tasks[i]->n_deps += frag->tasks[i]->n_deps_base;
+            frag->tasks[i]->super.status = UCC_OPERATION_INITIALIZED;
+        }
+    }
     if (schedule->frag_setup) {
-        status =
-            schedule->frag_setup(schedule, frag, schedule->n_frags_started);
+        status = schedule->frag_setup(schedule, frag, frag_num);
         if (UCC_OK != status) {
             ucc_error("failed to setup fragment %d of pipelined schedule",
-                      schedule->n_frags_started);
+                      frag_num);
             return status;
         }
     }
-    schedule->next_frag_to_post =
-        (schedule->next_frag_to_post + 1) % schedule->n_frags;
-    ucc_trace_req("sched %p started frag %p frag_num %d next_to_post %d",
-                  schedule, frag, schedule->n_frags_started,
-                  schedule->next_frag_to_post);
-    schedule->n_frags_started++;
-    schedule->n_frags_in_pipeline++;
-    return task->post(task);
-}
-
-static ucc_status_t
-ucc_schedule_pipelined_completed_handler(ucc_coll_task_t *parent_task, //NOLINT
-                                         ucc_coll_task_t *task)
-{
-    ucc_schedule_pipelined_t *schedule =
-        ucc_container_of(task, ucc_schedule_pipelined_t, super);
-    ucc_schedule_t *frag = ucc_derived_of(parent_task, ucc_schedule_t);
-    int             i;
-
-    schedule->super.n_completed_tasks += 1;
-    schedule->n_frags_in_pipeline--;
-    ucc_trace_req(
-        "sched %p completed frag %p, n_completed %d, n_started %d, n_total %d",
-        schedule, frag, schedule->super.n_completed_tasks,
-        schedule->n_frags_started, schedule->super.n_tasks);
-    ucc_assert(frag->super.super.status == UCC_OK);
-    if (schedule->super.n_completed_tasks == schedule->super.n_tasks) {
-        schedule->super.super.super.status = UCC_OK;
-        ucc_task_complete(task);
-        return UCC_OK;
-    }
-    while ((schedule->super.n_completed_tasks + schedule->n_frags_in_pipeline <
-            schedule->super.n_tasks) &&
-           (frag->super.super.status == UCC_OK)) {
-        /* need to post more frags*/
-        if (frag == schedule->frags[schedule->next_frag_to_post]) {
-            ucc_trace_req("sched %p restarting frag %d %p", schedule,
-                          schedule->next_frag_to_post, frag);
-            frag->super.super.status = UCC_OPERATION_INITIALIZED;
-            frag->n_completed_tasks  = 0;
-            for (i = 0; i < frag->n_tasks; i++) {
-                frag->tasks[i]->n_deps += frag->tasks[i]->n_deps_base;
-                frag->tasks[i]->super.status = UCC_OPERATION_INITIALIZED;
-            }
-            ucc_frag_start_handler(&schedule->super.super, &frag->super);
-        }
-        frag = schedule->frags[schedule->next_frag_to_post];
-        if (&frag->super == parent_task) {
-            break;
-        }
-    }
-    return UCC_OK;
+    ucc_trace_req("sched %p started frag %p frag_num %d", schedule, frag,
+                  frag_num);
+    return frag->super.post(&frag->super);
 }
 
 ucc_status_t ucc_schedule_pipelined_finalize(ucc_coll_task_t *task)
@@ -87,7 +48,11 @@ ucc_status_t ucc_schedule_pipelined_finalize(ucc_coll_task_t *task)
 
     ucc_trace_req("schedule pipelined %p is complete", schedule_p);
     for (i = 0; i < schedule_p->n_frags; i++) {
-        schedule_p->frags[i]->super.finalize(&frags[i]->super);
+        frags[i]->super.finalize(&frags[i]->super);
+    }
+    ucc_dag_cleanup(&schedule_p->super);
+    if (frags != schedule_p->inline_frags) {
+        ucc_free(frags);
     }
     return UCC_OK;
 }
@@ -99,12 +64,6 @@ ucc_status_t ucc_schedule_pipelined_post(ucc_coll_task_t *task)
     ucc_schedule_t **frags = schedule_p->frags;
     int              i, j;
 
-    schedule_p->super.super.super.status = UCC_OPERATION_INITIALIZED;
-    schedule_p->super.n_completed_tasks  = 0;
-    schedule_p->n_frags_started          = 0;
-    schedule_p->next_frag_to_post        = 0;
-    schedule_p->n_frags_in_pipeline      = 0;
-
     for (i = 0; i < schedule_p->n_frags; i++) {
         frags[i]->n_completed_tasks  = 0;
         frags[i]->super.super.status = UCC_OPERATION_INITIALIZED;
@@ -118,7 +77,7 @@ ucc_status_t ucc_schedule_pipelined_post(ucc_coll_task_t *task)
         }
     }
 
-    return ucc_schedule_start(&schedule_p->super);
+    return ucc_dag_start(&schedule_p->super);
 }
 
 ucc_status_t ucc_schedule_pipelined_init(
@@ -131,27 +90,35 @@ ucc_status_t ucc_schedule_pipelined_init(
     ucc_status_t     status;
     ucc_schedule_t **frags;
 
-    if (ucc_unlikely(n_frags > UCC_SCHEDULE_PIPELINED_MAX_FRAGS)) {
-        ucc_error("n_frags %d exceeds max limit of %d",
-                  n_frags, UCC_SCHEDULE_PIPELINED_MAX_FRAGS);
+    if (ucc_unlikely(n_frags < 1 || n_frags > n_frags_total)) {
+        ucc_error("invalid pipeline depth %d, n_frags_total %d",
+                  n_frags, n_frags_total);
         return UCC_ERR_INVALID_PARAM;
     }
 
-    status = ucc_schedule_init(&schedule->super, coll_args, team);
+    status = ucc_dag_init(&schedule->super, coll_args, team);
     if (ucc_unlikely(status != UCC_OK)) {
         ucc_error("failed to init pipelined schedule");
         return status;
     }
 
-    schedule->super.n_tasks        = n_frags_total;
+    frags = schedule->inline_frags;
+    if (n_frags > UCC_SCHEDULE_INLINE_FRAGS) {
+        frags = ucc_malloc(n_frags * sizeof(*frags), "pipelined_frags");
+        if (!frags) {
+            ucc_error("failed to allocate %zd bytes for pipelined frags",
+                      n_frags * sizeof(*frags));
+            return UCC_ERR_NO_MEMORY;
+        }
+    }
+    schedule->frags                = frags;
     schedule->n_frags              = n_frags;
+    schedule->n_frags_total        = n_frags_total;
     schedule->sequential           = sequential;
     schedule->frag_setup           = frag_setup;
-    schedule->next_frag_to_post    = 0;
-    schedule->n_frags_in_pipeline  = 0;
+    schedule->super.node_start     = ucc_frag_start;
     schedule->super.super.finalize = ucc_schedule_pipelined_finalize;
     schedule->super.super.post     = ucc_schedule_pipelined_post;
-    frags                          = schedule->frags;
     for (i = 0; i < n_frags; i++) {
         status = frag_init(coll_args, schedule, team, &frags[i]);
         if (UCC_OK != status) {
@@ -171,18 +138,41 @@ ucc_status_t ucc_schedule_pipelined_init(
                 frags[i]->tasks[j]->n_deps_base++;
             }
         }
-        ucc_event_manager_subscribe(&schedule->super.super.em,
-                                    UCC_EVENT_SCHEDULE_STARTED,
-                                    &frags[i]->super, ucc_frag_start_handler);
-        ucc_event_manager_subscribe(
-            &frags[i]->super.em, UCC_EVENT_COMPLETED, &schedule->super.super,
-                        ucc_schedule_pipelined_completed_handler);
+    }
+    for (i = 0; i < n_frags_total; i++) {
+        status = ucc_dag_add_node(&schedule->super,
+                                  &frags[i % n_frags]->super, NULL);
+        if (UCC_OK != status) {
+            goto err_dag;
+        }
+        /* frags are launched in order */
+        if (i > 0) {
+            status = ucc_dag_add_edge(&schedule->super, i - 1, i,
+                                      UCC_DAG_DEP_STARTED);
+            if (UCC_OK != status) {
+                goto err_dag;
+            }
+        }
+        /* frag schedule is reused when its previous launch is completed */
+        if (i >= n_frags) {
+            status = ucc_dag_add_edge(&schedule->super, i - n_frags, i,
+                                      UCC_DAG_DEP_COMPLETED);
+            if (UCC_OK != status) {
+                goto err_dag;
+            }
+        }
     }
     return UCC_OK;
+err_dag:
+    ucc_dag_cleanup(&schedule->super);
+    i = n_frags;
 err:
     for (i = i - 1; i >= 0; i--) {
         frags[i]->super.finalize(&frags[i]->super);
     }
+    if (frags != schedule->inline_frags) {
+        ucc_free(frags);
+    }
     return status;
 }
 
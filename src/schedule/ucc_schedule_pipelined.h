@@ -5,12 +5,14 @@
 #ifndef UCC_SCHEDULE_PIPELINED_H_
 #define UCC_SCHEDULE_PIPELINED_H_
 #include "components/base/ucc_base_iface.h"
+#include "ucc_dag.h"
 
 #define UCC_SCHEDULE_FRAG_MAX_TASKS 8
 
 typedef struct ucc_schedule_pipelined ucc_schedule_pipelined_t;
 
-#define UCC_SCHEDULE_PIPELINED_MAX_FRAGS 4
+/* Pipelines up to this depth keep frag pointers inline */
+#define UCC_SCHEDULE_INLINE_FRAGS 4
 
 /* frag_init is the callback provided by the user of pipelined
    framework (e.g., TL that needs to build a pipeline) that is reponsible
@@ -28,24 +30,25 @@ typedef ucc_status_t (*ucc_schedule_frag_init_fn_t)(
 typedef ucc_status_t (*ucc_schedule_frag_setup_fn_t)(
     ucc_schedule_pipelined_t *schedule_p, ucc_schedule_t *frag, int frag_num);
 
+/* Pipelined schedule is a DAG with a node per fragment launch: launch N
+   runs on frag schedule N % n_frags, it is started after launch N - 1 is
+   started and after launch N - n_frags (previous use of the same frag
+   schedule) is completed. */
 typedef struct ucc_schedule_pipelined {
-    ucc_schedule_t               super;
+    ucc_dag_t                    super;
     /* Array of the frag schedules - 1 schedule per pipeline entry */
-    ucc_schedule_t *             frags[UCC_SCHEDULE_PIPELINED_MAX_FRAGS];
+    ucc_schedule_t             **frags;
     /* n_frags - is the depth of the pipeline, ie how many fragments can
        be outstanding at a time */
     int                          n_frags;
-    /* total number of fragments started so far. Note, total number of frags
-       to be executed is stored in super.n_tasks */
-    int                          n_frags_started;
-    /* number of frags active in the pipeline */
-    int                          n_frags_in_pipeline;
+    /* total number of fragments to be executed */
+    int                          n_frags_total;
     /* sequential flag. if set to 1 the pipeline sets additional deps
        between the tasks in different frags. This prevents out-of-order
        task launch in different frags of a pipeline */
     int                          sequential;
-    int                          next_frag_to_post;
     ucc_schedule_frag_setup_fn_t frag_setup;
+    ucc_schedule_t              *inline_frags[UCC_SCHEDULE_INLINE_FRAGS];
 } ucc_schedule_pipelined_t;
 
 /* Creates a pipelined schedule for the algorithm defined by "frag_init".
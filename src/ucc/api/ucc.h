@@ -1103,6 +1103,35 @@ ucc_status_t ucc_context_create(ucc_lib_h lib_handle,
 
 ucc_status_t ucc_context_progress(ucc_context_h context);
 
+/**
+ *  @ingroup UCC_CONTEXT
+ *
+ *  @brief The @ref ucc_context_wait routine progresses the operations on the
+ *  context handle until an operation completes or timeout expires.
+ *
+ *  @param [in]  context  Communication context handle to be progressed
+ *  @param [in]  timeout  Timeout in seconds, negative value means infinite
+ *
+ *  @parblock
+ *
+ *  @b Description
+ *
+ *  The @ref ucc_context_wait routine progresses the context the same way as
+ *  @ref ucc_context_progress until at least one operation posted on the
+ *  context completes. The routine busy polls the context for a configurable
+ *  amount of time (UCC_WAIT_SPIN_TIME) and then, if all the components of
+ *  the context provide event file descriptors, sleeps until one of them is
+ *  signaled, releasing the CPU.
+ *  If the context is progressed by the asynchronous progress thread
+ *  (UCC_PROGRESS_THREAD=y) the routine returns UCC_OK immediately.
+ *
+ *  @endparblock
+ *
+ *  @return UCC_OK if an operation has completed, UCC_INPROGRESS if timeout
+ *  expired, otherwise error code as defined by @ref ucc_status_t
+ */
+ucc_status_t ucc_context_wait(ucc_context_h context, double timeout);
+
 /**
  *  @ingroup UCC_CONTEXT
  *
@@ -1682,6 +1711,34 @@ ucc_status_t ucc_team_get_my_ep(ucc_team_h team, uint64_t *ep);
 ucc_status_t ucc_team_get_all_eps(ucc_team_h team, uint64_t **ep,
                                   uint64_t *num_eps);
 
+/**
+ *  @ingroup UCC_TEAM
+ *
+ *  @brief The routine posts the collective operations deferred by the team.
+ *
+ *  @param [in]   team        Team handle
+ *
+ *  @parblock
+ *
+ *  @b Description
+ *
+ *  @ref ucc_team_flush posts the small allreduce operations of the team
+ *  that are held for fusion (see UCC_FUSION_ALLREDUCE_THRESH) and not yet
+ *  posted. Fused operations are also posted when the fusion buffer is full,
+ *  on a change of datatype or reduction operation and on initialization of
+ *  any other collective operation on the team, but never by progress of the
+ *  context. A request held for fusion does not complete until one of these
+ *  happens, so the user must call @ref ucc_team_flush before waiting for it.
+ *  The routine is a no-op if fusion is disabled. All the participants must
+ *  call it at the same point of the sequence of collective operations on
+ *  the team.
+ *
+ *  @endparblock
+ *
+ *  @return Error code as defined by @ref ucc_status_t
+ */
+ucc_status_t ucc_team_flush(ucc_team_h team);
+
 
 /*
  * *************************************************************
@@ -1965,6 +2022,30 @@ static inline ucc_status_t ucc_collective_test(ucc_coll_req_h request)
     return request->status;
 }
 
+/**
+ *  @ingroup UCC_COLLECTIVES
+ *
+ *  @brief The routine to wait for the completion of the collective operation.
+ *
+ *  @param [in]  request Request handle
+ *  @param [in]  timeout Timeout in seconds, negative value means infinite
+ *
+ *  @parblock
+ *
+ *  @b Description
+ *
+ *  @ref ucc_collective_wait progresses the context the collective operation
+ *  was posted on until the operation completes or the timeout expires. Same
+ *  as @ref ucc_context_wait, it busy polls the context for a short time and
+ *  then sleeps on the event file descriptors of the context, if supported.
+ *
+ *  @endparblock
+ *
+ *  @return Status of the collective operation: UCC_INPROGRESS if timeout
+ *  expired, otherwise error code as defined by @ref ucc_status_t
+ */
+ucc_status_t ucc_collective_wait(ucc_coll_req_h request, double timeout);
+
 /**
  *  @ingroup UCC_COLLECTIVES
  *
@@ -30,6 +30,10 @@
     (((_args).mask & UCC_COLL_ARGS_FIELD_FLAGS) && \
      ((_args).flags & UCC_COLL_ARGS_FLAG_IN_PLACE))
 
+#define UCC_IS_PERSISTENT(_args) \
+    (((_args).mask & UCC_COLL_ARGS_FIELD_FLAGS) && \
+     ((_args).flags & UCC_COLL_ARGS_FLAG_PERSISTENT))
+
 #define UCC_COLL_TIMEOUT_REQUIRED(_task)                       \
     (((_task)->bargs.args.mask & UCC_COLL_ARGS_FIELD_FLAGS) && \
      ((_task)->bargs.args.flags & UCC_COLL_ARGS_FLAG_TIMEOUT))
@@ -83,6 +87,24 @@ ucc_coll_args_get_total_count(const ucc_coll_args_t *args,
 
     return count;
 }
+/* Count and offset (in elements) of the block "block" when "total_count"
+   elements are split into "n_blocks" blocks as evenly as possible */
+static inline size_t ucc_buffer_block_count(size_t total_count,
+                                            ucc_rank_t n_blocks,
+                                            ucc_rank_t block)
+{
+    return total_count / n_blocks + (block < total_count % n_blocks ? 1 : 0);
+}
+
+static inline size_t ucc_buffer_block_offset(size_t total_count,
+                                             ucc_rank_t n_blocks,
+                                             ucc_rank_t block)
+{
+    size_t left = total_count % n_blocks;
+
+    return (total_count / n_blocks) * block + (block < left ? block : left);
+}
+
 typedef struct ucc_base_coll_args ucc_base_coll_args_t;
 
 ucc_coll_type_t   ucc_coll_type_from_str(const char *str);
@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_MPMC_QUEUE_H_
+#define UCC_MPMC_QUEUE_H_
+
+#include "utils/ucc_compiler_def.h"
+#include "utils/ucc_spinlock.h"
+#include "utils/ucc_atomic.h"
+#include "utils/ucc_malloc.h"
+#include "utils/ucc_log.h"
+#include "utils/ucc_list.h"
+
+/* Multi-producer multi-consumer queue of ucc_list_link_t elements.
+   Elements are stored in a bounded ring of cells, each cell has a sequence
+   number that tells producers and consumers whether the cell is free for
+   the given position (see D. Vyukov bounded MPMC queue). Enqueue and dequeue
+   are a single CAS on the shared position in the common case.
+   The queue is unbounded: if the ring is full the element is appended to
+   the spinlocked overflow list using the same list link. Overflow list is
+   only touched when it is not empty, dequeue alternates between the ring and
+   the overflow list so that neither of them is starved. */
+
+#define UCC_MPMC_QUEUE_DEFAULT_SIZE 1024
+
+typedef struct ucc_mpmc_queue_cell {
+    volatile uint64_t seq;
+    ucc_list_link_t  *elem;
+} ucc_mpmc_queue_cell_t;
+
+typedef struct ucc_mpmc_queue {
+    ucc_mpmc_queue_cell_t *cells;
+    uint64_t               mask;
+    char                   pad0[UCC_CACHE_LINE_SIZE];
+    volatile uint64_t      enqueue_pos;
+    char                   pad1[UCC_CACHE_LINE_SIZE - sizeof(uint64_t)];
+    volatile uint64_t      dequeue_pos;
+    char                   pad2[UCC_CACHE_LINE_SIZE - sizeof(uint64_t)];
+    volatile uint32_t      n_overflow;
+    uint32_t               tick;
+    ucc_spinlock_t         overflow_lock;
+    ucc_list_link_t        overflow;
+} ucc_mpmc_queue_t;
+
+static inline ucc_status_t ucc_mpmc_queue_init(ucc_mpmc_queue_t *queue,
+                                               uint64_t          size)
+{
+    uint64_t n_cells = 1;
+    uint64_t i;
+
+    while (n_cells < size) {
+        n_cells <<= 1;
+    }
+    queue->cells = (ucc_mpmc_queue_cell_t *)ucc_malloc(
+        n_cells * sizeof(*queue->cells), "mpmc_cells");
+    if (!queue->cells) {
+        ucc_error("failed to allocate %zd bytes for mpmc queue",
+                  n_cells * sizeof(*queue->cells));
+        return UCC_ERR_NO_MEMORY;
+    }
+    for (i = 0; i < n_cells; i++) {
+        queue->cells[i].seq  = i;
+        queue->cells[i].elem = NULL;
+    }
+    queue->mask        = n_cells - 1;
+    queue->enqueue_pos = 0;
+    queue->dequeue_pos = 0;
+    queue->n_overflow  = 0;
+    queue->tick        = 0;
+    ucc_spinlock_init(&queue->overflow_lock, 0);
+    ucc_list_head_init(&queue->overflow);
+    return UCC_OK;
+}
+
+static inline void ucc_mpmc_queue_destroy(ucc_mpmc_queue_t *queue)
+{
+    ucc_spinlock_destroy(&queue->overflow_lock);
+    ucc_free(queue->cells);
+}
+
+/* Approximate number of queued elements, exact if there are no concurrent
+   enqueue/dequeue calls */
+static inline uint64_t ucc_mpmc_queue_size(ucc_mpmc_queue_t *queue)
+{
+    uint64_t deq = queue->dequeue_pos;
+    uint64_t enq = queue->enqueue_pos;
+
+    return (enq > deq ? enq - deq : 0) + queue->n_overflow;
+}
+
+static inline void ucc_mpmc_queue_enqueue(ucc_mpmc_queue_t *queue,
+                                          ucc_list_link_t  *elem)
+{
+    uint64_t               pos = queue->enqueue_pos;
+    ucc_mpmc_queue_cell_t *cell;
+    int64_t                dif;
+
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        dif  = (int64_t)(cell->seq - pos);
+        ucc_memory_cpu_load_fence();
+        if (dif == 0) {
+            if (ucc_atomic_bool_cswap64(&queue->enqueue_pos, pos, pos + 1)) {
+                break;
+            }
+            pos = queue->enqueue_pos;
+        } else if (dif < 0) {
+            /* ring is full */
+            ucc_spin_lock(&queue->overflow_lock);
+            ucc_list_add_tail(&queue->overflow, elem);
+            queue->n_overflow++;
+            ucc_spin_unlock(&queue->overflow_lock);
+            return;
+        } else {
+            pos = queue->enqueue_pos;
+        }
+    }
+    cell->elem = elem;
+    ucc_memory_cpu_store_fence();
+    cell->seq = pos + 1;
+}
+
+static inline ucc_list_link_t *
+ucc_mpmc_queue_dequeue_overflow(ucc_mpmc_queue_t *queue)
+{
+    ucc_list_link_t *elem = NULL;
+
+    ucc_spin_lock(&queue->overflow_lock);
+    if (!ucc_list_is_empty(&queue->overflow)) {
+        elem = queue->overflow.next;
+        ucc_list_del(elem);
+        queue->n_overflow--;
+    }
+    ucc_spin_unlock(&queue->overflow_lock);
+    return elem;
+}
+
+static inline ucc_list_link_t *ucc_mpmc_queue_dequeue(ucc_mpmc_queue_t *queue)
+{
+    ucc_mpmc_queue_cell_t *cell;
+    ucc_list_link_t       *elem;
+    uint64_t               pos;
+    int64_t                dif;
+
+    if (ucc_unlikely(queue->n_overflow) &&
+        (ucc_atomic_fadd32(&queue->tick, 1) & 1)) {
+        elem = ucc_mpmc_queue_dequeue_overflow(queue);
+        if (elem) {
+            return elem;
+        }
+    }
+
+    pos = queue->dequeue_pos;
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        dif  = (int64_t)(cell->seq - (pos + 1));
+        ucc_memory_cpu_load_fence();
+        if (dif == 0) {
+            if (ucc_atomic_bool_cswap64(&queue->dequeue_pos, pos, pos + 1)) {
+                break;
+            }
+            pos = queue->dequeue_pos;
+        } else if (dif < 0) {
+            /* ring is empty */
+            return queue->n_overflow ? ucc_mpmc_queue_dequeue_overflow(queue)
+                                     : NULL;
+        } else {
+            pos = queue->dequeue_pos;
+        }
+    }
+    elem = cell->elem;
+    /* elem must be read before the cell is released to producers */
+    ucc_memory_cpu_fence();
+    cell->seq = pos + queue->mask + 1;
+    return elem;
+}
+
+#endif
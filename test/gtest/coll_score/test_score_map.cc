@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "test_score.h"
+extern "C" {
+#include "utils/ucc_time.h"
+}
+#include <sstream>
+
+#define TEAM_ID(_team) ((uint64_t)(_team))
+
+/* init fn returns the team pointer as a task so that the test can check
+   which range/fallback has been selected */
+static ucc_status_t map_init_ok(ucc_base_coll_args_t *, ucc_base_team_t *team,
+                                ucc_coll_task_t **task)
+{
+    *task = (ucc_coll_task_t *)team;
+    return UCC_OK;
+}
+
+static ucc_status_t map_init_ns(ucc_base_coll_args_t *, ucc_base_team_t *,
+                                ucc_coll_task_t **)
+{
+    return UCC_ERR_NOT_SUPPORTED;
+}
+
+class test_score_map : public test_score {
+public:
+    ucc_base_coll_args_t bargs;
+    test_score_map()
+    {
+        memset(&bargs, 0, sizeof(bargs));
+        bargs.args.coll_type         = UCC_COLL_TYPE_ALLREDUCE;
+        bargs.args.src.info.mem_type = UCC_MEMORY_TYPE_HOST;
+        bargs.args.dst.info.mem_type = UCC_MEMORY_TYPE_HOST;
+        bargs.args.src.info.datatype = UCC_DT_INT8;
+        bargs.args.dst.info.datatype = UCC_DT_INT8;
+    }
+    ucc_status_t lookup(ucc_score_map_t *map, size_t msgsize, uint64_t *id)
+    {
+        ucc_coll_task_t *task;
+        ucc_status_t     status;
+
+        bargs.args.src.info.count = msgsize;
+        bargs.args.dst.info.count = msgsize;
+        status = ucc_coll_init(map, &bargs, &task);
+        if (UCC_OK == status) {
+            *id = TEAM_ID(task);
+        }
+        return status;
+    }
+};
+
+UCC_TEST_F(test_score_map, lookup)
+{
+    ucc_coll_type_t   c = UCC_COLL_TYPE_ALLREDUCE;
+    ucc_memory_type_t m = UCC_MEMORY_TYPE_HOST;
+    ucc_coll_score_t *score;
+    ucc_score_map_t  *map;
+    uint64_t          id;
+
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc(&score));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(score, c, m, 0, 10, 1,
+                                               map_init_ok,
+                                               (ucc_base_team_t *)1));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(score, c, m, 20, 40, 1,
+                                               map_init_ok,
+                                               (ucc_base_team_t *)2));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(score, c, m, 40, 100, 1,
+                                               map_init_ok,
+                                               (ucc_base_team_t *)3));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_build_map(score, &map));
+
+    EXPECT_EQ(UCC_OK, lookup(map, 0, &id));
+    EXPECT_EQ(1, id);
+    EXPECT_EQ(UCC_OK, lookup(map, 9, &id));
+    EXPECT_EQ(1, id);
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, lookup(map, 10, &id));
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, lookup(map, 19, &id));
+    EXPECT_EQ(UCC_OK, lookup(map, 20, &id));
+    EXPECT_EQ(2, id);
+    EXPECT_EQ(UCC_OK, lookup(map, 40, &id));
+    EXPECT_EQ(3, id);
+    EXPECT_EQ(UCC_OK, lookup(map, 99, &id));
+    EXPECT_EQ(3, id);
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, lookup(map, 100, &id));
+
+    /* no ranges for other mem type */
+    bargs.args.src.info.mem_type = UCC_MEMORY_TYPE_CUDA;
+    bargs.args.dst.info.mem_type = UCC_MEMORY_TYPE_CUDA;
+    EXPECT_EQ(UCC_ERR_NOT_SUPPORTED, lookup(map, 0, &id));
+    ucc_coll_score_free_map(map);
+}
+
+UCC_TEST_F(test_score_map, fallback)
+{
+    ucc_coll_type_t   c = UCC_COLL_TYPE_ALLREDUCE;
+    ucc_memory_type_t m = UCC_MEMORY_TYPE_HOST;
+    ucc_coll_score_t *score1, *score2, *score3, *rst;
+    ucc_score_map_t  *map;
+    uint64_t          id;
+
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc(&score1));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc(&score2));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc(&score3));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(score1, c, m, 0, 100, 30,
+                                               map_init_ns,
+                                               (ucc_base_team_t *)1));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(score2, c, m, 0, 100, 20,
+                                               map_init_ns,
+                                               (ucc_base_team_t *)2));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(score3, c, m, 0, 100, 10,
+                                               map_init_ok,
+                                               (ucc_base_team_t *)3));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_merge(score1, score2, &rst, 1));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_merge(rst, score3, &score1, 1));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_build_map(score1, &map));
+
+    /* two fallbacks are taken */
+    EXPECT_EQ(UCC_OK, lookup(map, 50, &id));
+    EXPECT_EQ(3, id);
+    ucc_coll_score_free_map(map);
+}
+
+/* Measures the cost of ucc_coll_init (lookup + fallbacks) for growing
+   number of ranges coming from TUNE string. Lookup should stay (almost)
+   flat. */
+UCC_TEST_F(test_score_map, perf)
+{
+    const int         n_iters  = 100000;
+    const size_t      r_size   = 64;
+    int               n_ranges[] = {1, 16, 256, 4096};
+    ucc_coll_score_t *score;
+    ucc_score_map_t  *map;
+    uint64_t          id;
+    double            t;
+
+    for (int n : n_ranges) {
+        std::stringstream str;
+        for (int i = 0; i < n; i++) {
+            str << (i ? "#" : "") << "allreduce:host:" << i * r_size << "-"
+                << (i + 1) * r_size << ":10";
+        }
+        ASSERT_EQ(UCC_OK, ucc_coll_score_alloc_from_str(
+                              str.str().c_str(), &score, 0, map_init_ok,
+                              (ucc_base_team_t *)1, NULL));
+        ASSERT_EQ(UCC_OK, ucc_coll_score_build_map(score, &map));
+        t = ucc_get_time();
+        for (int i = 0; i < n_iters; i++) {
+            EXPECT_EQ(UCC_OK, lookup(map, (i % n) * r_size + (i % r_size),
+                                     &id));
+        }
+        t = ucc_get_time() - t;
+        EXPECT_EQ(1, id);
+        UCC_TEST_MESSAGE << "n_ranges " << n << ": "
+                         << t * 1e9 / n_iters << " ns per coll_init";
+        ucc_coll_score_free_map(map);
+    }
+}
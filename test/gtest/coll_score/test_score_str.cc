@@ -4,6 +4,8 @@
  */
 
 #include "test_score.h"
+#include <fstream>
+#include <unistd.h>
 class test_score_str : public test_score {
 };
 
@@ -113,3 +115,116 @@ UCC_TEST_F(test_score_str, check_range_multiple)
                           RLIST({RANGE(99, 12*1024*1024, 20)})));
     ucc_coll_score_free(score);
 }
+
+UCC_TEST_F(test_score_str, check_team_shape)
+{
+    std::string                str = "bcast:nnodes=[2-4]:ppn=[1-8]:10#"
+                                     "allreduce:ppn=[16-32]:20#"
+                                     "barrier:nnodes=[1]:30";
+    ucc_coll_score_team_info_t info;
+    ucc_coll_score_rules_t    *rules;
+    ucc_coll_score_t          *score;
+
+    EXPECT_EQ(UCC_OK, ucc_coll_score_rules_alloc(&rules));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_rules_add_str(rules, str.c_str()));
+
+    info = {8, 2, 4};
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc_from_str("bcast,allreduce,barrier:"
+                                                    "host:1", &score, 8, NULL,
+                                                    NULL, NULL));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_update_from_rules(rules, score, &info,
+                                                       NULL, NULL, 1, NULL));
+    EXPECT_EQ(10, SCORE(score, BCAST, HOST));
+    EXPECT_EQ(1, SCORE(score, ALLREDUCE, HOST));
+    EXPECT_EQ(1, SCORE(score, BARRIER, HOST));
+    ucc_coll_score_free(score);
+
+    /* unknown team shape: nnodes and ppn qualified ranges are skipped */
+    info = {8, 0, 0};
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc_from_str("bcast,allreduce,barrier:"
+                                                    "host:1", &score, 8, NULL,
+                                                    NULL, NULL));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_update_from_rules(rules, score, &info,
+                                                       NULL, NULL, 1, NULL));
+    EXPECT_EQ(1, SCORE(score, BCAST, HOST));
+    EXPECT_EQ(1, SCORE(score, ALLREDUCE, HOST));
+    EXPECT_EQ(1, SCORE(score, BARRIER, HOST));
+    ucc_coll_score_free(score);
+    ucc_coll_score_rules_free(rules);
+
+    testing::internal::CaptureStdout();
+    EXPECT_NE(UCC_OK, ucc_coll_score_alloc_from_str("bcast:nnodes=2:10",
+                                                    &score, 8, NULL, NULL,
+                                                    NULL));
+    EXPECT_NE(UCC_OK, ucc_coll_score_alloc_from_str("bcast:ppn=[a]:10",
+                                                    &score, 8, NULL, NULL,
+                                                    NULL));
+    testing::internal::GetCapturedStdout();
+}
+
+static int test_topo_alg(int alg_id, const char *alg_id_str,
+                         ucc_coll_type_t coll_type)
+{
+    return coll_type == UCC_COLL_TYPE_ALLTOALLV &&
+           (alg_id_str ? !strcmp(alg_id_str, "node") : alg_id == 2);
+}
+
+UCC_TEST_F(test_score_str, check_topo_required)
+{
+    std::vector<std::pair<std::string, int>> strs = {
+        {"alltoallv:@node:inf", 1},
+        {"alltoallv:@2:inf", 1},
+        {"@node:inf", 1},
+        {"alltoallv:@sparse:inf#bcast:host:10", 0},
+        {"alltoall:@node:inf", 0},
+        {"bcast:ppn=[1-8]:10", 1},
+        {"barrier:nnodes=[2]:10", 1}};
+    ucc_coll_score_rules_t *rules;
+
+    EXPECT_EQ(0, ucc_coll_score_rules_topo_required(NULL, test_topo_alg));
+    for (auto &s : strs) {
+        EXPECT_EQ(UCC_OK, ucc_coll_score_rules_alloc(&rules));
+        EXPECT_EQ(UCC_OK, ucc_coll_score_rules_add_str(rules,
+                                                       s.first.c_str()));
+        EXPECT_EQ(s.second,
+                  ucc_coll_score_rules_topo_required(rules, test_topo_alg))
+            << s.first;
+        /* qualifiers need topo even if the component has no topo algs */
+        EXPECT_EQ((int)(s.first.find('=') != std::string::npos),
+                  ucc_coll_score_rules_topo_required(rules, NULL))
+            << s.first;
+        ucc_coll_score_rules_free(rules);
+    }
+}
+
+UCC_TEST_F(test_score_str, check_file)
+{
+    std::string                fname = "/tmp/ucc_test_score_str_" +
+                                       std::to_string(getpid());
+    ucc_coll_score_team_info_t info  = {8, 0, 0};
+    ucc_coll_score_rules_t    *rules;
+    ucc_coll_score_t          *score;
+    std::ofstream              f(fname);
+
+    f << "# bcast mem_type=host team_size=8" << std::endl
+      << "UCC_TL_OTHER_TUNE=bcast:host:30" << std::endl
+      << "UCC_TL_TEST_TUNE=bcast:host:10" << std::endl
+      << "UCC_TL_TEST_TUNE=bcast:host:0-64:20" << std::endl;
+    f.close();
+
+    EXPECT_EQ(UCC_OK, ucc_coll_score_rules_alloc(&rules));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_rules_add_file(rules, fname.c_str(),
+                                                    "UCC_TL_TEST_TUNE"));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc_from_str("bcast:host:1", &score, 8,
+                                                    NULL, NULL, NULL));
+    /* lines are applied in the file order */
+    EXPECT_EQ(UCC_OK, ucc_coll_score_update_from_rules(rules, score, &info,
+                                                       NULL, NULL, 1, NULL));
+    EXPECT_EQ(UCC_OK,
+              check_range(score, UCC_COLL_TYPE_BCAST, UCC_MEMORY_TYPE_HOST,
+                          RLIST({RANGE(0, 64, 20),
+                                 RANGE(64, UCC_MSG_MAX, 10)})));
+    ucc_coll_score_free(score);
+    ucc_coll_score_rules_free(rules);
+    unlink(fname.c_str());
+}
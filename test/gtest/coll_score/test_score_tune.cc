@@ -0,0 +1,175 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "test_score.h"
+extern "C" {
+#include "coll_score/ucc_coll_score_tune.h"
+}
+
+static unsigned last_radix;
+
+/* init fn records the radix passed by the score/tuner and returns the team
+   pointer as a task */
+static ucc_status_t tune_init(ucc_base_coll_args_t *bargs,
+                              ucc_base_team_t *team, ucc_coll_task_t **task)
+{
+    last_radix = (bargs->mask & UCC_BASE_CARGS_RADIX) ? bargs->radix : 0;
+    *task      = (ucc_coll_task_t *)team;
+    return UCC_OK;
+}
+
+static ucc_status_t tune_alg_id_to_init(int, const char *, ucc_coll_type_t,
+                                        ucc_memory_type_t,
+                                        ucc_base_coll_init_fn_t *init)
+{
+    *init = tune_init;
+    return UCC_OK;
+}
+
+class test_score_tune : public test_score {
+public:
+    ucc_base_lib_t       lib;
+    ucc_base_context_t   ctx;
+    ucc_base_team_t      team;
+    ucc_base_coll_args_t bargs;
+    int                  n_agree;
+    test_score_tune()
+    {
+        memset(&lib, 0, sizeof(lib));
+        ucc_strncpy_safe(lib.log_component.name, "TL_TEST",
+                         sizeof(lib.log_component.name));
+        ctx.lib              = &lib;
+        ctx.ucc_context      = NULL;
+        team.context         = &ctx;
+        team.params.size     = 4;
+        n_agree              = 0;
+        last_radix           = 0;
+        memset(&bargs, 0, sizeof(bargs));
+        bargs.args.coll_type         = UCC_COLL_TYPE_ALLREDUCE;
+        bargs.args.src.info.mem_type = UCC_MEMORY_TYPE_HOST;
+        bargs.args.dst.info.mem_type = UCC_MEMORY_TYPE_HOST;
+        bargs.args.src.info.datatype = UCC_DT_INT8;
+        bargs.args.dst.info.datatype = UCC_DT_INT8;
+        bargs.args.src.info.count    = 1000;
+        bargs.args.dst.info.count    = 1000;
+    }
+    /* single rank team: local latencies are agreed ones */
+    static ucc_status_t agree(void *arg, double *, int)
+    {
+        ((test_score_tune *)arg)->n_agree++;
+        return UCC_OK;
+    }
+    void build(ucc_score_map_t **map)
+    {
+        ucc_coll_type_t   c = UCC_COLL_TYPE_ALLREDUCE;
+        ucc_memory_type_t m = UCC_MEMORY_TYPE_HOST;
+        ucc_coll_score_t *s1, *s2, *score;
+
+        /* candidates of 2 components are merged into single list */
+        ASSERT_EQ(UCC_OK, ucc_coll_score_alloc(&s1));
+        ASSERT_EQ(UCC_OK, ucc_coll_score_alloc(&s2));
+        EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(s1, c, m, 0, UCC_MSG_MAX, 10,
+                                                   tune_init, &team));
+        EXPECT_EQ(UCC_OK, ucc_coll_score_add_cand(s1, c, m, 0, 2, tune_init,
+                                                  &team));
+        EXPECT_EQ(UCC_OK, ucc_coll_score_add_cand(s2, c, m, 1, 4, tune_init,
+                                                  &team));
+        EXPECT_EQ(UCC_OK, ucc_coll_score_merge(s1, s2, &score, 1));
+        EXPECT_EQ(UCC_OK, ucc_coll_score_build_map(score, map));
+        EXPECT_EQ(2, ucc_list_length(ucc_coll_score_map_cands(*map, c, m)));
+    }
+};
+
+UCC_TEST_F(test_score_tune, radix_str)
+{
+    ucc_coll_score_t *score;
+    ucc_score_map_t  *map;
+    ucc_coll_task_t  *task;
+
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc(&score));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_add_range(
+                          score, UCC_COLL_TYPE_ALLREDUCE, UCC_MEMORY_TYPE_HOST,
+                          0, UCC_MSG_MAX, 10, tune_init, &team));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_update_from_str(
+                          "allreduce:host:0-4k:@0:radix=4", score, 4, NULL,
+                          &team, 10, tune_alg_id_to_init));
+    EXPECT_EQ(4, FIRST_RANGE(score, ALLREDUCE, HOST)->super.radix);
+    EXPECT_EQ(UCC_OK, ucc_coll_score_build_map(score, &map));
+
+    EXPECT_EQ(UCC_OK, ucc_coll_init(map, &bargs, &task));
+    EXPECT_EQ(4, last_radix);
+    EXPECT_EQ(0, bargs.mask & UCC_BASE_CARGS_RADIX);
+
+    bargs.args.src.info.count = bargs.args.dst.info.count = 8192;
+    EXPECT_EQ(UCC_OK, ucc_coll_init(map, &bargs, &task));
+    EXPECT_EQ(0, last_radix);
+    ucc_coll_score_free_map(map);
+
+    testing::internal::CaptureStdout();
+    EXPECT_NE(UCC_OK, ucc_coll_score_alloc_from_str("allreduce:radix=1", &score,
+                                                    4, NULL, NULL, NULL));
+    testing::internal::GetCapturedStdout();
+}
+
+UCC_TEST_F(test_score_tune, no_cands)
+{
+    ucc_coll_score_t *score;
+    ucc_score_map_t  *map;
+    ucc_coll_tuner_t *tuner;
+
+    EXPECT_EQ(UCC_OK, ucc_coll_score_alloc(&score));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_add_cand(score, UCC_COLL_TYPE_BCAST,
+                                              UCC_MEMORY_TYPE_HOST, 0, 2,
+                                              tune_init, &team));
+    EXPECT_EQ(UCC_OK, ucc_coll_score_build_map(score, &map));
+    EXPECT_EQ(UCC_ERR_NOT_FOUND,
+              ucc_coll_tuner_create(map, 1, agree, this, &tuner));
+    ucc_coll_score_free_map(map);
+}
+
+/* warm-up window rotates through the candidates, then the fastest one is
+   frozen and exported */
+UCC_TEST_F(test_score_tune, rotate_freeze)
+{
+    const uint32_t    n_iters = 2;
+    const double      lat[2]  = {2.0, 1.0};
+    ucc_score_map_t  *map;
+    ucc_coll_tuner_t *tuner;
+    ucc_coll_task_t  *task;
+    int               cand, i;
+    char              str[256];
+
+    build(&map);
+    ASSERT_EQ(UCC_OK, ucc_coll_tuner_create(map, n_iters, agree, this,
+                                            &tuner));
+    for (i = 0; i < 2 * n_iters; i++) {
+        EXPECT_EQ(UCC_OK, ucc_coll_tuner_coll_init(tuner, &bargs, &task,
+                                                   &cand));
+        EXPECT_EQ(i / n_iters, cand);
+        EXPECT_EQ(cand ? 4 : 2, last_radix);
+        ucc_coll_tuner_sample(tuner, &bargs, cand, lat[cand]);
+    }
+    EXPECT_EQ(0, ucc_coll_tuner_str(tuner, str, sizeof(str)));
+    EXPECT_EQ(0, n_agree);
+
+    for (i = 0; i < 3; i++) {
+        EXPECT_EQ(UCC_OK, ucc_coll_tuner_coll_init(tuner, &bargs, &task,
+                                                   &cand));
+        EXPECT_EQ(-1, cand);
+        EXPECT_EQ(4, last_radix);
+    }
+    EXPECT_EQ(1, n_agree);
+
+    /* other message size bucket is tuned independently */
+    bargs.args.src.info.count = bargs.args.dst.info.count = 0;
+    EXPECT_EQ(UCC_OK, ucc_coll_tuner_coll_init(tuner, &bargs, &task, &cand));
+    EXPECT_EQ(0, cand);
+
+    EXPECT_LT(0, ucc_coll_tuner_str(tuner, str, sizeof(str)));
+    EXPECT_EQ("UCC_TL_TEST_TUNE=allreduce:host:512-1024:[4]:@1:radix=4\n",
+              std::string(str));
+    ucc_coll_tuner_destroy(tuner);
+    ucc_coll_score_free_map(map);
+}
@@ -596,6 +596,14 @@ void UccCollArgs::set_inplace(gtest_ucc_inplace_t _inplace)
     inplace = _inplace;
 }
 
+void UccCollArgs::set_persistent(UccCollCtxVec &args)
+{
+    for (gtest_ucc_coll_ctx_t *ctx : args) {
+        ctx->args->mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+        ctx->args->flags |= UCC_COLL_ARGS_FLAG_PERSISTENT;
+    }
+}
+
 void clear_buffer(void *_buf, size_t size, ucc_memory_type_t mt, uint8_t value)
 {
     void *buf = _buf;
@@ -70,6 +70,7 @@ public:
     virtual bool data_validate(UccCollCtxVec args) = 0;
     void set_mem_type(ucc_memory_type_t _mt);
     void set_inplace(gtest_ucc_inplace_t _inplace);
+    void set_persistent(UccCollCtxVec &args);
 };
 
 class ThreadAllgather;
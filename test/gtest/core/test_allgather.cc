@@ -245,3 +245,35 @@ INSTANTIATE_TEST_CASE_P(
 #endif
         ::testing::Values(1,3,8192), // count
         ::testing::Values(TEST_INPLACE, TEST_NO_INPLACE)));  // inplace
+
+class test_allgather_alg : public test_allgather,
+        public ::testing::WithParamInterface<std::string> {};
+
+UCC_TEST_P(test_allgather_alg, alg)
+{
+    const std::string alg     = GetParam();
+    int               n_procs = 15;
+    ucc_job_env_t     env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                                 {"UCC_TL_UCP_TUNE", "allgather:@" + alg + ":inf"},
+                                 {"UCC_TL_UCP_ALLGATHER_KN_RADIX", "3"}};
+    UccJob            job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h         team    = job.create_team(n_procs);
+    UccCollCtxVec     ctxs;
+
+    set_mem_type(UCC_MEMORY_TYPE_HOST);
+    for (auto count : {1, 3, 8192}) {
+        for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+            set_inplace(inplace);
+            data_init(n_procs, UCC_DT_INT32, count, ctxs);
+            UccReq req(team, ctxs);
+            req.start();
+            req.wait();
+            EXPECT_EQ(true, data_validate(ctxs));
+            data_fini(ctxs);
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_allgather_alg,
+    ::testing::Values("knomial", "ring", "bruck"));
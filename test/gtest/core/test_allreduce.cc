@@ -161,6 +161,9 @@ TYPED_TEST_CASE(test_allreduce, ReductionTypesOps);
                 this->set_mem_type(_mem_type);                                 \
                 this->set_inplace(_inplace);                                   \
                 this->data_init(size, TypeParam::dt, count, ctxs);             \
+                if (_repeat > 1) {                                             \
+                    this->set_persistent(ctxs);                                \
+                }                                                              \
                 UccReq req(team, ctxs);                                        \
                 for (auto i = 0; i < _repeat; i++) {                           \
                     req.start();                                               \
@@ -283,6 +286,7 @@ TYPED_TEST(test_allreduce_alg, sra_knomial_pipelined) {
                 this->set_mem_type(m);
                 this->set_inplace(inplace);
                 this->data_init(n_procs, TypeParam::dt, count, ctxs);
+                this->set_persistent(ctxs);
                 UccReq req(team, ctxs);
 
                 for (auto i = 0; i < repeat; i++) {
@@ -297,6 +301,82 @@ TYPED_TEST(test_allreduce_alg, sra_knomial_pipelined) {
     }
 }
 
+TYPED_TEST(test_allreduce_alg, ring) {
+    int           n_procs = 15;
+    ucc_job_env_t env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "allreduce:@ring:inf"},
+                             {"UCC_TL_UCP_ALLREDUCE_RING_SEG_SIZE", "1024"}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h     team   = job.create_team(n_procs);
+    int           repeat = 3;
+    UccCollCtxVec ctxs;
+    std::vector<ucc_memory_type_t> mt = {UCC_MEMORY_TYPE_HOST};
+
+    if (UCC_OK == ucc_mc_available(UCC_MEMORY_TYPE_CUDA)) {
+        mt.push_back(UCC_MEMORY_TYPE_CUDA);
+    }
+
+    for (auto count : {7, 256, 65536, 123567}) {
+        for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+            for (auto m : mt) {
+                this->set_mem_type(m);
+                this->set_inplace(inplace);
+                this->data_init(n_procs, TypeParam::dt, count, ctxs);
+                this->set_persistent(ctxs);
+                UccReq req(team, ctxs);
+
+                for (auto i = 0; i < repeat; i++) {
+                    req.start();
+                    req.wait();
+                    EXPECT_EQ(true, this->data_validate(ctxs));
+                    this->reset(ctxs);
+                }
+                this->data_fini(ctxs);
+            }
+        }
+    }
+}
+
+TYPED_TEST(test_allreduce_alg, dbt) {
+    ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                         {"UCC_TL_UCP_TUNE", "allreduce:@dbt:inf"},
+                         {"UCC_TL_UCP_ALLREDUCE_DBT_FRAG_SIZE", "1024"},
+                         {"UCC_TL_UCP_ALLREDUCE_DBT_PIPELINE_DEPTH", "2"}};
+    int           repeat = 3;
+    UccCollCtxVec ctxs;
+    std::vector<ucc_memory_type_t> mt = {UCC_MEMORY_TYPE_HOST};
+
+    if (UCC_OK == ucc_mc_available(UCC_MEMORY_TYPE_CUDA)) {
+        mt.push_back(UCC_MEMORY_TYPE_CUDA);
+    }
+
+    /* second tree is shifted for odd and mirrored for even team size */
+    for (auto n_procs : {15, 16}) {
+        UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+        UccTeam_h team = job.create_team(n_procs);
+
+        for (auto count : {1, 7, 256, 65536}) {
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                for (auto m : mt) {
+                    this->set_mem_type(m);
+                    this->set_inplace(inplace);
+                    this->data_init(n_procs, TypeParam::dt, count, ctxs);
+                    this->set_persistent(ctxs);
+                    UccReq req(team, ctxs);
+
+                    for (auto i = 0; i < repeat; i++) {
+                        req.start();
+                        req.wait();
+                        EXPECT_EQ(true, this->data_validate(ctxs));
+                        this->reset(ctxs);
+                    }
+                    this->data_fini(ctxs);
+                }
+            }
+        }
+    }
+}
+
 template <typename T>
 class test_allreduce_avg_order : public test_allreduce<T> {
 };
@@ -340,3 +420,148 @@ TYPED_TEST(test_allreduce_avg_order, avg_post_op)
         }
     }
 }
+
+class test_allreduce_fusion : public ucc::test {
+};
+
+/* small allreduces are fused, buckets are fired on max number of requests,
+   op change, non fusable allreduce and ucc_team_flush */
+UCC_TEST_F(test_allreduce_fusion, small_msgs)
+{
+    const int                 n_procs = 4;
+    const int                 n_reqs  = 40;
+    ucc_job_env_t             env     = {{"UCC_FUSION_ALLREDUCE_THRESH", "256"},
+                                         {"UCC_FUSION_MAX_REQS", "16"}};
+    UccJob                    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h                 team = job.create_team(n_procs);
+    std::vector<std::vector<int32_t>> src(n_procs * n_reqs);
+    std::vector<std::vector<int32_t>> dst(n_procs * n_reqs);
+    std::vector<ucc_coll_req_h>       reqs(n_procs * n_reqs);
+    ucc_coll_args_t                   args;
+    bool                              done;
+    ucc_status_t                      st;
+
+    auto count = [](int i) { return (i % 13 == 12) ? 1024 : 1 + i % 16; };
+    auto op    = [](int i) { return (i % 3 == 2) ? UCC_OP_MAX : UCC_OP_SUM; };
+
+    for (int r = 0; r < n_procs; r++) {
+        for (int i = 0; i < n_reqs; i++) {
+            int k = r * n_reqs + i;
+            src[k].resize(count(i));
+            dst[k].resize(count(i));
+            for (int j = 0; j < count(i); j++) {
+                src[k][j] = r + i + j;
+            }
+            memset(&args, 0, sizeof(args));
+            args.coll_type         = UCC_COLL_TYPE_ALLREDUCE;
+            args.op                = op(i);
+            args.src.info.buffer   = src[k].data();
+            args.src.info.count    = count(i);
+            args.src.info.datatype = UCC_DT_INT32;
+            args.src.info.mem_type = UCC_MEMORY_TYPE_HOST;
+            args.dst.info.buffer   = dst[k].data();
+            args.dst.info.count    = count(i);
+            args.dst.info.datatype = UCC_DT_INT32;
+            args.dst.info.mem_type = UCC_MEMORY_TYPE_HOST;
+            ASSERT_EQ(UCC_OK, ucc_collective_init(&args, &reqs[k],
+                                                  team->procs[r].team));
+            ASSERT_EQ(UCC_OK, ucc_collective_post(reqs[k]));
+        }
+        ASSERT_EQ(UCC_OK, ucc_team_flush(team->procs[r].team));
+    }
+
+    do {
+        done = true;
+        for (auto &req : reqs) {
+            st = ucc_collective_test(req);
+            ASSERT_GE(st, UCC_OK);
+            if (st != UCC_OK) {
+                done = false;
+            }
+        }
+        team->progress();
+    } while (!done);
+
+    for (int r = 0; r < n_procs; r++) {
+        for (int i = 0; i < n_reqs; i++) {
+            int k = r * n_reqs + i;
+            for (int j = 0; j < count(i); j++) {
+                int32_t exp = (op(i) == UCC_OP_MAX)
+                                  ? n_procs - 1 + i + j
+                                  : n_procs * (i + j) +
+                                        n_procs * (n_procs - 1) / 2;
+                EXPECT_EQ(exp, dst[k][j]);
+            }
+            EXPECT_EQ(UCC_OK, ucc_collective_finalize(reqs[k]));
+        }
+    }
+}
+
+/* buckets are not fired by context progress: ranks progressing their
+   contexts a different number of times between the posts still fuse the
+   same requests */
+UCC_TEST_F(test_allreduce_fusion, uneven_progress)
+{
+    const int                         n_procs = 4;
+    const int                         n_reqs  = 24;
+    ucc_job_env_t                     env = {{"UCC_FUSION_ALLREDUCE_THRESH",
+                                              "256"},
+                                             {"UCC_FUSION_MAX_REQS", "64"}};
+    UccJob                            job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL,
+                                          env);
+    UccTeam_h                         team = job.create_team(n_procs);
+    std::vector<std::vector<int32_t>> dst(n_procs * n_reqs);
+    std::vector<ucc_coll_req_h>       reqs(n_procs * n_reqs);
+    ucc_coll_args_t                   args;
+    bool                              done;
+    ucc_status_t                      st;
+
+    for (int r = 0; r < n_procs; r++) {
+        for (int i = 0; i < n_reqs; i++) {
+            int k = r * n_reqs + i;
+            dst[k].assign(1 + i % 8, r + i);
+            memset(&args, 0, sizeof(args));
+            args.mask              = UCC_COLL_ARGS_FIELD_FLAGS;
+            args.flags             = UCC_COLL_ARGS_FLAG_IN_PLACE;
+            args.coll_type         = UCC_COLL_TYPE_ALLREDUCE;
+            args.op                = UCC_OP_SUM;
+            args.dst.info.buffer   = dst[k].data();
+            args.dst.info.count    = dst[k].size();
+            args.dst.info.datatype = UCC_DT_INT32;
+            args.dst.info.mem_type = UCC_MEMORY_TYPE_HOST;
+            ASSERT_EQ(UCC_OK, ucc_collective_init(&args, &reqs[k],
+                                                  team->procs[r].team));
+            ASSERT_EQ(UCC_OK, ucc_collective_post(reqs[k]));
+            for (int p = 0; p < (r * (i + 1)) % 5; p++) {
+                ucc_context_progress(team->procs[r].p->ctx_h);
+            }
+            /* request is held in the bucket until the flush */
+            EXPECT_EQ(UCC_INPROGRESS, ucc_collective_test(reqs[k]));
+        }
+    }
+    for (int r = 0; r < n_procs; r++) {
+        ASSERT_EQ(UCC_OK, ucc_team_flush(team->procs[r].team));
+    }
+
+    do {
+        done = true;
+        for (auto &req : reqs) {
+            st = ucc_collective_test(req);
+            ASSERT_GE(st, UCC_OK);
+            if (st != UCC_OK) {
+                done = false;
+            }
+        }
+        team->progress();
+    } while (!done);
+
+    for (int r = 0; r < n_procs; r++) {
+        for (int i = 0; i < n_reqs; i++) {
+            int k = r * n_reqs + i;
+            for (auto v : dst[k]) {
+                EXPECT_EQ(n_procs * i + n_procs * (n_procs - 1) / 2, v);
+            }
+            EXPECT_EQ(UCC_OK, ucc_collective_finalize(reqs[k]));
+        }
+    }
+}
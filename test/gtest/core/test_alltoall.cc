@@ -246,3 +246,32 @@ INSTANTIATE_TEST_CASE_P(
 #endif
         ::testing::Values(/*TEST_INPLACE,*/ TEST_NO_INPLACE), // inplace
         ::testing::Values(1,3,8192))); // count
+
+class test_alltoall_bruck : public test_alltoall,
+        public ::testing::WithParamInterface<std::string> {};
+
+UCC_TEST_P(test_alltoall_bruck, radix)
+{
+    const std::string radix   = GetParam();
+    int               n_procs = 15;
+    ucc_job_env_t     env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                                 {"UCC_TL_UCP_TUNE", "alltoall:@bruck:inf"},
+                                 {"UCC_TL_UCP_ALLTOALL_BRUCK_RADIX", radix}};
+    UccJob            job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h         team    = job.create_team(n_procs);
+    UccCollCtxVec     ctxs;
+
+    set_inplace(TEST_NO_INPLACE);
+    set_mem_type(UCC_MEMORY_TYPE_HOST);
+    for (auto count : {1, 3, 1024}) {
+        data_init(n_procs, UCC_DT_INT32, count, ctxs);
+        UccReq req(team, ctxs);
+        req.start();
+        req.wait();
+        EXPECT_EQ(true, data_validate(ctxs));
+        data_fini(ctxs);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(, test_alltoall_bruck,
+                        ::testing::Values("2", "3", "4", "16"));
@@ -5,6 +5,9 @@
 
 #include "common/test_ucc.h"
 #include "utils/ucc_math.h"
+extern "C" {
+#include "core/ucc_context.h"
+}
 
 using Param_0 = std::tuple<int, ucc_memory_type_t, gtest_ucc_inplace_t, ucc_datatype_t>;
 using Param_1 = std::tuple<ucc_memory_type_t, gtest_ucc_inplace_t, ucc_datatype_t>;
@@ -344,3 +347,84 @@ INSTANTIATE_TEST_CASE_P(
 #endif
             ::testing::Values(/*TEST_INPLACE,*/ TEST_NO_INPLACE), // inplace
             PREDEFINED_DTYPES)); // dtype
+
+class test_alltoallv_alg : public test_alltoallv<uint64_t>,
+        public ::testing::WithParamInterface<std::string> {};
+
+UCC_TEST_P(test_alltoallv_alg, persistent)
+{
+    const std::string alg     = GetParam();
+    int               n_procs = 15;
+    const int         n_calls = 2;
+    ucc_job_env_t     env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                                 {"UCC_TL_UCP_TUNE", "alltoallv:@" + alg + ":inf"}};
+    UccJob            job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccTeam_h         team    = job.create_team(n_procs);
+    UccCollCtxVec     ctxs;
+
+    coll_mask  = UCC_COLL_ARGS_FIELD_FLAGS;
+    coll_flags =
+        UCC_COLL_ARGS_FLAG_COUNT_64BIT | UCC_COLL_ARGS_FLAG_DISPLACEMENTS_64BIT;
+    set_inplace(TEST_NO_INPLACE);
+    set_mem_type(UCC_MEMORY_TYPE_HOST);
+    for (auto count : {1, 1024}) {
+        data_init(n_procs, UCC_DT_INT32, count, ctxs);
+        UccReq req(team, ctxs);
+        for (auto i = 0; i < n_calls; i++) {
+            req.start();
+            req.wait();
+            EXPECT_EQ(true, data_validate(ctxs));
+            reset(ctxs);
+        }
+        data_fini(ctxs);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(, test_alltoallv_alg,
+                        ::testing::Values("pairwise", "sparse", "node"));
+
+class test_alltoallv_node : public test_alltoallv<uint64_t>,
+        public ::testing::WithParamInterface<int> {};
+
+/* gtest processes share one host: host ids of the context topo are
+   rewritten before the team creation to spread the job over n_nodes
+   nodes (round robin), so the node alg runs the exchange between the
+   node leaders */
+UCC_TEST_P(test_alltoallv_node, fake_nodes)
+{
+    const ucc_rank_t n_nodes = GetParam();
+    int              n_procs = 15;
+    ucc_job_env_t    env     = {{"UCC_CL_BASIC_TUNE", "inf"},
+                                {"UCC_TL_UCP_TUNE", "alltoallv:@node:inf"}};
+    UccJob           job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+    UccCollCtxVec    ctxs;
+
+    for (auto &p : job.procs) {
+        ucc_context_topo_t *topo = ((ucc_context_t *)p->ctx_h)->topo;
+
+        ASSERT_NE(nullptr, topo);
+        for (ucc_rank_t r = 0; r < topo->n_procs; r++) {
+            topo->procs[r].host_id = r % n_nodes;
+        }
+        topo->nnodes  = n_nodes;
+        topo->min_ppn = topo->n_procs / n_nodes;
+        topo->max_ppn = ucc_div_round_up(topo->n_procs, n_nodes);
+    }
+    UccTeam_h team = job.create_team(n_procs);
+
+    coll_mask  = UCC_COLL_ARGS_FIELD_FLAGS;
+    coll_flags =
+        UCC_COLL_ARGS_FLAG_COUNT_64BIT | UCC_COLL_ARGS_FLAG_DISPLACEMENTS_64BIT;
+    set_inplace(TEST_NO_INPLACE);
+    set_mem_type(UCC_MEMORY_TYPE_HOST);
+    for (auto count : {1, 1024}) {
+        data_init(n_procs, UCC_DT_INT32, count, ctxs);
+        UccReq req(team, ctxs);
+        req.start();
+        req.wait();
+        EXPECT_EQ(true, data_validate(ctxs));
+        data_fini(ctxs);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(, test_alltoallv_node, ::testing::Values(2, 4, 15));
@@ -41,3 +41,30 @@ UCC_TEST_F(test_barrier, multiple)
     UccReq::startall(reqs);
     UccReq::waitall(reqs);
 }
+
+class test_barrier_alg : public test_barrier,
+                         public ::testing::WithParamInterface<std::string>
+{};
+
+UCC_TEST_P(test_barrier_alg, radix)
+{
+    std::string alg     = GetParam();
+    int         n_procs = 15;
+    for (auto radix : {"2", "3", "8"}) {
+        ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "barrier:@" + alg + ":inf"},
+                             {"UCC_TL_UCP_BARRIER_KN_RADIX", radix},
+                             {"UCC_TL_UCP_BARRIER_DISSEMINATION_RADIX", radix}};
+        UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+        std::vector<UccReq> reqs;
+        for (auto size : {n_procs, 6, 2}) {
+            reqs.push_back(UccReq(job.create_team(size), &coll));
+        }
+        UccReq::startall(reqs);
+        UccReq::waitall(reqs);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(, test_barrier_alg,
+                        ::testing::Values("knomial", "dissemination",
+                                          "hierarchical"));
@@ -223,3 +223,64 @@ INSTANTIATE_TEST_CASE_P(
 #endif
         ::testing::Values(1,3,65536), // count
         ::testing::Values(0,1))); // root
+
+class test_bcast_alg : public test_bcast
+{};
+
+UCC_TEST_F(test_bcast_alg, pipelined)
+{
+    int           n_procs = 15;
+    UccCollCtxVec ctxs;
+
+    /* chain, binary and ternary trees, message of 5 fragments (the last one
+       is not full) with depth 2 pipeline */
+    for (auto radix : {"1", "2", "3"}) {
+        ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "bcast:@pipelined:inf"},
+                             {"UCC_TL_UCP_BCAST_PIPELINE_RADIX", radix},
+                             {"UCC_TL_UCP_BCAST_PIPELINE_FRAG_SIZE", "1k"},
+                             {"UCC_TL_UCP_BCAST_PIPELINE_DEPTH", "2"}};
+        UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+        UccTeam_h     team = job.create_team(n_procs);
+
+        for (auto root : {0, 6, 14}) {
+            set_mem_type(UCC_MEMORY_TYPE_HOST);
+            set_root(root);
+            data_init(n_procs, UCC_DT_INT8, 4099, ctxs);
+            UccReq req(team, ctxs);
+            req.start();
+            req.wait();
+            EXPECT_EQ(true, data_validate(ctxs));
+            data_fini(ctxs);
+        }
+    }
+}
+
+UCC_TEST_F(test_bcast_alg, dbt)
+{
+    ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                         {"UCC_TL_UCP_TUNE", "bcast:@dbt:inf"},
+                         {"UCC_TL_UCP_BCAST_DBT_FRAG_SIZE", "1k"},
+                         {"UCC_TL_UCP_BCAST_DBT_PIPELINE_DEPTH", "2"}};
+    UccCollCtxVec ctxs;
+
+    /* trees over 14 and 15 non root ranks, messages of 1 element (empty
+       second half) and of 5 fragments */
+    for (auto n_procs : {15, 16}) {
+        UccJob    job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+        UccTeam_h team = job.create_team(n_procs);
+
+        for (auto count : {1, 4099}) {
+            for (auto root : {0, 6, 14}) {
+                set_mem_type(UCC_MEMORY_TYPE_HOST);
+                set_root(root);
+                data_init(n_procs, UCC_DT_INT8, count, ctxs);
+                UccReq req(team, ctxs);
+                req.start();
+                req.wait();
+                EXPECT_EQ(true, data_validate(ctxs));
+                data_fini(ctxs);
+            }
+        }
+    }
+}
@@ -4,6 +4,9 @@
  */
 #include "test_context.h"
 #include "../common/test_ucc.h"
+extern "C" {
+#include "utils/ucc_time.h"
+}
 #include <vector>
 #include <algorithm>
 #include <random>
@@ -90,3 +93,32 @@ UCC_TEST_F(test_context, global)
     job16.cleanup();
 
 }
+
+UCC_TEST_F(test_context_get_attr, wait_timeout)
+{
+    double t;
+
+    /* nothing is posted on the context, wait has to return on timeout */
+    t = ucc_get_time();
+    EXPECT_EQ(UCC_INPROGRESS, ucc_context_wait(ctx_h, 0.01));
+    EXPECT_GE(ucc_get_time() - t, 0.01);
+    EXPECT_EQ(UCC_INPROGRESS, ucc_context_wait(ctx_h, 0));
+}
+
+UCC_TEST_F(test_context, progress_thread)
+{
+    ucc_context_params_t ctx_params;
+    ucc_context_h        ctx_h;
+
+    ctx_params.mask = UCC_CONTEXT_PARAM_FIELD_TYPE;
+    ctx_params.type = UCC_CONTEXT_EXCLUSIVE;
+    EXPECT_EQ(UCC_OK, ucc_context_config_modify(ctx_config, NULL,
+                                                "PROGRESS_THREAD", "y"));
+    EXPECT_EQ(UCC_OK, ucc_context_create(lib_h, &ctx_params, ctx_config,
+                                         &ctx_h));
+    /* context is driven by the progress thread: progress and wait return
+       immediately */
+    EXPECT_EQ(UCC_OK, ucc_context_progress(ctx_h));
+    EXPECT_EQ(UCC_OK, ucc_context_wait(ctx_h, -1));
+    EXPECT_EQ(UCC_OK, ucc_context_destroy(ctx_h));
+}
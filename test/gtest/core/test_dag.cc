@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include <common/test.h>
+extern "C" {
+#include "schedule/ucc_dag.h"
+}
+#include <vector>
+
+typedef struct test_dag_task {
+    ucc_coll_task_t   super;
+    int               id;
+    int               sync; /* complete from post */
+    std::vector<int> *posted;
+} test_dag_task_t;
+
+class test_dag : public ucc::test {
+public:
+    ucc_dag_t                    dag;
+    std::vector<test_dag_task_t> tasks;
+    std::vector<int>             posted;
+    test_dag()
+    {
+        EXPECT_EQ(UCC_OK, ucc_dag_init(&dag, NULL, NULL));
+    }
+    ~test_dag()
+    {
+        ucc_dag_cleanup(&dag);
+    }
+    static ucc_status_t post(ucc_coll_task_t *task)
+    {
+        test_dag_task_t *t = ucc_derived_of(task, test_dag_task_t);
+
+        t->posted->push_back(t->id);
+        task->super.status = UCC_INPROGRESS;
+        if (t->sync) {
+            task->super.status = UCC_OK;
+            ucc_task_complete(task);
+        }
+        return UCC_OK;
+    }
+    void init_tasks(int n, int sync)
+    {
+        tasks.resize(n);
+        for (int i = 0; i < n; i++) {
+            EXPECT_EQ(UCC_OK, ucc_coll_task_init(&tasks[i].super, NULL, NULL));
+            tasks[i].super.post = post;
+            tasks[i].id         = i;
+            tasks[i].sync       = sync;
+            tasks[i].posted     = &posted;
+            EXPECT_EQ(UCC_OK, ucc_dag_add_node(&dag, &tasks[i].super, NULL));
+        }
+    }
+    void complete(int i)
+    {
+        ASSERT_EQ(UCC_INPROGRESS, tasks[i].super.super.status);
+        tasks[i].super.super.status = UCC_OK;
+        ucc_task_complete(&tasks[i].super);
+    }
+};
+
+/* node with several deps is started when the last one is completed */
+UCC_TEST_F(test_dag, fan_in_fan_out)
+{
+    init_tasks(4, 0);
+    EXPECT_EQ(UCC_OK, ucc_dag_add_edge(&dag, 0, 1, UCC_DAG_DEP_COMPLETED));
+    EXPECT_EQ(UCC_OK, ucc_dag_add_edge(&dag, 0, 2, UCC_DAG_DEP_COMPLETED));
+    EXPECT_EQ(UCC_OK, ucc_dag_add_edge(&dag, 1, 3, UCC_DAG_DEP_COMPLETED));
+    EXPECT_EQ(UCC_OK, ucc_dag_add_edge(&dag, 2, 3, UCC_DAG_DEP_COMPLETED));
+
+    EXPECT_EQ(UCC_OK, ucc_dag_start(&dag));
+    EXPECT_EQ(std::vector<int>({0}), posted);
+    complete(0);
+    EXPECT_EQ(3, posted.size());
+    complete(2);
+    EXPECT_EQ(3, posted.size());
+    complete(1);
+    EXPECT_EQ(std::vector<int>({0, 2, 1, 3}), posted);
+    EXPECT_EQ(UCC_INPROGRESS, dag.super.super.status);
+    complete(3);
+    EXPECT_EQ(UCC_OK, dag.super.super.status);
+}
+
+/* node is started together with its STARTED dependency */
+UCC_TEST_F(test_dag, started_dep)
+{
+    init_tasks(3, 0);
+    EXPECT_EQ(UCC_OK, ucc_dag_add_edge(&dag, 0, 1, UCC_DAG_DEP_STARTED));
+    EXPECT_EQ(UCC_OK, ucc_dag_add_edge(&dag, 1, 2, UCC_DAG_DEP_COMPLETED));
+
+    EXPECT_EQ(UCC_OK, ucc_dag_start(&dag));
+    EXPECT_EQ(std::vector<int>({0, 1}), posted);
+    complete(1);
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), posted);
+    complete(2);
+    EXPECT_EQ(UCC_INPROGRESS, dag.super.super.status);
+    complete(0);
+    EXPECT_EQ(UCC_OK, dag.super.super.status);
+}
+
+/* long chain of tasks completing from post: graph exceeds the inline
+   storage and is executed without recursion into the next post */
+UCC_TEST_F(test_dag, sync_chain)
+{
+    const int n_tasks = 10000;
+
+    init_tasks(n_tasks, 1);
+    for (int i = 1; i < n_tasks; i++) {
+        EXPECT_EQ(UCC_OK, ucc_dag_add_edge(&dag, i - 1, i,
+                                           UCC_DAG_DEP_COMPLETED));
+    }
+    EXPECT_EQ(UCC_OK, ucc_dag_start(&dag));
+    EXPECT_EQ(UCC_OK, dag.super.super.status);
+    ASSERT_EQ(n_tasks, posted.size());
+    for (int i = 0; i < n_tasks; i++) {
+        EXPECT_EQ(i, posted[i]);
+    }
+}
+
+/* completed DAG can be started again */
+UCC_TEST_F(test_dag, restart)
+{
+    init_tasks(2, 0);
+    EXPECT_EQ(UCC_OK, ucc_dag_add_edge(&dag, 0, 1, UCC_DAG_DEP_COMPLETED));
+    for (int i = 0; i < 3; i++) {
+        posted.clear();
+        EXPECT_EQ(UCC_OK, ucc_dag_start(&dag));
+        complete(0);
+        complete(1);
+        EXPECT_EQ(std::vector<int>({0, 1}), posted);
+        EXPECT_EQ(UCC_OK, dag.super.super.status);
+    }
+}
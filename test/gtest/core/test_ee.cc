@@ -0,0 +1,309 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+extern "C" {
+#include "core/ucc_ee.h"
+#include "core/ucc_mc.h"
+#include "utils/ucc_time.h"
+}
+#include <thread>
+
+class test_ee : public ucc::test {
+public:
+    ucc_ee_h ee;
+    test_ee()
+    {
+        ucc_ee_params_t params;
+
+        params.ee_type         = UCC_EE_CPU_THREAD;
+        params.ee_context      = NULL;
+        params.ee_context_size = 0;
+        EXPECT_EQ(UCC_OK,
+                  ucc_ee_create(UccJob::getStaticTeams()[0]->procs[0].team,
+                                &params, &ee));
+    }
+    ~test_ee()
+    {
+        EXPECT_EQ(UCC_OK, ucc_ee_destroy(ee));
+    }
+    void set_event(uint64_t id)
+    {
+        ucc_ev_t ev;
+
+        ev.ev_type         = UCC_EVENT_COMPUTE_COMPLETE;
+        ev.ev_context_size = 0;
+        ev.ev_context      = NULL;
+        ev.req             = (ucc_coll_req_h)id;
+        EXPECT_EQ(UCC_OK, ucc_ee_set_event(ee, &ev));
+    }
+};
+
+UCC_TEST_F(test_ee, events_order)
+{
+    const int n_events = 3 * UCC_EE_QUEUE_SIZE; /* exceeds the ring */
+    ucc_ev_t *ev;
+
+    for (int i = 0; i < n_events; i++) {
+        set_event(i + 1);
+    }
+    for (int i = 0; i < n_events; i++) {
+        ASSERT_EQ(UCC_OK,
+                  ucc_ee_get_event_internal(ee, &ev, &ee->event_in_queue));
+        EXPECT_EQ(UCC_EVENT_COMPUTE_COMPLETE, ev->ev_type);
+        EXPECT_EQ((ucc_coll_req_h)(uint64_t)(i + 1), ev->req);
+        EXPECT_EQ(UCC_OK, ucc_ee_ack_event(ee, ev));
+    }
+    EXPECT_EQ(UCC_ERR_NOT_FOUND,
+              ucc_ee_get_event_internal(ee, &ev, &ee->event_in_queue));
+    /* not consumed events are released by ee destroy */
+    set_event(1);
+    set_event(2);
+}
+
+/* events set by application thread are consumed by progress thread */
+UCC_TEST_F(test_ee, events_mt)
+{
+    const int              n_events = 100000;
+    std::vector<ucc_ev_t*> evs;
+    ucc_ev_t              *ev;
+
+    std::thread consumer([&]() {
+        while (evs.size() < n_events) {
+            if (UCC_OK ==
+                ucc_ee_get_event_internal(ee, &ev, &ee->event_in_queue)) {
+                evs.push_back(ev);
+            }
+        }
+    });
+    for (int i = 0; i < n_events; i++) {
+        set_event(i + 1);
+    }
+    consumer.join();
+    for (int i = 0; i < n_events; i++) {
+        EXPECT_EQ((ucc_coll_req_h)(uint64_t)(i + 1), evs[i]->req);
+        EXPECT_EQ(UCC_OK, ucc_ee_ack_event(ee, evs[i]));
+    }
+}
+
+/* Measures the cost of event round trip done per triggered collective:
+   set by application, consumed by ev task, acked on ev task finalize */
+UCC_TEST_F(test_ee, event_tput)
+{
+    const int n_iters = 1000000;
+    const int depth   = 16;
+    ucc_ev_t *ev;
+    double    t;
+
+    t = ucc_get_time();
+    for (int i = 0; i < n_iters; i += depth) {
+        for (int j = 0; j < depth; j++) {
+            set_event(j + 1);
+        }
+        for (int j = 0; j < depth; j++) {
+            ASSERT_EQ(UCC_OK, ucc_ee_get_event_internal(ee, &ev,
+                                                        &ee->event_in_queue));
+            ucc_ee_ack_event(ee, ev);
+        }
+    }
+    t = ucc_get_time() - t;
+    UCC_TEST_MESSAGE << t * 1e9 / n_iters << " ns per event, "
+                     << n_iters / t / 1e6 << " Mevents/s";
+}
+
+/* Triggered allreduce on cpu thread ee: compute completion events are set
+   concurrently by several compute threads per rank, collectives are posted
+   and completed in triggered post order */
+class test_ee_triggered : public ucc::test {
+public:
+    static const int n_threads = 4;
+    static const int n_colls   = 64;
+    static const int count     = 256;
+    UccTeam_h                         team;
+    std::vector<ucc_ee_h>             ees;
+    std::vector<ucc_coll_req_h>       reqs;
+    std::vector<std::vector<int32_t>> src;
+    std::vector<std::vector<int32_t>> dst;
+    test_ee_triggered()
+    {
+        ucc_ee_params_t params;
+
+        team = UccJob::getStaticTeams()[0];
+        ees.resize(team->n_procs);
+        params.ee_type         = UCC_EE_CPU_THREAD;
+        params.ee_context      = NULL;
+        params.ee_context_size = 0;
+        for (int r = 0; r < team->n_procs; r++) {
+            EXPECT_EQ(UCC_OK, ucc_ee_create(team->procs[r].team, &params,
+                                            &ees[r]));
+        }
+    }
+    ~test_ee_triggered()
+    {
+        for (auto &ee : ees) {
+            EXPECT_EQ(UCC_OK, ucc_ee_destroy(ee));
+        }
+    }
+    int req_idx(int r, int i)
+    {
+        return r * n_colls + i;
+    }
+    void coll_init()
+    {
+        ucc_coll_args_t args;
+
+        reqs.resize(team->n_procs * n_colls);
+        src.resize(team->n_procs * n_colls);
+        dst.resize(team->n_procs * n_colls);
+        for (int r = 0; r < team->n_procs; r++) {
+            for (int i = 0; i < n_colls; i++) {
+                int k = req_idx(r, i);
+                src[k].assign(count, r + i);
+                dst[k].assign(count, -1);
+                memset(&args, 0, sizeof(args));
+                args.coll_type         = UCC_COLL_TYPE_ALLREDUCE;
+                args.op                = UCC_OP_SUM;
+                args.src.info.buffer   = src[k].data();
+                args.src.info.count    = count;
+                args.src.info.datatype = UCC_DT_INT32;
+                args.src.info.mem_type = UCC_MEMORY_TYPE_HOST;
+                args.dst.info.buffer   = dst[k].data();
+                args.dst.info.count    = count;
+                args.dst.info.datatype = UCC_DT_INT32;
+                args.dst.info.mem_type = UCC_MEMORY_TYPE_HOST;
+                ASSERT_EQ(UCC_OK, ucc_collective_init(&args, &reqs[k],
+                                                      team->procs[r].team));
+            }
+        }
+    }
+};
+
+UCC_TEST_F(test_ee_triggered, allreduce_mt_producers)
+{
+    std::vector<std::thread> producers;
+    std::vector<int>         n_posted(team->n_procs, 0);
+    std::vector<int>         n_completed(team->n_procs, 0);
+    ucc_ev_t                 ev;
+    ucc_ev_t                *out_ev;
+    int                      done;
+
+    coll_init();
+    for (int r = 0; r < team->n_procs; r++) {
+        for (int i = 0; i < n_colls; i++) {
+            ev.ev_type         = UCC_EVENT_COMPUTE_COMPLETE;
+            ev.ev_context_size = 0;
+            ev.ev_context      = NULL;
+            ev.req             = reqs[req_idx(r, i)];
+            ASSERT_EQ(UCC_OK, ucc_collective_triggered_post(ees[r], &ev));
+        }
+    }
+
+    /* compute threads of every rank signal completion in arbitrary order */
+    for (int r = 0; r < team->n_procs; r++) {
+        for (int t = 0; t < n_threads; t++) {
+            producers.emplace_back([this, r]() {
+                ucc_ev_t compute_ev;
+
+                for (int i = 0; i < n_colls / n_threads; i++) {
+                    compute_ev.ev_type         = UCC_EVENT_COMPUTE_COMPLETE;
+                    compute_ev.ev_context_size = 0;
+                    compute_ev.ev_context      = NULL;
+                    compute_ev.req             = NULL;
+                    EXPECT_EQ(UCC_OK, ucc_ee_set_event(ees[r], &compute_ev));
+                }
+            });
+        }
+    }
+
+    do {
+        team->progress();
+        done = 1;
+        for (int r = 0; r < team->n_procs; r++) {
+            while (UCC_OK == ucc_ee_get_event(ees[r], &out_ev)) {
+                if (out_ev->ev_type == UCC_EVENT_COLLECTIVE_POST) {
+                    EXPECT_EQ(reqs[req_idx(r, n_posted[r])], out_ev->req);
+                    n_posted[r]++;
+                } else {
+                    EXPECT_EQ(UCC_EVENT_COLLECTIVE_COMPLETE, out_ev->ev_type);
+                    EXPECT_EQ(reqs[req_idx(r, n_completed[r])], out_ev->req);
+                    n_completed[r]++;
+                    /* collective is completed before the next one is posted */
+                    EXPECT_EQ(n_posted[r], n_completed[r]);
+                }
+                EXPECT_EQ(UCC_OK, ucc_ee_ack_event(ees[r], out_ev));
+            }
+            if (n_completed[r] < n_colls) {
+                done = 0;
+            }
+        }
+    } while (!done);
+
+    for (auto &p : producers) {
+        p.join();
+    }
+    for (int r = 0; r < team->n_procs; r++) {
+        for (int i = 0; i < n_colls; i++) {
+            int k = req_idx(r, i);
+            EXPECT_EQ(UCC_OK, ucc_collective_test(reqs[k]));
+            EXPECT_EQ(team->n_procs * i + team->n_procs * (team->n_procs - 1) / 2,
+                      dst[k][0]);
+            EXPECT_EQ(dst[k][0], dst[k][count - 1]);
+            EXPECT_EQ(UCC_OK, ucc_collective_finalize(reqs[k]));
+        }
+    }
+}
+
+/* event posted on cpu stream completes when all the tasks posted before it
+   are ended, tasks are started in order */
+UCC_TEST_F(test_ee, cpu_stream_order)
+{
+    void *ee_task[2];
+    void *event;
+
+    ASSERT_EQ(UCC_OK, ucc_mc_ee_create_event(&event, UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_event_test(event, UCC_EE_CPU_THREAD));
+    ASSERT_EQ(UCC_OK, ucc_mc_ee_task_post(ee->ee_context, UCC_EE_CPU_THREAD,
+                                          &ee_task[0]));
+    ASSERT_EQ(UCC_OK, ucc_mc_ee_task_post(ee->ee_context, UCC_EE_CPU_THREAD,
+                                          &ee_task[1]));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_event_post(ee->ee_context, event,
+                                           UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_task_query(ee_task[0], UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_INPROGRESS,
+              ucc_mc_ee_task_query(ee_task[1], UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_INPROGRESS, ucc_mc_ee_event_test(event, UCC_EE_CPU_THREAD));
+
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_task_end(ee_task[0], UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_task_query(ee_task[1], UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_INPROGRESS, ucc_mc_ee_event_test(event, UCC_EE_CPU_THREAD));
+
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_task_end(ee_task[1], UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_event_test(event, UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_destroy_event(event, UCC_EE_CPU_THREAD));
+}
+
+/* every cpu ee owns its stream: tasks posted on other ee don't block it */
+UCC_TEST_F(test_ee, cpu_stream_per_ee)
+{
+    ucc_ee_params_t params;
+    ucc_ee_h        ee2;
+    void           *ee_task[2];
+
+    params.ee_type         = UCC_EE_CPU_THREAD;
+    params.ee_context      = ee->ee_context;
+    params.ee_context_size = 0;
+    ASSERT_EQ(UCC_OK,
+              ucc_ee_create(UccJob::getStaticTeams()[0]->procs[0].team,
+                            &params, &ee2));
+    EXPECT_NE(ee->ee_context, ee2->ee_context);
+    ASSERT_EQ(UCC_OK, ucc_mc_ee_task_post(ee->ee_context, UCC_EE_CPU_THREAD,
+                                          &ee_task[0]));
+    ASSERT_EQ(UCC_OK, ucc_mc_ee_task_post(ee2->ee_context, UCC_EE_CPU_THREAD,
+                                          &ee_task[1]));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_task_query(ee_task[1], UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_task_end(ee_task[1], UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_OK, ucc_mc_ee_task_end(ee_task[0], UCC_EE_CPU_THREAD));
+    EXPECT_EQ(UCC_OK, ucc_ee_destroy(ee2));
+}
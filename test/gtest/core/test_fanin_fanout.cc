@@ -0,0 +1,70 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+
+class test_fanin_fanout : public ucc::test,
+                          public ::testing::WithParamInterface<ucc_coll_type_t>
+{
+public:
+    ucc_coll_args_t coll;
+    test_fanin_fanout() {
+        coll.mask      = 0;
+        coll.coll_type = GetParam();
+    }
+    void run(UccTeam_h team, ucc_rank_t root)
+    {
+        coll.root = root;
+        UccReq req(team, &coll);
+        req.start();
+        req.wait();
+    }
+};
+
+UCC_TEST_P(test_fanin_fanout, single_2proc)
+{
+    UccTeam_h team = UccJob::getStaticJob()->create_team(2);
+    for (ucc_rank_t root : {0, 1}) {
+        run(team, root);
+    }
+}
+
+UCC_TEST_P(test_fanin_fanout, single_max_procs)
+{
+    UccTeam_h  team = UccJob::getStaticTeams().back();
+    ucc_rank_t size = team->procs.size();
+    for (ucc_rank_t root : {(ucc_rank_t)0, size / 2, size - 1}) {
+        run(team, root);
+    }
+}
+
+UCC_TEST_P(test_fanin_fanout, multiple)
+{
+    std::vector<UccReq> reqs;
+    coll.root = 0;
+    for (auto &team : UccJob::getStaticTeams()) {
+        reqs.push_back(UccReq(team, &coll));
+    }
+    UccReq::startall(reqs);
+    UccReq::waitall(reqs);
+}
+
+UCC_TEST_P(test_fanin_fanout, radix)
+{
+    int n_procs = 15;
+    for (auto radix : {"2", "3", "8"}) {
+        ucc_job_env_t env = {{"UCC_TL_UCP_FANIN_KN_RADIX", radix},
+                             {"UCC_TL_UCP_FANOUT_KN_RADIX", radix}};
+        UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+        UccTeam_h     team = job.create_team(n_procs);
+        for (ucc_rank_t root : {0, 6, 14}) {
+            run(team, root);
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(, test_fanin_fanout,
+                        ::testing::Values(UCC_COLL_TYPE_FANIN,
+                                          UCC_COLL_TYPE_FANOUT));
@@ -0,0 +1,434 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "common/test_ucc.h"
+#include "utils/ucc_math.h"
+
+using Param_0 = std::tuple<ucc_coll_type_t, int, ucc_memory_type_t, int, int,
+                           gtest_ucc_inplace_t>;
+/* coll type, alg name ("" - default), radix */
+using Param_alg = std::tuple<ucc_coll_type_t, std::string, std::string>;
+
+/* Gather/scatter of count elements per rank, or gatherv/scatterv with
+   (r % 3) * count elements of rank r placed at the root in reversed rank
+   order */
+class test_gather_scatter : public UccCollArgs, public ucc::test
+{
+public:
+    ucc_coll_type_t coll_type;
+    int             root;
+    size_t          count;
+
+    bool is_v()
+    {
+        return coll_type == UCC_COLL_TYPE_GATHERV ||
+               coll_type == UCC_COLL_TYPE_SCATTERV;
+    }
+    bool is_gather()
+    {
+        return coll_type == UCC_COLL_TYPE_GATHER ||
+               coll_type == UCC_COLL_TYPE_GATHERV;
+    }
+    size_t block_count(int r)
+    {
+        return is_v() ? (r % 3) * count : count;
+    }
+    size_t block_displ(int nprocs, int r)
+    {
+        size_t displ = 0;
+        if (!is_v()) {
+            return r * count;
+        }
+        for (int i = nprocs - 1; i > r; i--) {
+            displ += block_count(i);
+        }
+        return displ;
+    }
+    size_t total_count(int nprocs)
+    {
+        size_t total = 0;
+        for (int i = 0; i < nprocs; i++) {
+            total += block_count(i);
+        }
+        return total;
+    }
+    /* counts and displacements of the v collectives at the root */
+    void root_info_v(int nprocs, ucc_coll_buffer_info_v_t *info_v)
+    {
+        uint32_t *counts = (uint32_t*)malloc(sizeof(uint32_t) * nprocs);
+        uint32_t *displs = (uint32_t*)malloc(sizeof(uint32_t) * nprocs);
+
+        for (int i = 0; i < nprocs; i++) {
+            counts[i] = block_count(i);
+            displs[i] = block_displ(nprocs, i);
+        }
+        info_v->counts        = (ucc_count_t*)counts;
+        info_v->displacements = (ucc_aint_t*)displs;
+    }
+    void gather_data_init(int nprocs, ucc_datatype_t dtype,
+                          UccCollCtxVec &ctxs)
+    {
+        size_t dt_size = ucc_dt_size(dtype);
+        size_t total   = total_count(nprocs);
+
+        for (auto r = 0; r < nprocs; r++) {
+            ucc_coll_args_t *coll     = ctxs[r]->args;
+            size_t           my_count = block_count(r);
+            void            *sbuf;
+
+            coll->src.info.mem_type = mem_type;
+            coll->src.info.count    = (ucc_count_t)my_count;
+            coll->src.info.datatype = dtype;
+
+            ctxs[r]->init_buf = ucc_malloc(ucc_max(my_count * dt_size, 1),
+                                           "init buf");
+            EXPECT_NE(ctxs[r]->init_buf, nullptr);
+            for (int i = 0; i < my_count * dt_size; i++) {
+                ((uint8_t*)ctxs[r]->init_buf)[i] = (uint8_t)(r * 7 + i);
+            }
+            if (r == root) {
+                ctxs[r]->rbuf_size = total * dt_size;
+                UCC_CHECK(ucc_mc_alloc(&ctxs[r]->dst_mc_header,
+                                       ucc_max(ctxs[r]->rbuf_size, 1),
+                                       mem_type));
+                if (is_v()) {
+                    root_info_v(nprocs, &coll->dst.info_v);
+                    coll->dst.info_v.mem_type = mem_type;
+                    coll->dst.info_v.datatype = dtype;
+                    coll->dst.info_v.buffer   = ctxs[r]->dst_mc_header->addr;
+                } else {
+                    coll->dst.info.mem_type = mem_type;
+                    coll->dst.info.datatype = dtype;
+                    coll->dst.info.count    = (ucc_count_t)total;
+                    coll->dst.info.buffer   = ctxs[r]->dst_mc_header->addr;
+                }
+                if (TEST_INPLACE == inplace) {
+                    coll->mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+                    coll->flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+                }
+            }
+            if (r == root && TEST_INPLACE == inplace) {
+                sbuf = PTR_OFFSET(ctxs[r]->dst_mc_header->addr,
+                                  block_displ(nprocs, r) * dt_size);
+            } else {
+                UCC_CHECK(ucc_mc_alloc(&ctxs[r]->src_mc_header,
+                                       ucc_max(my_count * dt_size, 1),
+                                       mem_type));
+                sbuf = coll->src.info.buffer = ctxs[r]->src_mc_header->addr;
+            }
+            UCC_CHECK(ucc_mc_memcpy(sbuf, ctxs[r]->init_buf, my_count * dt_size,
+                                    mem_type, UCC_MEMORY_TYPE_HOST));
+        }
+    }
+    void scatter_data_init(int nprocs, ucc_datatype_t dtype,
+                           UccCollCtxVec &ctxs)
+    {
+        size_t dt_size = ucc_dt_size(dtype);
+        size_t total   = total_count(nprocs);
+
+        for (auto r = 0; r < nprocs; r++) {
+            ucc_coll_args_t *coll     = ctxs[r]->args;
+            size_t           my_count = block_count(r);
+
+            coll->dst.info.mem_type = mem_type;
+            coll->dst.info.count    = (ucc_count_t)my_count;
+            coll->dst.info.datatype = dtype;
+            ctxs[r]->rbuf_size      = my_count * dt_size;
+
+            if (r == root) {
+                ctxs[r]->init_buf = ucc_malloc(ucc_max(total * dt_size, 1),
+                                               "init buf");
+                EXPECT_NE(ctxs[r]->init_buf, nullptr);
+                for (int i = 0; i < nprocs; i++) {
+                    uint8_t *block = (uint8_t*)ctxs[r]->init_buf +
+                                     block_displ(nprocs, i) * dt_size;
+                    for (int j = 0; j < block_count(i) * dt_size; j++) {
+                        block[j] = (uint8_t)(i * 7 + j);
+                    }
+                }
+                UCC_CHECK(ucc_mc_alloc(&ctxs[r]->src_mc_header,
+                                       ucc_max(total * dt_size, 1), mem_type));
+                UCC_CHECK(ucc_mc_memcpy(ctxs[r]->src_mc_header->addr,
+                                        ctxs[r]->init_buf, total * dt_size,
+                                        mem_type, UCC_MEMORY_TYPE_HOST));
+                if (is_v()) {
+                    root_info_v(nprocs, &coll->src.info_v);
+                    coll->src.info_v.mem_type = mem_type;
+                    coll->src.info_v.datatype = dtype;
+                    coll->src.info_v.buffer   = ctxs[r]->src_mc_header->addr;
+                } else {
+                    coll->src.info.mem_type = mem_type;
+                    coll->src.info.datatype = dtype;
+                    coll->src.info.count    = (ucc_count_t)total;
+                    coll->src.info.buffer   = ctxs[r]->src_mc_header->addr;
+                }
+                if (TEST_INPLACE == inplace) {
+                    coll->mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+                    coll->flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+                    continue;
+                }
+            }
+            UCC_CHECK(ucc_mc_alloc(&ctxs[r]->dst_mc_header,
+                                   ucc_max(ctxs[r]->rbuf_size, 1), mem_type));
+            coll->dst.info.buffer = ctxs[r]->dst_mc_header->addr;
+        }
+    }
+    void data_init(int nprocs, ucc_datatype_t dtype, size_t count,
+                   UccCollCtxVec &ctxs)
+    {
+        this->count = count;
+        ctxs.resize(nprocs);
+        for (auto r = 0; r < nprocs; r++) {
+            ucc_coll_args_t *coll = (ucc_coll_args_t*)
+                    calloc(1, sizeof(ucc_coll_args_t));
+
+            ctxs[r] = (gtest_ucc_coll_ctx_t*)calloc(1, sizeof(gtest_ucc_coll_ctx_t));
+            ctxs[r]->args   = coll;
+            coll->mask      = 0;
+            coll->coll_type = coll_type;
+            coll->root      = root;
+        }
+        if (is_gather()) {
+            gather_data_init(nprocs, dtype, ctxs);
+        } else {
+            scatter_data_init(nprocs, dtype, ctxs);
+        }
+    }
+    void reset(UccCollCtxVec ctxs)
+    {
+        int    nprocs = ctxs.size();
+        size_t dt_size;
+
+        if (!is_gather()) {
+            for (auto r = 0; r < nprocs; r++) {
+                if (ctxs[r]->dst_mc_header) {
+                    clear_buffer(ctxs[r]->dst_mc_header->addr,
+                                 ctxs[r]->rbuf_size, mem_type, 0);
+                }
+            }
+            return;
+        }
+        dt_size = ucc_dt_size(ctxs[0]->args->src.info.datatype);
+        clear_buffer(ctxs[root]->dst_mc_header->addr, ctxs[root]->rbuf_size,
+                     mem_type, 0);
+        if (TEST_INPLACE == inplace) {
+            UCC_CHECK(ucc_mc_memcpy(PTR_OFFSET(ctxs[root]->dst_mc_header->addr,
+                                               block_displ(nprocs, root) *
+                                               dt_size),
+                                    ctxs[root]->init_buf,
+                                    block_count(root) * dt_size, mem_type,
+                                    UCC_MEMORY_TYPE_HOST));
+        }
+    }
+    void data_fini(UccCollCtxVec ctxs)
+    {
+        for (auto r = 0; r < ctxs.size(); r++) {
+            gtest_ucc_coll_ctx_t     *ctx  = ctxs[r];
+            ucc_coll_args_t          *coll = ctx->args;
+            ucc_coll_buffer_info_v_t *info_v =
+                is_gather() ? &coll->dst.info_v : &coll->src.info_v;
+
+            if (ctx->src_mc_header) {
+                UCC_CHECK(ucc_mc_free(ctx->src_mc_header));
+            }
+            if (ctx->dst_mc_header) {
+                UCC_CHECK(ucc_mc_free(ctx->dst_mc_header));
+            }
+            if (r == root && is_v()) {
+                free(info_v->counts);
+                free(info_v->displacements);
+            }
+            ucc_free(ctx->init_buf);
+            free(coll);
+            free(ctx);
+        }
+        ctxs.clear();
+    }
+    bool check_block(int r, uint8_t *block, size_t dt_size)
+    {
+        for (int i = 0; i < block_count(r) * dt_size; i++) {
+            if ((uint8_t)(r * 7 + i) != block[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool data_validate(UccCollCtxVec ctxs)
+    {
+        int      nprocs  = ctxs.size();
+        size_t   dt_size = ucc_dt_size(is_gather() ?
+                                       ctxs[0]->args->src.info.datatype :
+                                       ctxs[0]->args->dst.info.datatype);
+        bool     ret     = true;
+        uint8_t *dst;
+
+        for (int r = 0; r < nprocs && ret; r++) {
+            if (is_gather() ? r != root : !ctxs[r]->dst_mc_header) {
+                /* non root of gather or inplace root of scatter */
+                continue;
+            }
+            dst = (uint8_t*)ucc_malloc(ucc_max(ctxs[r]->rbuf_size, 1), "dst");
+            EXPECT_NE(dst, nullptr);
+            UCC_CHECK(ucc_mc_memcpy(dst, ctxs[r]->dst_mc_header->addr,
+                                    ctxs[r]->rbuf_size, UCC_MEMORY_TYPE_HOST,
+                                    mem_type));
+            if (is_gather()) {
+                for (int i = 0; i < nprocs && ret; i++) {
+                    ret = check_block(i, dst + block_displ(nprocs, i) * dt_size,
+                                      dt_size);
+                }
+            } else {
+                ret = check_block(r, dst, dt_size);
+            }
+            ucc_free(dst);
+        }
+        return ret;
+    }
+};
+
+class test_gather_scatter_0 : public test_gather_scatter,
+        public ::testing::WithParamInterface<Param_0> {};
+
+UCC_TEST_P(test_gather_scatter_0, single)
+{
+    const int                 team_id  = std::get<1>(GetParam());
+    const ucc_memory_type_t   mem_type = std::get<2>(GetParam());
+    const int                 count    = std::get<3>(GetParam());
+    const gtest_ucc_inplace_t inplace  = std::get<5>(GetParam());
+    UccTeam_h                 team     = UccJob::getStaticTeams()[team_id];
+    int                       size     = team->procs.size();
+    UccCollCtxVec             ctxs;
+
+    this->coll_type = std::get<0>(GetParam());
+    this->root      = std::get<4>(GetParam());
+    set_mem_type(mem_type);
+    set_inplace(inplace);
+    data_init(size, UCC_DT_INT32, count, ctxs);
+    UccReq req(team, ctxs);
+    req.start();
+    req.wait();
+    EXPECT_EQ(true, data_validate(ctxs));
+    data_fini(ctxs);
+}
+
+UCC_TEST_P(test_gather_scatter_0, single_persistent)
+{
+    const int                 team_id  = std::get<1>(GetParam());
+    const ucc_memory_type_t   mem_type = std::get<2>(GetParam());
+    const int                 count    = std::get<3>(GetParam());
+    const gtest_ucc_inplace_t inplace  = std::get<5>(GetParam());
+    UccTeam_h                 team     = UccJob::getStaticTeams()[team_id];
+    int                       size     = team->procs.size();
+    const int                 n_calls  = 3;
+    UccCollCtxVec             ctxs;
+
+    this->coll_type = std::get<0>(GetParam());
+    this->root      = std::get<4>(GetParam());
+    set_mem_type(mem_type);
+    set_inplace(inplace);
+    data_init(size, UCC_DT_INT32, count, ctxs);
+    set_persistent(ctxs);
+    UccReq req(team, ctxs);
+    for (auto i = 0; i < n_calls; i++) {
+        req.start();
+        req.wait();
+        EXPECT_EQ(true, data_validate(ctxs));
+        reset(ctxs);
+    }
+    data_fini(ctxs);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_gather_scatter_0,
+    ::testing::Combine(
+        ::testing::Values(UCC_COLL_TYPE_GATHER, UCC_COLL_TYPE_GATHERV,
+                          UCC_COLL_TYPE_SCATTER, UCC_COLL_TYPE_SCATTERV),
+        ::testing::Range(0, UccJob::nStaticTeams), // team_ids
+#ifdef HAVE_CUDA
+        ::testing::Values(UCC_MEMORY_TYPE_HOST, UCC_MEMORY_TYPE_CUDA), // mem type
+#else
+        ::testing::Values(UCC_MEMORY_TYPE_HOST),
+#endif
+        ::testing::Values(1, 3, 8192), // count
+        ::testing::Values(0, 1), // root
+        ::testing::Values(TEST_NO_INPLACE, TEST_INPLACE)));
+
+class test_gather_scatter_alg : public test_gather_scatter,
+        public ::testing::WithParamInterface<Param_alg> {};
+
+UCC_TEST_P(test_gather_scatter_alg, root_inplace)
+{
+    const std::string alg     = std::get<1>(GetParam());
+    const std::string radix   = std::get<2>(GetParam());
+    int               n_procs = 15;
+    int               repeat  = 2;
+    std::string       coll, tune, radix_var;
+    UccCollCtxVec     ctxs;
+
+    this->coll_type = std::get<0>(GetParam());
+    switch (coll_type) {
+    case UCC_COLL_TYPE_GATHER:
+        coll = "gather";
+        break;
+    case UCC_COLL_TYPE_GATHERV:
+        coll = "gatherv";
+        break;
+    case UCC_COLL_TYPE_SCATTER:
+        coll = "scatter";
+        break;
+    default:
+        coll = "scatterv";
+        break;
+    }
+    tune = coll + (alg.empty() ? "" : ":@" + alg) + ":inf";
+    for (auto &c : coll) {
+        c = toupper(c);
+    }
+    radix_var = "UCC_TL_UCP_" + coll + "_KN_RADIX";
+
+    ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                         {"UCC_TL_UCP_TUNE", tune},
+                         {radix_var, radix}};
+    UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);
+
+    set_mem_type(UCC_MEMORY_TYPE_HOST);
+    /* team sizes with childless ranks at distance > 1, e.g. vrank 14 of 15
+       and vrank 2 of 3 with radix 2, vrank 4 of 5 with radix 4 */
+    for (int size : {15, 13, 5, 3}) {
+        UccTeam_h team = job.create_team(size);
+        for (auto root : {0, size / 2, size - 1}) {
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {
+                this->root = root;
+                set_inplace(inplace);
+                data_init(size, UCC_DT_INT8, 33, ctxs);
+                set_persistent(ctxs);
+                UccReq req(team, ctxs);
+                for (auto i = 0; i < repeat; i++) {
+                    req.start();
+                    req.wait();
+                    EXPECT_EQ(true, data_validate(ctxs));
+                    reset(ctxs);
+                }
+                data_fini(ctxs);
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    , test_gather_scatter_alg,
+    ::testing::Values(
+        Param_alg(UCC_COLL_TYPE_GATHER, "", "2"),
+        Param_alg(UCC_COLL_TYPE_GATHER, "", "3"),
+        Param_alg(UCC_COLL_TYPE_GATHER, "", "4"),
+        Param_alg(UCC_COLL_TYPE_GATHERV, "linear", "4"),
+        Param_alg(UCC_COLL_TYPE_GATHERV, "knomial", "2"),
+        Param_alg(UCC_COLL_TYPE_GATHERV, "knomial", "4"),
+        Param_alg(UCC_COLL_TYPE_SCATTER, "", "2"),
+        Param_alg(UCC_COLL_TYPE_SCATTER, "", "3"),
+        Param_alg(UCC_COLL_TYPE_SCATTER, "", "4"),
+        Param_alg(UCC_COLL_TYPE_SCATTERV, "linear", "4"),
+        Param_alg(UCC_COLL_TYPE_SCATTERV, "knomial", "2"),
+        Param_alg(UCC_COLL_TYPE_SCATTERV, "knomial", "4")));
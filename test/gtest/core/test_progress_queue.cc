@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include <common/test.h>
+extern "C" {
+#include "core/ucc_progress_queue.h"
+}
+#include <vector>
+
+typedef struct test_pq_task {
+    ucc_coll_task_t super;
+    int             n_progress;
+    int             complete_after;
+} test_pq_task_t;
+
+class test_pq_ready_list : public ucc::test {
+public:
+    ucc_progress_queue_t       *pq;
+    std::vector<test_pq_task_t> tasks;
+    test_pq_ready_list()
+    {
+        EXPECT_EQ(UCC_OK, ucc_progress_queue_init(&pq, UCC_THREAD_SINGLE, 0, 1));
+        EXPECT_EQ(1, ucc_progress_queue_has_ready_list(pq));
+    }
+    ~test_pq_ready_list()
+    {
+        ucc_progress_queue_finalize(pq);
+    }
+    static ucc_status_t progress(ucc_coll_task_t *task)
+    {
+        test_pq_task_t *t = ucc_derived_of(task, test_pq_task_t);
+
+        if (++t->n_progress == t->complete_after) {
+            task->super.status = UCC_OK;
+        }
+        return task->super.status;
+    }
+    void init_tasks(int n, int complete_after, uint32_t flags)
+    {
+        tasks.resize(n);
+        for (auto &t : tasks) {
+            memset(&t, 0, sizeof(t));
+            EXPECT_EQ(UCC_OK, ucc_coll_task_init(&t.super, NULL, NULL));
+            t.super.flags        = flags;
+            t.super.progress     = progress;
+            t.super.super.status = UCC_INPROGRESS;
+            t.complete_after     = complete_after;
+        }
+    }
+};
+
+/* event driven tasks are not progressed until they are marked ready */
+UCC_TEST_F(test_pq_ready_list, idle_until_ready)
+{
+    const int n_tasks = 8;
+
+    init_tasks(n_tasks, 2, UCC_COLL_TASK_FLAG_EVENT_DRIVEN);
+    for (auto &t : tasks) {
+        ucc_progress_enqueue(pq, &t.super);
+    }
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(0, ucc_progress_queue(pq));
+    }
+    for (auto &t : tasks) {
+        EXPECT_EQ(0, t.n_progress);
+    }
+
+    ucc_progress_task_ready(pq, &tasks[3].super);
+    EXPECT_EQ(0, ucc_progress_queue(pq));
+    EXPECT_EQ(0, ucc_progress_queue(pq));
+    for (int i = 0; i < n_tasks; i++) {
+        EXPECT_EQ(i == 3 ? 1 : 0, tasks[i].n_progress);
+    }
+
+    /* second event completes the task */
+    ucc_progress_task_ready(pq, &tasks[3].super);
+    EXPECT_EQ(1, ucc_progress_queue(pq));
+    EXPECT_EQ(UCC_OK, tasks[3].super.super.status);
+
+    for (int i = 0; i < n_tasks; i++) {
+        if (i != 3) {
+            ucc_progress_task_ready(pq, &tasks[i].super);
+            ucc_progress_task_ready(pq, &tasks[i].super);
+        }
+    }
+    EXPECT_EQ(0, ucc_progress_queue(pq));
+    for (int i = 0; i < n_tasks; i++) {
+        if (i != 3) {
+            ucc_progress_task_ready(pq, &tasks[i].super);
+        }
+    }
+    EXPECT_EQ(n_tasks - 1, ucc_progress_queue(pq));
+    for (auto &t : tasks) {
+        EXPECT_EQ(2, t.n_progress);
+        EXPECT_EQ(UCC_OK, t.super.super.status);
+    }
+}
+
+/* event that arrives before the task is enqueued (e.g. during post) is not
+   lost */
+UCC_TEST_F(test_pq_ready_list, ready_before_enqueue)
+{
+    init_tasks(1, 1, UCC_COLL_TASK_FLAG_EVENT_DRIVEN);
+    ucc_progress_task_ready(pq, &tasks[0].super);
+    ucc_progress_enqueue(pq, &tasks[0].super);
+    EXPECT_EQ(1, ucc_progress_queue(pq));
+    EXPECT_EQ(1, tasks[0].n_progress);
+}
+
+/* tasks that are not event driven are progressed on every call */
+UCC_TEST_F(test_pq_ready_list, polling_task)
+{
+    init_tasks(2, 4, 0);
+    for (auto &t : tasks) {
+        ucc_progress_enqueue(pq, &t.super);
+    }
+    EXPECT_EQ(0, ucc_progress_queue(pq));
+    EXPECT_EQ(0, ucc_progress_queue(pq));
+    EXPECT_EQ(0, ucc_progress_queue(pq));
+    EXPECT_EQ(2, ucc_progress_queue(pq));
+    for (auto &t : tasks) {
+        EXPECT_EQ(4, t.n_progress);
+    }
+}
@@ -15,6 +15,10 @@ class test_reduce : public UccCollArgs, public testing::Test {
   private:
     int root = 0;
   public:
+    void set_root(int _root)
+    {
+        root = _root;
+    }
     void data_init(int nprocs, ucc_datatype_t dt, size_t count,
                    UccCollCtxVec &ctxs)
     {
@@ -287,3 +291,64 @@ TYPED_TEST(test_reduce_avg_order, avg_post_op)
         }
     }
 }
+
+template <typename T> class test_reduce_alg : public test_reduce<T> {
+};
+
+using test_reduce_alg_type =
+    ::testing::Types<ReductionTest<UCC_DT_INT32, sum>,
+                     ReductionTest<UCC_DT_FLOAT32, max>,
+                     ReductionTest<UCC_DT_FLOAT64, avg>>;
+TYPED_TEST_CASE(test_reduce_alg, test_reduce_alg_type);
+
+#define TEST_REDUCE_ALG(_env, _counts)                                         \
+    {                                                                          \
+        int           n_procs = 15;                                            \
+        UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, _env);          \
+        UccTeam_h     team = job.create_team(n_procs);                         \
+        UccCollCtxVec ctxs;                                                    \
+                                                                               \
+        for (auto count : _counts) {                                           \
+            for (auto root : {0, 5, 14}) {                                     \
+                for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {         \
+                    this->set_mem_type(UCC_MEMORY_TYPE_HOST);                  \
+                    this->set_inplace(inplace);                                \
+                    this->set_root(root);                                      \
+                    this->data_init(n_procs, TypeParam::dt, count, ctxs);      \
+                    UccReq req(team, ctxs);                                    \
+                    for (auto i = 0; i < 2; i++) {                             \
+                        req.start();                                           \
+                        req.wait();                                            \
+                        EXPECT_EQ(true, this->data_validate(ctxs));            \
+                        this->reset(ctxs);                                     \
+                    }                                                          \
+                    this->data_fini(ctxs);                                     \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+    }
+
+TYPED_TEST(test_reduce_alg, srg_knomial)
+{
+    /* 15 ranks with radix 2 have 7 extra ranks, root 5 is one of them,
+       count 4 is below one element per rank */
+    for (auto radix : {"2", "3", "4"}) {
+        ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "reduce:@srg_knomial:inf"},
+                             {"UCC_TL_UCP_REDUCE_SRG_KN_RADIX", radix}};
+        TEST_REDUCE_ALG(env, std::vector<int>({4, 1001, 65536}));
+    }
+}
+
+TYPED_TEST(test_reduce_alg, pipelined)
+{
+    /* binary and ternary trees, the last fragment is not full */
+    for (auto radix : {"2", "3"}) {
+        ucc_job_env_t env = {{"UCC_CL_BASIC_TUNE", "inf"},
+                             {"UCC_TL_UCP_TUNE", "reduce:@pipelined:inf"},
+                             {"UCC_TL_UCP_REDUCE_PIPELINE_RADIX", radix},
+                             {"UCC_TL_UCP_REDUCE_PIPELINE_FRAG_SIZE", "1k"},
+                             {"UCC_TL_UCP_REDUCE_PIPELINE_DEPTH", "2"}};
+        TEST_REDUCE_ALG(env, std::vector<int>({4, 1001}));
+    }
+}
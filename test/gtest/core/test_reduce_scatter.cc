@@ -0,0 +1,284 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+
+#include "test_mc_reduce.h"
+#include "common/test_ucc.h"
+#include "utils/ucc_math.h"
+
+#include <array>
+
+/* Reduce-scatter of the vector of count * nprocs elements, or
+   reduce-scatterv with block of rank r of (r % 3) * count elements */
+template<typename T>
+class test_reduce_scatter : public UccCollArgs, public testing::Test {
+  public:
+    bool   is_v = false;
+    size_t count;
+
+    size_t block_count(int nprocs, size_t count, int r)
+    {
+        return is_v ? (r % 3) * count : count;
+    }
+    size_t block_offset(int nprocs, size_t count, int r)
+    {
+        size_t offset = 0;
+        for (int i = 0; i < r; i++) {
+            offset += block_count(nprocs, count, i);
+        }
+        return offset;
+    }
+    void data_init(int nprocs, ucc_datatype_t dt, size_t count,
+                   UccCollCtxVec &ctxs)
+    {
+        size_t total = block_offset(nprocs, count, nprocs);
+
+        this->count = count;
+        ctxs.resize(nprocs);
+        for (int r = 0; r < nprocs; r++) {
+            ucc_coll_args_t *coll = (ucc_coll_args_t*)
+                    calloc(1, sizeof(ucc_coll_args_t));
+            size_t my_count = block_count(nprocs, count, r);
+            void  *dst;
+
+            ctxs[r] = (gtest_ucc_coll_ctx_t*)calloc(1, sizeof(gtest_ucc_coll_ctx_t));
+            ctxs[r]->args = coll;
+
+            coll->coll_type = is_v ? UCC_COLL_TYPE_REDUCE_SCATTERV :
+                                     UCC_COLL_TYPE_REDUCE_SCATTER;
+            coll->op        = T::redop;
+
+            ctxs[r]->init_buf = ucc_malloc(ucc_dt_size(dt) * total, "init buf");
+            EXPECT_NE(ctxs[r]->init_buf, nullptr);
+            for (int i = 0; i < total; i++) {
+                typename T::type * ptr;
+                ptr = (typename T::type *)ctxs[r]->init_buf;
+                ptr[i] = (typename T::type)((i + r + 1) % 8);
+            }
+
+            ctxs[r]->rbuf_size = ucc_dt_size(dt) *
+                (TEST_INPLACE == inplace ? total : my_count);
+            UCC_CHECK(ucc_mc_alloc(&ctxs[r]->dst_mc_header,
+                                   ucc_max(ctxs[r]->rbuf_size, 1), mem_type));
+            dst = ctxs[r]->dst_mc_header->addr;
+            if (TEST_INPLACE == inplace) {
+                coll->mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+                coll->flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+                UCC_CHECK(ucc_mc_memcpy(dst, ctxs[r]->init_buf,
+                                        ucc_dt_size(dt) * total, mem_type,
+                                        UCC_MEMORY_TYPE_HOST));
+            } else {
+                UCC_CHECK(ucc_mc_alloc(&ctxs[r]->src_mc_header,
+                                       ucc_dt_size(dt) * total, mem_type));
+                coll->src.info.buffer = ctxs[r]->src_mc_header->addr;
+                UCC_CHECK(ucc_mc_memcpy(coll->src.info.buffer, ctxs[r]->init_buf,
+                                        ucc_dt_size(dt) * total, mem_type,
+                                        UCC_MEMORY_TYPE_HOST));
+                coll->src.info.mem_type = mem_type;
+                coll->src.info.count    = (ucc_count_t)total;
+                coll->src.info.datatype = dt;
+            }
+            if (is_v) {
+                uint32_t *counts = (uint32_t*)malloc(sizeof(uint32_t) * nprocs);
+                for (int i = 0; i < nprocs; i++) {
+                    counts[i] = block_count(nprocs, count, i);
+                }
+                coll->dst.info_v.buffer   = dst;
+                coll->dst.info_v.counts   = (ucc_count_t*)counts;
+                coll->dst.info_v.mem_type = mem_type;
+                coll->dst.info_v.datatype = dt;
+            } else {
+                coll->dst.info.buffer   = dst;
+                coll->dst.info.mem_type = mem_type;
+                coll->dst.info.count    = (ucc_count_t)
+                    (TEST_INPLACE == inplace ? total : my_count);
+                coll->dst.info.datatype = dt;
+            }
+        }
+    }
+    void data_fini(UccCollCtxVec ctxs) {
+        for (gtest_ucc_coll_ctx_t* ctx : ctxs) {
+            ucc_coll_args_t* coll = ctx->args;
+            if (coll->src.info.buffer) { /* no inplace */
+                UCC_CHECK(ucc_mc_free(ctx->src_mc_header));
+            }
+            if (is_v) {
+                free(coll->dst.info_v.counts);
+            }
+            UCC_CHECK(ucc_mc_free(ctx->dst_mc_header));
+            ucc_free(ctx->init_buf);
+            free(coll);
+            free(ctx);
+        }
+        ctxs.clear();
+    }
+    void reset(UccCollCtxVec ctxs)
+    {
+        for (auto r = 0; r < ctxs.size(); r++) {
+            void *dst = ctxs[r]->dst_mc_header->addr;
+
+            clear_buffer(dst, ctxs[r]->rbuf_size, mem_type, 0);
+            if (TEST_INPLACE == inplace) {
+                UCC_CHECK(ucc_mc_memcpy(dst, ctxs[r]->init_buf,
+                                        ctxs[r]->rbuf_size, mem_type,
+                                        UCC_MEMORY_TYPE_HOST));
+            }
+        }
+    }
+    bool data_validate(UccCollCtxVec ctxs)
+    {
+        int                             nprocs = ctxs.size();
+        std::vector<typename T::type *> dsts(nprocs);
+
+        for (int r = 0; r < nprocs; r++) {
+            dsts[r] = (typename T::type *)ctxs[r]->dst_mc_header->addr;
+            if (UCC_MEMORY_TYPE_HOST != mem_type) {
+                dsts[r] = (typename T::type *)ucc_malloc(
+                    ucc_max(ctxs[r]->rbuf_size, 1), "dsts buf");
+                EXPECT_NE(dsts[r], nullptr);
+                UCC_CHECK(ucc_mc_memcpy(dsts[r], ctxs[r]->dst_mc_header->addr,
+                                        ctxs[r]->rbuf_size,
+                                        UCC_MEMORY_TYPE_HOST, mem_type));
+            }
+        }
+        for (int r = 0; r < nprocs; r++) {
+            size_t offset = block_offset(nprocs, count, r);
+            size_t dst_offset = (TEST_INPLACE == inplace) ? offset : 0;
+            for (int i = 0; i < block_count(nprocs, count, r); i++) {
+                typename T::type res =
+                    ((typename T::type *)((ctxs[0])->init_buf))[offset + i];
+                for (int p = 1; p < nprocs; p++) {
+                    res = T::do_op(
+                        res, ((typename T::type *)((ctxs[p])->init_buf))[offset + i]);
+                }
+                if (T::redop == UCC_OP_AVG) {
+                    if (T::dt == UCC_DT_BFLOAT16) {
+                        float32tobfloat16(bfloat16tofloat32(&res) / (float)nprocs,
+                                          &res);
+                    } else {
+                        res = res / (typename T::type)nprocs;
+                    }
+                }
+                T::assert_equal(res, dsts[r][dst_offset + i]);
+            }
+        }
+        if (UCC_MEMORY_TYPE_HOST != mem_type) {
+            for (int r = 0; r < nprocs; r++) {
+                ucc_free(dsts[r]);
+            }
+        }
+        return true;
+    }
+};
+
+TYPED_TEST_CASE(test_reduce_scatter, ReductionTypesOps);
+
+#define TEST_DECLARE(_mem_type, _inplace, _repeat)                             \
+    {                                                                          \
+        std::array<int, 3> counts{1, 17, 4096};                                \
+        for (int tid = 0; tid < UccJob::nStaticTeams; tid++) {                 \
+            for (int count : counts) {                                         \
+                UccTeam_h     team = UccJob::getStaticTeams()[tid];            \
+                int           size = team->procs.size();                       \
+                UccCollCtxVec ctxs;                                            \
+                this->set_mem_type(_mem_type);                                 \
+                this->set_inplace(_inplace);                                   \
+                this->data_init(size, TypeParam::dt, count, ctxs);             \
+                if (_repeat > 1) {                                             \
+                    this->set_persistent(ctxs);                                \
+                }                                                              \
+                UccReq req(team, ctxs);                                        \
+                for (auto i = 0; i < _repeat; i++) {                           \
+                    req.start();                                               \
+                    req.wait();                                                \
+                    EXPECT_EQ(true, this->data_validate(ctxs));                \
+                    this->reset(ctxs);                                         \
+                }                                                              \
+                this->data_fini(ctxs);                                         \
+            }                                                                  \
+        }                                                                      \
+    }
+
+TYPED_TEST(test_reduce_scatter, single_host) {
+    TEST_DECLARE(UCC_MEMORY_TYPE_HOST, TEST_NO_INPLACE, 1);
+}
+
+TYPED_TEST(test_reduce_scatter, single_host_persistent)
+{
+    TEST_DECLARE(UCC_MEMORY_TYPE_HOST, TEST_NO_INPLACE, 3);
+}
+
+TYPED_TEST(test_reduce_scatter, single_host_inplace) {
+    TEST_DECLARE(UCC_MEMORY_TYPE_HOST, TEST_INPLACE, 1);
+}
+
+TYPED_TEST(test_reduce_scatter, v_host) {
+    this->is_v = true;
+    TEST_DECLARE(UCC_MEMORY_TYPE_HOST, TEST_NO_INPLACE, 1);
+}
+
+TYPED_TEST(test_reduce_scatter, v_host_persistent_inplace) {
+    this->is_v = true;
+    TEST_DECLARE(UCC_MEMORY_TYPE_HOST, TEST_INPLACE, 3);
+}
+
+#ifdef HAVE_CUDA
+TYPED_TEST(test_reduce_scatter, single_cuda) {
+    TEST_DECLARE(UCC_MEMORY_TYPE_CUDA, TEST_NO_INPLACE, 1);
+}
+
+TYPED_TEST(test_reduce_scatter, single_cuda_inplace) {
+    TEST_DECLARE(UCC_MEMORY_TYPE_CUDA, TEST_INPLACE, 1);
+}
+#endif
+
+template<typename T>
+class test_reduce_scatter_alg : public test_reduce_scatter<T>
+{};
+
+using test_reduce_scatter_alg_type =
+    ::testing::Types<ReductionTest<UCC_DT_INT32, sum>,
+                     ReductionTest<UCC_DT_FLOAT32, avg>>;
+TYPED_TEST_CASE(test_reduce_scatter_alg, test_reduce_scatter_alg_type);
+
+#define TEST_ALG(_alg, _radix)                                                 \
+    {                                                                          \
+        int           n_procs = 15;                                            \
+        ucc_job_env_t env     = {                                              \
+            {"UCC_CL_BASIC_TUNE", "inf"},                                      \
+            {"UCC_TL_UCP_TUNE", "reduce_scatter:@" _alg ":inf"},               \
+            {"UCC_TL_UCP_REDUCE_SCATTER_KN_RADIX", _radix}};                   \
+        UccJob        job(n_procs, UccJob::UCC_JOB_CTX_GLOBAL, env);           \
+        UccTeam_h     team   = job.create_team(n_procs);                       \
+        int           repeat = 3;                                              \
+        UccCollCtxVec ctxs;                                                    \
+        for (auto count : {1, 7, 65536}) {                                     \
+            for (auto inplace : {TEST_NO_INPLACE, TEST_INPLACE}) {             \
+                this->set_mem_type(UCC_MEMORY_TYPE_HOST);                      \
+                this->set_inplace(inplace);                                    \
+                this->data_init(n_procs, TypeParam::dt, count, ctxs);          \
+                this->set_persistent(ctxs);                                    \
+                UccReq req(team, ctxs);                                        \
+                for (auto i = 0; i < repeat; i++) {                            \
+                    req.start();                                               \
+                    req.wait();                                                \
+                    EXPECT_EQ(true, this->data_validate(ctxs));                \
+                    this->reset(ctxs);                                         \
+                }                                                              \
+                this->data_fini(ctxs);                                         \
+            }                                                                  \
+        }                                                                      \
+    }
+
+TYPED_TEST(test_reduce_scatter_alg, knomial_radix_2) {
+    TEST_ALG("knomial", "2");
+}
+
+TYPED_TEST(test_reduce_scatter_alg, knomial_radix_4) {
+    TEST_ALG("knomial", "4");
+}
+
+TYPED_TEST(test_reduce_scatter_alg, ring) {
+    TEST_ALG("ring", "0");
+}
@@ -77,3 +77,27 @@ UCC_TEST_F(test_schedule, different_handlers)
     EXPECT_EQ(true, (std::get<0>(rst[1]) == &tasks[1]) &&
               (std::get<1>(rst[1]) == 2));
 }
+
+/* Persistent schedule that completed with error is reset on re-post */
+UCC_TEST_F(test_schedule, restart_after_error)
+{
+    ucc_schedule_t  schedule;
+    ucc_coll_task_t task;
+
+    EXPECT_EQ(UCC_OK, ucc_coll_task_init(&schedule.super, NULL, NULL));
+    schedule.n_tasks = 0;
+    EXPECT_EQ(UCC_OK, ucc_coll_task_init(&task, NULL, NULL));
+    task.n_deps = 1;
+    ucc_schedule_add_task(&schedule, &task);
+
+    task.n_deps_satisfied       = 1;
+    task.super.status           = UCC_ERR_NO_MESSAGE;
+    schedule.n_completed_tasks  = 1;
+    schedule.super.super.status = UCC_ERR_NO_MESSAGE;
+
+    EXPECT_EQ(UCC_OK, ucc_schedule_start(&schedule));
+    EXPECT_EQ(UCC_INPROGRESS, schedule.super.super.status);
+    EXPECT_EQ(0, schedule.n_completed_tasks);
+    EXPECT_EQ(0, task.n_deps_satisfied);
+    EXPECT_EQ(UCC_OPERATION_INITIALIZED, task.super.status);
+}
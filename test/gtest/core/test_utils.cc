@@ -146,3 +146,23 @@ INSTANTIATE_TEST_CASE_P(
         ::testing::Values(2, 8, 11),
         ::testing::Values(UCC_DT_INT32, UCC_DT_UINT128, UCC_DT_FLOAT64),
         ::testing::Values(32, 4096, 65533)));
+
+class test_buffer_block : public ucc::test {
+};
+
+UCC_TEST_F(test_buffer_block, count_offset)
+{
+    for (size_t total : {0, 1, 7, 64, 1000, 65533}) {
+        for (ucc_rank_t n : {1, 2, 3, 8, 11}) {
+            size_t sum = 0;
+            for (ucc_rank_t b = 0; b < n; b++) {
+                size_t c = ucc_buffer_block_count(total, n, b);
+                EXPECT_EQ(sum, ucc_buffer_block_offset(total, n, b));
+                EXPECT_LE(c, ucc_buffer_block_count(total, n, 0));
+                EXPECT_GE(c + 1, ucc_buffer_block_count(total, n, 0));
+                sum += c;
+            }
+            EXPECT_EQ(total, sum);
+        }
+    }
+}
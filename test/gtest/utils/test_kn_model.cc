@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ * See file LICENSE for terms.
+ */
+extern "C" {
+#include "coll_patterns/knomial_model.h"
+}
+#include <common/test.h>
+
+class test_kn_model : public ucc::test {
+public:
+    ucc_kn_model_t model;
+    test_kn_model()
+    {
+        model.L = 1e-6;
+        model.o = 1e-7;
+        model.G = 1e-10;
+    }
+};
+
+UCC_TEST_F(test_kn_model, small_team)
+{
+    EXPECT_EQ(2, ucc_kn_model_get_radix(&model, UCC_KN_MODEL_RECURSIVE, 1, 8,
+                                        UCC_KN_MODEL_MAX_RADIX));
+    EXPECT_EQ(2, ucc_kn_model_get_radix(&model, UCC_KN_MODEL_RECURSIVE, 2, 8,
+                                        UCC_KN_MODEL_MAX_RADIX));
+}
+
+UCC_TEST_F(test_kn_model, max_radix)
+{
+    ucc_kn_radix_t r;
+
+    r = ucc_kn_model_get_radix(&model, UCC_KN_MODEL_RECURSIVE, 5, 0,
+                               UCC_KN_MODEL_MAX_RADIX);
+    EXPECT_LE(r, 5);
+    r = ucc_kn_model_get_radix(&model, UCC_KN_MODEL_RECURSIVE, 1024, 0, 4);
+    EXPECT_LE(r, 4);
+    r = ucc_kn_model_get_radix(&model, UCC_KN_MODEL_RECURSIVE, 1024, 0, 64);
+    EXPECT_LE(r, UCC_KN_MODEL_MAX_RADIX);
+}
+
+UCC_TEST_F(test_kn_model, latency_vs_bandwidth)
+{
+    ucc_kn_model_pattern_t patterns[] = {UCC_KN_MODEL_RECURSIVE,
+                                         UCC_KN_MODEL_TREE};
+    ucc_kn_radix_t         r_small, r_large;
+
+    for (auto p : patterns) {
+        /* latency bound: fewer steps are better */
+        r_small = ucc_kn_model_get_radix(&model, p, 64, 8,
+                                         UCC_KN_MODEL_MAX_RADIX);
+        /* bandwidth bound: fewer peers per step are better */
+        r_large = ucc_kn_model_get_radix(&model, p, 64, 64 * 1024 * 1024,
+                                         UCC_KN_MODEL_MAX_RADIX);
+        EXPECT_GT(r_small, 2);
+        EXPECT_EQ(2, r_large);
+        EXPECT_GE(r_small, r_large);
+    }
+}
+
+UCC_TEST_F(test_kn_model, cost)
+{
+    /* full tree: 2 steps with 3 peers each */
+    EXPECT_DOUBLE_EQ(2 * (model.L + 3 * 2 * model.o),
+                     ucc_kn_model_cost(&model, UCC_KN_MODEL_TREE, 16, 0, 4));
+    /* scatter: message is split between peers at every step */
+    EXPECT_DOUBLE_EQ(2 * model.L + 6 * 2 * model.o + 3 * 1024 * model.G +
+                         3 * 256 * model.G,
+                     ucc_kn_model_cost(&model, UCC_KN_MODEL_SCATTER, 16, 4096,
+                                       4));
+    /* sra is twice the scatter */
+    EXPECT_DOUBLE_EQ(2 * ucc_kn_model_cost(&model, UCC_KN_MODEL_SCATTER, 16,
+                                           4096, 4),
+                     ucc_kn_model_cost(&model, UCC_KN_MODEL_SRA, 16, 4096, 4));
+}
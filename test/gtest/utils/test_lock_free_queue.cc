@@ -6,6 +6,8 @@
 
 extern "C" {
 #include "utils/ucc_lock_free_queue.h"
+#include "utils/ucc_mpmc_queue.h"
+#include "utils/ucc_time.h"
 #include "utils/ucc_atomic.h"
 #include "utils/ucc_malloc.h"
 #include <pthread.h>
@@ -113,3 +115,218 @@ UCC_TEST_F(test_lf_queue, manyProducersManyConsumers)
 {
     EXPECT_EQ(lf_test(7, 7), 0);
 }
+
+typedef struct ucc_test_mpmc_queue {
+    ucc_mpmc_queue_t queue;
+    int64_t          test_sum;
+    uint32_t         elems_num;
+    uint32_t         active_producers_threads;
+    uint32_t         memory_err;
+} ucc_test_mpmc_queue_t;
+
+void *mpmc_producer_thread(void *arg)
+{
+    ucc_test_mpmc_queue_t *test = (ucc_test_mpmc_queue_t *)arg;
+    for (int j = 0; j < NUM_ITERS; j++) {
+        ucc_list_link_t *elem =
+            (ucc_list_link_t *)ucc_malloc(sizeof(ucc_list_link_t));
+        if (!elem) {
+            ucc_atomic_add32(&test->memory_err, 1);
+            goto exit;
+        }
+        ucc_mpmc_queue_enqueue(&test->queue, elem);
+        ucc_atomic_add64((uint64_t *)&test->test_sum, (uint64_t)elem);
+        ucc_atomic_add32(&test->elems_num, 1);
+    }
+exit:
+    ucc_atomic_sub32(&test->active_producers_threads, 1);
+    return 0;
+}
+
+void *mpmc_consumer_thread(void *arg)
+{
+    ucc_test_mpmc_queue_t *test = (ucc_test_mpmc_queue_t *)arg;
+    while (test->active_producers_threads || test->elems_num) {
+        ucc_list_link_t *elem = ucc_mpmc_queue_dequeue(&test->queue);
+        if (elem) {
+            ucc_atomic_sub64((uint64_t *)&test->test_sum, (uint64_t)elem);
+            ucc_atomic_sub32(&test->elems_num, 1);
+            ucc_free(elem);
+        }
+    }
+    return 0;
+}
+
+class test_mpmc_queue : public ucc::test
+{
+  public:
+    ucc_test_mpmc_queue_t  test;
+    std::vector<pthread_t> producers_threads;
+    std::vector<pthread_t> consumers_threads;
+    int mpmc_test(int num_of_producers, int num_of_consumers, uint64_t size);
+};
+
+int test_mpmc_queue::mpmc_test(int num_of_producers, int num_of_consumers,
+                               uint64_t size)
+{
+    int i;
+
+    producers_threads.resize(num_of_producers);
+    consumers_threads.resize(num_of_consumers);
+    memset(&test, 0, sizeof(test));
+    if (UCC_OK != ucc_mpmc_queue_init(&test.queue, size)) {
+        return 1;
+    }
+    for (i = 0; i < num_of_producers; i++) {
+        ucc_atomic_add32(&test.active_producers_threads, 1);
+        pthread_create(&producers_threads[i], NULL, &mpmc_producer_thread,
+                       (void *)&test);
+    }
+    for (i = 0; i < num_of_consumers; i++) {
+        pthread_create(&consumers_threads[i], NULL, &mpmc_consumer_thread,
+                       (void *)&test);
+    }
+    for (i = 0; i < num_of_producers; i++) {
+        pthread_join(producers_threads[i], NULL);
+    }
+    for (i = 0; i < num_of_consumers; i++) {
+        pthread_join(consumers_threads[i], NULL);
+    }
+    ucc_mpmc_queue_destroy(&test.queue);
+    if (test.memory_err || test.test_sum) {
+        return 1;
+    }
+    return 0;
+}
+
+UCC_TEST_F(test_mpmc_queue, oneProducerOneConsumer)
+{
+    EXPECT_EQ(mpmc_test(1, 1, UCC_MPMC_QUEUE_DEFAULT_SIZE), 0);
+}
+
+UCC_TEST_F(test_mpmc_queue, oneProducerManyConsumers)
+{
+    EXPECT_EQ(mpmc_test(1, 7, UCC_MPMC_QUEUE_DEFAULT_SIZE), 0);
+}
+
+UCC_TEST_F(test_mpmc_queue, manyProducersManyConsumers)
+{
+    EXPECT_EQ(mpmc_test(7, 7, UCC_MPMC_QUEUE_DEFAULT_SIZE), 0);
+}
+
+/* small ring: most of the elements go through the overflow list */
+UCC_TEST_F(test_mpmc_queue, overflow)
+{
+    EXPECT_EQ(mpmc_test(7, 7, 4), 0);
+}
+
+/* Throughput: every thread repeatedly dequeues an element and enqueues it
+   back, same as progress threads do with in-progress tasks. The queue is
+   pre-filled with a few elements per thread. */
+#define TPUT_TOTAL_OPS     (1 << 20)
+#define TPUT_ELEMS_PER_THR 4
+#define TPUT_MAX_THREADS   64
+
+typedef struct ucc_test_tput {
+    ucc_lf_queue_t   lf_queue;
+    ucc_mpmc_queue_t mpmc_queue;
+    int              use_mpmc;
+    int              n_ops;
+    uint32_t         n_ready;
+    uint32_t         start;
+} ucc_test_tput_t;
+
+void *tput_thread(void *arg)
+{
+    ucc_test_tput_t *test = (ucc_test_tput_t *)arg;
+    int              done = 0;
+
+    ucc_atomic_add32(&test->n_ready, 1);
+    while (!*(volatile uint32_t *)&test->start) {
+    }
+    while (done < test->n_ops) {
+        if (test->use_mpmc) {
+            ucc_list_link_t *elem = ucc_mpmc_queue_dequeue(&test->mpmc_queue);
+            if (elem) {
+                ucc_mpmc_queue_enqueue(&test->mpmc_queue, elem);
+                done++;
+            }
+        } else {
+            ucc_lf_queue_elem_t *elem =
+                ucc_lf_queue_dequeue(&test->lf_queue, 1);
+            if (elem) {
+                ucc_lf_queue_enqueue(&test->lf_queue, elem);
+                done++;
+            }
+        }
+    }
+    return 0;
+}
+
+class test_queue_tput : public ucc::test_with_param<int>
+{
+  public:
+    ucc_test_tput_t test;
+    /* returns million ops per second */
+    double run(int n_threads, int use_mpmc);
+};
+
+double test_queue_tput::run(int n_threads, int use_mpmc)
+{
+    int                              n_elems = n_threads * TPUT_ELEMS_PER_THR;
+    std::vector<pthread_t>           threads(n_threads);
+    std::vector<ucc_lf_queue_elem_t> lf_elems(n_elems);
+    std::vector<ucc_list_link_t>     mpmc_elems(n_elems);
+    double                           t;
+    int                              i;
+
+    memset(&test, 0, sizeof(test));
+    test.use_mpmc = use_mpmc;
+    test.n_ops    = TPUT_TOTAL_OPS / n_threads;
+    if (use_mpmc) {
+        EXPECT_EQ(UCC_OK, ucc_mpmc_queue_init(&test.mpmc_queue,
+                                              UCC_MPMC_QUEUE_DEFAULT_SIZE));
+        for (i = 0; i < n_elems; i++) {
+            ucc_mpmc_queue_enqueue(&test.mpmc_queue, &mpmc_elems[i]);
+        }
+    } else {
+        ucc_lf_queue_init(&test.lf_queue);
+        for (i = 0; i < n_elems; i++) {
+            ucc_lf_queue_init_elem(&lf_elems[i]);
+            ucc_lf_queue_enqueue(&test.lf_queue, &lf_elems[i]);
+        }
+    }
+    for (i = 0; i < n_threads; i++) {
+        pthread_create(&threads[i], NULL, &tput_thread, (void *)&test);
+    }
+    while (*(volatile uint32_t *)&test.n_ready < n_threads) {
+    }
+    t = ucc_get_time();
+    ucc_atomic_add32(&test.start, 1);
+    for (i = 0; i < n_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    t = ucc_get_time() - t;
+    if (use_mpmc) {
+        EXPECT_EQ(n_elems, ucc_mpmc_queue_size(&test.mpmc_queue));
+        ucc_mpmc_queue_destroy(&test.mpmc_queue);
+    } else {
+        ucc_lf_queue_destroy(&test.lf_queue);
+    }
+    return (double)test.n_ops * n_threads / t / 1e6;
+}
+
+UCC_TEST_P(test_queue_tput, lf_vs_mpmc)
+{
+    int    n_threads = GetParam();
+    double lf, mpmc;
+
+    lf   = run(n_threads, 0);
+    mpmc = run(n_threads, 1);
+    UCC_TEST_MESSAGE << "threads " << n_threads << ": lf_queue " << lf
+                     << " Mops/s, mpmc_queue " << mpmc << " Mops/s";
+}
+
+INSTANTIATE_TEST_CASE_P(threads, test_queue_tput,
+                        ::testing::Values(1, 2, 4, 8, 16, 32,
+                                          TPUT_MAX_THREADS));
@@ -1,8 +1,11 @@
 #include <iomanip>
+#include <ctime>
+#include <algorithm>
 #include "ucc_pt_benchmark.h"
 #include "core/ucc_mc.h"
 #include "ucc_perftest.h"
 #include "utils/ucc_coll_utils.h"
+#include "components/base/ucc_base_iface.h"
 
 ucc_pt_benchmark::ucc_pt_benchmark(ucc_pt_benchmark_config cfg,
                                    ucc_pt_comm *communicator):
@@ -24,7 +27,8 @@ ucc_pt_benchmark::ucc_pt_benchmark(ucc_pt_benchmark_config cfg,
         coll = new ucc_pt_coll_alltoall(cfg.dt, cfg.mt, cfg.inplace, comm);
         break;
     case UCC_COLL_TYPE_ALLTOALLV:
-        coll = new ucc_pt_coll_alltoallv(cfg.dt, cfg.mt, cfg.inplace, comm);
+        coll = new ucc_pt_coll_alltoallv(cfg.dt, cfg.mt, cfg.inplace,
+                                         cfg.counts_pattern, comm);
         break;
     case UCC_COLL_TYPE_BARRIER:
         coll = new ucc_pt_coll_barrier(comm);
@@ -32,10 +36,22 @@ ucc_pt_benchmark::ucc_pt_benchmark(ucc_pt_benchmark_config cfg,
     case UCC_COLL_TYPE_BCAST:
         coll = new ucc_pt_coll_bcast(cfg.dt, cfg.mt, comm);
         break;
+    case UCC_COLL_TYPE_GATHER:
+        coll = new ucc_pt_coll_gather(cfg.dt, cfg.mt, cfg.inplace, comm);
+        break;
+    case UCC_COLL_TYPE_GATHERV:
+        coll = new ucc_pt_coll_gatherv(cfg.dt, cfg.mt, cfg.inplace, comm);
+        break;
     case UCC_COLL_TYPE_REDUCE:
         coll = new ucc_pt_coll_reduce(cfg.dt, cfg.mt, cfg.op, cfg.inplace,
                                       comm);
         break;
+    case UCC_COLL_TYPE_SCATTER:
+        coll = new ucc_pt_coll_scatter(cfg.dt, cfg.mt, cfg.inplace, comm);
+        break;
+    case UCC_COLL_TYPE_SCATTERV:
+        coll = new ucc_pt_coll_scatterv(cfg.dt, cfg.mt, cfg.inplace, comm);
+        break;
     default:
         throw std::runtime_error("not supported collective");
     }
@@ -47,7 +63,7 @@ ucc_status_t ucc_pt_benchmark::run_bench() noexcept
     size_t max_count = coll->has_range() ? config.max_count : 1;
     ucc_status_t st;
     ucc_coll_args_t args;
-    std::chrono::nanoseconds time;
+    std::chrono::nanoseconds time, cpu_time, ovrl_time, ovrl_cpu_time;
 
     print_header();
     for (size_t cnt = min_count; cnt <= max_count; cnt *= 2) {
@@ -59,8 +75,19 @@ ucc_status_t ucc_pt_benchmark::run_bench() noexcept
             warmup = config.n_warmup_large;
         }
         UCCCHECK_GOTO(coll->init_coll_args(cnt, args), exit_err, st);
-        UCCCHECK_GOTO(run_single_test(args, warmup, iter, time), free_coll, st);
-        print_time(cnt, args, time);
+        UCCCHECK_GOTO(run_single_test(args, warmup, iter,
+                                      std::chrono::nanoseconds::zero(), time,
+                                      cpu_time),
+                      free_coll, st);
+        ovrl_time = std::chrono::nanoseconds::zero();
+        if (config.overlap) {
+            /* compute for the duration of the collective between post and
+               completion */
+            UCCCHECK_GOTO(run_single_test(args, warmup, iter, time,
+                                          ovrl_time, ovrl_cpu_time),
+                          free_coll, st);
+        }
+        print_time(cnt, args, time, cpu_time, ovrl_time);
         coll->free_coll_args(args);
     }
 
@@ -71,9 +98,60 @@ exit_err:
     return st;
 }
 
+ucc_status_t ucc_pt_benchmark::measure(size_t count, float &time_avg,
+                                       float &time_min, float &time_max,
+                                       size_t &msgsize) noexcept
+{
+    size_t               coll_size = count * ucc_dt_size(config.dt);
+    int                  iter      = config.n_iter_small;
+    int                  warmup    = config.n_warmup_small;
+    ucc_base_coll_args_t bargs;
+    ucc_coll_args_t      args;
+    ucc_status_t         st;
+    std::chrono::nanoseconds time, cpu_time;
+    float                time_us;
+
+    if (coll_size >= config.large_thresh) {
+        iter   = config.n_iter_large;
+        warmup = config.n_warmup_large;
+    }
+    UCCCHECK_GOTO(coll->init_coll_args(count, args), exit_err, st);
+    UCCCHECK_GOTO(run_single_test(args, warmup, iter,
+                                  std::chrono::nanoseconds::zero(), time,
+                                  cpu_time),
+                  free_coll, st);
+    memset(&bargs, 0, sizeof(bargs));
+    bargs.args = args;
+    msgsize    = ucc_coll_args_msgsize(&bargs);
+    time_us    = time.count() / 1000.0;
+    comm->allreduce(&time_us, &time_min, 1, UCC_OP_MIN);
+    comm->allreduce(&time_us, &time_max, 1, UCC_OP_MAX);
+    comm->allreduce(&time_us, &time_avg, 1, UCC_OP_SUM);
+    time_avg /= comm->get_size();
+free_coll:
+    coll->free_coll_args(args);
+exit_err:
+    return st;
+}
+
+/* emulates application computation, does not call into UCC */
+static void ucc_pt_compute(std::chrono::nanoseconds time)
+{
+    auto              s = std::chrono::high_resolution_clock::now();
+    volatile uint64_t v = 0;
+
+    while (std::chrono::high_resolution_clock::now() - s < time) {
+        for (int i = 0; i < 64; i++) {
+            v = v + i;
+        }
+    }
+}
+
 ucc_status_t ucc_pt_benchmark::run_single_test(ucc_coll_args_t args,
                                                int nwarmup, int niter,
-                                               std::chrono::nanoseconds &time)
+                                               std::chrono::nanoseconds compute,
+                                               std::chrono::nanoseconds &time,
+                                               std::chrono::nanoseconds &cpu_time)
                                                noexcept
 {
     ucc_team_h    team = comm->get_team();
@@ -82,28 +160,41 @@ ucc_status_t ucc_pt_benchmark::run_single_test(ucc_coll_args_t args,
     ucc_coll_req_h req;
 
     UCCCHECK_GOTO(comm->barrier(), exit_err, st);
-    time = std::chrono::nanoseconds::zero();
+    time     = std::chrono::nanoseconds::zero();
+    cpu_time = std::chrono::nanoseconds::zero();
     for (int i = 0; i < nwarmup + niter; i++) {
-        auto s = std::chrono::high_resolution_clock::now();
+        auto    s   = std::chrono::high_resolution_clock::now();
+        clock_t c_s = std::clock();
         UCCCHECK_GOTO(ucc_collective_init(&args, &req, team), exit_err, st);
         UCCCHECK_GOTO(ucc_collective_post(req), free_req, st);
-        st = ucc_collective_test(req);
-        while (st == UCC_INPROGRESS) {
-            UCCCHECK_GOTO(ucc_context_progress(ctx), free_req, st);
+        if (compute.count() > 0) {
+            ucc_pt_compute(compute);
+        }
+        if (config.wait_mode) {
+            st = ucc_collective_wait(req, -1);
+        } else {
             st = ucc_collective_test(req);
+            while (st == UCC_INPROGRESS) {
+                UCCCHECK_GOTO(ucc_context_progress(ctx), free_req, st);
+                st = ucc_collective_test(req);
+            }
         }
         ucc_collective_finalize(req);
-        auto f = std::chrono::high_resolution_clock::now();
+        auto    f   = std::chrono::high_resolution_clock::now();
+        clock_t c_f = std::clock();
         if (st != UCC_OK) {
             goto exit_err;
         }
         if (i >= nwarmup) {
             time += std::chrono::duration_cast<std::chrono::nanoseconds>(f - s);
+            cpu_time += std::chrono::nanoseconds(
+                (long long)((double)(c_f - c_s) * 1e9 / CLOCKS_PER_SEC));
         }
         UCCCHECK_GOTO(comm->barrier(), exit_err, st);
     }
     if (niter != 0) {
         time /= niter;
+        cpu_time /= niter;
     }
     return UCC_OK;
 free_req:
@@ -155,6 +246,12 @@ void ucc_pt_benchmark::print_header()
         std::cout << std::setw(12) << "Count"
                   << std::setw(12) << "Size"
                   << std::setw(24) << "Time, us";
+        if (config.cpu_time) {
+            std::cout << std::setw(36) << "CPU time, us";
+        }
+        if (config.overlap) {
+            std::cout << std::setw(36) << "Overlap, %";
+        }
         if (config.full_print) {
             std::cout << std::setw(42) << "Bandwidth, GB/s";
         }
@@ -162,6 +259,16 @@ void ucc_pt_benchmark::print_header()
         std::cout << std::setw(36) << "avg"
                   << std::setw(12) << "min"
                   << std::setw(12) << "max";
+        if (config.cpu_time) {
+            std::cout << std::setw(12) << "avg"
+                      << std::setw(12) << "min"
+                      << std::setw(12) << "max";
+        }
+        if (config.overlap) {
+            std::cout << std::setw(12) << "avg"
+                      << std::setw(12) << "min"
+                      << std::setw(12) << "max";
+        }
         if (config.full_print) {
             std::cout << std::setw(12) << "avg"
                       << std::setw(12) << "max"
@@ -172,17 +279,42 @@ void ucc_pt_benchmark::print_header()
 }
 
 void ucc_pt_benchmark::print_time(size_t count, ucc_coll_args_t args,
-                                  std::chrono::nanoseconds time)
+                                  std::chrono::nanoseconds time,
+                                  std::chrono::nanoseconds cpu_time,
+                                  std::chrono::nanoseconds ovrl_time)
 {
     float  time_ms = time.count() / 1000.0;
+    float  cpu_ms  = cpu_time.count() / 1000.0;
     size_t size    = count * ucc_dt_size(config.dt);
     int    gsize  = comm->get_size();
     float time_avg, time_min, time_max;
+    float cpu_avg, cpu_min, cpu_max;
+    float ovrl, ovrl_avg, ovrl_min, ovrl_max;
 
     comm->allreduce(&time_ms, &time_min, 1, UCC_OP_MIN);
     comm->allreduce(&time_ms, &time_max, 1, UCC_OP_MAX);
     comm->allreduce(&time_ms, &time_avg, 1, UCC_OP_SUM);
     time_avg /= gsize;
+    if (config.cpu_time) {
+        comm->allreduce(&cpu_ms, &cpu_min, 1, UCC_OP_MIN);
+        comm->allreduce(&cpu_ms, &cpu_max, 1, UCC_OP_MAX);
+        comm->allreduce(&cpu_ms, &cpu_avg, 1, UCC_OP_SUM);
+        cpu_avg /= gsize;
+    }
+    if (config.overlap) {
+        /* share of the collective time hidden behind computation of the same
+           duration: 100% - fully overlapped, 0% - serialized */
+        ovrl = 0;
+        if (time.count() > 0) {
+            ovrl = 100.0 * (1.0 - (float)(ovrl_time.count() - time.count()) /
+                                      time.count());
+            ovrl = std::min(std::max(ovrl, 0.0f), 100.0f);
+        }
+        comm->allreduce(&ovrl, &ovrl_min, 1, UCC_OP_MIN);
+        comm->allreduce(&ovrl, &ovrl_max, 1, UCC_OP_MAX);
+        comm->allreduce(&ovrl, &ovrl_avg, 1, UCC_OP_SUM);
+        ovrl_avg /= gsize;
+    }
 
     if (comm->get_rank() == 0) {
         std::ios iostate(nullptr);
@@ -197,6 +329,16 @@ void ucc_pt_benchmark::print_time(size_t count, ucc_coll_args_t args,
                   << std::setw(12) << time_avg
                   << std::setw(12) << time_min
                   << std::setw(12) << time_max;
+        if (config.cpu_time) {
+            std::cout << std::setw(12) << cpu_avg
+                      << std::setw(12) << cpu_min
+                      << std::setw(12) << cpu_max;
+        }
+        if (config.overlap) {
+            std::cout << std::setw(12) << ovrl_avg
+                      << std::setw(12) << ovrl_min
+                      << std::setw(12) << ovrl_max;
+        }
 
         if (config.full_print) {
             if (!coll->has_bw()) {
@@ -21,13 +21,22 @@ class ucc_pt_benchmark {
     ucc_status_t barrier();
     void print_header();
     void print_time(size_t count, ucc_coll_args_t args,
-                    std::chrono::nanoseconds time);
+                    std::chrono::nanoseconds time,
+                    std::chrono::nanoseconds cpu_time,
+                    std::chrono::nanoseconds ovrl_time);
 public:
     ucc_pt_benchmark(ucc_pt_benchmark_config cfg, ucc_pt_comm *communicator);
     ucc_status_t run_bench() noexcept;
+    /* measures the collective of "count" elements without printing: time of
+       single collective in us (avg/min/max over ranks) and message size used
+       by the algorithm selection */
+    ucc_status_t measure(size_t count, float &time_avg, float &time_min,
+                         float &time_max, size_t &msgsize) noexcept;
     ucc_status_t run_single_test(ucc_coll_args_t args,
                                  int nwarmup, int niter,
-                                 std::chrono::nanoseconds &time) noexcept;
+                                 std::chrono::nanoseconds compute,
+                                 std::chrono::nanoseconds &time,
+                                 std::chrono::nanoseconds &cpu_time) noexcept;
     ~ucc_pt_benchmark();
 };
 
@@ -79,9 +79,12 @@ public:
 };
 
 class ucc_pt_coll_alltoallv: public ucc_pt_coll {
+    ucc_pt_counts_pattern_t pattern;
+    size_t get_count(size_t count, int src, int dst);
 public:
     ucc_pt_coll_alltoallv(ucc_datatype_t dt, ucc_memory_type mt,
-                          bool is_inplace, ucc_pt_comm *communicator);
+                          bool is_inplace, ucc_pt_counts_pattern_t pattern,
+                          ucc_pt_comm *communicator);
     ucc_status_t init_coll_args(size_t count, ucc_coll_args_t &args) override;
     void free_coll_args(ucc_coll_args_t &args) override;
 };
@@ -102,6 +105,23 @@ public:
     float get_bw(float time_ms, int grsize, ucc_coll_args_t args) override;
 };
 
+class ucc_pt_coll_gather: public ucc_pt_coll {
+public:
+    ucc_pt_coll_gather(ucc_datatype_t dt, ucc_memory_type mt,
+                       bool is_inplace, ucc_pt_comm *communicator);
+    ucc_status_t init_coll_args(size_t count, ucc_coll_args_t &args) override;
+    void free_coll_args(ucc_coll_args_t &args) override;
+    float get_bw(float time_ms, int grsize, ucc_coll_args_t args) override;
+};
+
+class ucc_pt_coll_gatherv: public ucc_pt_coll {
+public:
+    ucc_pt_coll_gatherv(ucc_datatype_t dt, ucc_memory_type mt,
+                        bool is_inplace, ucc_pt_comm *communicator);
+    ucc_status_t init_coll_args(size_t count, ucc_coll_args_t &args) override;
+    void free_coll_args(ucc_coll_args_t &args) override;
+};
+
 class ucc_pt_coll_reduce: public ucc_pt_coll {
 public:
     ucc_pt_coll_reduce(ucc_datatype_t dt, ucc_memory_type mt,
@@ -112,4 +132,21 @@ public:
     float get_bw(float time_ms, int grsize, ucc_coll_args_t args) override;
 };
 
+class ucc_pt_coll_scatter: public ucc_pt_coll {
+public:
+    ucc_pt_coll_scatter(ucc_datatype_t dt, ucc_memory_type mt,
+                        bool is_inplace, ucc_pt_comm *communicator);
+    ucc_status_t init_coll_args(size_t count, ucc_coll_args_t &args) override;
+    void free_coll_args(ucc_coll_args_t &args) override;
+    float get_bw(float time_ms, int grsize, ucc_coll_args_t args) override;
+};
+
+class ucc_pt_coll_scatterv: public ucc_pt_coll {
+public:
+    ucc_pt_coll_scatterv(ucc_datatype_t dt, ucc_memory_type mt,
+                         bool is_inplace, ucc_pt_comm *communicator);
+    ucc_status_t init_coll_args(size_t count, ucc_coll_args_t &args) override;
+    void free_coll_args(ucc_coll_args_t &args) override;
+};
+
 #endif
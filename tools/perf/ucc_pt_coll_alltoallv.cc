@@ -6,8 +6,10 @@
 
 ucc_pt_coll_alltoallv::ucc_pt_coll_alltoallv(ucc_datatype_t dt,
                          ucc_memory_type mt, bool is_inplace,
+                         ucc_pt_counts_pattern_t pattern,
                          ucc_pt_comm *communicator) : ucc_pt_coll(communicator)
 {
+    this->pattern  = pattern;
     has_inplace_   = true;
     has_reduction_ = false;
     has_range_     = true;
@@ -25,14 +27,37 @@ ucc_pt_coll_alltoallv::ucc_pt_coll_alltoallv(ucc_datatype_t dt,
     }
 }
 
+size_t ucc_pt_coll_alltoallv::get_count(size_t count, int src, int dst)
+{
+    int size = comm->get_size();
+    int dist = (dst - src + size) % size;
+
+    switch (pattern) {
+    case UCC_PT_COUNTS_SPARSE:
+        /* self and peers at power of 2 distance: log2(size) + 1 peers */
+        return (dist & (dist - 1)) == 0 ? count : 0;
+    case UCC_PT_COUNTS_SKEWED:
+        return dst < (size + 7) / 8 ? 8 * count : count;
+    default:
+        return count;
+    }
+}
+
 ucc_status_t ucc_pt_coll_alltoallv::init_coll_args(size_t count,
                                                    ucc_coll_args_t &args)
 {
     int          comm_size = comm->get_size();
+    int          comm_rank = comm->get_rank();
     size_t       dt_size   = ucc_dt_size(coll_args.src.info_v.datatype);
-    size_t       size      = comm_size * count * dt_size;
+    size_t       src_count = 0;
+    size_t       dst_count = 0;
     ucc_status_t st        = UCC_OK;
 
+    for (int i = 0; i < comm_size; i++) {
+        src_count += get_count(count, comm_rank, i);
+        dst_count += get_count(count, i, comm_rank);
+    }
+
     args = coll_args;
     args.src.info_v.counts = (ucc_count_t *) ucc_malloc(comm_size * sizeof(uint32_t), "counts buf");
     UCC_MALLOC_CHECK_GOTO(args.src.info_v.counts, exit, st);
@@ -42,19 +67,26 @@ ucc_status_t ucc_pt_coll_alltoallv::init_coll_args(size_t count,
     UCC_MALLOC_CHECK_GOTO(args.dst.info_v.counts, free_src_displ, st);
     args.dst.info_v.displacements = (ucc_aint_t *) ucc_malloc(comm_size * sizeof(uint32_t), "displacements buf");
     UCC_MALLOC_CHECK_GOTO(args.dst.info_v.displacements, free_dst_count, st);
-    UCCCHECK_GOTO(ucc_mc_alloc(&dst_header, size, args.dst.info_v.mem_type),
+    UCCCHECK_GOTO(ucc_mc_alloc(&dst_header,
+                               ucc_max(src_count, dst_count) * dt_size,
+                               args.dst.info_v.mem_type),
                   free_dst_displ, st);
     args.dst.info_v.buffer = dst_header->addr;
     if (!UCC_IS_INPLACE(args)) {
-        UCCCHECK_GOTO(ucc_mc_alloc(&src_header, size, args.src.info_v.mem_type),
+        UCCCHECK_GOTO(ucc_mc_alloc(&src_header, src_count * dt_size,
+                                   args.src.info_v.mem_type),
                       free_dst, st);
         args.src.info_v.buffer = src_header->addr;
     }
+    src_count = 0;
+    dst_count = 0;
     for (int i = 0; i < comm_size; i++) {
-        ((uint32_t*)args.src.info_v.counts)[i] = count;
-        ((uint32_t*)args.src.info_v.displacements)[i] = count * i;
-        ((uint32_t*)args.dst.info_v.counts)[i] = count;
-        ((uint32_t*)args.dst.info_v.displacements)[i] = count * i;
+        ((uint32_t*)args.src.info_v.counts)[i] = get_count(count, comm_rank, i);
+        ((uint32_t*)args.src.info_v.displacements)[i] = src_count;
+        ((uint32_t*)args.dst.info_v.counts)[i] = get_count(count, i, comm_rank);
+        ((uint32_t*)args.dst.info_v.displacements)[i] = dst_count;
+        src_count += ((uint32_t*)args.src.info_v.counts)[i];
+        dst_count += ((uint32_t*)args.dst.info_v.counts)[i];
     }
     return UCC_OK;
 free_dst:
@@ -0,0 +1,79 @@
+#include "ucc_pt_coll.h"
+#include "ucc_perftest.h"
+#include <ucc/api/ucc.h>
+#include <utils/ucc_math.h>
+#include <utils/ucc_coll_utils.h>
+
+ucc_pt_coll_scatter::ucc_pt_coll_scatter(ucc_datatype_t dt, ucc_memory_type mt,
+                         bool is_inplace, ucc_pt_comm *communicator) :
+                         ucc_pt_coll(communicator)
+{
+    has_inplace_   = true;
+    has_reduction_ = false;
+    has_range_     = true;
+    has_bw_        = true;
+
+    coll_args.mask = 0;
+    coll_args.coll_type = UCC_COLL_TYPE_SCATTER;
+    coll_args.root = 0;
+    coll_args.src.info.datatype = dt;
+    coll_args.src.info.mem_type = mt;
+    coll_args.dst.info.datatype = dt;
+    coll_args.dst.info.mem_type = mt;
+    if (is_inplace) {
+        coll_args.mask = UCC_COLL_ARGS_FIELD_FLAGS;
+        coll_args.flags = UCC_COLL_ARGS_FLAG_IN_PLACE;
+    }
+}
+
+ucc_status_t ucc_pt_coll_scatter::init_coll_args(size_t count,
+                                                 ucc_coll_args_t &args)
+{
+    size_t dt_size  = ucc_dt_size(coll_args.dst.info.datatype);
+    size_t size_src = comm->get_size() * count * dt_size;
+    size_t size_dst = count * dt_size;
+    bool   is_root  = (comm->get_rank() == coll_args.root);
+    ucc_status_t st = UCC_OK;
+
+    args = coll_args;
+    args.dst.info.count = count;
+    if (is_root) {
+        args.src.info.count = comm->get_size() * count;
+        UCCCHECK_GOTO(ucc_mc_alloc(&src_header, size_src,
+                                   args.src.info.mem_type), exit, st);
+        args.src.info.buffer = src_header->addr;
+    }
+    if (!is_root || !UCC_IS_INPLACE(args)) {
+        UCCCHECK_GOTO(ucc_mc_alloc(&dst_header, size_dst,
+                                   args.dst.info.mem_type), free_src, st);
+        args.dst.info.buffer = dst_header->addr;
+    }
+    return UCC_OK;
+free_src:
+    if (is_root) {
+        ucc_mc_free(src_header);
+    }
+exit:
+    return st;
+}
+
+void ucc_pt_coll_scatter::free_coll_args(ucc_coll_args_t &args)
+{
+    bool is_root = (comm->get_rank() == args.root);
+
+    if (!is_root || !UCC_IS_INPLACE(args)) {
+        ucc_mc_free(dst_header);
+    }
+    if (is_root) {
+        ucc_mc_free(src_header);
+    }
+}
+
+float ucc_pt_coll_scatter::get_bw(float time_ms, int grsize,
+                                  ucc_coll_args_t args)
+{
+    float N = grsize;
+    float S = N * args.dst.info.count * ucc_dt_size(args.dst.info.datatype);
+
+    return (S / time_ms) * ((N - 1) / N) / 1000.0;
+}
@@ -23,6 +23,7 @@ public:
     ucc_pt_comm(ucc_pt_comm_config config);
     int get_rank();
     int get_size();
+    int get_ppn();
     ucc_team_h get_team();
     ucc_context_h get_context();
     ~ucc_pt_comm();
@@ -15,6 +15,10 @@ ucc_pt_config::ucc_pt_config() {
     bench.n_warmup_large = 20;
     bench.large_thresh   = 64 * 1024;
     bench.full_print     = false;
+    bench.wait_mode      = false;
+    bench.cpu_time       = false;
+    bench.overlap        = false;
+    bench.counts_pattern = UCC_PT_COUNTS_UNIFORM;
 }
 
 const std::map<std::string, ucc_reduction_op_t> ucc_pt_op_map = {
@@ -30,7 +34,17 @@ const std::map<std::string, ucc_coll_type_t> ucc_pt_coll_map = {
     {"alltoallv", UCC_COLL_TYPE_ALLTOALLV},
     {"barrier", UCC_COLL_TYPE_BARRIER},
     {"bcast", UCC_COLL_TYPE_BCAST},
+    {"gather", UCC_COLL_TYPE_GATHER},
+    {"gatherv", UCC_COLL_TYPE_GATHERV},
     {"reduce", UCC_COLL_TYPE_REDUCE},
+    {"scatter", UCC_COLL_TYPE_SCATTER},
+    {"scatterv", UCC_COLL_TYPE_SCATTERV},
+};
+
+const std::map<std::string, ucc_pt_counts_pattern_t> ucc_pt_counts_pattern_map = {
+    {"uniform", UCC_PT_COUNTS_UNIFORM},
+    {"sparse", UCC_PT_COUNTS_SPARSE},
+    {"skewed", UCC_PT_COUNTS_SKEWED},
 };
 
 const std::map<std::string, ucc_memory_type_t> ucc_pt_memtype_map = {
@@ -54,73 +68,161 @@ const std::map<std::string, ucc_datatype_t> ucc_pt_datatype_map = {
     {"uint128", UCC_DT_UINT128},
 };
 
+ucc_status_t ucc_pt_config::process_bench_arg(int c, const char *arg)
+{
+    switch (c) {
+        case 'c':
+            if (ucc_pt_coll_map.count(arg) == 0) {
+                std::cerr << "invalid collective" << std::endl;
+                return UCC_ERR_INVALID_PARAM;
+            }
+            bench.coll_type = ucc_pt_coll_map.at(arg);
+            break;
+        case 'o':
+            if (ucc_pt_op_map.count(arg) == 0) {
+                std::cerr << "invalid operation" << std::endl;
+                return UCC_ERR_INVALID_PARAM;
+            }
+            bench.op = ucc_pt_op_map.at(arg);
+            break;
+        case 'm':
+            if (ucc_pt_memtype_map.count(arg) == 0) {
+                std::cerr << "invalid memory type" << std::endl;
+                return UCC_ERR_INVALID_PARAM;
+            }
+            bench.mt = ucc_pt_memtype_map.at(arg);
+            comm.mt  = bench.mt;
+            break;
+        case 'd':
+            if (ucc_pt_datatype_map.count(arg) == 0) {
+                std::cerr << "invalid datatype" << std::endl;
+                return UCC_ERR_INVALID_PARAM;
+            }
+            bench.dt = ucc_pt_datatype_map.at(arg);
+            break;
+        case 'p':
+            if (ucc_pt_counts_pattern_map.count(arg) == 0) {
+                std::cerr << "invalid counts pattern" << std::endl;
+                return UCC_ERR_INVALID_PARAM;
+            }
+            bench.counts_pattern = ucc_pt_counts_pattern_map.at(arg);
+            break;
+        case 'b':
+            std::stringstream(arg) >> bench.min_count;
+            break;
+        case 'e':
+            std::stringstream(arg) >> bench.max_count;
+            break;
+        case 'n':
+            std::stringstream(arg) >> bench.n_iter_small;
+            bench.n_iter_large = bench.n_iter_small;
+            break;
+        case 'w':
+            std::stringstream(arg) >> bench.n_warmup_small;
+            bench.n_warmup_large = bench.n_warmup_small;
+            break;
+        case 'i':
+            bench.inplace = true;
+            break;
+        case 'F':
+            bench.full_print = true;
+            break;
+        case 'W':
+            bench.wait_mode = true;
+            break;
+        case 'C':
+            bench.cpu_time = true;
+            break;
+        case 'O':
+            bench.overlap = true;
+            break;
+        default:
+            return UCC_ERR_NOT_FOUND;
+    }
+    return UCC_OK;
+}
+
 ucc_status_t ucc_pt_config::process_args(int argc, char *argv[])
 {
-    int c;
+    ucc_status_t st;
+    int          c;
+
+    while ((c = getopt(argc, argv, "c:b:e:d:m:n:w:o:p:ihFWCO")) != -1) {
+        st = process_bench_arg(c, optarg);
+        if (st == UCC_ERR_NOT_FOUND) {
+            print_help();
+            std::exit(0);
+        } else if (st != UCC_OK) {
+            return st;
+        }
+    }
+    return UCC_OK;
+}
+
+template <typename T>
+static ucc_status_t ucc_pt_parse_list(const char *arg, std::vector<T> &list)
+{
+    std::stringstream ss(arg);
+    std::string       item;
 
-    while ((c = getopt(argc, argv, "c:b:e:d:m:n:w:o:ihF")) != -1) {
+    list.clear();
+    while (std::getline(ss, item, ',')) {
+        if (item == "inf") {
+            /* no fragmentation */
+            list.push_back(0);
+            continue;
+        }
+        T v;
+        if (!(std::stringstream(item) >> v)) {
+            return UCC_ERR_INVALID_PARAM;
+        }
+        list.push_back(v);
+    }
+    return list.empty() ? UCC_ERR_INVALID_PARAM : UCC_OK;
+}
+
+ucc_status_t ucc_pt_config::process_tune_args(int argc, char *argv[])
+{
+    ucc_status_t st;
+    int          c;
+
+    tune.radices        = {2, 4, 8};
+    tune.sra_frag_sizes = {0};
+    while ((c = getopt(argc, argv, "c:b:e:d:m:n:w:o:p:r:s:t:j:ih")) != -1) {
         switch (c) {
-            case 'c':
-                if (ucc_pt_coll_map.count(optarg) == 0) {
-                    std::cerr << "invalid collective" << std::endl;
-                    return UCC_ERR_INVALID_PARAM;
-                }
-                bench.coll_type = ucc_pt_coll_map.at(optarg);
-                break;
-            case 'o':
-                if (ucc_pt_op_map.count(optarg) == 0) {
-                    std::cerr << "invalid operation" << std::endl;
-                    return UCC_ERR_INVALID_PARAM;
-                }
-                bench.op = ucc_pt_op_map.at(optarg);
-                break;
-            case 'm':
-                if (ucc_pt_memtype_map.count(optarg) == 0) {
-                    std::cerr << "invalid memory type" << std::endl;
+            case 'r':
+                if (UCC_OK != ucc_pt_parse_list(optarg, tune.radices)) {
+                    std::cerr << "invalid radix list" << std::endl;
                     return UCC_ERR_INVALID_PARAM;
                 }
-                bench.mt = ucc_pt_memtype_map.at(optarg);
-                comm.mt  = bench.mt;
                 break;
-            case 'd':
-                if (ucc_pt_datatype_map.count(optarg) == 0) {
-                    std::cerr << "invalid datatype" << std::endl;
+            case 's':
+                if (UCC_OK != ucc_pt_parse_list(optarg, tune.sra_frag_sizes)) {
+                    std::cerr << "invalid SRA fragment size list" << std::endl;
                     return UCC_ERR_INVALID_PARAM;
                 }
-                bench.dt = ucc_pt_datatype_map.at(optarg);
-                break;
-            case 'b':
-                std::stringstream(optarg) >> bench.min_count;
                 break;
-            case 'e':
-                std::stringstream(optarg) >> bench.max_count;
+            case 't':
+                tune.tune_file = optarg;
                 break;
-            case 'n':
-                std::stringstream(optarg) >> bench.n_iter_small;
-                bench.n_iter_large = bench.n_iter_small;
+            case 'j':
+                tune.json_file = optarg;
                 break;
-            case 'w':
-                std::stringstream(optarg) >> bench.n_warmup_small;
-                bench.n_warmup_large = bench.n_warmup_small;
-                break;
-            case 'i':
-                bench.inplace = true;
-                break;
-            case 'F':
-                bench.full_print = true;
-                break;
-            case 'h':
             default:
-                print_help();
-                std::exit(0);
+                st = process_bench_arg(c, optarg);
+                if (st == UCC_ERR_NOT_FOUND) {
+                    print_tune_help();
+                    std::exit(0);
+                } else if (st != UCC_OK) {
+                    return st;
+                }
         }
     }
     return UCC_OK;
 }
 
-void ucc_pt_config::print_help()
+void ucc_pt_config::print_bench_help()
 {
-    std::cout << "Usage: ucc_perftest [options]"<<std::endl;
     std::cout << "  -c <collective name>: Collective type"<<std::endl;
     std::cout << "  -b <count>: Min number of elements"<<std::endl;
     std::cout << "  -e <count>: Max number of elements"<<std::endl;
@@ -128,9 +230,39 @@ void ucc_pt_config::print_help()
     std::cout << "  -d <dt name>: datatype"<<std::endl;
     std::cout << "  -o <op name>: reduction operation type"<<std::endl;
     std::cout << "  -m <mtype name>: memory type"<<std::endl;
+    std::cout << "  -p <pattern>: counts pattern of alltoallv: uniform, "
+                 "sparse, skewed"<<std::endl;
     std::cout << "  -n <number>: number of iterations"<<std::endl;
     std::cout << "  -w <number>: number of warmup iterations"<<std::endl;
+}
+
+void ucc_pt_config::print_help()
+{
+    std::cout << "Usage: ucc_perftest [options]"<<std::endl;
+    print_bench_help();
     std::cout << "  -F: enable full print"<<std::endl;
+    std::cout << "  -W: wait for completion with ucc_collective_wait "
+                 "instead of busy polling"<<std::endl;
+    std::cout << "  -C: report CPU time consumed per collective"<<std::endl;
+    std::cout << "  -O: measure overlap of collective with computation "
+                 "(use UCC_PROGRESS_THREAD=y for asynchronous progress)"
+              <<std::endl;
+    std::cout << "  -h: show this help message"<<std::endl;
+    std::cout << std::endl;
+}
+
+void ucc_pt_config::print_tune_help()
+{
+    std::cout << "Usage: ucc_tune [options]"<<std::endl;
+    print_bench_help();
+    std::cout << "  -r <list>: radices of knomial algorithms, default 2,4,8"
+              <<std::endl;
+    std::cout << "  -s <list>: fragment sizes of SRA knomial allreduce, "
+                 "inf - no fragmentation, default inf"<<std::endl;
+    std::cout << "  -t <file>: append selection to the tuning file, "
+                 "see UCC_TUNE_FILE"<<std::endl;
+    std::cout << "  -j <file>: write JSON report of all measured "
+                 "configurations"<<std::endl;
     std::cout << "  -h: show this help message"<<std::endl;
     std::cout << std::endl;
 }
@@ -11,6 +11,7 @@
 #include <sstream>
 #include <string>
 #include <map>
+#include <vector>
 #include <getopt.h>
 #include <ucc/api/ucc.h>
 
@@ -19,6 +20,13 @@ enum ucc_pt_bootstrap_type_t {
     UCC_PT_BOOTSTRAP_UCX
 };
 
+/* distribution of the per peer counts of the vector collectives */
+enum ucc_pt_counts_pattern_t {
+    UCC_PT_COUNTS_UNIFORM, /* same count for every peer */
+    UCC_PT_COUNTS_SPARSE,  /* count only for peers at power of 2 distance */
+    UCC_PT_COUNTS_SKEWED   /* first 1/8 of the ranks receive 8x count */
+};
+
 struct ucc_pt_bootstrap_config {
     ucc_pt_bootstrap_type_t bootstrap;
 };
@@ -41,16 +49,33 @@ struct ucc_pt_benchmark_config {
     int                n_iter_large;
     int                n_warmup_large;
     bool               full_print;
+    bool               wait_mode;
+    bool               cpu_time;
+    bool               overlap;
+    ucc_pt_counts_pattern_t counts_pattern;
+};
+
+struct ucc_pt_tune_config {
+    std::vector<unsigned> radices;
+    std::vector<size_t>   sra_frag_sizes; /* 0 - SRA is not fragmented */
+    std::string           tune_file;
+    std::string           json_file;
 };
 
 struct ucc_pt_config {
     ucc_pt_bootstrap_config bootstrap;
     ucc_pt_comm_config      comm;
     ucc_pt_benchmark_config bench;
+    ucc_pt_tune_config      tune;
 
     ucc_pt_config();
     ucc_status_t process_args(int argc, char *argv[]);
+    ucc_status_t process_tune_args(int argc, char *argv[]);
     void print_help();
+    void print_tune_help();
+private:
+    ucc_status_t process_bench_arg(int c, const char *arg);
+    void print_bench_help();
 };
 
 #endif
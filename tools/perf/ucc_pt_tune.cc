@@ -0,0 +1,393 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include "ucc_pt_tune.h"
+#include "ucc_pt_benchmark.h"
+#include "ucc_perftest.h"
+extern "C" {
+#include "core/ucc_global_opts.h"
+#include "components/tl/ucc_tl.h"
+#include "utils/ucc_coll_utils.h"
+}
+
+#define UCC_PT_TUNE_TL        "ucp"
+#define UCC_PT_TUNE_ENV       "UCC_TL_UCP_TUNE"
+#define UCC_PT_TUNE_ENV_FRAG  "UCC_TL_UCP_ALLREDUCE_SRA_KN_FRAG_SIZE"
+#define UCC_PT_TUNE_ENV_FTHR  "UCC_TL_UCP_ALLREDUCE_SRA_KN_FRAG_THRESH"
+
+ucc_pt_tune::ucc_pt_tune(ucc_pt_config &cfg, ucc_pt_comm *communicator):
+    config(cfg),
+    comm(communicator)
+{
+}
+
+static std::string ucc_pt_tune_coll_name(ucc_coll_type_t coll_type)
+{
+    std::string name = ucc_coll_type_str(coll_type);
+
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name;
+}
+
+static std::string ucc_pt_tune_mt_name(ucc_memory_type_t mt)
+{
+    std::string name = ucc_memory_type_names[mt];
+
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name;
+}
+
+void ucc_pt_tune::set_env(const std::string &name, const std::string &value)
+{
+    const char *v;
+
+    if (saved_env.count(name) == 0) {
+        v               = std::getenv(name.c_str());
+        saved_env[name] = std::make_pair(v != nullptr, v ? v : "");
+    }
+    setenv(name.c_str(), value.c_str(), 1);
+}
+
+void ucc_pt_tune::restore_env()
+{
+    for (auto &e : saved_env) {
+        if (e.second.first) {
+            setenv(e.first.c_str(), e.second.second.c_str(), 1);
+        } else {
+            unsetenv(e.first.c_str());
+        }
+    }
+    saved_env.clear();
+}
+
+/* Algorithm ids are taken from the same table TL/UCP maps with
+   ucc_tl_ucp_alg_id_to_init. Must be called after UCC is initialized so
+   that TL components are loaded. */
+ucc_status_t ucc_pt_tune::enum_points()
+{
+    ucc_pt_tune_point         p;
+    ucc_base_coll_alg_info_t *info = nullptr;
+    ucc_tl_iface_t           *tl;
+    int                       c;
+
+    for (c = 0; c < ucc_global_config.tl_framework.n_components; c++) {
+        tl = ucc_derived_of(ucc_global_config.tl_framework.components[c],
+                            ucc_tl_iface_t);
+        if (0 == strcmp(tl->super.name, UCC_PT_TUNE_TL)) {
+            info = tl->alg_info[ucc_ilog2(config.bench.coll_type)];
+            break;
+        }
+    }
+    if (!info) {
+        std::cerr << "TL/" UCC_PT_TUNE_TL " does not provide algorithm "
+                     "selection for " << ucc_coll_type_str(config.bench.coll_type)
+                  << std::endl;
+        return UCC_ERR_NOT_SUPPORTED;
+    }
+
+    /* reference point: selection without any tuning */
+    p.alg_id    = -1;
+    p.alg_name  = "default";
+    p.radix     = 0;
+    p.frag_size = 0;
+    points.push_back(p);
+    for (; info->name; info++) {
+        std::string name = info->name;
+        std::vector<unsigned> radices = {0};
+        std::vector<size_t>   frags   = {0};
+
+        if (name.find("knomial") != std::string::npos) {
+            radices.clear();
+            for (auto r : config.tune.radices) {
+                if (r < 2 || (!radices.empty() && r > (unsigned)comm->get_size())) {
+                    /* radix larger than team size is same as team size */
+                    continue;
+                }
+                radices.push_back(r);
+            }
+        }
+        if (config.bench.coll_type == UCC_COLL_TYPE_ALLREDUCE &&
+            name == "sra_knomial") {
+            frags = config.tune.sra_frag_sizes;
+        }
+        for (auto r : radices) {
+            for (auto f : frags) {
+                p.alg_id    = info->id;
+                p.alg_name  = name;
+                p.radix     = r;
+                p.frag_size = f;
+                points.push_back(p);
+            }
+        }
+    }
+    return UCC_OK;
+}
+
+ucc_status_t ucc_pt_tune::measure_point(ucc_pt_tune_point &p)
+{
+    size_t            min_count = config.bench.min_count;
+    size_t            max_count = config.bench.max_count;
+    ucc_pt_benchmark *bench;
+    ucc_pt_tune_sample s;
+    ucc_status_t      st;
+    std::string       tune;
+
+    if (p.alg_id >= 0) {
+        tune = ucc_pt_tune_coll_name(config.bench.coll_type) + ":" +
+               ucc_pt_tune_mt_name(config.bench.mt) + ":0-inf:inf:@" +
+               std::to_string(p.alg_id);
+        if (p.radix) {
+            tune += ":radix=" + std::to_string(p.radix);
+        }
+        set_env(UCC_PT_TUNE_ENV, tune);
+        if (p.frag_size) {
+            set_env(UCC_PT_TUNE_ENV_FTHR, "0");
+            set_env(UCC_PT_TUNE_ENV_FRAG, std::to_string(p.frag_size));
+        }
+    }
+    if (config.bench.coll_type == UCC_COLL_TYPE_BARRIER) {
+        min_count = max_count = 1;
+    }
+    UCCCHECK_GOTO(comm->init(), exit_env, st);
+    try {
+        bench = new ucc_pt_benchmark(config.bench, comm);
+    } catch(std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        st = UCC_ERR_NOT_SUPPORTED;
+        goto exit_comm;
+    }
+    for (size_t cnt = min_count; cnt <= max_count; cnt *= 2) {
+        s.count = cnt;
+        UCCCHECK_GOTO(bench->measure(cnt, s.time_avg, s.time_min,
+                                     s.time_max, s.msgsize),
+                      exit_bench, st);
+        p.samples.push_back(s);
+    }
+exit_bench:
+    delete bench;
+exit_comm:
+    comm->finalize();
+exit_env:
+    restore_env();
+    return st;
+}
+
+void ucc_pt_tune::select()
+{
+    size_t n_samples = points[0].samples.size();
+
+    best.assign(n_samples, -1);
+    for (size_t i = 0; i < n_samples; i++) {
+        for (size_t p = 1; p < points.size(); p++) {
+            if (best[i] < 0 || points[p].samples[i].time_max <
+                               points[best[i]].samples[i].time_max) {
+                best[i] = p;
+            }
+        }
+    }
+}
+
+/* Ranges of consecutive message sizes with the same algorithm and radix are
+   merged. The first range starts from 0 and the last one is open, so that
+   the string covers all message sizes. The ranges are keyed by the team
+   shape: team size, number of nodes and ppn (the latter two only if all the
+   nodes have the same ppn). */
+std::string ucc_pt_tune::score_str()
+{
+    std::vector<ucc_pt_tune_sample> &s     = points[0].samples;
+    int                              size  = comm->get_size();
+    int                              ppn   = comm->get_ppn();
+    std::string                      shape = "[" + std::to_string(size) + "]";
+    std::string                      str;
+    size_t                           i, e;
+
+    if (ppn > 0 && size % ppn == 0) {
+        shape += ":nnodes=[" + std::to_string(size / ppn) + "]:ppn=[" +
+                 std::to_string(ppn) + "]";
+    }
+
+    for (i = 0; i < best.size(); i = e) {
+        const ucc_pt_tune_point &p = points[best[i]];
+
+        for (e = i + 1; e < best.size(); e++) {
+            const ucc_pt_tune_point &n = points[best[e]];
+            if (n.alg_id != p.alg_id || n.radix != p.radix) {
+                break;
+            }
+        }
+        if (!str.empty()) {
+            str += "#";
+        }
+        str += ucc_pt_tune_coll_name(config.bench.coll_type) + ":" +
+               ucc_pt_tune_mt_name(config.bench.mt) + ":" +
+               std::to_string(i == 0 ? 0 : s[i].msgsize) + "-" +
+               (e == best.size() ? "inf" : std::to_string(s[e].msgsize)) +
+               ":" + shape + ":@" + std::to_string(p.alg_id);
+        if (p.radix) {
+            str += ":radix=" + std::to_string(p.radix);
+        }
+    }
+    return str;
+}
+
+static std::string ucc_pt_tune_point_str(const ucc_pt_tune_point &p)
+{
+    std::string str = p.alg_name;
+
+    if (p.radix) {
+        str += " radix " + std::to_string(p.radix);
+    }
+    if (p.frag_size) {
+        str += " frag " + std::to_string(p.frag_size);
+    }
+    return str;
+}
+
+void ucc_pt_tune::print_selection(const std::string &str)
+{
+    std::ios iostate(nullptr);
+
+    iostate.copyfmt(std::cout);
+    std::cout << std::setprecision(2) << std::fixed;
+    std::cout << std::setw(12) << "Count"
+              << std::setw(12) << "Size"
+              << std::setw(16) << "Default, us"
+              << std::setw(16) << "Tuned, us"
+              << "    Selection" << std::endl;
+    for (size_t i = 0; i < best.size(); i++) {
+        const ucc_pt_tune_sample &d = points[0].samples[i];
+        const ucc_pt_tune_point  &p = points[best[i]];
+
+        std::cout << std::setw(12) << d.count
+                  << std::setw(12) << d.msgsize
+                  << std::setw(16) << d.time_max
+                  << std::setw(16) << p.samples[i].time_max
+                  << "    " << ucc_pt_tune_point_str(p) << std::endl;
+    }
+    std::cout.copyfmt(iostate);
+    std::cout << std::endl << UCC_PT_TUNE_ENV "=" << str << std::endl;
+}
+
+/* Tuning file: the selection is keyed by the team shape qualifiers of the
+   TUNE string, so the files of different runs can be concatenated and
+   passed to UCC with UCC_TUNE_FILE */
+void ucc_pt_tune::write_tune_file(const std::string &str)
+{
+    std::ofstream f(config.tune.tune_file, std::ios::app);
+
+    if (!f) {
+        std::cerr << "failed to open tuning file " << config.tune.tune_file
+                  << std::endl;
+        return;
+    }
+    f << "# " << ucc_pt_tune_coll_name(config.bench.coll_type)
+      << " mem_type=" << ucc_pt_tune_mt_name(config.bench.mt)
+      << " dt=" << ucc_datatype_str(config.bench.dt)
+      << " team_size=" << comm->get_size()
+      << " ppn=" << comm->get_ppn() << std::endl;
+    for (size_t i = 0; i < best.size(); i++) {
+        const ucc_pt_tune_point &p = points[best[i]];
+        if (p.frag_size) {
+            f << "# count " << p.samples[i].count << ": "
+              << UCC_PT_TUNE_ENV_FRAG "=" << p.frag_size << std::endl;
+        }
+    }
+    f << UCC_PT_TUNE_ENV "=" << str << std::endl;
+}
+
+void ucc_pt_tune::write_json()
+{
+    std::ofstream f(config.tune.json_file);
+
+    if (!f) {
+        std::cerr << "failed to open JSON report " << config.tune.json_file
+                  << std::endl;
+        return;
+    }
+    f << "{" << std::endl
+      << "  \"collective\": \""
+      << ucc_pt_tune_coll_name(config.bench.coll_type) << "\"," << std::endl
+      << "  \"mem_type\": \"" << ucc_pt_tune_mt_name(config.bench.mt)
+      << "\"," << std::endl
+      << "  \"datatype\": \"" << ucc_datatype_str(config.bench.dt) << "\","
+      << std::endl
+      << "  \"team_size\": " << comm->get_size() << "," << std::endl
+      << "  \"ppn\": " << comm->get_ppn() << "," << std::endl
+      << "  \"tune_str\": \"" << score_str() << "\"," << std::endl
+      << "  \"configurations\": [" << std::endl;
+    for (size_t p = 0; p < points.size(); p++) {
+        f << "    {\"alg_id\": " << points[p].alg_id
+          << ", \"alg_name\": \"" << points[p].alg_name << "\""
+          << ", \"radix\": " << points[p].radix
+          << ", \"sra_frag_size\": " << points[p].frag_size
+          << ", \"samples\": [" << std::endl;
+        for (size_t i = 0; i < points[p].samples.size(); i++) {
+            const ucc_pt_tune_sample &s = points[p].samples[i];
+            f << "      {\"count\": " << s.count
+              << ", \"msgsize\": " << s.msgsize
+              << ", \"time_avg_us\": " << s.time_avg
+              << ", \"time_min_us\": " << s.time_min
+              << ", \"time_max_us\": " << s.time_max
+              << ", \"selected\": "
+              << ((best[i] == (int)p) ? "true" : "false") << "}"
+              << ((i + 1 < points[p].samples.size()) ? "," : "")
+              << std::endl;
+        }
+        f << "    ]}" << ((p + 1 < points.size()) ? "," : "") << std::endl;
+    }
+    f << "  ]" << std::endl << "}" << std::endl;
+}
+
+ucc_status_t ucc_pt_tune::run()
+{
+    ucc_status_t st;
+    std::string  str;
+
+    switch (config.bench.coll_type) {
+    case UCC_COLL_TYPE_ALLGATHERV:
+    case UCC_COLL_TYPE_ALLTOALLV:
+    case UCC_COLL_TYPE_GATHERV:
+    case UCC_COLL_TYPE_SCATTERV:
+        std::cerr << "message size based selection is not supported for "
+                  << ucc_coll_type_str(config.bench.coll_type) << std::endl;
+        return UCC_ERR_NOT_SUPPORTED;
+    default:
+        break;
+    }
+    /* UCC has to be initialized to get the algorithms of TL/UCP */
+    UCCCHECK_GOTO(comm->init(), exit_err, st);
+    st = enum_points();
+    comm->finalize();
+    if (st != UCC_OK) {
+        goto exit_err;
+    }
+    for (auto &p : points) {
+        if (comm->get_rank() == 0) {
+            std::cout << "measuring " << ucc_pt_tune_point_str(p)
+                      << std::endl;
+        }
+        UCCCHECK_GOTO(measure_point(p), exit_err, st);
+    }
+    select();
+    if (comm->get_rank() == 0) {
+        str = score_str();
+        print_selection(str);
+        if (!config.tune.tune_file.empty()) {
+            write_tune_file(str);
+        }
+        if (!config.tune.json_file.empty()) {
+            write_json();
+        }
+    }
+    return UCC_OK;
+exit_err:
+    return st;
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCC_PT_TUNE_H
+#define UCC_PT_TUNE_H
+
+#include "ucc_pt_config.h"
+#include "ucc_pt_comm.h"
+#include <ucc/api/ucc.h>
+#include <string>
+#include <vector>
+#include <map>
+
+/* Offline tuning of TL/UCP algorithm selection. Every configuration
+   (algorithm id x radix x SRA fragment size) is applied through the
+   environment of TL/UCP (UCC_TL_UCP_TUNE with alg id and radix
+   qualifiers), a new UCC lib/context/team is created for it and the
+   collective is measured for the whole message range. The fastest
+   configuration of every message size (max time over ranks) is merged into
+   a single TUNE string. */
+
+struct ucc_pt_tune_sample {
+    size_t count;
+    size_t msgsize;
+    float  time_avg;
+    float  time_min;
+    float  time_max;
+};
+
+struct ucc_pt_tune_point {
+    int         alg_id;    /* -1 - default selection */
+    std::string alg_name;
+    unsigned    radix;     /* 0 - not radix based algorithm */
+    size_t      frag_size; /* 0 - not fragmented */
+    std::vector<ucc_pt_tune_sample> samples;
+};
+
+class ucc_pt_tune {
+    ucc_pt_config                 &config;
+    ucc_pt_comm                   *comm;
+    std::vector<ucc_pt_tune_point> points;
+    std::vector<int>               best; /* point per sample */
+    std::map<std::string, std::pair<bool, std::string>> saved_env;
+
+    void set_env(const std::string &name, const std::string &value);
+    void restore_env();
+    ucc_status_t enum_points();
+    ucc_status_t measure_point(ucc_pt_tune_point &p);
+    void select();
+    std::string score_str();
+    void print_selection(const std::string &str);
+    void write_tune_file(const std::string &str);
+    void write_json();
+public:
+    ucc_pt_tune(ucc_pt_config &cfg, ucc_pt_comm *communicator);
+    ucc_status_t run();
+};
+
+#endif
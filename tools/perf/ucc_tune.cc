@@ -0,0 +1,27 @@
+#include <ucc/api/ucc.h>
+#include "ucc_pt_comm.h"
+#include "ucc_pt_config.h"
+#include "ucc_pt_tune.h"
+
+int main(int argc, char *argv[])
+{
+    ucc_pt_config pt_config;
+    ucc_pt_comm *comm;
+    ucc_pt_tune *tune;
+    ucc_status_t st;
+
+    if (pt_config.process_tune_args(argc, argv) != UCC_OK) {
+        std::exit(1);
+    }
+    try {
+        comm = new ucc_pt_comm(pt_config.comm);
+    } catch(std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        std::exit(1);
+    }
+    tune = new ucc_pt_tune(pt_config, comm);
+    st = tune->run();
+    delete tune;
+    delete comm;
+    return (st == UCC_OK) ? 0 : 1;
+}